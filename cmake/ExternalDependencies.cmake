@@ -28,7 +28,7 @@
 
 # Find boost static libraries
 set(Boost_USE_STATIC_LIBS ON)
-find_package(Boost 1.58.0 REQUIRED QUIET COMPONENTS system date_time iostreams filesystem regex chrono program_options unit_test_framework)
+find_package(Boost 1.59.0 REQUIRED QUIET COMPONENTS system date_time iostreams filesystem regex chrono program_options unit_test_framework)
 	
 # Add boost include directories
 include_directories(${Boost_INCLUDE_DIR})
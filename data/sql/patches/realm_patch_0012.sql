@@ -0,0 +1 @@
+ALTER TABLE `character` ADD COLUMN `state` mediumblob DEFAULT NULL COMMENT 'Versioned binary character state (explored zones, auras, cooldowns, quests). NULL if stored relational.' AFTER `power5`;
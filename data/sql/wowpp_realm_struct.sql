@@ -55,6 +55,7 @@ CREATE TABLE `character` (
   `power3` int(10) unsigned DEFAULT '0',
   `power4` int(10) unsigned DEFAULT '0',
   `power5` int(10) unsigned DEFAULT '0',
+  `state` mediumblob DEFAULT NULL COMMENT 'Versioned binary character state (explored zones, auras, cooldowns, quests). NULL if stored relational.',
   `deleted_account` int(11) DEFAULT NULL,
   `deleted_timestamp` timestamp NULL DEFAULT NULL,
   PRIMARY KEY (`id`)
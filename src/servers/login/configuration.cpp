@@ -36,6 +36,9 @@ namespace wowpp
         , realmPort(wowpp::constants::DefaultLoginRealmPort)
 		, maxPlayers((std::numeric_limits<decltype(maxPlayers)>::max)())
 		, maxRealms((std::numeric_limits<decltype(maxRealms)>::max)())
+		, maxPendingLogins(1024)
+		, cryptoThreads(0)
+		, loginDatabaseConnections(2)
 		, mysqlPort(wowpp::constants::DefaultMySQLPort)
 		, mysqlHost("127.0.0.1")
 		, mysqlUser("wow-pp")
@@ -44,6 +47,7 @@ namespace wowpp
 		, isLogActive(true)
 		, logFileName("wowpp_login.log")
 		, isLogFileBuffering(false)
+		, logMinimumImportance(0)
 		, webPort(8090)
 		, webSSLPort(8091)
 		, webUser("wowpp-web")
@@ -119,6 +123,9 @@ namespace wowpp
 			{
 				playerPort = playerManager->getInteger("port", playerPort);
 				maxPlayers = playerManager->getInteger("maxCount", maxPlayers);
+				maxPendingLogins = playerManager->getInteger("maxPendingLogins", maxPendingLogins);
+				cryptoThreads = playerManager->getInteger("cryptoThreads", cryptoThreads);
+				loginDatabaseConnections = playerManager->getInteger("databaseConnections", loginDatabaseConnections);
 			}
 
 			if (const Table *const realmManager = global.getTable("realmManager"))
@@ -132,6 +139,7 @@ namespace wowpp
 				isLogActive = log->getInteger("active", static_cast<unsigned>(isLogActive)) != 0;
 				logFileName = log->getString("fileName", logFileName);
 				isLogFileBuffering = log->getInteger("buffering", static_cast<unsigned>(isLogFileBuffering)) != 0;
+				logMinimumImportance = log->getInteger("minimumImportance", logMinimumImportance);
 			}
 		}
 		catch (const sff::read::ParseException<Iterator> &e)
@@ -188,6 +196,9 @@ namespace wowpp
 			sff::write::Table<Char> playerManager(global, "playerManager", sff::write::MultiLine);
 			playerManager.addKey("port", playerPort);
 			playerManager.addKey("maxCount", maxPlayers);
+			playerManager.addKey("maxPendingLogins", maxPendingLogins);
+			playerManager.addKey("cryptoThreads", cryptoThreads);
+			playerManager.addKey("databaseConnections", loginDatabaseConnections);
 			playerManager.finish();
 		}
 
@@ -207,6 +218,7 @@ namespace wowpp
 			log.addKey("active", static_cast<unsigned>(isLogActive));
 			log.addKey("fileName", logFileName);
 			log.addKey("buffering", isLogFileBuffering);
+			log.addKey("minimumImportance", logMinimumImportance);
 			log.finish();
 		}
 
@@ -40,6 +40,12 @@ namespace wowpp
 		size_t maxPlayers;
 		/// Maximum number of realm connections.
 		size_t maxRealms;
+		/// Maximum number of logins which are processed at the same time. Further logins are rejected.
+		size_t maxPendingLogins;
+		/// Number of threads used for login cryptography. 0 means one per cpu core.
+		size_t cryptoThreads;
+		/// Number of database connections used for player logins.
+		size_t loginDatabaseConnections;
 
 		/// The port to be used for a mysql connection.
 		NetPort mysqlPort;
@@ -59,6 +65,8 @@ namespace wowpp
 		/// If enabled, the log contents will be buffered before they are written to
 		/// the file, which could be more efficient..
 		bool isLogFileBuffering;
+		/// Minimum importance of log messages which are emitted at all (0 = debug, 1 = info/warning, 2 = error).
+		UInt32 logMinimumImportance;
 
 		/// The port to be used for a web connection.
 		NetPort webPort;
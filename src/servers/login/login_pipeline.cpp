@@ -0,0 +1,227 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "login_pipeline.h"
+#include "database.h"
+#include "log/default_log_levels.h"
+#include "log/log_exception.h"
+#include <openssl/crypto.h>
+#include <mutex>
+
+namespace wowpp
+{
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	namespace
+	{
+		// OpenSSL versions before 1.1 are only thread safe if locking callbacks are installed
+		std::vector<std::unique_ptr<std::mutex>> s_openSSLLocks;
+
+		void openSSLLockingCallback(int mode, int type, const char * /*file*/, int /*line*/)
+		{
+			if (mode & CRYPTO_LOCK)
+			{
+				s_openSSLLocks[type]->lock();
+			}
+			else
+			{
+				s_openSSLLocks[type]->unlock();
+			}
+		}
+
+		void setupOpenSSLThreading()
+		{
+			if (CRYPTO_get_locking_callback() != nullptr)
+			{
+				return;
+			}
+
+			s_openSSLLocks.resize(CRYPTO_num_locks());
+			for (auto &lock : s_openSSLLocks)
+			{
+				lock.reset(new std::mutex());
+			}
+
+			CRYPTO_set_locking_callback(&openSSLLockingCallback);
+		}
+	}
+#endif
+
+	LoginPipeline::LoginPipeline(boost::asio::io_service &ioService, size_t cryptoThreads, size_t maxPendingLogins)
+		: m_ioService(ioService)
+		, m_cryptoWork(new boost::asio::io_service::work(m_cryptoQueue))
+		, m_pendingLogins(0)
+		, m_maxPendingLogins(maxPendingLogins)
+		, m_rejectedLogins(0)
+	{
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+		setupOpenSSLThreading();
+#endif
+
+		cryptoThreads = std::max<size_t>(1, cryptoThreads);
+		for (size_t i = 0; i < cryptoThreads; ++i)
+		{
+			m_cryptoThreads.emplace_back([this]()
+			{
+				m_cryptoQueue.run();
+			});
+		}
+	}
+
+	LoginPipeline::~LoginPipeline()
+	{
+		// Finish all queued crypto jobs
+		m_cryptoWork.reset();
+		for (auto &thread : m_cryptoThreads)
+		{
+			thread.join();
+		}
+
+		// Database workers finish their queued jobs when they are destroyed
+		m_databaseWorkers.clear();
+	}
+
+	void LoginPipeline::addDatabase(std::unique_ptr<IDatabase> database)
+	{
+		ASSERT(database);
+		m_databaseWorkers.emplace_back(new DatabaseWorker(std::move(database)));
+	}
+
+	bool LoginPipeline::tryAdmit()
+	{
+		if (m_pendingLogins >= m_maxPendingLogins)
+		{
+			m_rejectedLogins++;
+			return false;
+		}
+
+		m_pendingLogins++;
+		return true;
+	}
+
+	void LoginPipeline::release()
+	{
+		ASSERT(m_pendingLogins > 0);
+		m_pendingLogins--;
+	}
+
+	void LoginPipeline::runDatabase(DatabaseJob job, Completion completion)
+	{
+		ASSERT(!m_databaseWorkers.empty());
+
+		// Use the worker with the least amount of queued jobs
+		auto it = std::min_element(m_databaseWorkers.begin(), m_databaseWorkers.end(),
+			[](const std::unique_ptr<DatabaseWorker> &a, const std::unique_ptr<DatabaseWorker> &b)
+		{
+			return a->pending < b->pending;
+		});
+
+		DatabaseWorker &worker = **it;
+		worker.pending++;
+
+		const auto start = std::chrono::steady_clock::now();
+		IDatabase &database = *worker.database;
+		worker.worker.addWork([this, &worker, &database, start, job, completion]()
+		{
+			try
+			{
+				job(database);
+			}
+			catch (const std::exception &ex)
+			{
+				defaultLogException(ex);
+			}
+
+			m_ioService.post([this, &worker, start, completion]()
+			{
+				worker.pending--;
+				recordLatency(login_stage::Database,
+					std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+
+				if (completion)
+				{
+					completion();
+				}
+			});
+		});
+	}
+
+	void LoginPipeline::runCrypto(CryptoJob job, Completion completion)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		m_cryptoQueue.post([this, start, job, completion]()
+		{
+			try
+			{
+				job();
+			}
+			catch (const std::exception &ex)
+			{
+				defaultLogException(ex);
+			}
+
+			m_ioService.post([this, start, completion]()
+			{
+				recordLatency(login_stage::Crypto,
+					std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+
+				if (completion)
+				{
+					completion();
+				}
+			});
+		});
+	}
+
+	void LoginPipeline::recordLatency(LoginStage stage, std::chrono::microseconds latency)
+	{
+		ASSERT(stage < login_stage::Count_);
+
+		const UInt64 value = static_cast<UInt64>(latency.count());
+
+		auto &stats = m_statistics[stage];
+		stats.count++;
+		stats.totalMicroseconds += value;
+		stats.maxMicroseconds = std::max(stats.maxMicroseconds, value);
+	}
+
+	const LoginPipeline::StageStatistics &LoginPipeline::getStatistics(LoginStage stage) const
+	{
+		ASSERT(stage < login_stage::Count_);
+		return m_statistics[stage];
+	}
+
+	const char *LoginPipeline::getStageName(LoginStage stage)
+	{
+		switch (stage)
+		{
+			case login_stage::Database:
+				return "database";
+			case login_stage::Crypto:
+				return "crypto";
+			case login_stage::Total:
+				return "total";
+			default:
+				return "unknown";
+		}
+	}
+}
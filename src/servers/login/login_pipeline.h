@@ -0,0 +1,150 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "common/background_worker.h"
+#include <chrono>
+#include <thread>
+
+namespace wowpp
+{
+	struct IDatabase;
+
+	namespace login_stage
+	{
+		enum Type
+		{
+			/// Database requests (account lookup, session key storage).
+			Database,
+			/// SRP6 big number computations.
+			Crypto,
+			/// Complete login from the logon challenge until the logon proof answer.
+			Total,
+
+			Count_
+		};
+	}
+
+	typedef login_stage::Type LoginStage;
+
+	/// Moves the expensive parts of a login away from the io thread of the login server.
+	/// Database requests are executed by a pool of workers which each own a database
+	/// connection, SRP6 computations are executed by a pool of crypto threads. Completion
+	/// handlers are always executed on the io thread again.
+	/// Also limits the number of logins which may be processed at the same time.
+	class LoginPipeline final
+	{
+	private:
+
+		LoginPipeline(const LoginPipeline &Other) = delete;
+		LoginPipeline &operator=(const LoginPipeline &Other) = delete;
+
+	public:
+
+		typedef std::function<void(IDatabase &)> DatabaseJob;
+		typedef std::function<void()> CryptoJob;
+		typedef std::function<void()> Completion;
+
+		/// Latency statistics of a single stage in microseconds.
+		struct StageStatistics
+		{
+			UInt64 count;
+			UInt64 totalMicroseconds;
+			UInt64 maxMicroseconds;
+
+			explicit StageStatistics()
+				: count(0)
+				, totalMicroseconds(0)
+				, maxMicroseconds(0)
+			{
+			}
+		};
+
+	public:
+
+		/// Initializes the login pipeline and starts the crypto threads.
+		/// @param ioService The io service on which completion handlers are executed.
+		/// @param cryptoThreads Number of threads used for SRP6 computations.
+		/// @param maxPendingLogins Maximum number of logins in progress at the same time.
+		explicit LoginPipeline(boost::asio::io_service &ioService, size_t cryptoThreads, size_t maxPendingLogins);
+		~LoginPipeline();
+
+		/// Adds a database connection which will be used exclusively by a new database worker.
+		void addDatabase(std::unique_ptr<IDatabase> database);
+
+		/// Tries to start a new login. Has to be called on the io thread.
+		/// @returns false if too many logins are already in progress.
+		bool tryAdmit();
+		/// Notifies the pipeline that a login admitted by tryAdmit has finished.
+		void release();
+		/// Gets the number of logins in progress.
+		size_t getPendingLogins() const { return m_pendingLogins; }
+		/// Gets the maximum number of logins in progress at the same time.
+		size_t getMaxPendingLogins() const { return m_maxPendingLogins; }
+		/// Gets the total number of logins which were rejected because the queue was full.
+		UInt64 getRejectedLogins() const { return m_rejectedLogins; }
+
+		/// Executes a job on one of the database workers.
+		/// @param job Executed on the worker thread using the workers database connection.
+		/// @param completion Executed on the io thread after the job has finished. May be empty.
+		void runDatabase(DatabaseJob job, Completion completion);
+		/// Executes a job on one of the crypto threads.
+		/// @param job Executed on a crypto thread. Must not access any io thread data.
+		/// @param completion Executed on the io thread after the job has finished. May be empty.
+		void runCrypto(CryptoJob job, Completion completion);
+
+		/// Adds a latency sample to the statistics of a stage. Has to be called on the io thread.
+		void recordLatency(LoginStage stage, std::chrono::microseconds latency);
+		/// Gets the latency statistics of a stage.
+		const StageStatistics &getStatistics(LoginStage stage) const;
+		/// Gets the name of a stage.
+		static const char *getStageName(LoginStage stage);
+
+	private:
+
+		struct DatabaseWorker
+		{
+			std::unique_ptr<IDatabase> database;
+			/// Number of queued jobs (only accessed by the io thread).
+			size_t pending;
+			BackgroundWorker worker;
+
+			explicit DatabaseWorker(std::unique_ptr<IDatabase> database_)
+				: database(std::move(database_))
+				, pending(0)
+			{
+			}
+		};
+
+		boost::asio::io_service &m_ioService;
+		std::vector<std::unique_ptr<DatabaseWorker>> m_databaseWorkers;
+		boost::asio::io_service m_cryptoQueue;
+		std::unique_ptr<boost::asio::io_service::work> m_cryptoWork;
+		std::vector<std::thread> m_cryptoThreads;
+		size_t m_pendingLogins;
+		size_t m_maxPendingLogins;
+		UInt64 m_rejectedLogins;
+		std::array<StageStatistics, login_stage::Count_> m_statistics;
+	};
+}
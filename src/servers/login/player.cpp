@@ -28,16 +28,214 @@
 #include "common/constants.h"
 #include "log/default_log_levels.h"
 #include "database.h"
+#include "login_pipeline.h"
 
 using namespace std;
 
 namespace wowpp
 {
-	Player::Player(PlayerManager &manager, RealmManager &realmManager, IDatabase &database, SessionFactory createSession, std::shared_ptr<Client> connection,
+	namespace
+	{
+		/// Number of bytes used to store s.
+		const int ByteCountS = 32;
+		/// Number of bytes used by a sha1 hash. Taken from OpenSSL.
+		const int ShaDigestLength = 20;
+
+		/// Calculates initial values of S and V based on the users password hash.
+		/// Note: These values are cached in the database.
+		/// @param passwordHash A string containing the hexadecimal version of the SHA1 password hash.
+		void calculateVSFields(const String &passwordHash, BigNumber &out_s, BigNumber &out_v)
+		{
+			out_s.setRand(ByteCountS * 8);
+
+			BigNumber I;
+			I.setHexStr(passwordHash);
+
+			// In case of leading zeros in the rI hash, restore them
+			std::array<UInt8, ShaDigestLength> mDigest;
+			mDigest.fill(0);
+
+			if (I.getNumBytes() <= ShaDigestLength)
+			{
+				auto arr = I.asByteArray();
+				std::copy(arr.begin(), arr.end(), mDigest.begin());
+			}
+
+			std::reverse(mDigest.begin(), mDigest.end());
+
+			// Generate sha1 hash
+			Boost_SHA1HashSink sha;
+			std::vector<UInt8> sArr = out_s.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sha.write(reinterpret_cast<const char*>(mDigest.data()), ShaDigestLength);
+			SHA1Hash hash = sha.finalizeHash();
+
+			BigNumber x;
+			x.setBinary(hash.data(), hash.size());
+
+			out_v = constants::srp::g.modExp(x, constants::srp::N);
+		}
+
+		/// Data of a logon challenge which is passed through the login pipeline.
+		struct LogonChallengeData
+		{
+			// Database stage
+			bool found;
+			UInt32 accountId;
+			String passwordHash;
+			BigNumber s, v;
+
+			// Crypto stage
+			bool calculatedVS;
+			BigNumber b, B;
+			BigNumber unk3;
+
+			LogonChallengeData()
+				: found(false)
+				, accountId(0)
+				, calculatedVS(false)
+			{
+			}
+		};
+
+		/// Data of a logon proof which is passed through the login pipeline.
+		struct LogonProofData
+		{
+			// Input
+			String userName;
+			BigNumber s, v, b, B;
+			std::array<UInt8, 32> A;
+			std::array<UInt8, 20> M1;
+
+			// Output
+			bool invalidA;
+			bool success;
+			BigNumber K;
+			SHA1Hash hash;
+
+			LogonProofData()
+				: invalidA(false)
+				, success(false)
+			{
+				hash.fill(0);
+			}
+		};
+
+		/// Continues the SRP6 calculation based on data received from the client.
+		void calculateLogonProof(LogonProofData &data)
+		{
+			BigNumber A;
+			A.setBinary(data.A.data(), data.A.size());
+
+			// SRP safeguard: abort if A % N == 0
+			if ((A % constants::srp::N).isZero())
+			{
+				data.invalidA = true;
+				return;
+			}
+
+			// Build hash
+			Boost_SHA1HashSink sha;
+			std::vector<UInt8> sArr = A.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sArr = data.B.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			SHA1Hash hash = sha.finalizeHash();
+
+			BigNumber u;
+			u.setBinary(hash.data(), hash.size());
+			BigNumber S = (A * (data.v.modExp(u, constants::srp::N))).modExp(data.b, constants::srp::N);
+
+			std::vector<UInt8> t = S.asByteArray(32);
+			std::array<UInt8, 16> t1;
+			for (size_t i = 0; i < t1.size(); ++i)
+			{
+				t1[i] = t[i * 2];
+			}
+
+			sha.write(reinterpret_cast<const char*>(t1.data()), t1.size());
+			hash = sha.finalizeHash();
+
+			std::array<UInt8, 40> vK;
+			for (size_t i = 0; i < 20; ++i)
+			{
+				vK[i * 2] = hash[i];
+			}
+			for (size_t i = 0; i < 16; ++i)
+			{
+				t1[i] = t[i * 2 + 1];
+			}
+
+			BigNumber K;
+			sha.write(reinterpret_cast<const char*>(t1.data()), t1.size());
+			hash = sha.finalizeHash();
+			for (size_t i = 0; i < 20; ++i)
+			{
+				vK[i * 2 + 1] = hash[i];
+			}
+			K.setBinary(vK.data(), vK.size());
+
+			sArr = constants::srp::N.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			SHA1Hash h = sha.finalizeHash();
+
+			sArr = constants::srp::g.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			hash = sha.finalizeHash();
+
+			for (size_t i = 0; i < h.size(); ++i)
+			{
+				h[i] ^= hash[i];
+			}
+
+			BigNumber t3;
+			t3.setBinary(h.data(), h.size());
+
+			sha.write(reinterpret_cast<const char*>(data.userName.data()), data.userName.size());
+			SHA1Hash t4 = sha.finalizeHash();
+
+			sArr = t3.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sha.write(reinterpret_cast<const char*>(t4.data()), t4.size());
+			sArr = data.s.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sArr = A.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sArr = data.B.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			sArr = K.asByteArray();
+			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+			hash = sha.finalizeHash();
+
+			BigNumber M;
+			M.setBinary(hash.data(), hash.size());
+
+			/// Check if SRP6 results match (password is correct)
+			sArr = M.asByteArray(20);
+			if (std::equal(sArr.begin(), sArr.end(), data.M1.begin()))
+			{
+				/// Finish SRP6 and send the final result to the client
+				sArr = A.asByteArray();
+				sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+				sArr = M.asByteArray();
+				sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+				sArr = K.asByteArray();
+				sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
+				hash = sha.finalizeHash();
+
+				data.success = true;
+				data.K = K;
+			}
+
+			data.hash = hash;
+		}
+	}
+
+	Player::Player(PlayerManager &manager, RealmManager &realmManager, LoginPipeline &pipeline, SessionFactory createSession, std::shared_ptr<Client> connection,
 	               const String &address, TimerQueue &timerQueue)
 		: m_manager(manager)
 		, m_realmManager(realmManager)
-		, m_database(database)
+		, m_pipeline(pipeline)
 		, m_connection(std::move(connection))
 		, m_address(address)
         , m_createSession(createSession)
@@ -47,6 +245,8 @@ namespace wowpp
 		, m_timeout(timerQueue)
 		, m_nextRealmRequest(0)
 		, m_realmRequestCount(0)
+		, m_admitted(false)
+		, m_alive(std::make_shared<bool>(true))
 	{
 		ASSERT(m_connection);
 
@@ -71,45 +271,48 @@ namespace wowpp
 
 	void Player::destroy()
 	{
+		releaseLogin();
+
 		m_connection->resetListener();
 		m_connection.reset();
 
 		m_manager.playerDisconnected(*this);
 	}
 
-	void Player::setVSFields(const String &passwordHash)
+	void Player::releaseLogin()
 	{
-		m_s.setRand(ByteCountS * 8);
-
-		BigNumber I;
-		I.setHexStr(passwordHash);
-
-		// In case of leading zeros in the rI hash, restore them
-		std::array<UInt8, ShaDigestLength> mDigest;
-		mDigest.fill(0);
-
-		if (I.getNumBytes() <= ShaDigestLength)
+		if (m_admitted)
 		{
-			auto arr = I.asByteArray();
-			std::copy(arr.begin(), arr.end(), mDigest.begin());
+			m_pipeline.release();
+			m_admitted = false;
 		}
+	}
 
-		std::reverse(mDigest.begin(), mDigest.end());
-
-		// Generate sha1 hash
-		Boost_SHA1HashSink sha;
-		std::vector<UInt8> sArr = m_s.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sha.write(reinterpret_cast<const char*>(mDigest.data()), ShaDigestLength);
-		SHA1Hash hash = sha.finalizeHash();
-
-		BigNumber x;
-		x.setBinary(hash.data(), hash.size());
-
-		m_v = constants::srp::g.modExp(x, constants::srp::N);
+	std::function<void()> Player::whileAlive(std::function<void()> handler)
+	{
+		std::weak_ptr<bool> alive = m_alive;
+		return [alive, handler]()
+		{
+			if (!alive.expired())
+			{
+				handler();
+			}
+		};
+	}
 
-		// Update database values
-		m_database.setSVFields(m_accountId, m_s, m_v);
+	void Player::sendLogonChallenge(auth::AuthResult result)
+	{
+		m_connection->sendSinglePacket(
+			std::bind(
+				auth::server_write::logonChallenge,
+				std::placeholders::_1,
+				result,
+				(auth::SecurityFlags)(auth::security_flags::None /*| auth::security_flags::MatrixInput*/),
+				std::cref(m_B),
+				std::cref(constants::srp::g),
+				std::cref(constants::srp::N),
+				std::cref(m_s),
+				std::cref(m_unk3)));
 	}
 
 	void Player::connectionMalformedPacket()
@@ -122,22 +325,23 @@ namespace wowpp
 	{
 		const auto packetId = packet.getId();
 		bool isValid = true;
+		PacketParseResult result = PacketParseResult::Pass;
 
 		switch (packetId)
 		{
 			case auth::client_packet::LogonChallenge:
 			{
-				handleLogonChallenge(packet);
+				result = handleLogonChallenge(packet);
 				break;
 			}
 			case auth::client_packet::LogonProof:
 			{
-				handleLogonProof(packet);
+				result = handleLogonProof(packet);
 				break;
 			}
 			case auth::client_packet::ReconnectChallenge:
 			{
-				handleReconnectChallenge(packet);
+				result = handleReconnectChallenge(packet);
 				break;
 			}
 			case auth::client_packet::ReconnectProof:
@@ -166,10 +370,10 @@ namespace wowpp
 			m_timeout.setEnd(getCurrentTime() + constants::OneMinute);
 		}
 
-		return PacketParseResult::Pass;
+		return result;
 	}
 
-	void Player::handleLogonChallenge(auth::IncomingPacket &packet)
+	PacketParseResult Player::handleLogonChallenge(auth::IncomingPacket &packet)
 	{
 		// Read packet data and save it
 		if (!auth::client_read::logonChallenge(packet, m_version1, m_version2, m_version3, m_build, m_platform, m_system, m_locale, m_userName))
@@ -177,7 +381,7 @@ namespace wowpp
 			ELOG("Could not read packet CMD_AUTH_LOGON_CHALLENGE");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		if (m_accountId != 0)
@@ -185,7 +389,7 @@ namespace wowpp
 			WLOG("Player tried to log in again!");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 		
 		if (m_reconnectChallenge)
@@ -193,68 +397,100 @@ namespace wowpp
 			WLOG("Already sent reconnect challenge, so can't send login challenge");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
+		}
+
+		// Admission control: Don't accept more logins than we are able to handle
+		if (!m_admitted)
+		{
+			if (!m_pipeline.tryAdmit())
+			{
+				WLOG("Login queue is full, rejecting login of " << m_userName << " from " << m_address);
+				sendLogonChallenge(auth::auth_result::FailDbBusy);
+				return PacketParseResult::Pass;
+			}
+
+			m_admitted = true;
+			m_loginStart = std::chrono::steady_clock::now();
 		}
-		
-		// The temporary result
-		auth::AuthResult result = auth::auth_result::FailUnknownAccount;
 
 		// Try to get user settings
-		String dbPassword;
-		if (m_database.getPlayerPassword(m_userName, m_accountId, dbPassword))
+		auto data = std::make_shared<LogonChallengeData>();
+		const String userName = m_userName;
+		m_pipeline.runDatabase([data, userName](IDatabase &database)
 		{
-			if (m_accountId != 0)
+			data->found = database.getPlayerPassword(userName, data->accountId, data->passwordHash);
+			if (data->found && data->accountId != 0)
 			{
 				// TODO: Check if the account is banned / suspended etc.
-				BigNumber tmpS, tmpV;
-				m_database.getSVFields(m_accountId, tmpS, tmpV);
+				database.getSVFields(data->accountId, data->s, data->v);
+			}
+		}, whileAlive([this, data]()
+		{
+			if (!data->found || data->accountId == 0)
+			{
+				sendLogonChallenge(auth::auth_result::FailUnknownAccount);
+				releaseLogin();
+				m_connection->resumeParsing();
+				return;
+			}
 
-				if (tmpS.getNumBytes() != ByteCountS || tmpV.getNumBytes() != ByteCountS)
-				{
-					setVSFields(dbPassword);
-				}
-				else
+			m_accountId = data->accountId;
+
+			// Calculate SRP6 values
+			m_pipeline.runCrypto([data]()
+			{
+				if (data->s.getNumBytes() != ByteCountS || data->v.getNumBytes() != ByteCountS)
 				{
-					m_s = tmpS;
-					m_v = tmpV;
+					calculateVSFields(data->passwordHash, data->s, data->v);
+					data->calculatedVS = true;
 				}
 
-				// We are NOT banned so continue
-				result = auth::auth_result::Success;
-
-				m_b.setRand(19 * 8);
-				BigNumber gmod = constants::srp::g.modExp(m_b, constants::srp::N);
-				m_B = ((m_v * 3) + gmod) % constants::srp::N;
+				data->b.setRand(19 * 8);
+				BigNumber gmod = constants::srp::g.modExp(data->b, constants::srp::N);
+				data->B = ((data->v * 3) + gmod) % constants::srp::N;
 
 				ASSERT(gmod.getNumBytes() <= 32);
 
-				m_unk3.setRand(16 * 8);
+				data->unk3.setRand(16 * 8);
+			}, whileAlive([this, data]()
+			{
+				m_s = data->s;
+				m_v = data->v;
+				m_b = data->b;
+				m_B = data->B;
+				m_unk3 = data->unk3;
+
+				if (data->calculatedVS)
+				{
+					// Update database values
+					const UInt32 accountId = m_accountId;
+					const BigNumber s = m_s, v = m_v;
+					m_pipeline.runDatabase([accountId, s, v](IDatabase &database)
+					{
+						database.setSVFields(accountId, s, v);
+					}, nullptr);
+				}
+
+				// We are NOT banned so continue
 				m_loginChallenge = true;
-			}
-		}
+				sendLogonChallenge(auth::auth_result::Success);
+				m_connection->resumeParsing();
+			}));
+		}));
 
-		// Send packet
-		m_connection->sendSinglePacket(
-			std::bind(
-				auth::server_write::logonChallenge,
-				std::placeholders::_1,
-				result,
-				(auth::SecurityFlags)(auth::security_flags::None /*| auth::security_flags::MatrixInput*/),
-				std::cref(m_B),
-				std::cref(constants::srp::g),
-				std::cref(constants::srp::N),
-				std::cref(m_s),
-				std::cref(m_unk3)));
+		// Block incoming packets until the challenge has been answered
+		return PacketParseResult::Block;
 	}
 
-	void Player::handleLogonProof(auth::IncomingPacket &packet)
+	PacketParseResult Player::handleLogonProof(auth::IncomingPacket &packet)
 	{
 		if (m_accountId == 0)
 		{
 			WLOG("Tried to send logon proof before challenge");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		if (m_session)
@@ -262,7 +498,7 @@ namespace wowpp
 			WLOG("Tried to send proof when already proofed!");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 		
 		if (!m_loginChallenge || m_reconnectChallenge)
@@ -270,22 +506,21 @@ namespace wowpp
 			WLOG("Received logon proof without proper challenge packet!");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		// Read packet data and save it
-		std::array<UInt8, 32> rec_A;
-		std::array<UInt8, 20> rec_M1;
+		auto data = std::make_shared<LogonProofData>();
 		std::array<UInt8, 20> rec_crc_hash;
 		UInt8 number_of_keys;
 		UInt8 securityFlags;
 
 		// Parse packet content
-		if (!auth::client_read::logonProof(packet, rec_A, rec_M1, rec_crc_hash, number_of_keys, securityFlags))
+		if (!auth::client_read::logonProof(packet, data->A, data->M1, rec_crc_hash, number_of_keys, securityFlags))
 		{
 			ELOG("Could not read packet CMD_AUTH_LOGON_PROOF");
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		// TODO: Read pin input
@@ -298,7 +533,7 @@ namespace wowpp
 			{
 				ELOG("Could not read matrix card hash");
 				destroy();
-				return;
+				return PacketParseResult::Disconnect;
 			}
 
 			// TODO: Make sure that the hash matches...
@@ -308,156 +543,84 @@ namespace wowpp
 
 		// TODO: Token
 
-		SHA1Hash hash;
-
 		// Check if the client version is valid (SUPPORTED_CLIENT_BUILD is set in CMake)
 		if (m_build != SUPPORTED_CLIENT_BUILD)
 		{
 			// Send failure and stop here
 			WLOG("Player " << m_address << " tried to login with unsupported client build (" << m_build << ")");
-			m_connection->sendSinglePacket(
-				std::bind(
-					auth::server_write::logonChallenge,
-					std::placeholders::_1,
-					auth::auth_result::FailVersionInvalid,
-					auth::security_flags::None,
-					std::cref(m_B),
-					std::cref(constants::srp::g),
-					std::cref(constants::srp::N),
-					std::cref(m_s),
-					std::cref(m_unk3)));
-			return;
+			sendLogonChallenge(auth::auth_result::FailVersionInvalid);
+			releaseLogin();
+			return PacketParseResult::Pass;
 		}
 
-		// Continue the SRP6 calculation based on data received from the client
-		BigNumber A;
-		A.setBinary(rec_A.data(), rec_A.size());
-
-		// SRP safeguard: abort if A % N == 0
-		if ((A % constants::srp::N).isZero())
+		// Continue the SRP6 calculation on a crypto thread
+		data->userName = m_userName;
+		data->s = m_s;
+		data->v = m_v;
+		data->b = m_b;
+		data->B = m_B;
+		m_pipeline.runCrypto([data]()
 		{
-			ELOG("Detected invalid A value from client");
-			m_connection->close();
-			destroy();
-			return;
-		}
-
-		// Build hash
-		Boost_SHA1HashSink sha;
-		std::vector<UInt8> sArr = A.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sArr = m_B.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		hash = sha.finalizeHash();
-
-		BigNumber u;
-		u.setBinary(hash.data(), hash.size());
-		BigNumber S = (A * (m_v.modExp(u, constants::srp::N))).modExp(m_b, constants::srp::N);
-
-		std::vector<UInt8> t = S.asByteArray(32);
-		std::array<UInt8, 16> t1;
-		for (size_t i = 0; i < t1.size(); ++i)
+			calculateLogonProof(*data);
+		}, whileAlive([this, data]()
 		{
-			t1[i] = t[i * 2];
-		}
-
-		sha.write(reinterpret_cast<const char*>(t1.data()), t1.size());
-		hash = sha.finalizeHash();
-
-		std::array<UInt8, 40> vK;
-		for (size_t i = 0; i < 20; ++i)
-		{
-			vK[i * 2] = hash[i];
-		}
-		for (size_t i = 0; i < 16; ++i)
-		{
-			t1[i] = t[i * 2 + 1];
-		}
-
-		BigNumber K;
-		sha.write(reinterpret_cast<const char*>(t1.data()), t1.size());
-		hash = sha.finalizeHash();
-		for (size_t i = 0; i < 20; ++i)
-		{
-			vK[i * 2 + 1] = hash[i];
-		}
-		K.setBinary(vK.data(), vK.size());
-
-		sArr = constants::srp::N.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		SHA1Hash h = sha.finalizeHash();
-
-		sArr = constants::srp::g.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		hash = sha.finalizeHash();
-
-		for (size_t i = 0; i < h.size(); ++i)
-		{
-			h[i] ^= hash[i];
-		}
-
-		BigNumber t3;
-		t3.setBinary(h.data(), h.size());
-
-		sha.write(reinterpret_cast<const char*>(m_userName.data()), m_userName.size());
-		SHA1Hash t4 = sha.finalizeHash();
-
-		sArr = t3.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sha.write(reinterpret_cast<const char*>(t4.data()), t4.size());
-		sArr = m_s.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sArr = A.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sArr = m_B.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		sArr = K.asByteArray();
-		sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-		hash = sha.finalizeHash();
-
-		BigNumber M;
-		M.setBinary(hash.data(), hash.size());
+			if (data->invalidA)
+			{
+				ELOG("Detected invalid A value from client");
+				m_connection->close();
+				destroy();
+				return;
+			}
 
-		// Result
-		auth::AuthResult proofResult = auth::auth_result::FailUnknownAccount;
+			if (!data->success)
+			{
+				WLOG("Account " << m_userName << " tried to login with wrong password!");
+
+				// Send proof result
+				m_connection->sendSinglePacket(
+					std::bind(
+						auth::server_write::logonProof,
+						std::placeholders::_1,
+						auth::auth_result::FailUnknownAccount,
+						std::cref(data->hash)));
+
+				releaseLogin();
+				m_connection->resumeParsing();
+				return;
+			}
 
-		/// Check if SRP6 results match (password is correct), else send an error
-		sArr = M.asByteArray(20);
-		if (std::equal(sArr.begin(), sArr.end(), rec_M1.begin()))
-		{
 			ILOG("User " << m_userName << " successfully authenticated");
 
-			/// Finish SRP6 and send the final result to the client
-			sArr = A.asByteArray();
-			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-			sArr = M.asByteArray();
-			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-			sArr = K.asByteArray();
-			sha.write(reinterpret_cast<const char*>(sArr.data()), sArr.size());
-			hash = sha.finalizeHash();
-
 			// Create session
-			m_session = m_createSession(K, m_accountId, m_userName, m_v, m_s);
-			m_database.setKey(m_accountId, K);
-
-			// Send proof
-			proofResult = auth::auth_result::Success;
-		}
-		else
-		{
-			WLOG("Account " << m_userName << " tried to login with wrong password!");
-		}
+			m_session = m_createSession(data->K, m_accountId, m_userName, m_v, m_s);
 
-		// Send proof result
-		m_connection->sendSinglePacket(
-			std::bind(
-				auth::server_write::logonProof,
-				std::placeholders::_1,
-				proofResult,
-				std::cref(hash)));
+			// Store the session key before the client may use it to reconnect
+			const UInt32 accountId = m_accountId;
+			m_pipeline.runDatabase([accountId, data](IDatabase &database)
+			{
+				database.setKey(accountId, data->K);
+			}, whileAlive([this, data]()
+			{
+				// Send proof
+				m_connection->sendSinglePacket(
+					std::bind(
+						auth::server_write::logonProof,
+						std::placeholders::_1,
+						auth::auth_result::Success,
+						std::cref(data->hash)));
+
+				m_pipeline.recordLatency(login_stage::Total,
+					std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_loginStart));
+				releaseLogin();
+				m_connection->resumeParsing();
+			}));
+		}));
+
+		// Block incoming packets until the proof has been answered
+		return PacketParseResult::Block;
 	}
 
-	void Player::handleReconnectChallenge(auth::IncomingPacket & packet)
+	PacketParseResult Player::handleReconnectChallenge(auth::IncomingPacket & packet)
 	{
 		// Read packet data and save it
 		if (!auth::client_read::reconnectChallenge(packet, m_version1, m_version2, m_version3, m_build, m_platform, m_system, m_locale, m_userName))
@@ -465,7 +628,7 @@ namespace wowpp
 			ELOG("Could not read packet CMD_AUTH_RECONNECT_CHALLENGE");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		if (m_accountId != 0)
@@ -473,7 +636,7 @@ namespace wowpp
 			WLOG("Player tried to reconnect again!");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 		
 		if (m_loginChallenge)
@@ -481,29 +644,54 @@ namespace wowpp
 			WLOG("Already sent login challenge, so can't send reconnect challenge");
 			m_connection->close();
 			destroy();
-			return;
+			return PacketParseResult::Disconnect;
 		}
 
 		// Get account informations (TODO: We need a session key)
-		if (!m_database.getKey(m_userName, m_accountId, m_reconnectKey) ||
-			m_accountId == 0)
+		struct ReconnectData
 		{
-			WLOG("Unknown account!");
-			m_connection->close();
-			destroy();
-			return;
-		}
+			bool found;
+			UInt32 accountId;
+			BigNumber key;
+		};
 
-		// Build some random reconnect proof
-		m_reconnectProof.setRand(16 * 8);
-		m_reconnectChallenge = true;
-		
-		// Send proof result
-		m_connection->sendSinglePacket(
-			std::bind(
-				auth::server_write::reconnectChallenge,
-				std::placeholders::_1,
-				std::cref(m_reconnectProof)));
+		auto data = std::make_shared<ReconnectData>();
+		data->found = false;
+		data->accountId = 0;
+
+		const String userName = m_userName;
+		m_pipeline.runDatabase([data, userName](IDatabase &database)
+		{
+			data->found = database.getKey(userName, data->accountId, data->key);
+		}, whileAlive([this, data]()
+		{
+			if (!data->found || data->accountId == 0)
+			{
+				WLOG("Unknown account!");
+				m_connection->close();
+				destroy();
+				return;
+			}
+
+			m_accountId = data->accountId;
+			m_reconnectKey = data->key;
+
+			// Build some random reconnect proof
+			m_reconnectProof.setRand(16 * 8);
+			m_reconnectChallenge = true;
+
+			// Send proof result
+			m_connection->sendSinglePacket(
+				std::bind(
+					auth::server_write::reconnectChallenge,
+					std::placeholders::_1,
+					std::cref(m_reconnectProof)));
+
+			m_connection->resumeParsing();
+		}));
+
+		// Block incoming packets until the challenge has been answered
+		return PacketParseResult::Block;
 	}
 
 	void Player::handleReconnectProof(auth::IncomingPacket & packet)
@@ -25,13 +25,14 @@
 #include "auth_protocol/auth_connection.h"
 #include "common/big_number.h"
 #include "common/countdown.h"
+#include <chrono>
 #include "session.h"
 
 namespace wowpp
 {
 	class PlayerManager;
 	class RealmManager;
-	struct IDatabase;
+	class LoginPipeline;
 
 	/// Player connection class.
 	class Player final
@@ -51,7 +52,7 @@ namespace wowpp
 
 		explicit Player(PlayerManager &manager,
 						RealmManager &realmManager,
-						IDatabase &database,
+						LoginPipeline &pipeline,
 						SessionFactory createSession,
 		                std::shared_ptr<Client> connection,
 						const String &address,
@@ -81,7 +82,7 @@ namespace wowpp
 
 		PlayerManager &m_manager;
 		RealmManager &m_realmManager;
-		IDatabase &m_database;
+		LoginPipeline &m_pipeline;
 		std::shared_ptr<Client> m_connection;
 		String m_address;						// IP address in string format
 		String m_userName;						// Account name in uppercase letters
@@ -101,6 +102,9 @@ namespace wowpp
 		simple::scoped_connection m_onTimeout;
 		GameTime m_nextRealmRequest;
 		UInt8 m_realmRequestCount;
+		bool m_admitted;						// Counted as pending login by the login pipeline?
+		std::chrono::steady_clock::time_point m_loginStart;
+		std::shared_ptr<bool> m_alive;			// Expires on destruction, checked by pipeline completion handlers
 
 	private:
 
@@ -110,19 +114,17 @@ namespace wowpp
 		BigNumber m_reconnectProof;
 		BigNumber m_reconnectKey;
 
-		/// Number of bytes used to store m_s.
-		const static int ByteCountS = 32;
-		/// Number of bytes used by a sha1 hash. Taken from OpenSSL.
-		const static int ShaDigestLength = 20;
-
 	private:
 
 		/// Closes the connection if still connected.
 		void destroy();
-		/// Calculates initial values of S and V based on the users password hash.
-		/// Note: These values could be cached to the database.
-		/// @param passwordHash A string containing the hexadecimal version of the SHA1 password hash.
-		void setVSFields(const String &passwordHash);
+		/// Tells the login pipeline that this login is no longer in progress.
+		void releaseLogin();
+		/// Wraps a login pipeline completion handler so that it is skipped if this player
+		/// has been destroyed in the meantime.
+		std::function<void()> whileAlive(std::function<void()> handler);
+		/// Sends the result of a logon challenge.
+		void sendLogonChallenge(auth::AuthResult result);
 
 		/// @copydoc wow::auth::IConnectionListener::connectionLost()
 		void connectionLost() override;
@@ -133,13 +135,13 @@ namespace wowpp
 
 		/// Handles an incoming packet with packet id LogonChallenge.
 		/// @param packet The packet data.
-		void handleLogonChallenge(auth::IncomingPacket &packet);
+		PacketParseResult handleLogonChallenge(auth::IncomingPacket &packet);
 		/// Handles an incoming packet with packet id LogonProof.
 		/// @param packet The packet data.
-		void handleLogonProof(auth::IncomingPacket &packet);
+		PacketParseResult handleLogonProof(auth::IncomingPacket &packet);
 		/// Handles an incoming packet with packet id LogonChallenge.
 		/// @param packet The packet data.
-		void handleReconnectChallenge(auth::IncomingPacket &packet);
+		PacketParseResult handleReconnectChallenge(auth::IncomingPacket &packet);
 		/// Handles an incoming packet with packet id LogonProof.
 		/// @param packet The packet data.
 		void handleReconnectProof(auth::IncomingPacket &packet);
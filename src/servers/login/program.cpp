@@ -24,7 +24,8 @@
 #include "common/constants.h"
 #include "auth_protocol/auth_server.h"
 #include "wowpp_protocol/wowpp_server.h"
-#include "common/background_worker.h"
+#include "common/make_unique.h"
+#include "log/async_log_sink.h"
 #include "common/timer_queue.h"
 #include "log/log_std_stream.h"
 #include "log/log_entry.h"
@@ -35,6 +36,7 @@
 #include "realm_manager.h"
 #include "realm.h"
 #include "web_service.h"
+#include "login_pipeline.h"
 #include "version.h"
 
 namespace wowpp
@@ -62,11 +64,15 @@ namespace wowpp
 			return false;
 		}
 
+		// Skip formatting of log messages which aren't important enough
+		g_DefaultLog.setMinimumImportance(static_cast<LogImportance>(
+			std::min<UInt32>(m_configuration.logMinimumImportance, log_importance::High)));
+
 		// The log files are written to in a special background thread
 		std::ofstream logFile;
-		BackgroundWorker backgroundLogger;
 		LogStreamOptions logFileOptions = g_DefaultFileLogOptions;
 		logFileOptions.alwaysFlush = !m_configuration.isLogFileBuffering;
+		std::unique_ptr<AsyncLogSink> logSink;
 
 		simple::scoped_connection genericLogConnection;
 		if (m_configuration.isLogActive)
@@ -75,14 +81,16 @@ namespace wowpp
 			logFile.open(fileName.c_str(), std::ios::app);
 			if (logFile)
 			{
+				logSink = make_unique<AsyncLogSink>(std::bind(
+					printLogEntry,
+					std::ref(logFile),
+					std::placeholders::_1,
+					std::cref(logFileOptions)));
+
 				genericLogConnection = g_DefaultLog.signal().connect(
-					[&logFile, &backgroundLogger, &logFileOptions](const LogEntry & entry)
+					[&logSink](const LogEntry & entry)
 				{
-					backgroundLogger.addWork(std::bind(
-						printLogEntry,
-						std::ref(logFile),
-						entry,
-						std::cref(logFileOptions)));
+					logSink->push(entry);
 				});
 			}
 			else
@@ -107,6 +115,30 @@ namespace wowpp
 
 		// Set database instance
 		m_database = std::move(db);
+
+		// Setup the login pipeline, which uses its own database connections and crypto threads
+		const size_t cryptoThreads = (m_configuration.cryptoThreads != 0) ?
+			m_configuration.cryptoThreads : std::max<size_t>(1, std::thread::hardware_concurrency());
+		LoginPipeline loginPipeline(m_ioService, cryptoThreads, m_configuration.maxPendingLogins);
+		for (size_t i = 0; i < std::max<size_t>(1, m_configuration.loginDatabaseConnections); ++i)
+		{
+			std::unique_ptr<MySQLDatabase> loginDb(
+				new MySQLDatabase(
+					MySQL::DatabaseInfo(m_configuration.mysqlHost,
+										m_configuration.mysqlPort,
+										m_configuration.mysqlUser,
+										m_configuration.mysqlPassword,
+										m_configuration.mysqlDatabase)));
+			if (!loginDb->load())
+			{
+				return false;
+			}
+
+			loginPipeline.addDatabase(std::move(loginDb));
+		}
+
+		ILOG("Login pipeline: " << cryptoThreads << " crypto threads, " << std::max<size_t>(1, m_configuration.loginDatabaseConnections)
+			<< " database connections, up to " << m_configuration.maxPendingLogins << " pending logins");
 		
 		// Create the realm server
 		std::unique_ptr<wowpp::pp::Server> realmServer;
@@ -170,7 +202,7 @@ namespace wowpp
 			return std::unique_ptr<Session>(new Session(key, userId, std::move(userName), v, s));
 		};
 
-		auto const createPlayer = [&PlayerManager, &RealmManager, &Database, createSession, &timerQueue](std::shared_ptr<wowpp::Player::Client> connection)
+		auto const createPlayer = [&PlayerManager, &RealmManager, &loginPipeline, createSession, &timerQueue](std::shared_ptr<wowpp::Player::Client> connection)
 		{
 			connection->startReceiving();
 			boost::asio::ip::address address;
@@ -186,7 +218,7 @@ namespace wowpp
 				return;
 			}
 
-			std::unique_ptr<wowpp::Player> player(new wowpp::Player(*PlayerManager, *RealmManager, Database, createSession, std::move(connection), address.to_string(), timerQueue));
+			std::unique_ptr<wowpp::Player> player(new wowpp::Player(*PlayerManager, *RealmManager, loginPipeline, createSession, std::move(connection), address.to_string(), timerQueue));
 
 			DLOG("Incoming player connection from " << address);
 			PlayerManager->addPlayer(std::move(player));
@@ -201,7 +233,8 @@ namespace wowpp
 			m_configuration.webPort,
 			m_configuration.webPassword,
 			*PlayerManager,
-			Database
+			Database,
+			loginPipeline
 			));
 
 		// Log start
@@ -29,6 +29,7 @@
 #include "game/game_character.h"
 #include "log/default_log_levels.h"
 #include "database.h"
+#include "login_pipeline.h"
 
 namespace wowpp
 {
@@ -74,6 +75,27 @@ namespace wowpp
 
 					sendXmlAnswer(response, message.str());
 				}
+				else if (url == "/login-pipeline")
+				{
+					const auto &pipeline = static_cast<WebService &>(getService()).getLoginPipeline();
+
+					std::ostringstream message;
+					message << "<pipeline pending=\"" << pipeline.getPendingLogins()
+						<< "\" max=\"" << pipeline.getMaxPendingLogins()
+						<< "\" rejected=\"" << pipeline.getRejectedLogins() << "\">";
+					for (UInt32 i = 0; i < login_stage::Count_; ++i)
+					{
+						const auto stage = static_cast<LoginStage>(i);
+						const auto &stats = pipeline.getStatistics(stage);
+						message << "<stage name=\"" << LoginPipeline::getStageName(stage)
+							<< "\" count=\"" << stats.count
+							<< "\" avgUs=\"" << (stats.count ? stats.totalMicroseconds / stats.count : 0)
+							<< "\" maxUs=\"" << stats.maxMicroseconds << "\" />";
+					}
+					message << "</pipeline>";
+
+					sendXmlAnswer(response, message.str());
+				}
 				else
 				{
 					response.setStatus(net::http::OutgoingAnswer::NotFound);
@@ -33,11 +33,13 @@ namespace wowpp
 	    UInt16 port,
 	    String password,
 	    PlayerManager &playerManager,
-		IDatabase &database
+		IDatabase &database,
+		LoginPipeline &loginPipeline
 	)
 		: web::WebService(service, port)
 		, m_playerManager(playerManager)
 		, m_database(database)
+		, m_loginPipeline(loginPipeline)
 		, m_startTime(getCurrentTime())
 		, m_password(std::move(password))
 	{
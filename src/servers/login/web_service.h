@@ -26,6 +26,7 @@
 namespace wowpp
 {
 	class PlayerManager;
+	class LoginPipeline;
 	struct IDatabase;
 
 	class WebService 
@@ -38,11 +39,13 @@ namespace wowpp
 		    UInt16 port,
 		    String password,
 		    PlayerManager &playerManager,
-			IDatabase &database
+			IDatabase &database,
+			LoginPipeline &loginPipeline
 		);
 
 		PlayerManager &getPlayerManager() const { return m_playerManager; }
 		IDatabase &getDatabase() const { return m_database; }
+		LoginPipeline &getLoginPipeline() const { return m_loginPipeline; }
 		GameTime getStartTime() const;
 		const String &getPassword() const;
 
@@ -52,6 +55,7 @@ namespace wowpp
 
 		PlayerManager &m_playerManager;
 		IDatabase &m_database;
+		LoginPipeline &m_loginPipeline;
 		const GameTime m_startTime;
 		const String m_password;
 	};
@@ -55,14 +55,17 @@ namespace wowpp
 		, mysqlUser("wow-pp")
 		, mysqlPassword("test")
 		, mysqlDatabase("wowpp_realm")
+		, useCharacterStateBlob(false)
 		, isLogActive(true)
 		, logFileName("wowpp_realm.log")
 		, isLogFileBuffering(false)
+		, logMinimumImportance(0)
 		, messageOfTheDay("Welcome to the WoW++ Realm!\\nCore Version: $version\\nLast Change: $lastchange")
 		, webPort(8088)
 		, webSSLPort(8089)
 		, webUser("wowpp-web")
 		, webPassword("test")
+		, isPacketStatisticsActive(false)
 	{
 	}
 
@@ -120,6 +123,7 @@ namespace wowpp
 				mysqlUser = mysqlDatabaseTable->getString("user", mysqlUser);
 				mysqlPassword = mysqlDatabaseTable->getString("password", mysqlPassword);
 				mysqlDatabase = mysqlDatabaseTable->getString("database", mysqlDatabase);
+				useCharacterStateBlob = mysqlDatabaseTable->getInteger("characterStateBlob", static_cast<unsigned>(useCharacterStateBlob)) != 0;
 			}
 
 			if (const Table *const mysqlDatabaseTable = global.getTable("webServer"))
@@ -128,6 +132,7 @@ namespace wowpp
 				webSSLPort = mysqlDatabaseTable->getInteger("ssl_port", webSSLPort);
 				webUser = mysqlDatabaseTable->getString("user", webUser);
 				webPassword = mysqlDatabaseTable->getString("password", webPassword);
+				isPacketStatisticsActive = mysqlDatabaseTable->getInteger("packetStatistics", static_cast<unsigned>(isPacketStatisticsActive)) != 0;
 			}
 
 			if (const Table *const worldManager = global.getTable("worldManager"))
@@ -158,6 +163,7 @@ namespace wowpp
 				isLogActive = log->getInteger("active", static_cast<unsigned>(isLogActive)) != 0;
 				logFileName = log->getString("fileName", logFileName);
 				isLogFileBuffering = log->getInteger("buffering", static_cast<unsigned>(isLogFileBuffering)) != 0;
+				logMinimumImportance = log->getInteger("minimumImportance", logMinimumImportance);
 			}
 
 			if (const Table *const game = global.getTable("game"))
@@ -248,6 +254,7 @@ namespace wowpp
 			mysqlDatabaseTable.addKey("user", mysqlUser);
 			mysqlDatabaseTable.addKey("password", mysqlPassword);
 			mysqlDatabaseTable.addKey("database", mysqlDatabase);
+			mysqlDatabaseTable.addKey("characterStateBlob", static_cast<unsigned>(useCharacterStateBlob));
 			mysqlDatabaseTable.finish();
 		}
 
@@ -261,6 +268,7 @@ namespace wowpp
 			mysqlDatabaseTable.addKey("ssl_port", webSSLPort);
 			mysqlDatabaseTable.addKey("user", webUser);
 			mysqlDatabaseTable.addKey("password", webPassword);
+			mysqlDatabaseTable.addKey("packetStatistics", static_cast<unsigned>(isPacketStatisticsActive));
 			mysqlDatabaseTable.finish();
 		}
 
@@ -309,6 +317,7 @@ namespace wowpp
 			log.addKey("active", static_cast<unsigned>(isLogActive));
 			log.addKey("fileName", logFileName);
 			log.addKey("buffering", isLogFileBuffering);
+			log.addKey("minimumImportance", logMinimumImportance);
 			log.finish();
 		}
 
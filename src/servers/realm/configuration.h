@@ -70,6 +70,9 @@ namespace wowpp
 		String mysqlPassword;
 		/// The mysql database to be used.
 		String mysqlDatabase;
+		/// If enabled, explored zones, auras, cooldowns and quests of characters are saved as one
+		/// binary blob in the character table instead of the relational tables.
+		bool useCharacterStateBlob;
 
 		/// Indicates whether or not file logging is enabled.
 		bool isLogActive;
@@ -78,6 +81,8 @@ namespace wowpp
 		/// If enabled, the log contents will be buffered before they are written to
 		/// the file, which could be more efficient..
 		bool isLogFileBuffering;
+		/// Minimum importance of log messages which are emitted at all (0 = debug, 1 = info/warning, 2 = error).
+		UInt32 logMinimumImportance;
 
 		/// Message of the day which will be displayed to all players which enter the world.
 		String messageOfTheDay;
@@ -90,6 +95,9 @@ namespace wowpp
 		String webUser;
 		/// The password for the web user.
 		String webPassword;
+		/// Indicates whether per opcode packet statistics are collected right from the start. They
+		/// can also be enabled at runtime through the web interface.
+		bool isPacketStatisticsActive;
 
 		/// Initializes a new instance of the Configuration class using the default
 		/// values.
@@ -31,13 +31,32 @@
 #include "player_manager.h"
 #include "log/default_log_levels.h"
 #include "proto_data/project.h"
+#include "game/character_state.h"
+#include "binary_io/memory_source.h"
+#include "binary_io/string_sink.h"
 #include <stdexcept>
 
 namespace wowpp
 {
+	/// Lets a quest fail if it timed out while the character was offline.
+	static void checkQuestExpiration(QuestStatusData &data)
+	{
+		if ((data.status == game::quest_status::Incomplete || data.status == game::quest_status::Complete) &&
+			data.expiration > 0 &&
+			data.expiration <= GameTime(time(nullptr)))
+		{
+			data.status = game::quest_status::Failed;
+		}
+		else if (data.status == game::quest_status::Failed)
+		{
+			data.expiration = 1;
+		}
+	}
+
 	MySQLDatabase::MySQLDatabase(proto::Project &project, const MySQL::DatabaseInfo &connectionInfo)
 		: m_project(project)
 		, m_connectionInfo(connectionInfo)
+		, m_useStateBlob(false)
 	{
 	}
 
@@ -508,7 +527,9 @@ namespace wowpp
             //       15        16       17       18       19	   20					21			  22		 23				
 				   "`home_map`,`home_x`,`home_y`,`home_z`,`home_o`,`explored_zones`, `last_save`, `last_group`, `actionbars`,"
 			//		 24	      25             26			  27       28       29        30       31      32
-				   "`flags`, `played_time`, `level_time`, `health`,`power1`,`power2`,`power3`,`power4`,`power5` "
+				   "`flags`, `played_time`, `level_time`, `health`,`power1`,`power2`,`power3`,`power4`,`power5`, "
+			//		 33		  34
+				   "`state`, (SELECT COUNT(*) FROM `character_quests` WHERE `guid`={0}) "
 			"FROM `character` WHERE `id`={0} LIMIT 1"
 			, characterId));
 		if (select.success())
@@ -603,9 +624,31 @@ namespace wowpp
 				row.getField(23, actionBars);
 				out_character.setByteValue(character_fields::FieldBytes, 2, actionBars);
 
+				// Binary character state, if the character has been saved using it
+				CharacterState state;
+				bool hasState = false;
+				if (row.getField(33) && row.getFieldLength(33) > 0)
+				{
+					io::MemorySource source(row.getField(33), row.getField(33) + row.getFieldLength(33));
+					io::Reader reader(source);
+					hasState = static_cast<bool>(reader >> state);
+					if (!hasState)
+					{
+						WLOG("Could not read state of character " << characterId << " - using relational data instead");
+					}
+				}
+
 				String zoneBuffer;
 				row.getField(20, zoneBuffer);
-				if (!zoneBuffer.empty())
+				if (hasState)
+				{
+					for (auto &pair : state.quests)
+					{
+						checkQuestExpiration(pair.second);
+					}
+					state.apply(out_character);
+				}
+				else if (!zoneBuffer.empty())
 				{
 					std::stringstream strm(zoneBuffer);
 					for (size_t i = 0; i < 64; ++i)
@@ -715,63 +758,13 @@ namespace wowpp
 					}
 				}
 
-				// Load quest data
-				wowpp::MySQL::Select questSelect(m_connection, fmt::format(
-					//         0		1			2		
-					"SELECT `quest`, `status`, `explored`, "
-					//		3			4			5				6
-					"`unitcount1`, `unitcount2`, `unitcount3`, `unitcount4`, "
-					//		7				8				9			10
-					"`objectcount1`, `objectcount2`, `objectcount3`, `objectcount4`, "
-					//		11			12			13				14		  15
-					"`itemcount1`, `itemcount2`, `itemcount3`, `itemcount4`, `timer` "
-					"FROM `character_quests` WHERE `guid`={0}"
-					, characterId));
-				if (questSelect.success())
+				// Quest rows are written between two saves of a character and removed once the state
+				// blob of the character has been saved, so they are always newer than the blob
+				UInt32 questRowCount = 0;
+				row.getField(34, questRowCount);
+				if (!hasState || questRowCount > 0)
 				{
-					wowpp::MySQL::Row questRow(questSelect);
-					while (questRow)
-					{
-						UInt32 questId = 0, index = 0;
-						QuestStatusData data;
-						questRow.getField(index++, questId);
-						
-						UInt32 status = 0;
-						questRow.getField(index++, status);
-						data.status = static_cast<game::QuestStatus>(status);
-
-						questRow.getField(index++, data.explored);
-						questRow.getField(index++, data.creatures[0]);
-						questRow.getField(index++, data.creatures[1]);
-						questRow.getField(index++, data.creatures[2]);
-						questRow.getField(index++, data.creatures[3]);
-						questRow.getField(index++, data.objects[0]);
-						questRow.getField(index++, data.objects[1]);
-						questRow.getField(index++, data.objects[2]);
-						questRow.getField(index++, data.objects[3]);
-						questRow.getField(index++, data.items[0]);
-						questRow.getField(index++, data.items[1]);
-						questRow.getField(index++, data.items[2]);
-						questRow.getField(index++, data.items[3]);
-						questRow.getField(index++, data.expiration);
-						
-						// Let the quest fail if it timed out
-						if ((data.status == game::quest_status::Incomplete || data.status == game::quest_status::Complete) &&
-							data.expiration > 0 &&
-							data.expiration <= GameTime(time(nullptr)))
-						{
-							data.status = game::quest_status::Failed;
-						}
-						else if (data.status == game::quest_status::Failed)
-						{
-							data.expiration = 1;
-						}
-
-						out_character.setQuestData(questId, data);
-
-						// Next row
-						questRow = questRow.next(questSelect);
-					}
+					loadQuestRows(characterId, out_character);
 				}
 
 				// Load skills
@@ -810,42 +803,44 @@ namespace wowpp
 					}
 				}
 
-				out_character.getAuraData().clear();
-
-				// Load auras
-				wowpp::MySQL::Select auraSelect(m_connection, fmt::format(
-					//       0     
-					"SELECT `caster_guid`,`item_guid`,`spell`,`stack_count`,`remain_charges`,`basepoints_0`,`basepoints_1`,`basepoints_2`,`periodictime_0`,`periodictime_1`,`periodictime_2`,`max_duration`,`remain_time`,`eff_index_mask` FROM `character_auras` WHERE `guid`={0}"
-					, characterId));
-				if (auraSelect.success())
+				// Load auras, unless they are part of the character state
+				if (!hasState)
 				{
-					wowpp::MySQL::Row auraRow(auraSelect);
-					while (auraRow)
+					out_character.getAuraData().clear();
+					wowpp::MySQL::Select auraSelect(m_connection, fmt::format(
+						//       0     
+						"SELECT `caster_guid`,`item_guid`,`spell`,`stack_count`,`remain_charges`,`basepoints_0`,`basepoints_1`,`basepoints_2`,`periodictime_0`,`periodictime_1`,`periodictime_2`,`max_duration`,`remain_time`,`eff_index_mask` FROM `character_auras` WHERE `guid`={0}"
+						, characterId));
+					if (auraSelect.success())
 					{
-						Int32 fieldIndex = 0;
-
-						// Load data
-						AuraData data;
-						auraRow.getField(fieldIndex++, data.casterGuid);
-						auraRow.getField(fieldIndex++, data.itemGuid);
-						auraRow.getField(fieldIndex++, data.spell);
-						auraRow.getField(fieldIndex++, data.stackCount);
-						auraRow.getField(fieldIndex++, data.remainingCharges);
-						auraRow.getField(fieldIndex++, data.basePoints[0]);
-						auraRow.getField(fieldIndex++, data.basePoints[1]);
-						auraRow.getField(fieldIndex++, data.basePoints[2]);
-						auraRow.getField(fieldIndex++, data.periodicTime[0]);
-						auraRow.getField(fieldIndex++, data.periodicTime[1]);
-						auraRow.getField(fieldIndex++, data.periodicTime[2]);
-						auraRow.getField(fieldIndex++, data.maxDuration);
-						auraRow.getField(fieldIndex++, data.remainingTime);
-						auraRow.getField(fieldIndex++, data.effectIndexMask);
-
-						// Add data
-						out_character.getAuraData().push_back(std::move(data));
+						wowpp::MySQL::Row auraRow(auraSelect);
+						while (auraRow)
+						{
+							Int32 fieldIndex = 0;
+
+							// Load data
+							AuraData data;
+							auraRow.getField(fieldIndex++, data.casterGuid);
+							auraRow.getField(fieldIndex++, data.itemGuid);
+							auraRow.getField(fieldIndex++, data.spell);
+							auraRow.getField(fieldIndex++, data.stackCount);
+							auraRow.getField(fieldIndex++, data.remainingCharges);
+							auraRow.getField(fieldIndex++, data.basePoints[0]);
+							auraRow.getField(fieldIndex++, data.basePoints[1]);
+							auraRow.getField(fieldIndex++, data.basePoints[2]);
+							auraRow.getField(fieldIndex++, data.periodicTime[0]);
+							auraRow.getField(fieldIndex++, data.periodicTime[1]);
+							auraRow.getField(fieldIndex++, data.periodicTime[2]);
+							auraRow.getField(fieldIndex++, data.maxDuration);
+							auraRow.getField(fieldIndex++, data.remainingTime);
+							auraRow.getField(fieldIndex++, data.effectIndexMask);
+
+							// Add data
+							out_character.getAuraData().push_back(std::move(data));
 						
-						// Next row
-						auraRow = auraRow.next(auraSelect);
+							// Next row
+							auraRow = auraRow.next(auraSelect);
+						}
 					}
 				}
 
@@ -878,18 +873,67 @@ namespace wowpp
 		float homeO;
 		character.getHome(homeMap, homePos, homeO);
 
-		std::ostringstream strm;
-		for (UInt32 i = 0; i < 64; ++i)
+		const UInt32 lowerGuid = guidLowerPart(character.getGuid());
+
+		// Explored zones, auras, cooldowns and quests are saved as part of the character row if
+		// enabled, in which case the explored zones text column is cleared
+		String exploredZonesValue("NULL");
+		String stateValue("NULL");
+		bool rewriteQuests = m_useStateBlob;
+		if (!m_useStateBlob)
 		{
-			strm << character.getUInt32Value(character_fields::ExploredZones_1 + i) << " ";
+			// Quest rows are only rewritten if the character was saved as a state blob before, as
+			// they are otherwise kept up to date by setQuestData
+			wowpp::MySQL::Select stateSelect(m_connection, fmt::format(
+				"SELECT `state` IS NOT NULL FROM `character` WHERE `id`={0} LIMIT 1"
+				, lowerGuid));
+			if (!stateSelect.success())
+			{
+				printDatabaseError();
+				return false;
+			}
+
+			wowpp::MySQL::Row stateRow(stateSelect);
+			if (stateRow)
+			{
+				UInt32 hasState = 0;
+				stateRow.getField(0, hasState);
+				rewriteQuests = (hasState != 0);
+			}
+
+			std::ostringstream strm;
+			strm << "'";
+			for (UInt32 i = 0; i < 64; ++i)
+			{
+				strm << character.getUInt32Value(character_fields::ExploredZones_1 + i) << " ";
+			}
+			strm << "'";
+			exploredZonesValue = strm.str();
 		}
+		else
+		{
+			CharacterState state;
+			state.capture(character);
 
-		const UInt32 lowerGuid = guidLowerPart(character.getGuid());
+			String buffer;
+			io::StringSink sink(buffer);
+			io::Writer writer(sink);
+			writer << state;
+
+			// Saving would fail or truncate the blob, and quest rows are deleted below
+			if (buffer.size() > CharacterState::MaxSerializedSize)
+			{
+				ELOG("State of character " << lowerGuid << " is too large to be saved (" << buffer.size() << " bytes)");
+				return false;
+			}
+
+			stateValue = "'" + m_connection.escapeString(buffer) + "'";
+		}
 
 		if (!m_connection.execute(fmt::format(
 			"UPDATE `character` SET `map`={1}, `zone`={2}, `position_x`={3}, `position_y`={4}, `position_z`={5}, `orientation`={6}, `level`={7}, `xp`={8}, `gold`={9}, "
-			"`home_map`={10}, `home_x`={11}, `home_y`={12}, `home_z`={13}, `home_o`={14}, `explored_zones`='{15}', `last_save`={16}, `last_group`={17}, `actionbars`={18}, `flags`={19},"
-			"`played_time`={20}, `level_time`={21}, `health`={22},`power1`={23},`power2`={24},`power3`={25},`power4`={26},`power5`={27} WHERE `id`={0};"
+			"`home_map`={10}, `home_x`={11}, `home_y`={12}, `home_z`={13}, `home_o`={14}, `explored_zones`={15}, `last_save`={16}, `last_group`={17}, `actionbars`={18}, `flags`={19},"
+			"`played_time`={20}, `level_time`={21}, `health`={22},`power1`={23},`power2`={24},`power3`={25},`power4`={26},`power5`={27}, `state`={28} WHERE `id`={0};"
 			, lowerGuid															// 0
 			, character.getMapId()												// 1
 			, character.getZone()												// 2
@@ -899,7 +943,7 @@ namespace wowpp
 			, character.getUInt32Value(character_fields::Coinage)				// 9
 			, homeMap															// 10
 			, homePos.x, homePos.y, homePos.z, homeO							// 11, 12, 13, 14
-			, strm.str()														// 15
+			, exploredZonesValue												// 15
 			, time(nullptr)														// 16
 			, character.getGroupId()											// 17
 			, UInt32(character.getByteValue(character_fields::FieldBytes, 2))	// 18
@@ -912,6 +956,7 @@ namespace wowpp
 			, character.getUInt32Value(unit_fields::Power3)						// 25
 			, character.getUInt32Value(unit_fields::Power4)						// 26
 			, character.getUInt32Value(unit_fields::Power5)						// 27
+			, stateValue														// 28
 			)))
 		{
 			// There was an error
@@ -1062,47 +1107,97 @@ namespace wowpp
 			}
 		}
 
-		// Delete character auras
-		if (!m_connection.execute(fmt::format(
-			"DELETE FROM `character_auras` WHERE `guid`={0};"
-			, lowerGuid					// 0
-		)))
+		// Quest rows written since the last save are either contained in the state blob or
+		// rewritten below
+		if (rewriteQuests)
 		{
-			// There was an error
-			printDatabaseError();
-			return false;
+			if (!m_connection.execute(fmt::format(
+				"DELETE FROM `character_quests` WHERE `guid`={0};"
+				, lowerGuid					// 0
+			)))
+			{
+				// There was an error
+				printDatabaseError();
+				return false;
+			}
 		}
 
-		// Save character auras
-		const auto& auraData = character.getAuraData();
-		if (!auraData.empty())
+		if (!m_useStateBlob)
 		{
-			std::ostringstream strm;
-			strm << "INSERT INTO `character_auras` (`guid`, `caster_guid`, `item_guid`, `spell`, `stack_count`, `remain_charges`, `basepoints_0`, `basepoints_1`, `basepoints_2`, `periodictime_0`, `periodictime_1`, `periodictime_2`, `max_duration`, `remain_time`, `eff_index_mask`) VALUES ";
-			bool isFirstItem = true;
-			for (const auto &data : auraData)
+			// Save character quests when switching a character back from a state blob
+			const auto &quests = character.getQuests();
+			if (rewriteQuests && !quests.empty())
 			{
-				if (!isFirstItem) strm << ",";
-				else
+				std::ostringstream strm;
+				strm << "INSERT INTO `character_quests` (`guid`, `quest`, `status`, `explored`, `timer`, `unitcount1`, `unitcount2`, `unitcount3`, `unitcount4`, `objectcount1`, `objectcount2`, `objectcount3`, `objectcount4`, `itemcount1`, `itemcount2`, `itemcount3`, `itemcount4`) VALUES ";
+				bool isFirstItem = true;
+				for (const auto &pair : quests)
 				{
-					isFirstItem = false;
+					if (!isFirstItem) strm << ",";
+					else
+					{
+						isFirstItem = false;
+					}
+
+					const auto &data = pair.second;
+					strm
+						<< "(" << lowerGuid << "," << pair.first << "," << static_cast<UInt32>(data.status) << "," << (data.explored ? 1 : 0) << "," << data.expiration << ","
+						<< data.creatures[0] << "," << data.creatures[1] << "," << data.creatures[2] << "," << data.creatures[3] << ","
+						<< data.objects[0] << "," << data.objects[1] << "," << data.objects[2] << "," << data.objects[3] << ","
+						<< data.items[0] << "," << data.items[1] << "," << data.items[2] << "," << data.items[3] << ")";
 				}
+				strm << ";";
 
-				strm 
-					<< "(" 
-					<< lowerGuid << "," << data.casterGuid << "," << data.itemGuid << "," << data.spell << "," << data.stackCount << "," << data.remainingCharges << "," 
-					<< data.basePoints[0] << "," << data.basePoints[1] << "," << data.basePoints[2] << "," 
-					<< data.periodicTime[0] << "," << data.periodicTime[1] << "," << data.periodicTime[2] << "," 
-					<< data.maxDuration << "," << data.remainingTime << "," << data.effectIndexMask << ")";
+				if (!m_connection.execute(strm.str()))
+				{
+					// There was an error
+					printDatabaseError();
+					return false;
+				}
 			}
-			strm << ";";
 
-			if (!m_connection.execute(strm.str()))
+			// Delete character auras
+			if (!m_connection.execute(fmt::format(
+				"DELETE FROM `character_auras` WHERE `guid`={0};"
+				, lowerGuid					// 0
+			)))
 			{
 				// There was an error
 				printDatabaseError();
 				return false;
 			}
+
+			// Save character auras
+			const auto& auraData = character.getAuraData();
+			if (!auraData.empty())
+			{
+				std::ostringstream strm;
+				strm << "INSERT INTO `character_auras` (`guid`, `caster_guid`, `item_guid`, `spell`, `stack_count`, `remain_charges`, `basepoints_0`, `basepoints_1`, `basepoints_2`, `periodictime_0`, `periodictime_1`, `periodictime_2`, `max_duration`, `remain_time`, `eff_index_mask`) VALUES ";
+				bool isFirstItem = true;
+				for (const auto &data : auraData)
+				{
+					if (!isFirstItem) strm << ",";
+					else
+					{
+						isFirstItem = false;
+					}
+
+					strm 
+						<< "(" 
+						<< lowerGuid << "," << data.casterGuid << "," << data.itemGuid << "," << data.spell << "," << data.stackCount << "," << data.remainingCharges << "," 
+						<< data.basePoints[0] << "," << data.basePoints[1] << "," << data.basePoints[2] << "," 
+						<< data.periodicTime[0] << "," << data.periodicTime[1] << "," << data.periodicTime[2] << "," 
+						<< data.maxDuration << "," << data.remainingTime << "," << data.effectIndexMask << ")";
+				}
+				strm << ";";
+
+				if (!m_connection.execute(strm.str()))
+				{
+					// There was an error
+					printDatabaseError();
+					return false;
+				}
+			}
 		}
 
 		transaction.commit();
@@ -1118,6 +1213,57 @@ namespace wowpp
 		ASSERT(false);
 	}
 
+	void MySQLDatabase::loadQuestRows(DatabaseId characterId, GameCharacter &out_character)
+	{
+		wowpp::MySQL::Select questSelect(m_connection, fmt::format(
+			//         0		1			2		
+			"SELECT `quest`, `status`, `explored`, "
+			//		3			4			5				6
+			"`unitcount1`, `unitcount2`, `unitcount3`, `unitcount4`, "
+			//		7				8				9			10
+			"`objectcount1`, `objectcount2`, `objectcount3`, `objectcount4`, "
+			//		11			12			13				14		  15
+			"`itemcount1`, `itemcount2`, `itemcount3`, `itemcount4`, `timer` "
+			"FROM `character_quests` WHERE `guid`={0}"
+			, characterId));
+		if (questSelect.success())
+		{
+			wowpp::MySQL::Row questRow(questSelect);
+			while (questRow)
+			{
+				UInt32 questId = 0, index = 0;
+				QuestStatusData data;
+				questRow.getField(index++, questId);
+				
+				UInt32 status = 0;
+				questRow.getField(index++, status);
+				data.status = static_cast<game::QuestStatus>(status);
+
+				questRow.getField(index++, data.explored);
+				questRow.getField(index++, data.creatures[0]);
+				questRow.getField(index++, data.creatures[1]);
+				questRow.getField(index++, data.creatures[2]);
+				questRow.getField(index++, data.creatures[3]);
+				questRow.getField(index++, data.objects[0]);
+				questRow.getField(index++, data.objects[1]);
+				questRow.getField(index++, data.objects[2]);
+				questRow.getField(index++, data.objects[3]);
+				questRow.getField(index++, data.items[0]);
+				questRow.getField(index++, data.items[1]);
+				questRow.getField(index++, data.items[2]);
+				questRow.getField(index++, data.items[3]);
+				questRow.getField(index++, data.expiration);
+				
+				checkQuestExpiration(data);
+
+				out_character.setQuestData(questId, data);
+
+				// Next row
+				questRow = questRow.next(questSelect);
+			}
+		}
+	}
+
 	game::CharEntry MySQLDatabase::getCharacterById(DatabaseId id)
 	{
 		// Create temporary character entry for the results
@@ -43,6 +43,9 @@ namespace wowpp
 
 		/// Tries to establish a connection to the MySQL server.
 		bool load();
+		/// Enables or disables saving characters with the binary character state blob. Characters
+		/// which already have a blob are always loaded from it.
+		void setCharacterStateBlob(bool enable) { m_useStateBlob = enable; }
 
 		/// @copydoc wowpp::IDatabase::renameCharacter
 		game::ResponseCode renameCharacter(DatabaseId id, const String &newName) override;
@@ -107,11 +110,14 @@ namespace wowpp
 
 		/// Prints the last database error to the log.
 		void printDatabaseError();
+		/// Loads the rows of the character_quests table into a character.
+		void loadQuestRows(DatabaseId characterId, GameCharacter &out_character);
 
 	private:
 
 		proto::Project &m_project;
 		MySQL::DatabaseInfo m_connectionInfo;
 		MySQL::Connection m_connection;
+		bool m_useStateBlob;
 	};
 }
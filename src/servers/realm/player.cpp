@@ -53,6 +53,7 @@ namespace wowpp
 		           IDatabase &database,
 		           AsyncDatabase &asyncDatabase,
 		           proto::Project &project, 
+		           QueryCache &queryCache,
 		           std::shared_ptr<Client> connection,
 		           const String &address)
 		: m_config(config)
@@ -63,6 +64,7 @@ namespace wowpp
 		, m_database(database)
 		, m_asyncDatabase(asyncDatabase)
 		, m_project(project)
+		, m_queryCache(queryCache)
 		, m_connection(std::move(connection))
 		, m_address(address)
         , m_authed(false)
@@ -422,12 +424,11 @@ namespace wowpp
 			m_social->sendToFriends(
 				std::bind(game::server_write::friendStatus, std::placeholders::_1, m_gameCharacter->getGuid(), game::friend_result::Offline, std::cref(info)));
 
-			// Try to find the world node
-			auto world = m_worldManager.getWorldByInstanceId(m_instanceId);
-			if (world)
+			// Notify the world node the character is on
+			if (m_worldNode)
 			{
 				ILOG("Sent leave world instance packet");
-				world->leaveWorldInstance(m_characterId, pp::world_realm::world_left_reason::Disconnect);
+				m_worldNode->leaveWorldInstance(m_characterId, pp::world_realm::world_left_reason::Disconnect);
 				// We don't destroy this player instance yet, as we are still connected to a world node: This world node needs to
 				// send the character's new data back to us, so that we can save it.
 				return;
@@ -592,12 +593,11 @@ namespace wowpp
 				if (m_gameCharacter)
 				{
 					// Redirect packet as proxy packet
-					auto world = m_worldManager.getWorldByInstanceId(m_instanceId);
-					if (world)
+					if (m_worldNode)
 					{
 						// Buffer
 						const std::vector<char> packetBuffer(memorySource->getBegin(), memorySource->getEnd());
-						world->sendProxyPacket(m_characterId, packetId, packetBuffer.size(), packetBuffer);
+						m_worldNode->sendProxyPacket(m_characterId, packetId, packetBuffer.size(), packetBuffer);
 						break;
 					}
 				}
@@ -630,7 +630,7 @@ namespace wowpp
 		if (m_group &&
 			m_group->isMember(m_gameCharacter->getGuid()))
 		{
-			m_group->addInstanceBinding(instanceId, mapId);
+			m_group->addInstanceBinding(world, instanceId, mapId);
 		}
 
 		// Update character on the realm side with data received from the world server
@@ -863,6 +863,33 @@ namespace wowpp
 		packet
 			<< io::write_range(buffer);
 		packet.finish();
+		m_connection->countSentPacket(opCode, sendBuffer.size() - bufferPos);
+
+		// Crypt packet header
+		game::Connection *cryptCon = static_cast<game::Connection*>(m_connection.get());
+		cryptCon->getCrypt().encryptSend(reinterpret_cast<UInt8*>(&sendBuffer[bufferPos]), game::Crypt::CryptedSendLength);
+
+		// Flush buffers
+		m_connection->flush();
+	}
+
+	void Player::sendCachedPacket(const std::vector<char> &buffer)
+	{
+		if (buffer.empty())
+			return;
+
+		wowpp::Buffer &sendBuffer = m_connection->getSendBuffer();
+
+		// Get the end of the buffer (needed for encryption)
+		const size_t bufferPos = sendBuffer.size();
+		sendBuffer.append(buffer.data(), buffer.size());
+
+		// Cached packets contain the plain header: size (2 bytes) followed by the opcode
+		if (buffer.size() >= game::Crypt::CryptedSendLength)
+		{
+			const UInt16 opCode = static_cast<UInt8>(buffer[2]) | (static_cast<UInt8>(buffer[3]) << 8);
+			m_connection->countSentPacket(opCode, buffer.size());
+		}
 
 		// Crypt packet header
 		game::Connection *cryptCon = static_cast<game::Connection*>(m_connection.get());
@@ -1019,7 +1046,7 @@ namespace wowpp
 
 	bool Player::initializeTransfer(UInt32 map, math::Vector3 location, float o, bool shouldLeaveNode/* = false*/)
 	{
-		auto *world = m_worldManager.getWorldByInstanceId(m_instanceId);
+		auto *world = m_worldNode;
 		if (shouldLeaveNode && !world)
 		{
 			return false;
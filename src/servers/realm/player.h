@@ -42,6 +42,7 @@ namespace wowpp
 	struct Configuration;
 	class PlayerSocial;
 	class PlayerGroup;
+	class QueryCache;
 	namespace proto
 	{
 		class Project;
@@ -114,6 +115,7 @@ namespace wowpp
 						IDatabase &database,
 						AsyncDatabase &asyncDatabase,
 						proto::Project &project,
+						QueryCache &queryCache,
 		                std::shared_ptr<Client> connection,
 						const String &address);
 
@@ -197,6 +199,7 @@ namespace wowpp
 
 			typename game::Protocol::OutgoingPacket packet(sink);
 			generator(packet);
+			m_connection->countSentPacket(packet.getOpCode(), sink.position() - bufferPos);
 
 			// Crypt packet header
 			game::Connection *cryptCon = static_cast<game::Connection*>(m_connection.get());
@@ -212,6 +215,10 @@ namespace wowpp
 		/// @param opCode The packet's identifier.
 		/// @param buffer The packet content buffer which also includes the op code and the packet size.
 		void sendProxyPacket(UInt16 opCode, const std::vector<char> &buffer);
+		/// Sends a packet which has already been serialized (including the unencrypted header)
+		/// to the client and encrypts it's header.
+		/// @param buffer The complete packet buffer.
+		void sendCachedPacket(const std::vector<char> &buffer);
 
 	public:
 
@@ -230,6 +237,7 @@ namespace wowpp
 		IDatabase &m_database;
 		AsyncDatabase &m_asyncDatabase;
 		proto::Project &m_project;
+		QueryCache &m_queryCache;
 		std::shared_ptr<Client> m_connection;
 		String m_address;								// IP address in string format
 		String m_accountName;
@@ -370,26 +370,33 @@ namespace wowpp
 		return 0;
 	}
 
-	UInt32 PlayerGroup::instanceBindingForMap(UInt32 map)
+	const PlayerGroup::InstanceBinding *PlayerGroup::instanceBindingForMap(UInt32 map) const
 	{
 		auto it = m_instances.find(map);
 		if (it != m_instances.end())
 		{
-			return it->second;
+			return &it->second;
 		}
 
-		return std::numeric_limits<UInt32>::max();
+		return nullptr;
 	}
 
-	bool PlayerGroup::addInstanceBinding(UInt32 instance, UInt32 map)
+	bool PlayerGroup::addInstanceBinding(World &world, UInt32 instance, UInt32 map)
 	{
 		auto it = m_instances.find(map);
 		if (it != m_instances.end())
 		{
-			return false;
+			// Keep the binding as long as the bound instance is still running
+			auto boundWorld = it->second.world.lock();
+			if (boundWorld && boundWorld->hasInstance(it->second.instanceId))
+			{
+				return false;
+			}
 		}
 
-		m_instances[map] = instance;
+		auto &binding = m_instances[map];
+		binding.world = world.shared_from_this();
+		binding.instanceId = instance;
 		return true;
 	}
 
@@ -96,7 +96,15 @@ namespace wowpp
 
 		typedef std::map<UInt64, game::GroupMemberSlot> MembersByGUID;
 		typedef LinearSet<UInt64> InvitedMembers;
-		typedef std::map<UInt32, UInt32> InstancesByMap;
+		/// An instance the group is bound to. Instance ids are only unique per world node.
+		struct InstanceBinding
+		{
+			/// The world node which runs the instance.
+			std::weak_ptr<World> world;
+			/// The id of the instance on that world node.
+			UInt32 instanceId;
+		};
+		typedef std::map<UInt32, InstanceBinding> InstancesByMap;
 		typedef std::array<UInt64, 8> TargetIcons;
 
 	public:
@@ -129,10 +137,10 @@ namespace wowpp
 		void sendUpdate();
 		/// 
 		void disband(bool silent);
-		/// 
-		UInt32 instanceBindingForMap(UInt32 map);
-		/// 
-		bool addInstanceBinding(UInt32 instance, UInt32 map);
+		/// Gets the instance of a map the group is bound to or nullptr if there is no binding.
+		const InstanceBinding *instanceBindingForMap(UInt32 map) const;
+		/// Binds the group to an instance of a map unless it is already bound to a running instance of that map.
+		bool addInstanceBinding(World &world, UInt32 instance, UInt32 map);
 		/// Sends the groups target list to a specific player instance.
 		/// @param player 
 		void sendTargetList(Player &player);
@@ -38,6 +38,7 @@
 #include "game/game_item.h"
 #include "player_group.h"
 #include "game/constants.h"
+#include "query_cache.h"
 
 using namespace std;
 
@@ -446,6 +447,7 @@ namespace wowpp
 		}
 
 		// Restore character group if possible
+		std::shared_ptr<World> groupWorld;
 		UInt32 groupInstanceId = std::numeric_limits<UInt32>::max();
 		if (character->getGroupId() != 0)
 		{
@@ -454,7 +456,11 @@ namespace wowpp
 			{
 				// Apply character group
 				m_group = groupIt->second;
-				groupInstanceId = m_group->instanceBindingForMap(charEntry->mapId);
+				if (const auto *binding = m_group->instanceBindingForMap(charEntry->mapId))
+				{
+					groupWorld = binding->world.lock();
+					groupInstanceId = binding->instanceId;
+				}
 			}
 			else
 			{
@@ -467,7 +473,8 @@ namespace wowpp
 		// which is hosting a fitting world instance or is able to create
 		// a new one
 
-		auto *worldNode = m_worldManager.getWorldByMapId(charEntry->mapId);
+		const auto *map = m_project.maps.getById(charEntry->mapId);
+		auto *worldNode = map ? m_worldManager.selectWorldForMap(*map, groupWorld.get(), groupInstanceId) : nullptr;
 		if (!worldNode)
 		{
 			// World does not exist
@@ -544,15 +551,14 @@ namespace wowpp
 		if (realmID != m_loginConnector.getRealmID())
 		{
 			// Redirect the request to the current world node
-			auto world = m_worldManager.getWorldByInstanceId(m_instanceId);
-			if (world)
+			if (m_worldNode)
 			{
 				// Decrypt position
 				io::MemorySource *memorySource = static_cast<io::MemorySource*>(packet.getSource());
 
 				// Buffer
 				const std::vector<char> packetBuffer(memorySource->getBegin(), memorySource->getEnd());
-				world->sendProxyPacket(m_characterId, game::client_packet::NameQuery, packetBuffer.size(), packetBuffer);
+				m_worldNode->sendProxyPacket(m_characterId, game::client_packet::NameQuery, packetBuffer.size(), packetBuffer);
 			}
 			else
 			{
@@ -932,15 +938,14 @@ namespace wowpp
 			return PacketParseResult::Disconnect;
 		}
 
-		// Find item
-		const auto *item = m_project.items.getById(itemID);
-		if (item)
+		// Find item response
+		const auto *response = m_queryCache.getItemQuery(itemID, m_locale);
+		if (response)
 		{
 			// TODO: Cache multiple query requests and send one, bigger response with multiple items
 
 			// Write answer packet
-			sendPacket(
-				std::bind(game::server_write::itemQuerySingleResponse, std::placeholders::_1, m_locale, std::cref(*item)));
+			sendCachedPacket(*response);
 		}
 
 		return PacketParseResult::Pass;
@@ -960,12 +965,11 @@ namespace wowpp
 		//TODO: Find creature object and check if it exists
 
 		// Find creature info by entry
-		const auto *unit = m_project.units.getById(creatureEntry);
-		if (unit)
+		const auto *response = m_queryCache.getCreatureQuery(creatureEntry, m_locale);
+		if (response)
 		{
 			// Write answer packet
-			sendPacket(
-				std::bind(game::server_write::creatureQueryResponse, std::placeholders::_1, m_locale, std::cref(*unit)));
+			sendCachedPacket(*response);
 		}
 		else
 		{
@@ -1417,6 +1421,7 @@ namespace wowpp
 		// which is hosting a fitting world instance or is able to create
 		// a new one
 
+		std::shared_ptr<World> groupWorld;
 		UInt32 groupInstanceId = std::numeric_limits<UInt32>::max();
 
 		// Determine group instance to join
@@ -1425,12 +1430,17 @@ namespace wowpp
 		{
 			if (auto *group = player->getGroup())
 			{
-				groupInstanceId = group->instanceBindingForMap(m_transferMap);
+				if (const auto *binding = group->instanceBindingForMap(m_transferMap))
+				{
+					groupWorld = binding->world.lock();
+					groupInstanceId = binding->instanceId;
+				}
 			}
 		}
 
 		// Find a new world node
-		auto *world = m_worldManager.getWorldByMapId(m_transferMap);
+		const auto *map = m_project.maps.getById(m_transferMap);
+		auto *world = map ? m_worldManager.selectWorldForMap(*map, groupWorld.get(), groupInstanceId) : nullptr;
 		if (!world)
 		{
 			// World does not exist
@@ -1800,15 +1810,14 @@ namespace wowpp
 			return PacketParseResult::Disconnect;
 		}
 
-		const auto *quest = m_project.quests.getById(questId);
-		if (!quest)
+		const auto *response = m_queryCache.getQuestQuery(questId, m_locale);
+		if (!response)
 		{
 			return PacketParseResult::Disconnect;
 		}
 
 		// Send response
-		sendPacket(
-			std::bind(game::server_write::questQueryResponse, std::placeholders::_1, m_locale, std::cref(*quest)));
+		sendCachedPacket(*response);
 		return PacketParseResult::Pass;
 	}
 
@@ -2016,20 +2025,14 @@ namespace wowpp
 			return PacketParseResult::Disconnect;
 		}
 
-		const auto *entry = m_project.items.getById(itemEntry);
-		if (!entry)
+		const auto *response = m_queryCache.getItemNameQuery(itemEntry, m_locale);
+		if (!response)
 		{
 			return PacketParseResult::Disconnect;
 		}
 
-		String name =
-			entry->name_loc_size() >= static_cast<Int32>(m_locale) ?
-			entry->name_loc(static_cast<Int32>(m_locale) - 1) : entry->name();
-		if (name.empty()) name = entry->name();
-
 		// Match Count is request count right now
-		sendPacket(
-			std::bind(game::server_write::itemNameQueryResponse, std::placeholders::_1, itemEntry, std::cref(name), entry->inventorytype()));
+		sendCachedPacket(*response);
 		return PacketParseResult::Pass;
 	}
 
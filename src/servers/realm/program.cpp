@@ -33,12 +33,15 @@
 #include "world_manager.h"
 #include "world.h"
 #include "login_connector.h"
-#include "common/background_worker.h"
+#include "common/make_unique.h"
+#include "log/async_log_sink.h"
 #include "log/log_std_stream.h"
 #include "log/log_entry.h"
 #include "log/default_log_levels.h"
 #include "mysql_database.h"
 #include "web_service.h"
+#include "query_cache.h"
+#include "realm_packet_statistics.h"
 #include "common/timer_queue.h"
 #include "common/id_generator.h"
 #include "proto_data/project.h"
@@ -75,14 +78,18 @@ namespace wowpp
 			return false;
 		}
 
+		// Skip formatting of log messages which aren't important enough
+		g_DefaultLog.setMinimumImportance(static_cast<LogImportance>(
+			std::min<UInt32>(m_configuration.logMinimumImportance, log_importance::High)));
+
 		// Create a timer queue
 		TimerQueue timer(m_ioService);
 
 		// The log files are written to in a special background thread
 		std::ofstream logFile;
-		BackgroundWorker backgroundLogger;
 		LogStreamOptions logFileOptions = g_DefaultFileLogOptions;
 		logFileOptions.alwaysFlush = !m_configuration.isLogFileBuffering;
+		std::unique_ptr<AsyncLogSink> logSink;
 
 		simple::scoped_connection genericLogConnection;
 		if (m_configuration.isLogActive)
@@ -91,14 +98,16 @@ namespace wowpp
 			logFile.open(fileName.c_str(), std::ios::app);
 			if (logFile)
 			{
+				logSink = make_unique<AsyncLogSink>(std::bind(
+					printLogEntry,
+					std::ref(logFile),
+					std::placeholders::_1,
+					std::cref(logFileOptions)));
+
 				genericLogConnection = g_DefaultLog.signal().connect(
-					[&logFile, &backgroundLogger, &logFileOptions](const LogEntry & entry)
+					[&logSink](const LogEntry & entry)
 				{
-					backgroundLogger.addWork(std::bind(
-						printLogEntry,
-						std::ref(logFile),
-						entry,
-						std::cref(logFileOptions)));
+					logSink->push(entry);
 				});
 			}
 			else
@@ -115,6 +124,9 @@ namespace wowpp
 			return false;
 		}
 
+		// Cache for static data query responses
+		QueryCache queryCache(project);
+
 		// Setup MySQL database
 		std::unique_ptr<MySQLDatabase> db(
 			new MySQLDatabase(
@@ -132,6 +144,7 @@ namespace wowpp
 			// Could not load MySQL database
 			return false;
 		}
+		db->setCharacterStateBlob(m_configuration.useCharacterStateBlob);
 
 		// Set database instance
 		m_database = std::move(db);
@@ -155,6 +168,11 @@ namespace wowpp
 
 		// TODO: Use async database requests so no blocking occurs
 
+		// Per opcode packet counters of all world node and player connections. These have to
+		// outlive every connection.
+		RealmPacketStatistics packetStatistics;
+		packetStatistics.setEnabled(m_configuration.isPacketStatisticsActive);
+
 		// Create the player manager
 		std::unique_ptr<wowpp::PlayerManager> PlayerManager(new wowpp::PlayerManager(timer, m_configuration.realmID, m_configuration.maxPlayers));
 
@@ -178,8 +196,10 @@ namespace wowpp
 		}
 
 		String &realmName = m_configuration.internalName;
-		auto const createWorld = [&WorldManager, &realmName, &PlayerManager, &project, this](std::shared_ptr<wowpp::World::Client> connection)
+		auto const createWorld = [&WorldManager, &realmName, &PlayerManager, &project, &packetStatistics, this](std::shared_ptr<wowpp::World::Client> connection)
 		{
+			connection->setPacketStatistics(&packetStatistics.worldReceived, &packetStatistics.worldSent);
+			connection->setReceiveSize(wowpp::constants::ServerLinkReceiveSize);
 			connection->startReceiving();
 			boost::asio::ip::address address;
 
@@ -224,7 +244,9 @@ namespace wowpp
 			*WorldManager,
 			*m_database,
 			asyncDatabase,
-			project
+			project,
+			queryCache,
+			packetStatistics
 			));
 
 		IdGenerator<UInt64> groupIdGenerator(0x01);
@@ -254,8 +276,9 @@ namespace wowpp
 			ELOG("Could not restore group ids!");
 		}
 
-		auto const createPlayer = [&PlayerManager, &loginConnector, &WorldManager, &database, &asyncDatabase, &project, &config, &groupIdGenerator](std::shared_ptr<wowpp::Player::Client> connection)
+		auto const createPlayer = [&PlayerManager, &loginConnector, &WorldManager, &database, &asyncDatabase, &project, &queryCache, &config, &groupIdGenerator, &packetStatistics](std::shared_ptr<wowpp::Player::Client> connection)
 		{
+			connection->setPacketStatistics(&packetStatistics.clientReceived, &packetStatistics.clientSent);
 			connection->startReceiving();
 			boost::asio::ip::address address;
 
@@ -270,7 +293,7 @@ namespace wowpp
 				return;
 			}
 
-			auto player = std::make_shared<Player>(config, groupIdGenerator, *PlayerManager, *loginConnector, *WorldManager, database, asyncDatabase, project, std::move(connection), address.to_string());
+			auto player = std::make_shared<Player>(config, groupIdGenerator, *PlayerManager, *loginConnector, *WorldManager, database, asyncDatabase, project, queryCache, std::move(connection), address.to_string());
 
 			DLOG("Incoming player connection from " << address);
 			PlayerManager->addPlayer(player);
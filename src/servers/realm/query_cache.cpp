@@ -0,0 +1,157 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "query_cache.h"
+#include "game_protocol/game_protocol.h"
+#include "binary_io/vector_sink.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	QueryCache::QueryCache(proto::Project &project)
+		: m_project(project)
+	{
+	}
+
+	template<class F>
+	const QueryCache::Packet &QueryCache::getOrCreate(Kind kind, const String &hash, UInt32 id, auth::AuthLocale locale, F generator)
+	{
+		auto &bucket = m_buckets[kind];
+
+		// Data has been reloaded since the packets were built
+		if (bucket.hash != hash)
+		{
+			bucket.packets.clear();
+			bucket.bytes = 0;
+			bucket.hash = hash;
+		}
+
+		const UInt64 key = (static_cast<UInt64>(locale) << 32) | id;
+		auto it = bucket.packets.find(key);
+		if (it != bucket.packets.end())
+		{
+			++bucket.hits;
+			return it->second;
+		}
+
+		++bucket.misses;
+
+		Packet &buffer = bucket.packets[key];
+		io::VectorSink sink(buffer);
+		game::Protocol::OutgoingPacket packet(sink);
+		generator(packet);
+
+		bucket.bytes += buffer.size();
+		return buffer;
+	}
+
+	const QueryCache::Packet * QueryCache::getItemQuery(UInt32 itemId, auth::AuthLocale locale)
+	{
+		const auto *item = m_project.items.getById(itemId);
+		if (!item) {
+			return nullptr;
+		}
+
+		return &getOrCreate(ItemQuery, m_project.items.hashString, itemId, locale,
+			std::bind(game::server_write::itemQuerySingleResponse, std::placeholders::_1, locale, std::cref(*item)));
+	}
+
+	const QueryCache::Packet * QueryCache::getCreatureQuery(UInt32 unitId, auth::AuthLocale locale)
+	{
+		const auto *unit = m_project.units.getById(unitId);
+		if (!unit) {
+			return nullptr;
+		}
+
+		return &getOrCreate(CreatureQuery, m_project.units.hashString, unitId, locale,
+			std::bind(game::server_write::creatureQueryResponse, std::placeholders::_1, locale, std::cref(*unit)));
+	}
+
+	const QueryCache::Packet * QueryCache::getQuestQuery(UInt32 questId, auth::AuthLocale locale)
+	{
+		const auto *quest = m_project.quests.getById(questId);
+		if (!quest) {
+			return nullptr;
+		}
+
+		return &getOrCreate(QuestQuery, m_project.quests.hashString, questId, locale,
+			std::bind(game::server_write::questQueryResponse, std::placeholders::_1, locale, std::cref(*quest)));
+	}
+
+	const QueryCache::Packet * QueryCache::getItemNameQuery(UInt32 itemId, auth::AuthLocale locale)
+	{
+		const auto *entry = m_project.items.getById(itemId);
+		if (!entry) {
+			return nullptr;
+		}
+
+		return &getOrCreate(ItemNameQuery, m_project.items.hashString, itemId, locale, [entry, itemId, locale](game::OutgoingPacket &packet)
+		{
+			String name =
+				entry->name_loc_size() >= static_cast<Int32>(locale) ?
+				entry->name_loc(static_cast<Int32>(locale) - 1) : entry->name();
+			if (name.empty()) name = entry->name();
+
+			game::server_write::itemNameQueryResponse(packet, itemId, name, entry->inventorytype());
+		});
+	}
+
+	void QueryCache::clear()
+	{
+		for (auto &bucket : m_buckets)
+		{
+			bucket.packets.clear();
+			bucket.bytes = 0;
+			bucket.hash.clear();
+		}
+	}
+
+	QueryCache::Statistics QueryCache::getStatistics(Kind kind) const
+	{
+		const auto &bucket = m_buckets[kind];
+
+		Statistics stats;
+		stats.hits = bucket.hits;
+		stats.misses = bucket.misses;
+		stats.entries = bucket.packets.size();
+		stats.bytes = bucket.bytes;
+		return stats;
+	}
+
+	const char * QueryCache::getKindName(Kind kind)
+	{
+		switch (kind)
+		{
+			case ItemQuery:
+				return "item";
+			case CreatureQuery:
+				return "creature";
+			case QuestQuery:
+				return "quest";
+			case ItemNameQuery:
+				return "item_name";
+			default:
+				return "unknown";
+		}
+	}
+}
@@ -0,0 +1,117 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "auth_protocol/auth_protocol.h"
+
+namespace wowpp
+{
+	namespace proto
+	{
+		class Project;
+	}
+
+	/// Caches the serialized response packets of static data queries (item, creature, quest and
+	/// item name queries) per locale, so that floods of these requests don't rebuild the same
+	/// packet from the protobuf entries over and over again. Cached packets include the unencrypted
+	/// packet header. Cached packets of a query kind are dropped automatically if the data manager
+	/// they were built from has been reloaded (its hash changed). Not thread-safe, as all players
+	/// are served on the realms io service thread.
+	class QueryCache final
+	{
+	private:
+
+		QueryCache(const QueryCache &Other) = delete;
+		QueryCache &operator=(const QueryCache &Other) = delete;
+
+	public:
+
+		/// Enumerates the cached query kinds.
+		enum Kind
+		{
+			ItemQuery,
+			CreatureQuery,
+			QuestQuery,
+			ItemNameQuery,
+
+			Count_
+		};
+
+		typedef std::vector<char> Packet;
+
+		/// Hit and miss counters of a query kind.
+		struct Statistics
+		{
+			UInt64 hits;
+			UInt64 misses;
+			size_t entries;
+			size_t bytes;
+		};
+
+	public:
+
+		explicit QueryCache(proto::Project &project);
+
+		/// Gets the SMSG_ITEM_QUERY_SINGLE_RESPONSE packet of an item or nullptr if the item doesn't exist.
+		const Packet *getItemQuery(UInt32 itemId, auth::AuthLocale locale);
+		/// Gets the SMSG_CREATURE_QUERY_RESPONSE packet of a unit or nullptr if the unit doesn't exist.
+		const Packet *getCreatureQuery(UInt32 unitId, auth::AuthLocale locale);
+		/// Gets the SMSG_QUEST_QUERY_RESPONSE packet of a quest or nullptr if the quest doesn't exist.
+		const Packet *getQuestQuery(UInt32 questId, auth::AuthLocale locale);
+		/// Gets the SMSG_ITEM_NAME_QUERY_RESPONSE packet of an item or nullptr if the item doesn't exist.
+		const Packet *getItemNameQuery(UInt32 itemId, auth::AuthLocale locale);
+		/// Drops all cached packets. Should be called whenever the project has been reloaded.
+		void clear();
+		/// Gets the statistics of a query kind.
+		Statistics getStatistics(Kind kind) const;
+		/// Gets a readable name of a query kind.
+		static const char *getKindName(Kind kind);
+
+	private:
+
+		struct Bucket
+		{
+			String hash;
+			std::unordered_map<UInt64, Packet> packets;
+			UInt64 hits;
+			UInt64 misses;
+			size_t bytes;
+
+			Bucket()
+				: hits(0)
+				, misses(0)
+				, bytes(0)
+			{
+			}
+		};
+
+		template<class F>
+		const Packet &getOrCreate(Kind kind, const String &hash, UInt32 id, auth::AuthLocale locale, F generator);
+
+	private:
+
+		proto::Project &m_project;
+		std::array<Bucket, Count_> m_buckets;
+	};
+}
@@ -0,0 +1,91 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "network/packet_statistics.h"
+
+namespace wowpp
+{
+	/// Packet statistics of all connections of the realm server.
+	struct RealmPacketStatistics final
+	{
+	private:
+
+		RealmPacketStatistics(const RealmPacketStatistics &Other) = delete;
+		RealmPacketStatistics &operator=(const RealmPacketStatistics &Other) = delete;
+
+	public:
+
+		/// Upper bound of game client opcodes (game::client_packet and game::server_packet).
+		static const size_t GameOpCodeCount = 0x500;
+		/// Upper bound of world node opcodes (pp::world_realm).
+		static const size_t WorldOpCodeCount = 0x100;
+
+		/// Packets received from game clients.
+		PacketStatistics clientReceived;
+		/// Packets sent to game clients, including packets proxied from world nodes.
+		PacketStatistics clientSent;
+		/// Packets received from world nodes.
+		PacketStatistics worldReceived;
+		/// Packets sent to world nodes.
+		PacketStatistics worldSent;
+
+		RealmPacketStatistics()
+			: clientReceived(GameOpCodeCount)
+			, clientSent(GameOpCodeCount)
+			, worldReceived(WorldOpCodeCount)
+			, worldSent(WorldOpCodeCount)
+		{
+		}
+
+		/// Enables or disables counting on all connections.
+		void setEnabled(bool enabled)
+		{
+			clientReceived.setEnabled(enabled);
+			clientSent.setEnabled(enabled);
+			worldReceived.setEnabled(enabled);
+			worldSent.setEnabled(enabled);
+		}
+		/// Resets all counters.
+		void reset()
+		{
+			clientReceived.reset();
+			clientSent.reset();
+			worldReceived.reset();
+			worldSent.reset();
+		}
+		/// Writes all statistics as a json object.
+		void writeJson(std::ostream &out) const
+		{
+			out << "{\"client\":{\"received\":";
+			clientReceived.writeJson(out);
+			out << ",\"sent\":";
+			clientSent.writeJson(out);
+			out << "},\"world\":{\"received\":";
+			worldReceived.writeJson(out);
+			out << ",\"sent\":";
+			worldSent.writeJson(out);
+			out << "}}";
+		}
+	};
+}
@@ -32,6 +32,8 @@
 #include "log/default_log_levels.h"
 #include "proto_data/project.h"
 #include "common/weak_ptr_function.h"
+#include "query_cache.h"
+#include "realm_packet_statistics.h"
 
 namespace wowpp
 {
@@ -84,6 +86,18 @@ namespace wowpp
 				{
 					handleListDeletedChars(request, response);
 				}
+				else if (url == "/query-cache")
+				{
+					handleGetQueryCache(request, response);
+				}
+				else if (url == "/packet-stats")
+				{
+					handleGetPacketStats(request, response);
+				}
+				else if (url == "/tick-profile")
+				{
+					handleGetTickProfile(request, response);
+				}
 				else
 				{
 					response.setStatus(net::http::OutgoingAnswer::NotFound);
@@ -111,6 +125,10 @@ namespace wowpp
 				{
 					handlePostRestoreChar(response, arguments);
 				}
+				else if (url == "/packet-stats")
+				{
+					handlePostPacketStats(response, arguments);
+				}
 #ifdef WOWPP_WITH_DEV_COMMANDS
 				else if (url == "/additem")
 				{
@@ -266,6 +284,80 @@ namespace wowpp
 		asyncDb.asyncRequest(std::move(handler), &IDatabase::getDeletedCharacters, accountId);
 	}
 
+	void WebClient::handleGetQueryCache(const net::http::IncomingRequest &request, web::WebResponse &response)
+	{
+		std::ostringstream message;
+		message << "<queries>";
+
+		const auto &cache = static_cast<WebService &>(this->getService()).getQueryCache();
+		for (UInt32 i = 0; i < QueryCache::Count_; ++i)
+		{
+			const auto kind = static_cast<QueryCache::Kind>(i);
+			const auto stats = cache.getStatistics(kind);
+			message << "<query kind=\"" << QueryCache::getKindName(kind) << "\" hits=\"" << stats.hits << "\" misses=\"" << stats.misses <<
+				"\" entries=\"" << stats.entries << "\" bytes=\"" << stats.bytes << "\" />";
+		}
+
+		message << "</queries>";
+		sendXmlAnswer(response, message.str());
+	}
+
+	void WebClient::handleGetPacketStats(const net::http::IncomingRequest &request, web::WebResponse &response)
+	{
+		std::ostringstream message;
+		static_cast<WebService &>(this->getService()).getPacketStatistics().writeJson(message);
+
+		const String json = message.str();
+		response.finishWithContent("application/json", json.data(), json.size());
+	}
+
+	void WebClient::handleGetTickProfile(const net::http::IncomingRequest &request, web::WebResponse &response)
+	{
+		std::ostringstream message;
+		message << "{\"nodes\":[";
+
+		bool first = true;
+		auto &worldMgr = static_cast<WebService &>(this->getService()).getWorldManager();
+		for (const auto &world : worldMgr.getWorlds())
+		{
+			if (!first) message << ",";
+			first = false;
+
+			// Nodes without an enabled tick profiler don't report anything
+			const auto &profile = world->getTickProfile();
+			message << "{\"address\":\"" << world->getAddress() << "\",\"profile\":"
+				<< (profile.empty() ? "null" : profile) << "}";
+		}
+
+		message << "]}";
+
+		const String json = message.str();
+		response.finishWithContent("application/json", json.data(), json.size());
+	}
+
+	void WebClient::handlePostPacketStats(web::WebResponse &response, const std::vector<std::string> &arguments)
+	{
+		auto &statistics = static_cast<WebService &>(this->getService()).getPacketStatistics();
+
+		for (auto &arg : arguments)
+		{
+			auto delimiterPos = arg.find('=');
+			String argName = arg.substr(0, delimiterPos);
+			String argValue = arg.substr(delimiterPos + 1);
+
+			if (argName == "enabled")
+			{
+				statistics.setEnabled(atoi(argValue.c_str()) != 0);
+			}
+			else if (argName == "reset" && atoi(argValue.c_str()) != 0)
+			{
+				statistics.reset();
+			}
+		}
+
+		sendXmlAnswer(response, "<status>SUCCESS</status>");
+	}
+
 	void WebClient::handlePostShutdown(web::WebResponse & response, const std::vector<std::string> &arguments)
 	{
 		ILOG("Shutting down..");
@@ -78,6 +78,18 @@ namespace wowpp
 		/// 
 		/// @param response Can be used to receive a list of deleted characters.
 		void handleListDeletedChars(const net::http::IncomingRequest &request, web::WebResponse &response);
+		/// Handles the /query-cache GET request.
+		/// 
+		/// @param response Can be used to receive hit and miss counters of the query response cache.
+		void handleGetQueryCache(const net::http::IncomingRequest &request, web::WebResponse &response);
+		/// Handles the /packet-stats GET request.
+		/// 
+		/// @param response Can be used to receive per opcode packet counters of all client and world node connections as json.
+		void handleGetPacketStats(const net::http::IncomingRequest &request, web::WebResponse &response);
+		/// Handles the /tick-profile GET request.
+		/// 
+		/// @param response Can be used to receive the tick and subsystem histograms reported by the world nodes as json.
+		void handleGetTickProfile(const net::http::IncomingRequest &request, web::WebResponse &response);
 
 	private:
 		// POST handlers
@@ -100,6 +112,12 @@ namespace wowpp
 		/// @param response Can be used to send a response to the web client.
 		/// @param arguments List of arguments which have been parsed from the POST data.
 		void handlePostRestoreChar(web::WebResponse &response, const std::vector<std::string> &arguments);
+		/// Handles the /packet-stats POST request.
+		/// Optional arguments: enabled (0/1), reset (1)
+		/// 
+		/// @param response Can be used to send a response to the web client.
+		/// @param arguments List of arguments which have been parsed from the POST data.
+		void handlePostPacketStats(web::WebResponse &response, const std::vector<std::string> &arguments);
 #ifdef WOWPP_WITH_DEV_COMMANDS
 		/// Handles the /additem POST request.
 		/// Required arguments: character, item
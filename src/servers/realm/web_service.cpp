@@ -36,7 +36,9 @@ namespace wowpp
 		WorldManager &worldManager,
 		IDatabase &database,
 		AsyncDatabase &asyncDatabase,
-		proto::Project &project
+		proto::Project &project,
+		QueryCache &queryCache,
+		RealmPacketStatistics &packetStatistics
 	)
 		: web::WebService(service, port)
 		, m_playerManager(playerManager)
@@ -44,6 +46,8 @@ namespace wowpp
 		, m_database(database)
 		, m_asyncDatabase(asyncDatabase)
 		, m_project(project)
+		, m_queryCache(queryCache)
+		, m_packetStatistics(packetStatistics)
 		, m_startTime(getCurrentTime())
 		, m_password(std::move(password))
 	{
@@ -29,6 +29,8 @@ namespace wowpp
 	class WorldManager;
 	struct IDatabase;
 	class AsyncDatabase;
+	class QueryCache;
+	struct RealmPacketStatistics;
 	namespace proto
 	{
 		class Project;
@@ -47,7 +49,9 @@ namespace wowpp
 			WorldManager &worldManager,
 			IDatabase &database,
 			AsyncDatabase &asyncDatabase,
-			proto::Project &project
+			proto::Project &project,
+			QueryCache &queryCache,
+			RealmPacketStatistics &packetStatistics
 		);
 
 		PlayerManager &getPlayerManager() const { return m_playerManager; }
@@ -55,6 +59,8 @@ namespace wowpp
 		IDatabase &getDatabase() const { return m_database; }
 		AsyncDatabase &getAsyncDatabase() const { return m_asyncDatabase; }
 		proto::Project &getProject() const { return m_project; }
+		QueryCache &getQueryCache() const { return m_queryCache; }
+		RealmPacketStatistics &getPacketStatistics() const { return m_packetStatistics; }
 		GameTime getStartTime() const { return m_startTime; }
 		const String &getPassword() const { return m_password; }
 
@@ -67,6 +73,8 @@ namespace wowpp
 		IDatabase &m_database;
 		AsyncDatabase &m_asyncDatabase;
 		proto::Project &m_project;
+		QueryCache &m_queryCache;
+		RealmPacketStatistics &m_packetStatistics;
 		const GameTime m_startTime;
 		const String m_password;
 	};
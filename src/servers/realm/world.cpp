@@ -123,6 +123,15 @@ namespace wowpp
 			case world_packet::MailMarkAsRead:
 				handleMailMarkAsRead(packet);
 				break;
+			case world_packet::WorldLoad:
+				handleWorldLoad(packet);
+				break;
+			case world_packet::WorldInstanceUnloaded:
+				handleWorldInstanceUnloaded(packet);
+				break;
+			case world_packet::WorldTickProfile:
+				handleWorldTickProfile(packet);
+				break;
 			default:
 			{
 				WLOG("Unknown packet received from world " << m_address
@@ -164,16 +173,13 @@ namespace wowpp
 				continue;
 			}
 
-			// Is the map id already handled?
+			// Maps may be supported by multiple world nodes, new instances are placed depending on load
 			if (m_manager.getWorldByMapId(mapId))
 			{
-				WLOG("Map id " << mapId << " is already handled by another world server");
-				continue;;
-			}
-			else
-			{
-				m_mapIds.push_back(mapId);
+				DLOG("Map id " << mapId << " is also supported by another world server");
 			}
+
+			m_mapIds.push_back(mapId);
 		}
 
 		// Empty vector?
@@ -188,12 +194,21 @@ namespace wowpp
 		// Successfully logged in
 		ILOG("World node registered successfully");
 		m_authed = true;
+
+		for (auto &mapId : m_mapIds)
+		{
+			m_manager.addWorldMap(*this, mapId);
+		}
 		m_connection->sendSinglePacket(
 			std::bind(realm_write::loginAnswer, std::placeholders::_1, login_result::Success, std::cref(m_realmName)));
 	}
 
 	void World::enterWorldInstance(UInt64 characterGuid, UInt32 instanceId, const GameCharacter &character, auth::AuthLocale locale)
 	{
+		// Count the player until the world node reports its load again, so that players who log in
+		// at the same time are spread across world nodes
+		m_load.playerCount++;
+
 		m_connection->sendSinglePacket(
 			std::bind(pp::world_realm::realm_write::characterLogIn, std::placeholders::_1, characterGuid, instanceId, std::cref(character), locale));
 	}
@@ -232,6 +247,13 @@ namespace wowpp
 			m_instances.add(instanceId);
 		}
 
+		// Global maps only have one instance which all players of that map should enter
+		const auto *map = m_project.maps.getById(mapId);
+		if (map && map->instancetype() == proto::MapEntry_MapInstanceType_GLOBAL)
+		{
+			m_manager.addWorldGlobalMap(*this, mapId);
+		}
+
 		// Notify player about this
 		auto player = m_playerManager.getPlayerByCharacterId(characterDbId);
 		if (!player)
@@ -692,4 +714,54 @@ namespace wowpp
 			std::bind(pp::world_realm::realm_write::moneyChange, std::placeholders::_1, characterDbId, money, remove));
 	}
 
+	void World::handleWorldLoad(pp::IncomingPacket &packet)
+	{
+		Load load;
+		if (!(pp::world_realm::world_read::worldLoad(packet, load.playerCount, load.instanceCount, load.tickDuration)))
+		{
+			return;
+		}
+
+		// Not authorised
+		if (!m_authed)
+		{
+			return;
+		}
+
+		m_load = load;
+	}
+
+	void World::handleWorldInstanceUnloaded(pp::IncomingPacket &packet)
+	{
+		UInt32 instanceId;
+		if (!(pp::world_realm::world_read::worldInstanceUnloaded(packet, instanceId)))
+		{
+			return;
+		}
+
+		// Not authorised
+		if (!m_authed)
+		{
+			return;
+		}
+
+		m_instances.optionalRemove(instanceId);
+	}
+
+	void World::handleWorldTickProfile(pp::IncomingPacket &packet)
+	{
+		String profile;
+		if (!(pp::world_realm::world_read::worldTickProfile(packet, profile)))
+		{
+			return;
+		}
+
+		// Not authorised
+		if (!m_authed)
+		{
+			return;
+		}
+
+		m_tickProfile = std::move(profile);
+	}
 }
@@ -57,6 +57,24 @@ namespace wowpp
 		typedef std::vector<UInt32> MapList;
 		typedef LinearSet<UInt32> InstanceList;
 
+		/// Load of a world node as reported by the node.
+		struct Load
+		{
+			/// Number of players on the world node.
+			UInt32 playerCount;
+			/// Number of running world instances.
+			UInt32 instanceCount;
+			/// Average duration of a world update in microseconds.
+			UInt32 tickDuration;
+
+			Load()
+				: playerCount(0)
+				, instanceCount(0)
+				, tickDuration(0)
+			{
+			}
+		};
+
 	public:
 
 		/// Triggered if the connection was lost or closed somehow.
@@ -92,6 +110,13 @@ namespace wowpp
 		const MapList &getMapList() const { return m_mapIds; }
 		/// Returns an array of opened instance id's of this world node.
 		const InstanceList &getInstanceList() const { return m_instances; }
+		/// Returns the last reported load of this world node.
+		const Load &getLoad() const { return m_load; }
+		/// Returns the last reported tick profile of this world node as json object, or an empty
+		/// string if the node doesn't profile its ticks.
+		const String &getTickProfile() const { return m_tickProfile; }
+		/// Returns the address of this world node.
+		const String &getAddress() const { return m_address; }
 		
 		// Called by player
 		void enterWorldInstance(UInt64 characterDbId, UInt32 instanceId, const GameCharacter &character, auth::AuthLocale locale);
@@ -119,6 +144,8 @@ namespace wowpp
 		MapList m_mapIds;			// A vector of map id's which this node does support
 		InstanceList m_instances;		// A vector of running instances on this server
 		String m_realmName;
+		Load m_load;
+		String m_tickProfile;
 
 	private:
 
@@ -146,5 +173,8 @@ namespace wowpp
 		void handleMailDraft(pp::IncomingPacket &packet);
 		void handleMailGetList(pp::IncomingPacket &packet);
 		void handleMailMarkAsRead(pp::IncomingPacket &packet);
+		void handleWorldLoad(pp::IncomingPacket &packet);
+		void handleWorldInstanceUnloaded(pp::IncomingPacket &packet);
+		void handleWorldTickProfile(pp::IncomingPacket &packet);
 	};
 }
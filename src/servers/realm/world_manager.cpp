@@ -23,9 +23,54 @@
 #include "world_manager.h"
 #include "world.h"
 #include "binary_io/string_sink.h"
+#include "shared/proto_data/maps.pb.h"
 
 namespace wowpp
 {
+	namespace
+	{
+		/// World nodes which need longer than this for an update (in microseconds) can't keep up
+		/// with their update rate and only receive new players if there is no other choice.
+		const UInt32 BusyTickDuration = 25000;
+
+		/// Determines whether world a should be preferred over world b when placing players.
+		bool isLessLoaded(const World &a, const World &b)
+		{
+			const auto &loadA = a.getLoad();
+			const auto &loadB = b.getLoad();
+
+			const bool isBusyA = (loadA.tickDuration > BusyTickDuration);
+			const bool isBusyB = (loadB.tickDuration > BusyTickDuration);
+			if (isBusyA != isBusyB)
+			{
+				return !isBusyA;
+			}
+
+			if (loadA.playerCount != loadB.playerCount)
+			{
+				return loadA.playerCount < loadB.playerCount;
+			}
+
+			return loadA.instanceCount < loadB.instanceCount;
+		}
+
+		/// Removes all entries of a world from an id index.
+		void eraseWorld(std::unordered_map<UInt32, World *> &index, const World &world)
+		{
+			for (auto it = index.begin(); it != index.end();)
+			{
+				if (it->second == &world)
+				{
+					it = index.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+	}
+
 	WorldManager::WorldManager(
 	    size_t worldCapacity)
 		: m_worldCapacity(worldCapacity)
@@ -46,6 +91,23 @@ namespace wowpp
 			return (&world == w.get());
 		});
 		ASSERT(w != m_worlds.end());
+
+		// Remove the world from all indices
+		for (auto it = m_worldsByMap.begin(); it != m_worldsByMap.end();)
+		{
+			auto &worlds = it->second;
+			worlds.erase(std::remove(worlds.begin(), worlds.end(), &world), worlds.end());
+			if (worlds.empty())
+			{
+				it = m_worldsByMap.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		eraseWorld(m_worldsByGlobalMap, world);
+
 		m_worlds.erase(w);
 	}
 
@@ -67,38 +129,85 @@ namespace wowpp
 
 	World * WorldManager::getWorldByMapId(UInt32 mapId)
 	{
-		const auto w = std::find_if(
-			m_worlds.begin(),
-			m_worlds.end(),
-			[mapId](const WorldPtr &w)
-		{
-			return w->isMapSupported(mapId);
-		});
-
-		if (w != m_worlds.end())
+		const auto it = m_worldsByMap.find(mapId);
+		if (it != m_worldsByMap.end())
 		{
-			return w->get();
+			ASSERT(!it->second.empty());
+			return it->second.front();
 		}
 
 		return nullptr;
 	}
 
-	World * WorldManager::getWorldByInstanceId(UInt32 instanceId)
+	World * WorldManager::selectWorldForMap(const proto::MapEntry &map, World *instanceWorld, UInt32 &instanceId)
 	{
-		const auto w = std::find_if(
-			m_worlds.begin(),
-			m_worlds.end(),
-			[instanceId](const WorldPtr &w)
+		// Is the requested instance still running on its node? Every world node numbers its
+		// instances on its own, so the id is meaningless on any other node
+		if (instanceId != std::numeric_limits<UInt32>::max())
+		{
+			const bool isConnected = std::any_of(m_worlds.begin(), m_worlds.end(), [instanceWorld](const WorldPtr &w)
+			{
+				return (w.get() == instanceWorld);
+			});
+			if (instanceWorld &&
+				isConnected &&
+				instanceWorld->hasInstance(instanceId) &&
+				instanceWorld->isMapSupported(map.id()))
+			{
+				return instanceWorld;
+			}
+
+			instanceId = std::numeric_limits<UInt32>::max();
+		}
+
+		// There is only one instance of a global map, so stay on the node which runs it
+		if (map.instancetype() == proto::MapEntry_MapInstanceType_GLOBAL)
+		{
+			const auto it = m_worldsByGlobalMap.find(map.id());
+			if (it != m_worldsByGlobalMap.end())
+			{
+				return it->second;
+			}
+		}
+
+		// Place new instances on the least loaded node
+		const auto it = m_worldsByMap.find(map.id());
+		if (it == m_worldsByMap.end())
+		{
+			return nullptr;
+		}
+
+		const auto &worlds = it->second;
+		ASSERT(!worlds.empty());
+
+		const auto best = std::min_element(worlds.begin(), worlds.end(), [](const World *a, const World *b)
 		{
-			return w->hasInstance(instanceId);
+			return isLessLoaded(*a, *b);
 		});
 
-		if (w != m_worlds.end())
+		// Pin a global map to the chosen node right away: the node only reports the instance
+		// once the first player entered it, and players logging in until then must not be
+		// spread across nodes
+		if (map.instancetype() == proto::MapEntry_MapInstanceType_GLOBAL)
 		{
-			return w->get();
+			addWorldGlobalMap(**best, map.id());
 		}
 
-		return nullptr;
+		return *best;
+	}
+
+	void WorldManager::addWorldMap(World &world, UInt32 mapId)
+	{
+		auto &worlds = m_worldsByMap[mapId];
+		if (std::find(worlds.begin(), worlds.end(), &world) == worlds.end())
+		{
+			worlds.push_back(&world);
+		}
 	}
 
+	void WorldManager::addWorldGlobalMap(World &world, UInt32 mapId)
+	{
+		// Keep the first node, players should not be split between multiple instances of a global map
+		m_worldsByGlobalMap.insert(std::make_pair(mapId, &world));
+	}
 }
@@ -26,6 +26,10 @@
 namespace wowpp
 {
 	class World;
+	namespace proto
+	{
+		class MapEntry;
+	}
 
 	/// Manages all connected worlds.
 	class WorldManager final
@@ -60,12 +64,31 @@ namespace wowpp
 		void addWorld(WorldPtr added);
 		/// Gets a world which supports a specific map id if available.
 		World *getWorldByMapId(UInt32 mapId);
-		/// Gets a world which supports a specific instance id if available.
-		World *getWorldByInstanceId(UInt32 instanceId);
+		/// Selects the world node on which a character should enter a map. Existing instances are
+		/// preferred (the requested instance or the running instance of a global map), otherwise the
+		/// least loaded world node which supports the map is chosen. Global maps are pinned to
+		/// the chosen node immediately.
+		/// @param map The map which should be entered.
+		/// @param instanceWorld The world node which runs the preferred instance or nullptr.
+		/// @param instanceId The preferred instance id (for example a group binding) or max UInt32.
+		///        Instance ids are only unique per world node, so this is reset to max UInt32 if
+		///        the instance isn't running on instanceWorld anymore.
+		World *selectWorldForMap(const proto::MapEntry &map, World *instanceWorld, UInt32 &instanceId);
+		/// Registers a supported map of a logged in world node.
+		void addWorldMap(World &world, UInt32 mapId);
+		/// Registers the world node which runs the instance of a global (non-instanced) map.
+		void addWorldGlobalMap(World &world, UInt32 mapId);
 
 	private:
 
+		typedef std::unordered_map<UInt32, std::vector<World *>> WorldsByMap;
+		typedef std::unordered_map<UInt32, World *> WorldsById;
+
 		Worlds m_worlds;
 		size_t m_worldCapacity;
+		/// World nodes by supported map id in the order they logged in.
+		WorldsByMap m_worldsByMap;
+		/// World nodes by map id of the global map instance they run.
+		WorldsById m_worldsByGlobalMap;
 	};
 }
@@ -37,6 +37,12 @@ namespace wowpp
 #else
 		: dataPath("/etc/wow-pp/data")
 #endif
+		, updateCompressionLevel(1)
+		, spawnCompressionLevel(9)
+		, dataReloadInterval(0)
+		, instanceIdleTimeout(15 * 60)
+		, memoryReportInterval(0)
+		, tickBudget(0)
 		, mysqlPort(wowpp::constants::DefaultMySQLPort)
 		, mysqlHost("127.0.0.1")
 		, mysqlUser("wow-pp")
@@ -46,6 +52,7 @@ namespace wowpp
 		, logFileName("wowpp_world.log")
 		, cheatLogFileName("wowpp_anti_cheat.log")
 		, isLogFileBuffering(false)
+		, logMinimumImportance(0)
 	{
 	}
 
@@ -144,11 +151,18 @@ namespace wowpp
 				logFileName = log->getString("fileName", logFileName);
 				cheatLogFileName = log->getString("cheatFileName", cheatLogFileName);
 				isLogFileBuffering = log->getInteger("buffering", static_cast<unsigned>(isLogFileBuffering)) != 0;
+				logMinimumImportance = log->getInteger("minimumImportance", logMinimumImportance);
 			}
 
 			if (const Table *const game = global.getTable("game"))
 			{
 				dataPath = game->getString("dataPath", dataPath);
+				updateCompressionLevel = game->getInteger("updateCompressionLevel", updateCompressionLevel);
+				spawnCompressionLevel = game->getInteger("spawnCompressionLevel", spawnCompressionLevel);
+				dataReloadInterval = game->getInteger("dataReloadInterval", dataReloadInterval);
+				instanceIdleTimeout = game->getInteger("instanceIdleTimeout", instanceIdleTimeout);
+				memoryReportInterval = game->getInteger("memoryReportInterval", memoryReportInterval);
+				tickBudget = game->getInteger("tickBudget", tickBudget);
 			}
 		}
 		catch (const sff::read::ParseException<Iterator> &e)
@@ -222,6 +236,7 @@ namespace wowpp
 			log.addKey("fileName", logFileName);
 			log.addKey("cheatFileName", cheatLogFileName);
 			log.addKey("buffering", isLogFileBuffering);
+			log.addKey("minimumImportance", logMinimumImportance);
 			log.finish();
 		}
 
@@ -230,6 +245,12 @@ namespace wowpp
 		{
 			sff::write::Table<Char> game(global, "game", sff::write::MultiLine);
 			game.addKey("dataPath", dataPath);
+			game.addKey("updateCompressionLevel", updateCompressionLevel);
+			game.addKey("spawnCompressionLevel", spawnCompressionLevel);
+			game.addKey("dataReloadInterval", dataReloadInterval);
+			game.addKey("instanceIdleTimeout", instanceIdleTimeout);
+			game.addKey("memoryReportInterval", memoryReportInterval);
+			game.addKey("tickBudget", tickBudget);
 			game.finish();
 		}
 
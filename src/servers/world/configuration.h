@@ -48,6 +48,20 @@ namespace wowpp
 
 		/// Path to the client data
 		String dataPath;
+		/// zlib compression level (0-9) of object updates sent while playing.
+		Int32 updateCompressionLevel;
+		/// zlib compression level (0-9) of the spawn burst sent when entering a world.
+		Int32 spawnCompressionLevel;
+		/// Interval in seconds in which the data project is checked for changes and reloaded
+		/// while the server is running (0 = disabled).
+		UInt32 dataReloadInterval;
+		/// Time in seconds after which a dungeon instance without players is unloaded (0 = never).
+		UInt32 instanceIdleTimeout;
+		/// Interval in seconds in which the memory usage of pooled objects is logged (0 = disabled).
+		UInt32 memoryReportInterval;
+		/// Tick duration in milliseconds above which world ticks are logged as slow. Enables the tick
+		/// profiler, whose histograms are reported to the realm (0 = disabled).
+		UInt32 tickBudget;
 
 		/// Contains all realms this world node should connect to.
 		std::vector<RealmConfiguration> realms;
@@ -72,6 +86,8 @@ namespace wowpp
 		/// If enabled, the log contents will be buffered before they are written to
 		/// the file, which could be more efficient..
 		bool isLogFileBuffering;
+		/// Minimum importance of log messages which are emitted at all (0 = debug, 1 = info/warning, 2 = error).
+		UInt32 logMinimumImportance;
 
 		explicit Configuration();
 		bool load(const String &fileName);
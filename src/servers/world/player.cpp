@@ -60,6 +60,7 @@ namespace wowpp
 		, m_timeSyncCounter(0)
 		, m_movementInitialized(false)
 		, m_locale(locale)
+		, m_spawnStream(instance, *this)
 	{
 		// Connect character signals
 		m_characterSignals.append({
@@ -211,6 +212,14 @@ namespace wowpp
 
 		// Register as network unit watcher
 		m_character->setNetUnitWatcher(this);
+
+		// Keep the instance loaded as long as we are using it
+		m_instance.bindPlayer();
+	}
+
+	Player::~Player()
+	{
+		m_instance.unbindPlayer();
 	}
 
 	void Player::logoutRequest()
@@ -559,7 +568,7 @@ namespace wowpp
 
 		// Send the actual spawn packet packet
 		sendProxyPacket(
-			std::bind(game::server_write::compressedUpdateObject, std::placeholders::_1, std::cref(blocks)));
+			std::bind(game::server_write::compressedUpdateObject, std::placeholders::_1, std::cref(blocks), game::update_compression::Spawn));
 
 		// Send time sync request packet (this will also enable character movement at the client)
 		onClientSync();
@@ -568,6 +577,15 @@ namespace wowpp
 		VisibilityTile &tile = m_instance.getGrid().requireTile(getTileIndex());
 		tile.getWatchers().add(this);
 
+		// Stream all visible objects to the client, nearest first
+		forEachTileInSight(
+			m_instance.getGrid(),
+			tile.getPosition(),
+			[this](VisibilityTile &sightTile)
+		{
+			m_spawnStream.queueTile(sightTile);
+		});
+
 		// Cast passive spells after spawn, so that SpellMods are sent AFTER the spawn packet
 		SpellTargetMap target;
 		target.m_targetMap = game::spell_cast_target_flags::Self;
@@ -627,6 +645,9 @@ namespace wowpp
 		// No longer watch for network events
 		m_character->setNetUnitWatcher(nullptr);
 
+		// Stop streaming object spawns
+		m_spawnStream.clear();
+
 		// Cancel trade (if any)
 		cancelTrade();
 
@@ -728,78 +749,8 @@ namespace wowpp
 			}
 		}
 
-		auto &grid = m_instance.getGrid();
-
-		// Despawn old objects
-		auto guid = m_character->getGuid();
-		forEachTileInSightWithout(
-			grid,
-			oldTile.getPosition(),
-			newTile.getPosition(),
-			[this](VisibilityTile &tile)
-		{
-			for (auto *object : tile.getGameObjects().getElements())
-			{
-				ASSERT(object);
-				if (!object->canSpawnForCharacter(*m_character))
-				{
-					continue;
-				}
-
-				// Dont spawn stealthed targets that we can't see yet
-				if (object->isCreature() || object->isGameCharacter())
-				{
-					GameUnit &unit = reinterpret_cast<GameUnit&>(*object);
-					if (unit.isStealthed() && !m_character->canDetectStealth(unit))
-					{
-						continue;
-					}
-				}
-
-				this->sendProxyPacket(
-					std::bind(game::server_write::destroyObject, std::placeholders::_1, object->getGuid(), false));
-			}
-		});
-
-		// Spawn new objects
-		forEachTileInSightWithout(
-			grid,
-			newTile.getPosition(),
-			oldTile.getPosition(),
-			[this](VisibilityTile &tile)
-		{
-			for (auto *obj : tile.getGameObjects().getElements())
-			{
-				ASSERT(obj);
-
-				if (!obj->canSpawnForCharacter(*m_character))
-				{
-					continue;
-				}
-
-				// Dont spawn stealthed targets that we can't see yet
-				if (obj->isCreature() || obj->isGameCharacter())
-				{
-					GameUnit &unit = reinterpret_cast<GameUnit&>(*obj);
-					if (unit.isStealthed() && !m_character->canDetectStealth(unit))
-					{
-						continue;
-					}
-				}
-
-				std::vector<std::vector<char>> createBlock;
-				createUpdateBlocks(*obj, *m_character, createBlock);
-
-				this->sendProxyPacket(
-					std::bind(game::server_write::compressedUpdateObject, std::placeholders::_1, std::cref(createBlock)));
-
-				// Send movement packets
-				if (obj->isCreature() || obj->isGameCharacter())
-				{
-					reinterpret_cast<GameUnit*>(obj)->getMover().sendMovementPackets(*this);
-				}
-			}
-		});
+		// Despawn objects which are no longer in sight and stream the new ones
+		m_spawnStream.changeTile(oldTile, newTile);
 
 		// Make us a watcher of the new tile
 		newTile.getWatchers().add(this);
@@ -33,6 +33,7 @@
 #include "game/each_tile_in_region.h"
 #include "game/world_instance.h"
 #include "game/tile_subscriber.h"
+#include "game/spawn_stream.h"
 #include "game/loot_instance.h"
 #include "common/macros.h"
 #include "trade_data.h"
@@ -78,6 +79,7 @@ namespace wowpp
 						WorldInstance &instance,
 						proto::Project &project,
 						auth::AuthLocale locale);
+		~Player();
 
 		/// Gets the player manager which manages all connected players.
 		PlayerManager &getManager() const { return m_manager; }
@@ -157,21 +159,19 @@ namespace wowpp
 			TileIndex2D tile = getTileIndex();
 
 			// Get all subscribers
-			forEachTileInSight(
+			forEachSubscriberInSightOf(
 				m_instance.getGrid(),
 				tile,
-				[&generator](VisibilityTile &tile)
+				getCharacterGuid(),
+				[&generator](ITileSubscriber &subscriber)
 			{
-				for (auto * const subscriber : tile.getWatchers().getElements())
-				{
-					std::vector<char> buffer;
-					io::VectorSink sink(buffer);
+				std::vector<char> buffer;
+				io::VectorSink sink(buffer);
 
-					typename game::Protocol::OutgoingPacket packet(sink);
-					generator(packet);
+				typename game::Protocol::OutgoingPacket packet(sink);
+				generator(packet);
 
-					subscriber->sendPacket(packet, buffer);
-				}
+				subscriber.sendPacket(packet, buffer);
 			});
 		}
 		/// Saves the characters data.
@@ -199,6 +199,8 @@ namespace wowpp
 		GameCharacter *getControlledObject() override { return m_character.get(); }
 		/// @copydoc ITileSubscriber::sendPacket()
 		void sendPacket(game::Protocol::OutgoingPacket &packet, const std::vector<char> &buffer) override;
+		/// @copydoc ITileSubscriber::isSpawnPending()
+		bool isSpawnPending(UInt64 guid) const override { return m_spawnStream.isPending(guid); }
 
 		// Network packet handlers (implemented in separate cpp files like player_XXX_handler.cpp)
 
@@ -349,6 +351,7 @@ namespace wowpp
 		GameTime m_lastTimeSync;
 		bool m_movementInitialized;
 		auth::AuthLocale m_locale;
+		SpawnStream m_spawnStream;
 
 		/*struct ClientAck
 		{
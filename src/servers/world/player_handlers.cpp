@@ -114,9 +114,10 @@ namespace wowpp
 						io::VectorSink sink(buffer);
 						game::Protocol::OutgoingPacket itemPacket(sink);
 						game::server_write::itemPushResult(itemPacket, m_character->getGuid(), std::cref(*inst), true, false, bag, subslot, slot.second, totalCount);
-						forEachSubscriberInSight(
+						forEachSubscriberInSightOf(
 							m_character->getWorldInstance()->getGrid(),
 							tile,
+							m_character->getGuid(),
 							[&](ITileSubscriber &subscriber)
 						{
 							if (subscriber.getControlledObject()->getGuid() != m_character->getGuid())
@@ -675,7 +676,8 @@ namespace wowpp
 		{
 			for (auto &watcher : tile.getWatchers())
 			{
-				if (watcher != this)
+				if (watcher != this &&
+					!watcher->isSpawnPending(guid))
 				{
 					// Create the chat packet
 					std::vector<char> buffer;
@@ -718,15 +720,13 @@ namespace wowpp
 							game::server_write::environmentalDamageLog(dmgPacket, getCharacterGuid(), 2, damage, 0, 0);
 
 							// Deal damage
-							forEachTileInSight(
+							forEachSubscriberInSightOf(
 								getWorldInstance().getGrid(),
 								gridIndex,
-								[&dmgPacket, &dmgBuffer](VisibilityTile &tile)
+								getCharacterGuid(),
+								[&dmgPacket, &dmgBuffer](ITileSubscriber &subscriber)
 							{
-								for (auto &watcher : tile.getWatchers())
-								{
-									watcher->sendPacket(dmgPacket, dmgBuffer);
-								}
+								subscriber.sendPacket(dmgPacket, dmgBuffer);
 							});
 
 							m_character->dealDamage(damage, 0, game::DamageType::Indirect, nullptr, true);
@@ -1847,19 +1847,17 @@ namespace wowpp
 				game::server_write::moveKnockBackWithInfo(movePacket, m_character->getGuid(), info);
 
 				// Notify all watchers
-				forEachTileInSight(
+				forEachSubscriberInSightOf(
 					getWorldInstance().getGrid(),
 					gridIndex,
-					[this, &info, &buffer, &movePacket](VisibilityTile &tile)
+					m_character->getGuid(),
+					[this, &info, &buffer, &movePacket](ITileSubscriber &subscriber)
 				{
-					for (auto &watcher : tile.getWatchers())
+					// We don't need to inform the player who sent the ack since he already received
+					// the forced knockback packet.
+					if (&subscriber != this)
 					{
-						// We don't need to inform the player who sent the ack since he already received
-						// the forced knockback packet.
-						if (watcher != this)
-						{
-							watcher->sendPacket(movePacket, buffer);
-						}
+						subscriber.sendPacket(movePacket, buffer);
 					}
 				});
 				break;
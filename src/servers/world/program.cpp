@@ -34,12 +34,15 @@
 #include "mysql_database.h"
 #include "proto_data/project.h"
 #include "game/universe.h"
+#include "game/project_snapshots.h"
 #include "trigger_handler.h"
 #include "common/timer_queue.h"
 #include "common/id_generator.h"
 #include "common/make_unique.h"
 #include "common/crash_handler.h"
+#include "common/slab_pool.h"
 #include "game/cheat_log.h"
+#include "game_protocol/update_compressor.h"
 #include "version.h"
 
 namespace wowpp
@@ -51,8 +54,8 @@ namespace wowpp
 
 	void Program::setupLogFiles()
 	{
-		LogStreamOptions logFileOptions = g_DefaultFileLogOptions;
-		logFileOptions.alwaysFlush = !m_configuration.isLogFileBuffering;
+		m_logFileOptions = g_DefaultFileLogOptions;
+		m_logFileOptions.alwaysFlush = !m_configuration.isLogFileBuffering;
 
 		if (m_configuration.isLogActive)
 		{
@@ -60,23 +63,7 @@ namespace wowpp
 			{
 				const String fileName = m_configuration.logFileName;
 				m_logFile.open(fileName.c_str(), std::ios::app);
-				if (m_logFile)
-				{
-					m_logConnections.append(g_DefaultLog.signal().connect(
-						[&](const LogEntry & entry)
-					{
-						// Don't log anti cheat entries to the default log file
-						if (entry.level != &g_CheatLevel)
-						{
-							m_backgroundLogger.addWork(std::bind(
-								printLogEntry,
-								std::ref(m_logFile),
-								entry,
-								std::cref(logFileOptions)));
-						}
-					}));
-				}
-				else
+				if (!m_logFile)
 				{
 					ELOG("Could not open log file '" << fileName << "'");
 				}
@@ -85,27 +72,32 @@ namespace wowpp
 			if (!m_cheatLogFile.is_open())
 			{
 				m_cheatLogFile.open(m_configuration.cheatLogFileName.c_str(), std::ios::app);
-				if (m_cheatLogFile)
-				{
-					m_logConnections.append(g_DefaultLog.signal().connect(
-						[&](const LogEntry & entry)
-					{
-						// Only log anti cheat entries to the default log file
-						if (entry.level == &g_CheatLevel)
-						{
-							m_backgroundLogger.addWork(std::bind(
-								printLogEntry,
-								std::ref(m_cheatLogFile),
-								entry,
-								std::cref(logFileOptions)));
-						}
-					}));
-				}
-				else
+				if (!m_cheatLogFile)
 				{
 					ELOG("Could not open cheat log file '" << m_configuration.cheatLogFileName << "'");
 				}
 			}
+
+			if (!m_logSink && (m_logFile.is_open() || m_cheatLogFile.is_open()))
+			{
+				// Entries are written by a background thread, so that logging never blocks the world update
+				m_logSink = make_unique<AsyncLogSink>(
+					[this](const LogEntry & entry)
+				{
+					// Anti cheat entries go to their own log file
+					std::ofstream &file = (entry.level == &g_CheatLevel) ? m_cheatLogFile : m_logFile;
+					if (file.is_open())
+					{
+						printLogEntry(file, entry, m_logFileOptions);
+					}
+				});
+
+				m_logConnections.append(g_DefaultLog.signal().connect(
+					[this](const LogEntry & entry)
+				{
+					m_logSink->push(entry);
+				}));
+			}
 		}
 	}
 
@@ -127,6 +119,10 @@ namespace wowpp
 			return false;
 		}
 
+		// Skip formatting of log messages which aren't important enough
+		g_DefaultLog.setMinimumImportance(static_cast<LogImportance>(
+			std::min<UInt32>(m_configuration.logMinimumImportance, log_importance::High)));
+
 		// No realms set up
 		if (m_configuration.realms.empty())
 		{
@@ -143,14 +139,22 @@ namespace wowpp
 		// The log files are written to in a special background thread
 		setupLogFiles();
 
-		// Load project
-		proto::Project project;
-		if (!project.load(m_configuration.dataPath))
+		// Load project and precompile spell execution plans. This has to outlive every object
+		// which references project data.
+		ProjectSnapshots snapshots(m_ioService);
+		if (!snapshots.loadInitial(m_configuration.dataPath))
 		{
 			ELOG("Could not load data project!");
 			return false;
 		}
 
+		proto::Project &project = snapshots.getCurrent().project;
+		universe.setSpellPlans(&snapshots.getCurrent().spellPlans);
+
+		// Setup update packet compression
+		game::setUpdateCompressionLevel(game::update_compression::Update, m_configuration.updateCompressionLevel);
+		game::setUpdateCompressionLevel(game::update_compression::Spawn, m_configuration.spawnCompressionLevel);
+
 		// Setup MySQL database
 		std::unique_ptr<MySQLDatabase> db(
 			new MySQLDatabase(
@@ -181,6 +185,11 @@ namespace wowpp
 		// Create world instance manager
 		auto worldInstanceManager =
 			std::make_shared<wowpp::WorldInstanceManager>(m_ioService, universe, *triggerHandler, instanceIdGenerator, objectIdGenerator, project, 0, m_configuration.dataPath);
+		worldInstanceManager->setIdleTimeout(m_configuration.instanceIdleTimeout * constants::OneSecond);
+		if (m_configuration.tickBudget > 0)
+		{
+			worldInstanceManager->enableTickProfiler(m_configuration.tickBudget * 1000);
+		}
 
 		std::vector<std::shared_ptr<RealmConnector>> realmConnectors;
 		std::map<UInt32, RealmConnector*> realmConnectorByMap;
@@ -196,8 +205,11 @@ namespace wowpp
 			realmConnectors.push_back(std::move(realmConnector));
 		}
 		
-		auto const createPlayer = [&PlayerManager, &worldInstanceManager, &project](RealmConnector &connector, auth::AuthLocale locale, DatabaseId characterId, std::shared_ptr<GameCharacter> character, WorldInstance &instance)
+		auto const createPlayer = [&PlayerManager, &worldInstanceManager](RealmConnector &connector, auth::AuthLocale locale, DatabaseId characterId, std::shared_ptr<GameCharacter> character, WorldInstance &instance)
 		{
+			// The player uses the project snapshot its character was created from
+			auto &project = character->getProject();
+
 			// Create the player instance
 			std::unique_ptr<wowpp::Player> player(
 				new wowpp::Player(
@@ -222,6 +234,94 @@ namespace wowpp
 			enterConnections[realm.get()] = realm->worldInstanceEntered.connect(createPlayer);
 		}
 
+		// Switch to reloaded data between two world updates. Objects which already exist keep the
+		// data they were created with, everything created from now on uses the new project.
+		const simple::scoped_connection snapshotActivatedConnection(snapshots.snapshotActivated.connect(
+			[&](ProjectSnapshot &snapshot)
+		{
+			universe.setSpellPlans(&snapshot.spellPlans);
+			triggerHandler->setProject(snapshot.project);
+			for (auto &realm : realmConnectors)
+			{
+				realm->setProject(snapshot.project);
+			}
+			worldInstanceManager->setProject(snapshot.project);
+		}));
+
+		// Watch the data project for changes
+		const boost::filesystem::path realmDataPath = boost::filesystem::path(m_configuration.dataPath) / "wowpp";
+		auto const getDataWriteTime = [&realmDataPath]() -> std::time_t
+		{
+			// project.txt lists the hash of every data file, so it is rewritten whenever the data changes
+			boost::system::error_code error;
+			const std::time_t writeTime = boost::filesystem::last_write_time(realmDataPath / "project.txt", error);
+			return error ? 0 : writeTime;
+		};
+
+		std::time_t loadedDataWriteTime = getDataWriteTime();
+		std::time_t changedDataWriteTime = loadedDataWriteTime;
+		boost::asio::deadline_timer dataReloadTimer(m_ioService);
+		std::function<void()> scheduleDataCheck = [&]()
+		{
+			dataReloadTimer.expires_from_now(boost::posix_time::seconds(m_configuration.dataReloadInterval));
+			dataReloadTimer.async_wait([&](const boost::system::error_code &error)
+			{
+				if (error)
+				{
+					return;
+				}
+
+				// Destroy outdated projects which are no longer used
+				snapshots.collectRetired();
+
+				const std::time_t writeTime = getDataWriteTime();
+				if (writeTime != loadedDataWriteTime)
+				{
+					// Only reload after the files didn't change for a whole interval, so that we don't
+					// read a project which is still being written
+					if (writeTime == changedDataWriteTime && snapshots.beginReload(m_configuration.dataPath))
+					{
+						ILOG("Data project changed - reloading in background");
+						loadedDataWriteTime = writeTime;
+					}
+					changedDataWriteTime = writeTime;
+				}
+
+				scheduleDataCheck();
+			});
+		};
+		if (m_configuration.dataReloadInterval > 0)
+		{
+			scheduleDataCheck();
+		}
+
+		// Report the memory used by pooled objects from time to time
+		boost::asio::deadline_timer memoryReportTimer(m_ioService);
+		std::function<void()> scheduleMemoryReport = [&]()
+		{
+			memoryReportTimer.expires_from_now(boost::posix_time::seconds(m_configuration.memoryReportInterval));
+			memoryReportTimer.async_wait([&](const boost::system::error_code &error)
+			{
+				if (error)
+				{
+					return;
+				}
+
+				for (const auto &stats : SlabPool::getAllStats())
+				{
+					ILOG("Memory pool " << stats.name << ": " << stats.usedBlocks << " used, " << stats.freeBlocks << " free, "
+						<< stats.blockSize << " bytes per block, " << stats.slabCount << " slabs (" << (stats.reservedBytes / 1024) << " KB), "
+						<< stats.fallbackAllocations << " fallbacks");
+				}
+
+				scheduleMemoryReport();
+			});
+		};
+		if (m_configuration.memoryReportInterval > 0)
+		{
+			scheduleMemoryReport();
+		}
+
 		//when the application terminates unexpectedly
 		const auto crashFlushConnection =
 			wowpp::CrashHandler::get().onCrash.connect(
@@ -241,7 +341,7 @@ namespace wowpp
 			ILOG("Player character saved. Shutting down.");
 
 			// Flush background logger
-			m_backgroundLogger.flush();
+			if (m_logSink) m_logSink->flush();
 
 			// Flush log files
 			if (m_logFile) m_logFile.flush();
@@ -252,6 +352,12 @@ namespace wowpp
 		// Run IO service
 		m_ioService.run();
 
+		// Players are bound to their world instances, so they have to be destroyed first
+		while (!PlayerManager->getPlayers().empty())
+		{
+			PlayerManager->playerDisconnected(*PlayerManager->getPlayers().back());
+		}
+
 		// Do not restart but shutdown after this
 		return m_shouldRestart;
 	}
@@ -23,7 +23,8 @@
 
 #include "configuration.h"
 #include "database.h"
-#include "common/background_worker.h"
+#include "log/async_log_sink.h"
+#include "log/log_stream_options.h"
 
 namespace wowpp
 {
@@ -56,7 +57,8 @@ namespace wowpp
 		bool m_shouldRestart;
 		std::ofstream m_logFile;
 		std::ofstream m_cheatLogFile;
-		BackgroundWorker m_backgroundLogger;
+		LogStreamOptions m_logFileOptions;
+		std::unique_ptr<AsyncLogSink> m_logSink;
 		simple::scoped_connection_container m_logConnections;
 	};
 }
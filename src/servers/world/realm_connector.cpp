@@ -30,6 +30,8 @@
 #include "game_protocol/game_protocol.h"
 #include "configuration.h"
 #include "common/clock.h"
+#include "common/constants.h"
+#include "common/tick_profiler.h"
 #include "proto_data/project.h"
 #include "game/game_world_object.h"
 #include "game/visibility_tile.h"
@@ -44,6 +46,7 @@ namespace wowpp
 {
 	static const auto ReconnectDelay = (constants::OneSecond * 4);
 	static const auto KeepAliveDelay = (constants::OneMinute / 2);
+	static const auto LoadReportDelay = (constants::OneSecond * 5);
 
 	RealmConnector::RealmConnector(
 		boost::asio::io_service &ioService, 
@@ -62,7 +65,10 @@ namespace wowpp
 		, m_timer(timer)
 		, m_realmEntryIndex(realmEntryIndex)
 		, m_realmName("UNKNOWN")
+		, m_isLoadReportScheduled(false)
 	{
+		m_onInstanceUnloading = m_worldInstanceManager.instanceUnloading.connect(this, &RealmConnector::onInstanceUnloading);
+
 		tryConnect();
 	}
 
@@ -149,7 +155,12 @@ namespace wowpp
 			io::StringSink sink(m_connection->getSendBuffer());
 			pp::OutgoingPacket packet(sink);
 
-			std::vector<UInt32> instanceIds;;
+			// Report running instances, so that the realm sends players of these instances to us
+			std::vector<UInt32> instanceIds;
+			for (const auto &instance : m_worldInstanceManager.getInstances())
+			{
+				instanceIds.push_back(instance->getId());
+			}
 
 			// Write packet structure
 			pp::world_realm::world_write::login(packet,
@@ -182,6 +193,7 @@ namespace wowpp
 		ILOG("Trying to connect to the realm server..");
 
 		m_connection = pp::Connector::create(m_ioService);
+		m_connection->setReceiveSize(constants::ServerLinkReceiveSize);
 		m_connection->connect(realm.realmAddress, realm.realmPort, *this, m_ioService);
 	}
 
@@ -193,6 +205,56 @@ namespace wowpp
 	{
 	}
 
+	void RealmConnector::scheduleLoadReport()
+	{
+		if (m_isLoadReportScheduled)
+		{
+			return;
+		}
+
+		m_isLoadReportScheduled = true;
+		m_timer.addEvent(
+			std::bind(&RealmConnector::onScheduledLoadReport, this), getCurrentTime() + LoadReportDelay);
+	}
+
+	void RealmConnector::onScheduledLoadReport()
+	{
+		m_isLoadReportScheduled = false;
+
+		// Stop reporting until we are logged in again
+		if (!m_connection)
+		{
+			return;
+		}
+
+		m_connection->sendSinglePacket(
+			std::bind(pp::world_realm::world_write::worldLoad, std::placeholders::_1,
+				static_cast<UInt32>(m_playerManager.getPlayers().size()),
+				static_cast<UInt32>(m_worldInstanceManager.getInstances().size()),
+				m_worldInstanceManager.getAverageTickDuration()));
+
+		if (m_worldInstanceManager.isTickProfilerEnabled())
+		{
+			std::ostringstream profile;
+			m_worldInstanceManager.writeTickProfile(profile);
+			m_connection->sendSinglePacket(
+				std::bind(pp::world_realm::world_write::worldTickProfile, std::placeholders::_1, profile.str()));
+		}
+
+		scheduleLoadReport();
+	}
+
+	void RealmConnector::onInstanceUnloading(WorldInstance &instance)
+	{
+		if (!m_connection)
+		{
+			return;
+		}
+
+		m_connection->sendSinglePacket(
+			std::bind(pp::world_realm::world_write::worldInstanceUnloaded, std::placeholders::_1, instance.getId()));
+	}
+
 	void RealmConnector::handleLoginAnswer(pp::Protocol::IncomingPacket &packet)
 	{
 		using namespace pp::world_realm;
@@ -218,6 +280,12 @@ namespace wowpp
 			case login_result::Success:
 			{
 				ILOG("World node successfully registered at the realm server");
+
+				// Report our load right away so that the realm can place players on this node
+				if (!m_isLoadReportScheduled)
+				{
+					onScheduledLoadReport();
+				}
 				break;
 			}
 
@@ -254,7 +322,7 @@ namespace wowpp
 		DatabaseId requesterDbId;
 		UInt32 instanceId;
 		std::shared_ptr<GameCharacter> character(new GameCharacter(
-			m_project,
+			m_project.get(),
 			m_worldInstanceManager.getUniverse().getTimers()));
 		if (!(pp::world_realm::realm_read::characterLogIn(packet, requesterDbId, instanceId, character.get(), locale)))
 		{
@@ -266,7 +334,7 @@ namespace wowpp
 		math::Vector3 location(character->getLocation());
 
 		// Let's lookup some informations about the requested map
-		auto map = m_project.maps.getById(character->getMapId());
+		auto map = m_project.get().maps.getById(character->getMapId());
 		if (!map)
 		{
 			ELOG("Unsupported map: " << character->getMapId());
@@ -356,39 +424,9 @@ namespace wowpp
 		ASSERT(instance);
 		instance->addGameObject(*character);
 
-		// Spawn objects
+		// Objects in sight are streamed to the client by the player instance after it spawned
 		TileIndex2D tileIndex;
 		instance->getGrid().getTilePosition(location, tileIndex[0], tileIndex[1]);
-		forEachTileInSight(instance->getGrid(), tileIndex, [character, this](VisibilityTile &tile)
-		{
-			for (auto it = tile.getGameObjects().begin(); it != tile.getGameObjects().end(); ++it)
-			{
-				auto &object = *it;
-				if (object->getGuid() != character->getGuid() &&
-					object->canSpawnForCharacter(*character))
-				{
-					// Dont spawn stealthed targets that we can't see yet
-					if (object->isCreature() || object->isGameCharacter())
-					{
-						GameUnit &unit = reinterpret_cast<GameUnit&>(*object);
-						if (unit.isStealthed() && !character->canDetectStealth(unit))
-						{
-							continue;
-						}
-					}
-
-					// Create update block
-					std::vector<std::vector<char>> blocks;
-					createUpdateBlocks(*object, *character, blocks);
-
-					std::vector<char> buffer;
-					io::VectorSink sink(buffer);
-					game::Protocol::OutgoingPacket packet(sink);
-					game::server_write::compressedUpdateObject(packet, blocks);
-					this->sendProxyPacket(character->getGuid(), packet.getOpCode(), packet.getSize(), buffer);
-				}
-			}
-		});
 
 		// Get that tile and make us a subscriber
 		instance->getGrid().requireTile(tileIndex);
@@ -516,7 +554,7 @@ namespace wowpp
 		for (auto &it : data)
 		{
 			// Skip items that are not available
-			const auto *entry = m_project.items.getById(it.entry);
+			const auto *entry = character->getProject().items.getById(it.entry);
 			if (!entry)
 			{
 				WLOG("Unknown item entry: " << it.entry << " - item will be skipped!");
@@ -553,12 +591,6 @@ namespace wowpp
 			return;
 		}
 
-		const auto *spell = m_project.spells.getById(spellId);
-		if (!spell)
-		{
-			return;
-		}
-
 		// Find requested character
 		auto *player = m_playerManager.getPlayerByCharacterGuid(characterId);
 		if (!player)
@@ -571,6 +603,13 @@ namespace wowpp
 			return;
 		}
 
+		// Use the spell of the project snapshot the character was created from
+		const auto *spell = character->getProject().spells.getById(spellId);
+		if (!spell)
+		{
+			return;
+		}
+
 		// Already learned?
 		if (character->hasSpell(spellId))
 		{
@@ -594,9 +633,10 @@ namespace wowpp
 		io::VectorSink sink(buffer);
 		game::Protocol::OutgoingPacket outPacket(sink);
 		game::server_write::playSpellImpact(outPacket, character->getGuid(), 0x016A);
-		forEachSubscriberInSight(
+		forEachSubscriberInSightOf(
 			world->getGrid(),
 			tile,
+			character->getGuid(),
 			[&outPacket, &buffer](ITileSubscriber &subscriber)
 		{
 			subscriber.sendPacket(outPacket, buffer);
@@ -876,6 +916,8 @@ namespace wowpp
 
 	void RealmConnector::sendProxyPacket(DatabaseId senderId, UInt16 opCode, UInt32 size, const std::vector<char> &buffer)
 	{
+		TickProfileScope zone(tick_zone::ProxySends);
+
 		m_connection->sendSinglePacket(
 			std::bind(pp::world_realm::world_write::clientProxyPacket, std::placeholders::_1, senderId, opCode, size, std::cref(buffer)));
 	}
@@ -1072,7 +1114,7 @@ namespace wowpp
 		}
 
 		// Look for the spell
-		const auto *spell = m_project.spells.getById(spellId);
+		const auto *spell = sender.getCharacter()->getProject().spells.getById(spellId);
 		if (!spell)
 		{
 			return;
@@ -1192,7 +1234,7 @@ namespace wowpp
 		}
 
 		// Check the trigger
-		const auto *trigger = m_project.areaTriggers.getById(triggerId);
+		const auto *trigger = sender.getCharacter()->getProject().areaTriggers.getById(triggerId);
 		if (!trigger)
 		{
 			WLOG("Unknown trigger " << trigger->id());
@@ -1244,7 +1286,7 @@ namespace wowpp
 		}
 
 		// Find that spell
-		const auto *spell = m_project.spells.getById(spellId);
+		const auto *spell = sender.getCharacter()->getProject().spells.getById(spellId);
 		if (!spell)
 		{
 			WLOG("Unknown spell - can't cancel aura");
@@ -1287,15 +1329,13 @@ namespace wowpp
 		sender.getCharacter()->getTileIndex(gridIndex);
 
 		// Notify all watchers about the new object
-		forEachTileInSight(
+		forEachSubscriberInSightOf(
 			sender.getWorldInstance().getGrid(),
 			gridIndex,
-			[&emotePacket, &buffer](VisibilityTile &tile)
+			sender.getCharacterGuid(),
+			[&emotePacket, &buffer](ITileSubscriber &subscriber)
 		{
-			for (auto &watcher : tile.getWatchers())
-			{
-				watcher->sendPacket(emotePacket, buffer);
-			}
+			subscriber.sendPacket(emotePacket, buffer);
 		});
 	}
 
@@ -1315,7 +1355,7 @@ namespace wowpp
 			return;
 		}
 
-		const auto *emote = m_project.emotes.getById(textEmote);
+		const auto *emote = sender.getCharacter()->getProject().emotes.getById(textEmote);
 		if (!emote)
 		{
 			WLOG("Could not find emote " << textEmote);
@@ -1343,15 +1383,13 @@ namespace wowpp
 				game::server_write::emote(emotePacket, anim, sender.getCharacterGuid());
 
 				// Notify all watchers about the new object
-				forEachTileInSight(
+				forEachSubscriberInSightOf(
 					sender.getWorldInstance().getGrid(),
 					gridIndex,
-					[&emotePacket, &buffer](VisibilityTile &tile)
+					sender.getCharacterGuid(),
+					[&emotePacket, &buffer](ITileSubscriber &subscriber)
 				{
-					for (auto &watcher : tile.getWatchers())
-					{
-						watcher->sendPacket(emotePacket, buffer);
-					}
+					subscriber.sendPacket(emotePacket, buffer);
 				});
 			}
 		}
@@ -1374,7 +1412,7 @@ namespace wowpp
 				else
 				{
 					UInt32 entry = unit->getUInt32Value(object_fields::Entry);
-					auto *unitEntry = m_project.units.getById(entry);
+					auto *unitEntry = sender.getCharacter()->getProject().units.getById(entry);
 					if (unitEntry)
 					{
 						name = unitEntry->name();
@@ -1390,15 +1428,13 @@ namespace wowpp
 		game::server_write::textEmote(emotePacket, sender.getCharacterGuid(), textEmote, emoteNum, name);
 
 		// Notify all watchers about the new object
-		forEachTileInSight(
+		forEachSubscriberInSightOf(
 			sender.getWorldInstance().getGrid(),
 			gridIndex,
-			[&emotePacket, &buffer](VisibilityTile &tile)
+			sender.getCharacterGuid(),
+			[&emotePacket, &buffer](ITileSubscriber &subscriber)
 		{
-			for (auto &watcher : tile.getWatchers())
-			{
-				watcher->sendPacket(emotePacket, buffer);
-			}
+			subscriber.sendPacket(emotePacket, buffer);
 		});
 	}
 
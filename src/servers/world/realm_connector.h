@@ -76,6 +76,11 @@ namespace wowpp
 			TimerQueue &timer);
 		~RealmConnector();
 
+		/// Sets the project which is used for characters logging in from now on.
+		void setProject(proto::Project &project) {
+			m_project = proto::ProjectReference(project);
+		}
+
 		/// @copydoc wowpp::pp::IConnectorListener::connectionLost()
 		virtual void connectionLost() override;
 		/// @copydoc wowpp::pp::IConnectorListener::connectionMalformedPacket()
@@ -123,6 +128,12 @@ namespace wowpp
 		void scheduleKeepAlive();
 		/// 
 		void onScheduledKeepAlive();
+		/// Schedules the next load report to the realm.
+		void scheduleLoadReport();
+		/// Sends the current load of this world node to the realm and schedules the next report.
+		void onScheduledLoadReport();
+		/// Notifies the realm that an idle world instance is about to be unloaded.
+		void onInstanceUnloading(WorldInstance &instance);
 
 		// Realm packet handlers
 		void handleLoginAnswer(pp::Protocol::IncomingPacket &packet);
@@ -164,10 +175,12 @@ namespace wowpp
 		WorldInstanceManager &m_worldInstanceManager;
 		PlayerManager &m_playerManager;
 		const Configuration &m_config;
-		proto::Project &m_project;
+		proto::ProjectReference m_project;
 		TimerQueue &m_timer;
 		std::shared_ptr<pp::Connector> m_connection;
 		UInt32 m_realmEntryIndex;
 		String m_realmName;
+		bool m_isLoadReportScheduled;
+		simple::scoped_connection m_onInstanceUnloading;
 	};
 }
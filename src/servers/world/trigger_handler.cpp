@@ -147,9 +147,11 @@ namespace wowpp
 						break;
 					}
 
-					// Save delay
+					// Save delay. The trigger entry belongs either to the owner's project or to the
+					// current one, so keep that project alive even if it is replaced in the meantime.
+					const proto::ProjectReference projectRef(strongOwner ? strongOwner->getProject() : m_project.get());
 					auto delayCountdown = make_unique<Countdown>(m_timers);
-					delayCountdown->ended.connect([&entry, i, this, context, weakOwner]()
+					delayCountdown->ended.connect([&entry, i, this, context, weakOwner, projectRef]()
 					{
 						GameObject *oldOwner = context.owner;
 
@@ -187,8 +189,9 @@ namespace wowpp
 
 		UInt32 data = getActionData(action, 0);
 
-		// Find that trigger
-		const auto *trigger = m_project.triggers.getById(data);
+		// Find that trigger in the project the owner was created from
+		auto &project = context.owner ? context.owner->getProject() : m_project.get();
+		const auto *trigger = project.triggers.getById(data);
 		if (!trigger)
 		{
 			ELOG("Unable to find trigger " << data << " - trigger is not executed");
@@ -423,7 +426,7 @@ namespace wowpp
 		}
 
 		// Resolve spell id
-		const auto *spell = m_project.spells.getById(getActionData(action, 0));
+		const auto *spell = caster->getProject().spells.getById(getActionData(action, 0));
 		if (!spell)
 		{
 			ELOG("TRIGGER_ACTION_CAST_SPELL: Invalid spell index or spell not found");
@@ -616,7 +619,7 @@ namespace wowpp
 		Int32 item = getActionData(action, 1);
 		if (item > 0)
 		{
-			auto *itemEntry = m_project.items.getById(item);
+			auto *itemEntry = target->getProject().items.getById(item);
 			if (itemEntry)
 			{
 				reinterpret_cast<GameCreature*>(target)->setVirtualItem(slot, itemEntry);
@@ -25,6 +25,7 @@
 #include "common/timer_queue.h"
 #include "common/countdown.h"
 #include "game/trigger_handler.h"
+#include "shared/proto_data/project_reference.h"
 
 namespace wowpp
 {
@@ -46,6 +47,10 @@ namespace wowpp
 
 		/// Fires a trigger event.
 		virtual void executeTrigger(const proto::TriggerEntry &entry, game::TriggerContext context, UInt32 actionOffset = 0, bool ignoreProbability = false) override;
+		/// Sets the project which is used to look up triggers, spells and items referenced by trigger actions.
+		void setProject(proto::Project &project) {
+			m_project = proto::ProjectReference(project);
+		}
 
 	private:
 
@@ -84,7 +89,7 @@ namespace wowpp
 
 	private:
 
-		proto::Project &m_project;
+		proto::ProjectReference m_project;
 		PlayerManager &m_playerManager;
 		TimerQueue &m_timers;
 		std::list<std::unique_ptr<Countdown>> m_delays;
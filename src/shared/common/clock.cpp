@@ -36,6 +36,12 @@
 
 namespace wowpp
 {
+	namespace
+	{
+		static std::atomic<bool> s_simulated(false);
+		static std::atomic<GameTime> s_simulatedTime(0);
+	}
+
 	UInt32 TimeStamp()
 	{
 #ifdef _WIN32
@@ -70,6 +76,11 @@ namespace wowpp
 
 	GameTime getCurrentTime()
 	{
+		if (s_simulated.load(std::memory_order_relaxed))
+		{
+			return s_simulatedTime.load(std::memory_order_relaxed);
+		}
+
 #if defined(WIN32) || defined(_WIN32)
 		//::GetTickCount64() is not available on Windows XP and prior systems
 		return ::GetTickCount64();
@@ -80,4 +91,25 @@ namespace wowpp
             (tp.tv_sec * 1000) + (tp.tv_usec / 1000) % UInt64(0x00000000FFFFFFFF));
 #endif
     }
+
+	void enableSimulatedTime(GameTime start)
+	{
+		s_simulatedTime = start;
+		s_simulated = true;
+	}
+
+	void disableSimulatedTime()
+	{
+		s_simulated = false;
+	}
+
+	void advanceSimulatedTime(GameTime delta)
+	{
+		s_simulatedTime += delta;
+	}
+
+	bool isSimulatedTime()
+	{
+		return s_simulated.load(std::memory_order_relaxed);
+	}
 }
@@ -51,4 +51,15 @@ namespace wowpp
 
 
 	GameTime getCurrentTime();
+	/// Lets getCurrentTime() return a simulated time, which only advances through
+	/// advanceSimulatedTime(). Timer queues then no longer wait for their events on their own, but
+	/// have to be processed by hand (see TimerQueue::processEvents). Meant for tools which need a
+	/// reproducible game time, like the tick benchmark.
+	void enableSimulatedTime(GameTime start);
+	/// Lets getCurrentTime() return the real time again.
+	void disableSimulatedTime();
+	/// Advances the simulated time returned by getCurrentTime().
+	void advanceSimulatedTime(GameTime delta);
+	/// Determines whether getCurrentTime() returns a simulated time.
+	bool isSimulatedTime();
 }
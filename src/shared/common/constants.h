@@ -43,6 +43,10 @@ namespace wowpp
 		/// This is the default port used by MySQL servers.
 		static const NetPort DefaultMySQLPort = 3306;
 
+		/// Number of bytes read at once on the link between realm and world servers, which carries
+		/// large bursts of spawn packets and proxied player traffic.
+		static const size_t ServerLinkReceiveSize = 64 * 1024;
+
 		/// Every packet of the wowpp protocol has to start with this constant.
 		static const NetPacketBegin PacketBegin = 0xfc;
 
@@ -23,6 +23,7 @@
 #include "macros.h"
 #include "countdown.h"
 #include "timer_queue.h"
+#include "slab_pool.h"
 
 namespace wowpp
 {
@@ -88,9 +89,20 @@ namespace wowpp
 	};
 
 
+	namespace
+	{
+		/// Countdowns are created for every unit, so their implementations are pooled. The pool is
+		/// never destroyed, as pending timer events may keep implementations alive until shutdown.
+		SlabPool &getImplPool()
+		{
+			static SlabPool &pool = *new SlabPool("Countdown", 1024);
+			return pool;
+		}
+	}
+
 	Countdown::Countdown(TimerQueue &timers)
 		: running(false)
-		, m_impl(std::make_shared<Impl>(timers, *this))
+		, m_impl(allocateShared<Impl>(getImplPool(), timers, *this))
 		, m_end(0)
 	{
 	}
@@ -0,0 +1,114 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "simple/simple.hpp"
+
+namespace wowpp
+{
+	template <class Signature, class Collector = simple::default_collector<
+		typename simple::detail::expand_signature<Signature>::result_type>>
+	class LazySignal;
+
+	/// Drop-in replacement for simple::signal which allocates the signal on the first connect.
+	/// A simple::signal allocates its list head and tail on construction, which adds up for
+	/// objects like units which declare lots of signals that most instances never connect to.
+	/// Connections behave exactly like those of simple::signal. Invoking a signal without any
+	/// connection returns the empty collector result.
+	template <class Collector, class R, class... Args>
+	class LazySignal<R(Args...), Collector> final
+	{
+	private:
+
+		LazySignal(const LazySignal &Other) = delete;
+		LazySignal &operator=(const LazySignal &Other) = delete;
+
+	public:
+
+		typedef simple::signal<R(Args...), Collector> SignalType;
+		typedef typename SignalType::slot_type slot_type;
+
+	public:
+
+		LazySignal() = default;
+
+		/// Connects a slot to this signal. Accepts everything simple::signal::connect accepts.
+		template <class... ConnectArgs>
+		simple::connection connect(ConnectArgs &&... args)
+		{
+			return getSignal().connect(std::forward<ConnectArgs>(args)...);
+		}
+
+		simple::connection operator += (slot_type slot)
+		{
+			return connect(std::move(slot));
+		}
+
+		/// Disconnects all slots, but keeps the signal allocated.
+		void clear()
+		{
+			if (m_signal)
+			{
+				m_signal->clear();
+			}
+		}
+
+		/// Determines whether something has ever been connected to this signal.
+		bool isAllocated() const
+		{
+			return m_signal != nullptr;
+		}
+
+		template <class ValueCollector = Collector>
+		auto invoke(Args const &... args) const -> decltype(ValueCollector{}.result())
+		{
+			if (!m_signal)
+			{
+				return ValueCollector{}.result();
+			}
+
+			return m_signal->template invoke<ValueCollector>(args...);
+		}
+
+		auto operator () (Args const &... args) const -> decltype(invoke(args...))
+		{
+			return invoke(args...);
+		}
+
+	private:
+
+		SignalType &getSignal()
+		{
+			if (!m_signal)
+			{
+				m_signal.reset(new SignalType);
+			}
+
+			return *m_signal;
+		}
+
+	private:
+
+		std::unique_ptr<SignalType> m_signal;
+	};
+}
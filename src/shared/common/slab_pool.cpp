@@ -0,0 +1,164 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "slab_pool.h"
+#include "macros.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Alignment of every block, which is enough for all types we pool.
+		const size_t BlockAlignment = 16;
+
+		std::mutex &getRegistryMutex()
+		{
+			static std::mutex mutex;
+			return mutex;
+		}
+
+		std::vector<SlabPool*> &getRegistry()
+		{
+			static std::vector<SlabPool*> registry;
+			return registry;
+		}
+	}
+
+	SlabPool::SlabPool(String name, size_t blocksPerSlab)
+		: m_name(std::move(name))
+		, m_blocksPerSlab(std::max<size_t>(blocksPerSlab, 1))
+		, m_blockSize(0)
+		, m_freeList(nullptr)
+		, m_usedBlocks(0)
+		, m_freeBlocks(0)
+		, m_fallbackAllocations(0)
+	{
+		std::lock_guard<std::mutex> lock(getRegistryMutex());
+		getRegistry().push_back(this);
+	}
+
+	SlabPool::~SlabPool()
+	{
+		std::lock_guard<std::mutex> lock(getRegistryMutex());
+		auto &registry = getRegistry();
+		registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+	}
+
+	void *SlabPool::allocate(size_t size)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		// The first allocation determines the block size
+		if (m_blockSize == 0)
+		{
+			m_blockSize = std::max(size, sizeof(FreeBlock));
+			m_blockSize = (m_blockSize + BlockAlignment - 1) & ~(BlockAlignment - 1);
+		}
+
+		if (size > m_blockSize)
+		{
+			++m_fallbackAllocations;
+			lock.unlock();
+			return ::operator new(size);
+		}
+
+		if (!m_freeList)
+		{
+			allocateSlab();
+		}
+
+		FreeBlock *block = m_freeList;
+		m_freeList = block->next;
+		--m_freeBlocks;
+		++m_usedBlocks;
+		return block;
+	}
+
+	void SlabPool::deallocate(void *ptr, size_t size)
+	{
+		if (!ptr)
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (size > m_blockSize)
+		{
+			lock.unlock();
+			::operator delete(ptr);
+			return;
+		}
+
+		ASSERT(m_usedBlocks > 0);
+		FreeBlock *block = static_cast<FreeBlock*>(ptr);
+		block->next = m_freeList;
+		m_freeList = block;
+		++m_freeBlocks;
+		--m_usedBlocks;
+	}
+
+	SlabPool::Stats SlabPool::getStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		Stats stats;
+		stats.name = m_name;
+		stats.blockSize = m_blockSize;
+		stats.usedBlocks = m_usedBlocks;
+		stats.freeBlocks = m_freeBlocks;
+		stats.slabCount = m_slabs.size();
+		stats.reservedBytes = m_slabs.size() * m_blocksPerSlab * m_blockSize;
+		stats.fallbackAllocations = m_fallbackAllocations;
+		return stats;
+	}
+
+	std::vector<SlabPool::Stats> SlabPool::getAllStats()
+	{
+		std::lock_guard<std::mutex> lock(getRegistryMutex());
+
+		std::vector<Stats> result;
+		result.reserve(getRegistry().size());
+		for (const auto *pool : getRegistry())
+		{
+			result.push_back(pool->getStats());
+		}
+		return result;
+	}
+
+	void SlabPool::allocateSlab()
+	{
+		// operator new[] returns memory which is suitably aligned for BlockAlignment
+		std::unique_ptr<char[]> slab(new char[m_blockSize * m_blocksPerSlab]);
+
+		// Link the blocks in order, so that objects created after each other are close in memory
+		for (size_t i = m_blocksPerSlab; i-- > 0;)
+		{
+			FreeBlock *block = reinterpret_cast<FreeBlock*>(slab.get() + i * m_blockSize);
+			block->next = m_freeList;
+			m_freeList = block;
+		}
+
+		m_freeBlocks += m_blocksPerSlab;
+		m_slabs.push_back(std::move(slab));
+	}
+}
@@ -0,0 +1,164 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "typedefs.h"
+#include <mutex>
+
+namespace wowpp
+{
+	/// Hands out memory blocks of a single size which are carved from larger slabs. Freed blocks
+	/// are kept in a free list and reused, so that objects which are created and destroyed very
+	/// often don't fragment the heap. The block size is taken from the first allocation, larger
+	/// requests fall back to the global operator new.
+	class SlabPool final
+	{
+	private:
+
+		SlabPool(const SlabPool &Other) = delete;
+		SlabPool &operator=(const SlabPool &Other) = delete;
+
+	public:
+
+		/// Default number of blocks per slab.
+		static const size_t DefaultBlocksPerSlab = 256;
+
+		/// Current usage of a pool.
+		struct Stats
+		{
+			String name;
+			/// Size of a single block in bytes (0 if nothing was allocated yet).
+			size_t blockSize;
+			/// Number of blocks which are currently in use.
+			size_t usedBlocks;
+			/// Number of blocks which are ready to be reused.
+			size_t freeBlocks;
+			/// Number of allocated slabs.
+			size_t slabCount;
+			/// Memory reserved by all slabs in bytes.
+			size_t reservedBytes;
+			/// Number of requests which didn't fit into a block.
+			size_t fallbackAllocations;
+		};
+
+	public:
+
+		/// Creates a new, empty pool.
+		/// @param name Name of this pool used in memory reports.
+		/// @param blocksPerSlab Number of blocks which are allocated at once.
+		explicit SlabPool(String name, size_t blocksPerSlab = DefaultBlocksPerSlab);
+		/// Frees all slabs. Blocks which are still in use become invalid.
+		~SlabPool();
+
+		/// Allocates a block of memory.
+		/// @param size Requested size in bytes.
+		void *allocate(size_t size);
+		/// Returns a block which has been allocated using allocate.
+		/// @param ptr The block to release.
+		/// @param size The size which was passed to allocate.
+		void deallocate(void *ptr, size_t size);
+
+		/// Gets the name of this pool.
+		const String &getName() const { return m_name; }
+		/// Gets the current usage of this pool.
+		Stats getStats() const;
+
+		/// Gets the usage of all existing pools.
+		static std::vector<Stats> getAllStats();
+
+	private:
+
+		struct FreeBlock
+		{
+			FreeBlock *next;
+		};
+
+		void allocateSlab();
+
+	private:
+
+		const String m_name;
+		const size_t m_blocksPerSlab;
+		mutable std::mutex m_mutex;
+		size_t m_blockSize;
+		FreeBlock *m_freeList;
+		std::vector<std::unique_ptr<char[]>> m_slabs;
+		size_t m_usedBlocks;
+		size_t m_freeBlocks;
+		size_t m_fallbackAllocations;
+	};
+
+	/// Standard allocator which takes its memory from a SlabPool. Meant to be used with
+	/// std::allocate_shared, so that the object and its reference counts share a single block.
+	template<typename T>
+	class SlabAllocator
+	{
+		template<typename U>
+		friend class SlabAllocator;
+
+	public:
+
+		typedef T value_type;
+
+		explicit SlabAllocator(SlabPool &pool) noexcept
+			: m_pool(&pool)
+		{
+		}
+		template<typename U>
+		SlabAllocator(const SlabAllocator<U> &other) noexcept
+			: m_pool(other.m_pool)
+		{
+		}
+
+		T *allocate(size_t count)
+		{
+			return static_cast<T*>(m_pool->allocate(count * sizeof(T)));
+		}
+		void deallocate(T *ptr, size_t count)
+		{
+			m_pool->deallocate(ptr, count * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator==(const SlabAllocator<U> &other) const
+		{
+			return m_pool == other.m_pool;
+		}
+		template<typename U>
+		bool operator!=(const SlabAllocator<U> &other) const
+		{
+			return m_pool != other.m_pool;
+		}
+
+	private:
+
+		SlabPool *m_pool;
+	};
+
+	/// Creates a shared object whose memory is taken from the given pool.
+	template<typename T, typename... Args>
+	std::shared_ptr<T> allocateShared(SlabPool &pool, Args &&... args)
+	{
+		return std::allocate_shared<T>(SlabAllocator<T>(pool), std::forward<Args>(args)...);
+	}
+}
@@ -0,0 +1,293 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "tick_profiler.h"
+#include "log/default_log_levels.h"
+
+namespace wowpp
+{
+	/// Minimum time between two slow tick log entries, so that an overloaded node doesn't flood the log.
+	static const auto SlowTickLogInterval = std::chrono::seconds(1);
+	/// Number of zones which are listed in a slow tick log entry.
+	static const size_t SlowTickLogZones = 3;
+
+	const char *getTickZoneName(TickZone zone)
+	{
+		static const char *const Names[tick_zone::Count_] =
+		{
+			"timers",
+			"creatureAI",
+			"movement",
+			"objectUpdates",
+			"proxySends"
+		};
+
+		return (zone < tick_zone::Count_) ? Names[zone] : "unknown";
+	}
+
+	const std::array<UInt32, 9> RollingHistogram::BucketBounds =
+	{
+		{ 1000, 2000, 5000, 10000, 20000, 33000, 50000, 100000, 250000 }
+	};
+
+	RollingHistogram::RollingHistogram(size_t capacity)
+		: m_capacity(capacity)
+		, m_next(0)
+		, m_sampleCount(0)
+	{
+	}
+
+	void RollingHistogram::add(UInt32 microseconds)
+	{
+		if (m_samples.empty())
+		{
+			m_samples.resize(m_capacity);
+		}
+
+		m_samples[m_next] = microseconds;
+		m_next = (m_next + 1) % m_capacity;
+		m_sampleCount = std::min(m_sampleCount + 1, m_capacity);
+	}
+
+	void RollingHistogram::clear()
+	{
+		m_next = 0;
+		m_sampleCount = 0;
+	}
+
+	UInt32 RollingHistogram::getPercentile(UInt32 percentile) const
+	{
+		if (m_sampleCount == 0)
+		{
+			return 0;
+		}
+
+		std::vector<UInt32> sorted(m_samples.begin(), m_samples.begin() + m_sampleCount);
+		const size_t index = std::min(m_sampleCount - 1, m_sampleCount * percentile / 100);
+		std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+		return sorted[index];
+	}
+
+	UInt32 RollingHistogram::getMax() const
+	{
+		if (m_sampleCount == 0)
+		{
+			return 0;
+		}
+
+		return *std::max_element(m_samples.begin(), m_samples.begin() + m_sampleCount);
+	}
+
+	UInt32 RollingHistogram::getMean() const
+	{
+		if (m_sampleCount == 0)
+		{
+			return 0;
+		}
+
+		UInt64 total = 0;
+		for (size_t i = 0; i < m_sampleCount; ++i)
+		{
+			total += m_samples[i];
+		}
+
+		return static_cast<UInt32>(total / m_sampleCount);
+	}
+
+	void RollingHistogram::writeJson(std::ostream &out) const
+	{
+		std::array<UInt32, BucketCount> buckets;
+		buckets.fill(0);
+		for (size_t i = 0; i < m_sampleCount; ++i)
+		{
+			const auto bound = std::upper_bound(BucketBounds.begin(), BucketBounds.end(), m_samples[i]);
+			buckets[bound - BucketBounds.begin()]++;
+		}
+
+		out << "{\"samples\":" << m_sampleCount
+			<< ",\"mean\":" << getMean()
+			<< ",\"p50\":" << getPercentile(50)
+			<< ",\"p90\":" << getPercentile(90)
+			<< ",\"p99\":" << getPercentile(99)
+			<< ",\"max\":" << getMax()
+			<< ",\"histogram\":[";
+		for (size_t i = 0; i < buckets.size(); ++i)
+		{
+			if (i) out << ",";
+			out << buckets[i];
+		}
+		out << "]}";
+	}
+
+	thread_local TickProfiler *TickProfiler::s_active = nullptr;
+
+	TickProfiler::TickProfiler(UInt32 budget)
+		: m_budget(budget)
+		, m_ticks(HistorySize)
+		, m_zoneHistograms(tick_zone::Count_, RollingHistogram(HistorySize))
+		, m_depth(0)
+		, m_timeBetweenTicks(Clock::duration::zero())
+		, m_inTick(false)
+		, m_slowTicks(0)
+		, m_suppressedSlowTicks(0)
+	{
+		m_zoneTimes.fill(Clock::duration::zero());
+	}
+
+	void TickProfiler::beginTick()
+	{
+		m_tickStart = Clock::now();
+		m_inTick = true;
+	}
+
+	void TickProfiler::endTick()
+	{
+		if (!m_inTick)
+		{
+			return;
+		}
+
+		const auto now = Clock::now();
+		if (m_depth > 0)
+		{
+			// Split zones which span the end of the tick
+			addSegment(now);
+		}
+
+		m_inTick = false;
+
+		const auto duration = static_cast<UInt32>(std::chrono::duration_cast<std::chrono::microseconds>(
+			(now - m_tickStart) + m_timeBetweenTicks).count());
+		m_ticks.add(duration);
+		for (size_t i = 0; i < tick_zone::Count_; ++i)
+		{
+			m_zoneHistograms[i].add(static_cast<UInt32>(
+				std::chrono::duration_cast<std::chrono::microseconds>(m_zoneTimes[i]).count()));
+		}
+
+		if (duration > m_budget)
+		{
+			++m_slowTicks;
+			logSlowTick(duration);
+		}
+
+		m_zoneTimes.fill(Clock::duration::zero());
+		m_timeBetweenTicks = Clock::duration::zero();
+	}
+
+	bool TickProfiler::enter(TickZone zone)
+	{
+		if (m_depth >= MaxDepth)
+		{
+			return false;
+		}
+
+		const auto now = Clock::now();
+		if (m_depth > 0)
+		{
+			addSegment(now);
+		}
+
+		m_stack[m_depth++] = zone;
+		m_segmentStart = now;
+		return true;
+	}
+
+	void TickProfiler::leave()
+	{
+		addSegment(Clock::now());
+		--m_depth;
+	}
+
+	void TickProfiler::addSegment(Clock::time_point now)
+	{
+		const auto segment = now - m_segmentStart;
+		m_zoneTimes[m_stack[m_depth - 1]] += segment;
+		if (!m_inTick)
+		{
+			m_timeBetweenTicks += segment;
+		}
+
+		m_segmentStart = now;
+	}
+
+	void TickProfiler::logSlowTick(UInt32 duration)
+	{
+		const auto now = Clock::now();
+		if (m_lastSlowTickLog != Clock::time_point() &&
+			now - m_lastSlowTickLog < SlowTickLogInterval)
+		{
+			++m_suppressedSlowTicks;
+			return;
+		}
+
+		m_lastSlowTickLog = now;
+
+		std::array<size_t, tick_zone::Count_> zones;
+		for (size_t i = 0; i < zones.size(); ++i)
+		{
+			zones[i] = i;
+		}
+		std::sort(zones.begin(), zones.end(), [this](size_t a, size_t b)
+		{
+			return m_zoneTimes[a] > m_zoneTimes[b];
+		});
+
+		std::ostringstream message;
+		message << "Slow world tick: " << duration << " us (budget " << m_budget << " us)";
+		for (size_t i = 0; i < SlowTickLogZones && i < zones.size(); ++i)
+		{
+			const auto zoneTime = std::chrono::duration_cast<std::chrono::microseconds>(m_zoneTimes[zones[i]]).count();
+			if (zoneTime == 0)
+			{
+				break;
+			}
+
+			message << (i ? ", " : ": ") << getTickZoneName(static_cast<TickZone>(zones[i])) << " " << zoneTime << " us";
+		}
+
+		if (m_suppressedSlowTicks > 0)
+		{
+			message << " (" << m_suppressedSlowTicks << " slow ticks not logged since the last entry)";
+		}
+
+		WLOG(message.str());
+		m_suppressedSlowTicks = 0;
+	}
+
+	void TickProfiler::writeJson(std::ostream &out) const
+	{
+		out << "{\"budget\":" << m_budget
+			<< ",\"slowTicks\":" << m_slowTicks
+			<< ",\"tick\":";
+		m_ticks.writeJson(out);
+		out << ",\"zones\":{";
+		for (size_t i = 0; i < tick_zone::Count_; ++i)
+		{
+			if (i) out << ",";
+			out << "\"" << getTickZoneName(static_cast<TickZone>(i)) << "\":";
+			m_zoneHistograms[i].writeJson(out);
+		}
+		out << "}}";
+	}
+}
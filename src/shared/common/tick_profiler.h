@@ -0,0 +1,206 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "typedefs.h"
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+namespace wowpp
+{
+	namespace tick_zone
+	{
+		/// Subsystems whose time is measured by the tick profiler.
+		enum Type
+		{
+			/// Timer callbacks which aren't covered by one of the other zones.
+			Timers,
+			/// Creature AI decisions.
+			CreatureAI,
+			/// Unit movement and its fan-out to nearby players.
+			Movement,
+			/// Serialization and distribution of object value updates.
+			ObjectUpdates,
+			/// Packets which are sent to players through the realm.
+			ProxySends,
+
+			Count_
+		};
+	}
+
+	typedef tick_zone::Type TickZone;
+
+	/// Gets the name of a tick zone as used in reports.
+	const char *getTickZoneName(TickZone zone);
+
+	/// Keeps the durations of the most recent samples in a ring buffer and builds a histogram,
+	/// percentiles and maxima of them on request.
+	class RollingHistogram final
+	{
+	public:
+
+		/// Upper bounds of the histogram buckets in microseconds. The last bucket has no upper bound.
+		static const std::array<UInt32, 9> BucketBounds;
+		/// Number of histogram buckets.
+		static const size_t BucketCount = 10;
+
+	public:
+
+		/// @param capacity Number of samples which are kept. Memory is reserved with the first sample.
+		explicit RollingHistogram(size_t capacity);
+
+		/// Adds a sample and drops the oldest one if the capacity has been reached.
+		void add(UInt32 microseconds);
+		/// Removes all samples.
+		void clear();
+		/// Gets the number of samples which are currently kept.
+		size_t getSampleCount() const { return m_sampleCount; }
+		/// Gets a percentile of the kept samples in microseconds.
+		UInt32 getPercentile(UInt32 percentile) const;
+		/// Gets the largest kept sample in microseconds.
+		UInt32 getMax() const;
+		/// Gets the average of the kept samples in microseconds.
+		UInt32 getMean() const;
+		/// Writes the kept samples as json object with mean, percentiles, maximum and histogram.
+		void writeJson(std::ostream &out) const;
+
+	private:
+
+		std::vector<UInt32> m_samples;
+		size_t m_capacity;
+		size_t m_next;
+		size_t m_sampleCount;
+	};
+
+	/// Measures how long world ticks take and which subsystems dominate them. Code marks
+	/// subsystems with TickProfileScope, whose time is accumulated exclusively, so a nested zone
+	/// pauses the zone around it. Zone time spent between two ticks, like timer callbacks, is
+	/// accounted to the next tick, since it uses up the same update budget.
+	///
+	/// Zones report to the profiler which has been activated for the current thread. If none
+	/// is active, a zone costs a single pointer comparison.
+	class TickProfiler final
+	{
+	private:
+
+		TickProfiler(const TickProfiler &Other) = delete;
+		TickProfiler &operator=(const TickProfiler &Other) = delete;
+
+	public:
+
+		typedef std::chrono::steady_clock Clock;
+
+		/// Number of ticks kept in the rolling histograms.
+		static const size_t HistorySize = 1024;
+
+	public:
+
+		/// @param budget Tick duration in microseconds which should not be exceeded.
+		explicit TickProfiler(UInt32 budget);
+
+		/// Gets the profiler which zones of the current thread report to, or nullptr.
+		static TickProfiler *getActive() { return s_active; }
+		/// Sets the profiler which zones of the current thread report to. nullptr disables profiling.
+		static void setActive(TickProfiler *profiler) { s_active = profiler; }
+
+		/// Starts a new tick.
+		void beginTick();
+		/// Finishes the current tick, records it and logs it if it exceeded the budget.
+		void endTick();
+
+		/// Enters a zone. Returns false if the zone could not be entered, in which case leave
+		/// must not be called.
+		bool enter(TickZone zone);
+		/// Leaves the zone which was entered last.
+		void leave();
+
+		/// Gets the tick budget in microseconds.
+		UInt32 getBudget() const { return m_budget; }
+		/// Gets the number of ticks which exceeded the budget since this profiler was created.
+		UInt64 getSlowTickCount() const { return m_slowTicks; }
+		/// Gets the rolling tick duration histogram.
+		const RollingHistogram &getTicks() const { return m_ticks; }
+		/// Gets the rolling histogram of a zone's time per tick.
+		const RollingHistogram &getZone(TickZone zone) const { return m_zoneHistograms[zone]; }
+		/// Writes the tick and zone histograms as json object.
+		void writeJson(std::ostream &out) const;
+
+	private:
+
+		void addSegment(Clock::time_point now);
+		void logSlowTick(UInt32 duration);
+
+	private:
+
+		static const size_t MaxDepth = 16;
+
+		static thread_local TickProfiler *s_active;
+
+		const UInt32 m_budget;
+		RollingHistogram m_ticks;
+		std::vector<RollingHistogram> m_zoneHistograms;
+		std::array<Clock::duration, tick_zone::Count_> m_zoneTimes;
+		std::array<TickZone, MaxDepth> m_stack;
+		size_t m_depth;
+		Clock::time_point m_segmentStart;
+		Clock::time_point m_tickStart;
+		Clock::duration m_timeBetweenTicks;
+		bool m_inTick;
+		UInt64 m_slowTicks;
+		Clock::time_point m_lastSlowTickLog;
+		UInt32 m_suppressedSlowTicks;
+	};
+
+	/// Accounts the time until the end of the scope to a zone of the active tick profiler.
+	class TickProfileScope final
+	{
+	private:
+
+		TickProfileScope(const TickProfileScope &Other) = delete;
+		TickProfileScope &operator=(const TickProfileScope &Other) = delete;
+
+	public:
+
+		explicit TickProfileScope(TickZone zone)
+			: m_profiler(TickProfiler::getActive())
+		{
+			if (m_profiler && !m_profiler->enter(zone))
+			{
+				m_profiler = nullptr;
+			}
+		}
+		~TickProfileScope()
+		{
+			if (m_profiler)
+			{
+				m_profiler->leave();
+			}
+		}
+
+	private:
+
+		TickProfiler *m_profiler;
+	};
+}
@@ -23,6 +23,7 @@
 #include "timer_queue.h"
 #include "macros.h"
 #include "clock.h"
+#include "tick_profiler.h"
 
 namespace wowpp
 {
@@ -42,6 +43,22 @@ namespace wowpp
 		setTimer();
 	}
 
+	void TimerQueue::processEvents()
+	{
+		m_timer.cancel();
+		m_timerTime.reset();
+
+		const auto now = getNow();
+		while (!m_queue.empty() && now >= m_queue.top().time)
+		{
+			const auto callback = m_queue.top().callback;
+			m_queue.pop();
+
+			TickProfileScope zone(tick_zone::Timers);
+			callback();
+		}
+	}
+
 	void TimerQueue::update(const boost::system::error_code &error)
 	{
 		if (error)
@@ -61,6 +78,8 @@ namespace wowpp
 				//ASSERT(getCurrentTime() >= next.time);
 				const auto callback = next.callback;
 				m_queue.pop();
+
+				TickProfileScope zone(tick_zone::Timers);
 				callback();
 			}
 			else
@@ -73,6 +92,12 @@ namespace wowpp
 
 	void TimerQueue::setTimer()
 	{
+		// Simulated time doesn't pass while waiting, so events are executed by processEvents
+		if (isSimulatedTime())
+		{
+			return;
+		}
+
 		const auto nextEventTime = m_queue.top().time;
 
 		// Is the timer active?
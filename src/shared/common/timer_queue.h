@@ -39,6 +39,9 @@ namespace wowpp
 		explicit TimerQueue(boost::asio::io_service &service);
 		GameTime getNow() const;
 		void addEvent(EventCallback callback, GameTime time);
+		/// Executes all events which are due. Only needed when the game time is simulated (see
+		/// enableSimulatedTime), as the queue can't wait for its events then.
+		void processEvents();
 
 	private:
 
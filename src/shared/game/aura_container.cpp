@@ -453,7 +453,7 @@ namespace wowpp
 			}
 
 			// Restore aura
-			AuraPtr aura = std::make_shared<AuraSpellSlot>(m_owner.getTimers(), *spellEntry, auraData.itemGuid);
+			AuraPtr aura = std::make_shared<AuraSpellSlot>(m_owner.getTimers(), m_owner.getProject(), *spellEntry, auraData.itemGuid);
 			aura->setOwner(std::static_pointer_cast<GameUnit>(m_owner.shared_from_this()));
 			aura->setInitialDuration(auraData.remainingTime);
 			aura->setStackCount(auraData.stackCount);
@@ -591,7 +591,7 @@ namespace wowpp
 			wowpp::game::OutgoingPacket packet(sink);
 			wowpp::game::server_write::spellDamageShield(packet, m_target.getGuid(), attacker->getGuid(), m_spellSlot.getSpell().id(), m_basePoints, m_spellSlot.getSpell().schoolmask());
 
-			forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+			forEachSubscriberInSightOf(world->getGrid(), tileIndex, attacker->getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 			{
 				subscriber.sendPacket(packet, buffer);
 			});
@@ -719,7 +719,7 @@ namespace wowpp
 			wowpp::game::OutgoingPacket healPacket(healSink);
 			game::server_write::spellHealLog(healPacket, m_caster->getGuid(), (m_caster ? m_caster->getGuid() : 0), m_spellSlot.getSpell().id(), damage, false);
 
-			forEachSubscriberInSight(world->getGrid(), tileIndex, [&](ITileSubscriber & subscriber)
+			forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&](ITileSubscriber & subscriber)
 			{
 				subscriber.sendPacket(packet, buffer);
 				subscriber.sendPacket(healPacket, healBuffer);
@@ -819,7 +819,7 @@ namespace wowpp
 					wowpp::game::OutgoingPacket packet(sink);
 					game::server_write::periodicAuraLog(packet, m_target.getGuid(), (m_caster ? m_caster->getGuid() : 0), spell.id(), m_effect.aura(), damage, school, absorbed, resisted);
 
-					forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+					forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
 					});
@@ -882,7 +882,7 @@ namespace wowpp
 					wowpp::game::OutgoingPacket packet(sink);
 					game::server_write::periodicAuraLog(packet, m_target.getGuid(), (m_caster ? m_caster->getGuid() : 0), spell.id(), m_effect.aura(), powerType, power);
 
-					forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+					forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
 					});
@@ -917,7 +917,7 @@ namespace wowpp
 					wowpp::game::OutgoingPacket packet(sink);
 					game::server_write::periodicAuraLog(packet, m_target.getGuid(), (m_caster ? m_caster->getGuid() : 0), spell.id(), m_effect.aura(), heal);
 
-					forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+					forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
 					});
@@ -956,7 +956,7 @@ namespace wowpp
 					wowpp::game::OutgoingPacket packet(sink);
 					game::server_write::periodicAuraLog(packet, m_target.getGuid(), (m_caster ? m_caster->getGuid() : 0), spell.id(), m_effect.aura(), 0, value);
 
-					forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+					forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
 					});
@@ -1001,7 +1001,7 @@ namespace wowpp
 					wowpp::game::OutgoingPacket packet(sink);
 					game::server_write::periodicAuraLog(packet, m_target.getGuid(), (m_caster ? m_caster->getGuid() : 0), spell.id(), m_effect.aura(), value);
 
-					forEachSubscriberInSight(world->getGrid(), tileIndex, [&packet, &buffer](ITileSubscriber & subscriber)
+					forEachSubscriberInSightOf(world->getGrid(), tileIndex, m_target.getGuid(), [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
 					});
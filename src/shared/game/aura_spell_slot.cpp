@@ -29,8 +29,9 @@
 
 namespace wowpp
 {
-	AuraSpellSlot::AuraSpellSlot(TimerQueue &timers, const proto::SpellEntry &spell, UInt64 itemGuid/* = 0*/)
+	AuraSpellSlot::AuraSpellSlot(TimerQueue &timers, proto::Project &project, const proto::SpellEntry &spell, UInt64 itemGuid/* = 0*/)
 		: m_applied(false)
+		, m_project(project)
 		, m_spell(spell)
 		, m_itemGuid(itemGuid)
 		, m_totalDuration(0)
@@ -23,6 +23,7 @@
 
 #include "common/typedefs.h"
 #include "common/countdown.h"
+#include "shared/proto_data/project_reference.h"
 
 namespace wowpp
 {
@@ -60,7 +61,8 @@ namespace wowpp
 	public:
 
 		/// Creates a new, empty aura spell slot.
-		explicit AuraSpellSlot(TimerQueue &timers, const proto::SpellEntry &spell, UInt64 itemGuid = 0);
+		/// @param project The project which owns the spell entry. It is kept alive as long as this slot exists.
+		explicit AuraSpellSlot(TimerQueue &timers, proto::Project &project, const proto::SpellEntry &spell, UInt64 itemGuid = 0);
 		virtual ~AuraSpellSlot();
 
 		/// Applies all aura effects. After calling this method, aura effects may not
@@ -156,6 +158,9 @@ namespace wowpp
 		std::array<AuraEffectPtr, MaxAuraEffects> m_effects;
 		std::shared_ptr<GameUnit> m_owner;
 		std::weak_ptr<GameUnit> m_caster;
+		/// Auras may outlive the object which cast them, and with it the last reference to the
+		/// project snapshot their spell entry belongs to.
+		proto::ProjectReference m_project;
 		const proto::SpellEntry &m_spell;
 		UInt64 m_itemGuid;
 		Int32 m_totalDuration;
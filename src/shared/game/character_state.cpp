@@ -0,0 +1,301 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "character_state.h"
+
+namespace wowpp
+{
+	const UInt8 CharacterState::Version = 1;
+	const size_t CharacterState::MaxSerializedSize = 16777215;
+
+	CharacterState::CharacterState()
+	{
+		exploredZones.fill(0);
+	}
+
+	void CharacterState::capture(const GameCharacter &character)
+	{
+		for (size_t i = 0; i < exploredZones.size(); ++i)
+		{
+			exploredZones[i] = character.getUInt32Value(character_fields::ExploredZones_1 + i);
+		}
+
+		auras = character.getAuraData();
+
+		// Cooldowns are kept as end times in memory, but only the remaining time is meaningful
+		// after the server was restarted
+		cooldowns.clear();
+		for (const auto &pair : character.getCooldowns())
+		{
+			const UInt32 remaining = character.getCooldown(pair.first);
+			if (remaining > 0)
+			{
+				cooldowns.emplace_back(pair.first, remaining);
+			}
+		}
+
+		quests = character.getQuests();
+	}
+
+	void CharacterState::apply(GameCharacter &character) const
+	{
+		for (size_t i = 0; i < exploredZones.size(); ++i)
+		{
+			character.setUInt32Value(character_fields::ExploredZones_1 + i, exploredZones[i]);
+		}
+
+		character.getAuraData() = auras;
+
+		for (const auto &cooldown : cooldowns)
+		{
+			character.setCooldown(cooldown.first, cooldown.second);
+		}
+
+		for (const auto &pair : quests)
+		{
+			character.setQuestData(pair.first, pair.second);
+		}
+	}
+
+	namespace
+	{
+		template <class F>
+		void writeSection(io::Writer &w, CharacterState::Section section, F writePayload)
+		{
+			w << io::write<NetUInt8>(static_cast<UInt8>(section));
+
+			// The payload size is patched in once the payload has been written
+			const size_t sizePos = w.sink().position();
+			w << io::write<NetUInt32>(0);
+			writePayload();
+			w.writePOD(sizePos, static_cast<UInt32>(w.sink().position() - sizePos - sizeof(UInt32)));
+		}
+
+		void readExploredZones(io::Reader &r, CharacterState::ExploredZoneArray &out_zones)
+		{
+			UInt8 count = 0;
+			r >> io::read<NetUInt8>(count);
+			for (UInt8 i = 0; i < count && r; ++i)
+			{
+				UInt32 zone = 0;
+				r >> io::read<NetUInt32>(zone);
+				if (i < out_zones.size())
+				{
+					out_zones[i] = zone;
+				}
+			}
+		}
+
+		void readAuras(io::Reader &r, std::vector<AuraData> &out_auras)
+		{
+			UInt16 count = 0;
+			r >> io::read<NetUInt16>(count);
+			out_auras.resize(count);
+			for (auto &data : out_auras)
+			{
+				if (!(r
+					>> io::read<NetUInt64>(data.casterGuid)
+					>> io::read<NetUInt64>(data.itemGuid)
+					>> io::read<NetUInt32>(data.spell)
+					>> io::read<NetUInt32>(data.stackCount)
+					>> io::read<NetUInt32>(data.remainingCharges)
+					>> io::read_range(data.basePoints)
+					>> io::read_range(data.periodicTime)
+					>> io::read<NetUInt32>(data.maxDuration)
+					>> io::read<NetUInt32>(data.remainingTime)
+					>> io::read<NetUInt32>(data.effectIndexMask)))
+				{
+					return;
+				}
+			}
+		}
+
+		void readCooldowns(io::Reader &r, CharacterState::CooldownList &out_cooldowns)
+		{
+			UInt16 count = 0;
+			r >> io::read<NetUInt16>(count);
+			out_cooldowns.resize(count);
+			for (auto &cooldown : out_cooldowns)
+			{
+				if (!(r
+					>> io::read<NetUInt32>(cooldown.first)
+					>> io::read<NetUInt32>(cooldown.second)))
+				{
+					return;
+				}
+			}
+		}
+
+		void readQuests(io::Reader &r, CharacterState::QuestMap &out_quests)
+		{
+			UInt16 count = 0;
+			r >> io::read<NetUInt16>(count);
+			out_quests.clear();
+			for (UInt16 i = 0; i < count; ++i)
+			{
+				UInt32 questId = 0;
+				QuestStatusData data;
+				if (!(r
+					>> io::read<NetUInt32>(questId)
+					>> io::read<NetUInt8>(data.status)
+					>> io::read<NetUInt64>(data.expiration)
+					>> io::read<NetUInt8>(data.explored)
+					>> io::read_range(data.creatures)
+					>> io::read_range(data.objects)
+					>> io::read_range(data.items)))
+				{
+					return;
+				}
+
+				out_quests[questId] = data;
+			}
+		}
+	}
+
+	io::Writer &operator<<(io::Writer &w, CharacterState const &state)
+	{
+		w << io::write<NetUInt8>(CharacterState::Version);
+
+		writeSection(w, CharacterState::Section::ExploredZones, [&w, &state]()
+		{
+			w << io::write<NetUInt8>(state.exploredZones.size());
+			for (const auto &zone : state.exploredZones)
+			{
+				w << io::write<NetUInt32>(zone);
+			}
+		});
+
+		writeSection(w, CharacterState::Section::Auras, [&w, &state]()
+		{
+			w << io::write<NetUInt16>(state.auras.size());
+			for (const auto &data : state.auras)
+			{
+				w
+					<< io::write<NetUInt64>(data.casterGuid)
+					<< io::write<NetUInt64>(data.itemGuid)
+					<< io::write<NetUInt32>(data.spell)
+					<< io::write<NetUInt32>(data.stackCount)
+					<< io::write<NetUInt32>(data.remainingCharges)
+					<< io::write_range(data.basePoints)
+					<< io::write_range(data.periodicTime)
+					<< io::write<NetUInt32>(data.maxDuration)
+					<< io::write<NetUInt32>(data.remainingTime)
+					<< io::write<NetUInt32>(data.effectIndexMask);
+			}
+		});
+
+		writeSection(w, CharacterState::Section::Cooldowns, [&w, &state]()
+		{
+			w << io::write<NetUInt16>(state.cooldowns.size());
+			for (const auto &cooldown : state.cooldowns)
+			{
+				w
+					<< io::write<NetUInt32>(cooldown.first)
+					<< io::write<NetUInt32>(cooldown.second);
+			}
+		});
+
+		writeSection(w, CharacterState::Section::Quests, [&w, &state]()
+		{
+			w << io::write<NetUInt16>(state.quests.size());
+			for (const auto &pair : state.quests)
+			{
+				w
+					<< io::write<NetUInt32>(pair.first)
+					<< io::write<NetUInt8>(pair.second.status)
+					<< io::write<NetUInt64>(pair.second.expiration)
+					<< io::write<NetUInt8>(pair.second.explored)
+					<< io::write_range(pair.second.creatures)
+					<< io::write_range(pair.second.objects)
+					<< io::write_range(pair.second.items);
+			}
+		});
+
+		return w;
+	}
+
+	io::Reader &operator>>(io::Reader &r, CharacterState &state)
+	{
+		UInt8 version = 0;
+		if (!(r >> io::read<NetUInt8>(version)))
+		{
+			return r;
+		}
+
+		if (version == 0 || version > CharacterState::Version)
+		{
+			r.setFailure();
+			return r;
+		}
+
+		io::ISource &source = *r.getSource();
+		while (source.position() < source.size())
+		{
+			UInt8 tag = 0;
+			UInt32 size = 0;
+			if (!(r
+				>> io::read<NetUInt8>(tag)
+				>> io::read<NetUInt32>(size)))
+			{
+				return r;
+			}
+
+			const size_t end = source.position() + size;
+			if (end > source.size())
+			{
+				r.setFailure();
+				return r;
+			}
+
+			switch (static_cast<CharacterState::Section>(tag))
+			{
+				case CharacterState::Section::ExploredZones:
+					readExploredZones(r, state.exploredZones);
+					break;
+				case CharacterState::Section::Auras:
+					readAuras(r, state.auras);
+					break;
+				case CharacterState::Section::Cooldowns:
+					readCooldowns(r, state.cooldowns);
+					break;
+				case CharacterState::Section::Quests:
+					readQuests(r, state.quests);
+					break;
+				default:
+					// Section written by a newer version, skip it
+					break;
+			}
+
+			// A section may not read past its own end
+			if (!r || source.position() > end)
+			{
+				r.setFailure();
+				return r;
+			}
+
+			source.seek(end);
+		}
+
+		return r;
+	}
+}
@@ -0,0 +1,79 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "binary_io/reader.h"
+#include "binary_io/writer.h"
+#include "aura_container.h"
+#include "game_character.h"
+
+namespace wowpp
+{
+	/// Per-character state which is stored as one versioned binary blob in the `state` column
+	/// of the character table, instead of spreading it across several relational tables.
+	/// 
+	/// The blob starts with a version byte, followed by a list of sections. Every section
+	/// is prefixed by a one byte tag and its payload size, so readers skip sections they
+	/// don't know and data which newer writers appended to a known section.
+	struct CharacterState final
+	{
+		/// Current blob format version. Blobs with a higher version are rejected.
+		static const UInt8 Version;
+		/// Maximum size of a serialized state, which is the capacity of the MEDIUMBLOB column.
+		/// Larger blobs must not be saved, as MySQL would reject or truncate them.
+		static const size_t MaxSerializedSize;
+
+		/// Section tags. Never reuse or renumber a tag once blobs using it have been saved.
+		enum class Section : UInt8
+		{
+			/// Explored zone bit mask fields.
+			ExploredZones = 1,
+			/// Active auras which are restored on login.
+			Auras = 2,
+			/// Remaining spell cooldowns in milliseconds.
+			Cooldowns = 3,
+			/// Quest log and quest progress.
+			Quests = 4,
+		};
+
+		typedef std::array<UInt32, 64> ExploredZoneArray;
+		typedef std::vector<std::pair<UInt32, UInt32>> CooldownList;
+		typedef std::map<UInt32, QuestStatusData> QuestMap;
+
+		ExploredZoneArray exploredZones;
+		std::vector<AuraData> auras;
+		CooldownList cooldowns;
+		QuestMap quests;
+
+		CharacterState();
+
+		/// Copies the state of a character.
+		void capture(const GameCharacter &character);
+		/// Restores this state on a character which is being loaded.
+		void apply(GameCharacter &character) const;
+	};
+
+	io::Writer &operator << (io::Writer &w, CharacterState const &state);
+	io::Reader &operator >> (io::Reader &r, CharacterState &state);
+}
@@ -32,6 +32,7 @@
 #include "game_protocol/game_protocol.h"
 #include "each_tile_in_sight.h"
 #include "common/constants.h"
+#include "common/tick_profiler.h"
 #include "log/default_log_levels.h"
 #include "unit_mover.h"
 
@@ -152,9 +153,10 @@ namespace wowpp
 			game::Protocol::OutgoingPacket packet(sink);
 			game::server_write::aiReaction(packet, controlled.getGuid(), 2);
 
-			forEachSubscriberInSight(
+			forEachSubscriberInSightOf(
 			    controlled.getWorldInstance()->getGrid(),
 			    tile,
+			    controlled.getGuid(),
 			    [&packet, &buffer](ITileSubscriber & subscriber)
 			{
 				subscriber.sendPacket(packet, buffer);
@@ -417,6 +419,8 @@ namespace wowpp
 
 	void CreatureAICombatState::updateVictim()
 	{
+		TickProfileScope zone(tick_zone::CreatureAI);
+
 		GameCreature &controlled = getControlled();
 		if (!controlled.canAutoAttack())
 		{
@@ -508,6 +512,8 @@ namespace wowpp
 
 	void CreatureAICombatState::chooseNextAction()
 	{
+		TickProfileScope zone(tick_zone::CreatureAI);
+
 		GameCreature &controlled = getControlled();
 		if (!controlled.isCombatMovementEnabled())
 		{
@@ -958,6 +964,8 @@ namespace wowpp
 	}
 	void CreatureAICombatState::onControlledMoved()
 	{
+		TickProfileScope zone(tick_zone::CreatureAI);
+
 		if (!getControlled().isCombatMovementEnabled())
 		{
 			return;
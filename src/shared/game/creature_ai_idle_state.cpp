@@ -28,6 +28,7 @@
 #include "unit_finder.h"
 #include "unit_mover.h"
 #include "universe.h"
+#include "common/tick_profiler.h"
 #include "log/default_log_levels.h"
 
 namespace wowpp
@@ -210,6 +211,8 @@ namespace wowpp
 
 	void CreatureAIIdleState::onControlledMoved()
 	{
+		TickProfileScope zone(tick_zone::CreatureAI);
+
 		if (m_aggroWatcher)
 		{
 			auto now = getCurrentTime();
@@ -226,6 +229,8 @@ namespace wowpp
 
 	void CreatureAIIdleState::onChooseNextMove()
 	{
+		TickProfileScope zone(tick_zone::CreatureAI);
+
 		const float dist = 15.0f;
 		const auto &loc = getAI().getHome().position;
 		const Circle clipping(loc.x, loc.y, dist);
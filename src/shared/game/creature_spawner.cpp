@@ -38,8 +38,8 @@ namespace wowpp
 	    const proto::UnitEntry &entry,
 		const proto::UnitSpawnEntry &spawnEntry)
 		: m_world(world)
-		, m_entry(entry)
-		, m_spawnEntry(spawnEntry)
+		, m_entry(&entry)
+		, m_spawnEntry(&spawnEntry)
 		, m_active(spawnEntry.isactive())
 		, m_respawn(spawnEntry.respawn())
 		, m_currentlySpawned(0)
@@ -48,7 +48,7 @@ namespace wowpp
 	{
 		if (m_active)
 		{
-			for (size_t i = 0; i < m_spawnEntry.maxcount(); ++i)
+			for (size_t i = 0; i < m_spawnEntry->maxcount(); ++i)
 			{
 				spawnOne();
 			}
@@ -65,32 +65,32 @@ namespace wowpp
 	void CreatureSpawner::spawnOne()
 	{
 		// TODO: Generate random point and if needed, random rotation
-		const math::Vector3 location(m_spawnEntry.positionx(), m_spawnEntry.positiony(), m_spawnEntry.positionz());
-		const float o = m_spawnEntry.rotation();
+		const math::Vector3 location(m_spawnEntry->positionx(), m_spawnEntry->positiony(), m_spawnEntry->positionz());
+		const float o = m_spawnEntry->rotation();
 
 		// Spawn a new creature
-		auto spawned = m_world.spawnCreature(m_entry, location, o, m_spawnEntry.radius());
+		auto spawned = m_world.spawnCreature(*m_entry, location, o, m_spawnEntry->radius());
 		spawned->setRandomPointGenerator(std::bind(&CreatureSpawner::randomPoint, this));
-		spawned->setFloatValue(object_fields::ScaleX, m_entry.scale());
-		if (m_spawnEntry.defaultemote() != 0)
+		spawned->setFloatValue(object_fields::ScaleX, m_entry->scale());
+		if (m_spawnEntry->defaultemote() != 0)
 		{
-			spawned->setUInt32Value(unit_fields::NpcEmoteState, m_spawnEntry.defaultemote());
+			spawned->setUInt32Value(unit_fields::NpcEmoteState, m_spawnEntry->defaultemote());
 		}
 		spawned->clearUpdateMask();
 		
 		game::CreatureMovement movement = game::creature_movement::None;
-		if (m_spawnEntry.movement() >= game::creature_movement::Invalid)
+		if (m_spawnEntry->movement() >= game::creature_movement::Invalid)
 		{
 			WLOG("Invalid movement type for creature spawn - spawn ignored");
 		}
 		else
 		{
-			movement = static_cast<game::CreatureMovement>(m_spawnEntry.movement());
+			movement = static_cast<game::CreatureMovement>(m_spawnEntry->movement());
 		}
 		spawned->setMovementType(movement);
 		
 		// Update stand state
-		spawned->setStandState(static_cast<UnitStandState>(m_spawnEntry.standstate()));
+		spawned->setStandState(static_cast<UnitStandState>(m_spawnEntry->standstate()));
 
 		// watch for destruction
 		spawned->destroy = std::bind(&CreatureSpawner::onRemoval, this, std::placeholders::_1);
@@ -127,13 +127,13 @@ namespace wowpp
 
 	void CreatureSpawner::setRespawnTimer()
 	{
-		if (m_currentlySpawned >= m_spawnEntry.maxcount())
+		if (m_currentlySpawned >= m_spawnEntry->maxcount())
 		{
 			return;
 		}
 
 		m_respawnCountdown.setEnd(
-		    getCurrentTime() + m_spawnEntry.respawndelay());
+		    getCurrentTime() + m_spawnEntry->respawndelay());
 	}
 
 	const math::Vector3 & CreatureSpawner::randomPoint()
@@ -150,13 +150,20 @@ namespace wowpp
 		return m_location;
 	}
 
+	void CreatureSpawner::setEntries(const proto::UnitEntry &entry, const proto::UnitSpawnEntry &spawnEntry)
+	{
+		m_entry = &entry;
+		m_spawnEntry = &spawnEntry;
+		m_location = math::Vector3(spawnEntry.positionx(), spawnEntry.positiony(), spawnEntry.positionz());
+	}
+
 	void CreatureSpawner::setState(bool active)
 	{
 		if (m_active != active)
 		{
 			if (active && !m_currentlySpawned)
 			{
-				for (size_t i = 0; i < m_spawnEntry.maxcount(); ++i)
+				for (size_t i = 0; i < m_spawnEntry->maxcount(); ++i)
 				{
 					spawnOne();
 				}
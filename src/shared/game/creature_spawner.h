@@ -79,6 +79,9 @@ namespace wowpp
 		void setRespawn(bool enabled);
 		/// Gets a random movement point in the spawn radius.
 		const math::Vector3 &randomPoint();
+		/// Points this spawner to entries of another project snapshot. Creatures which are already
+		/// spawned keep their current data, new spawns will use the new entries.
+		void setEntries(const proto::UnitEntry &entry, const proto::UnitSpawnEntry &spawnEntry);
 
 	private:
 
@@ -94,8 +97,8 @@ namespace wowpp
 	private:
 
 		WorldInstance &m_world;
-		const proto::UnitEntry &m_entry;
-		const proto::UnitSpawnEntry &m_spawnEntry;
+		const proto::UnitEntry *m_entry;
+		const proto::UnitSpawnEntry *m_spawnEntry;
 		bool m_active;
 		bool m_respawn;
 		size_t m_currentlySpawned;
@@ -99,6 +99,28 @@ namespace wowpp
 		    onSubscriber);
 	}
 
+	/// Like forEachSubscriberInSight, but skips subscribers which are still waiting for the
+	/// create block of the given object, as their client doesn't know its guid yet. Use this
+	/// for every packet about a single object.
+	template <class OnSubscriber>
+	void forEachSubscriberInSightOf(
+	    VisibilityGrid &grid,
+	    const TileIndex2D &center,
+	    UInt64 guid,
+	    const OnSubscriber &onSubscriber)
+	{
+		forEachSubscriberInSight(
+		    grid,
+		    center,
+		    [guid, &onSubscriber](ITileSubscriber & subscriber)
+		{
+			if (!subscriber.isSpawnPending(guid))
+			{
+				onSubscriber(subscriber);
+			}
+		});
+	}
+
 	static inline bool isInSight(
 	    const TileIndex2D &first,
 	    const TileIndex2D &second)
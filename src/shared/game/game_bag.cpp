@@ -26,7 +26,7 @@
 namespace wowpp
 {
 	GameBag::GameBag(proto::Project &project, const proto::ItemEntry &entry)
-		: GameItem(project, entry)
+		: GameItem(project, entry, bag_fields::BagFieldCount)
 	{
 		// Resize values field
 		m_values.resize(bag_fields::BagFieldCount, 0);
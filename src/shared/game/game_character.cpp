@@ -42,7 +42,7 @@ namespace wowpp
 	GameCharacter::GameCharacter(
 	    proto::Project &project,
 	    TimerQueue &timers)
-		: GameUnit(project, timers)
+		: GameUnit(project, timers, character_fields::CharacterFieldCount)
 		, m_name("UNKNOWN")
 		, m_zoneIndex(0)
 		, m_weaponProficiency(0)
@@ -3082,6 +3082,29 @@ namespace wowpp
 		return value;
 	}
 
+	bool GameCharacter::getReactionOverride(const proto::FactionTemplateEntry &faction, bool &out_hostile, bool &out_friendly) const
+	{
+		// Forced reactions (for example by spells) take precedence over reputation
+		const auto forcedIt = m_forcedReactions.find(faction.faction());
+		if (forcedIt != m_forcedReactions.end())
+		{
+			out_hostile = (forcedIt->second <= game::reputation_rank::Hostile);
+			out_friendly = (forcedIt->second >= game::reputation_rank::Friendly);
+			return true;
+		}
+
+		// Factions the player declared war on are hostile
+		const auto stateIt = m_factions.find(faction.faction());
+		if (stateIt != m_factions.end() && (stateIt->second.flags & game::faction_flags::AtWar) != 0)
+		{
+			out_hostile = true;
+			out_friendly = false;
+			return true;
+		}
+
+		return false;
+	}
+
 	UInt32 GameCharacter::getDefenseSkillValue(const GameUnit &attacker) const 
 	{
 		// In case of failure of getSkillValue, initialize these
@@ -676,31 +676,31 @@ namespace wowpp
 		// Signals
 
 		/// Fired when a proficiency was changes (weapon & armor prof.)
-		simple::signal<void(Int32, UInt32)> proficiencyChanged;
+		LazySignal<void(Int32, UInt32)> proficiencyChanged;
 		/// Fired when an inventory error occurred. Used to send a packet to the owning players client.
-		simple::signal<void(game::InventoryChangeFailure, GameItem *, GameItem *)> inventoryChangeFailure;
+		LazySignal<void(game::InventoryChangeFailure, GameItem *, GameItem *)> inventoryChangeFailure;
 		/// Fired when an item was added to the inventory that the players client needs to notified of.
-		simple::signal<void(UInt16, UInt16, bool, bool)> itemAdded;
+		LazySignal<void(UInt16, UInt16, bool, bool)> itemAdded;
 		/// Fired when the characters combo points changes. Used to send a packet to the owning players client.
-		simple::signal<void()> comboPointsChanged;
+		LazySignal<void()> comboPointsChanged;
 		/// Fired when the character gained some experience points. Used to send a packet to the owning players client.
-		simple::signal<void(UInt64, UInt32, UInt32)> experienceGained;
+		LazySignal<void(UInt64, UInt32, UInt32)> experienceGained;
 		/// Fired when the characters home changed. Used to send a packet to the owning players client.
-		simple::signal<void()> homeChanged;
+		LazySignal<void()> homeChanged;
 		/// Fired when a quest status changed. Used to save quest status at the realm.
-		simple::signal<void(UInt32 questId, const QuestStatusData & data)> questDataChanged;
+		LazySignal<void(UInt32 questId, const QuestStatusData & data)> questDataChanged;
 		/// Fired when a kill credit for a specific quest was made. Used to send a packet to the owning players client.
-		simple::signal<void(const proto::QuestEntry &, UInt64 guid, UInt32 entry, UInt32 count, UInt32 total)> questKillCredit;
+		LazySignal<void(const proto::QuestEntry &, UInt64 guid, UInt32 entry, UInt32 count, UInt32 total)> questKillCredit;
 		/// Fired when the character want to inspect loot of an object. Used to send packets to the owning players client.
-		simple::signal<void(std::shared_ptr<LootInstance>)> lootinspect;
+		LazySignal<void(std::shared_ptr<LootInstance>)> lootinspect;
 		/// Fired when a spell mod was applied or misapplied on the character. Used to send packets to the owning players client.
-		simple::signal<void(SpellModType, UInt8, SpellModOp, Int32)> spellModChanged;
+		LazySignal<void(SpellModType, UInt8, SpellModOp, Int32)> spellModChanged;
 		/// Fired when the character interacts with a game object.
-		simple::signal<void(WorldObject &)> objectInteraction;
+		LazySignal<void(WorldObject &)> objectInteraction;
 		/// Fired when a new spell was learned.
-		simple::signal<void(const proto::SpellEntry &)> spellLearned;
+		LazySignal<void(const proto::SpellEntry &)> spellLearned;
 		/// Fired when resurrection is requested by a spell. Used to send a packet to the owning players client.
-		simple::signal<void(UInt64, const String&, UInt8)> resurrectRequested;
+		LazySignal<void(UInt64, const String&, UInt8)> resurrectRequested;
 
 	public:
 
@@ -785,6 +785,8 @@ namespace wowpp
 		virtual UInt32 getWeaponSkillValue(game::WeaponAttack attackType, const GameUnit &target) const override;
 		/// @copydoc GameUnit::getDefenseSkillValue
 		virtual UInt32 getDefenseSkillValue(const GameUnit &attacker) const override;
+		/// @copydoc GameUnit::getReactionOverride
+		virtual bool getReactionOverride(const proto::FactionTemplateEntry &faction, bool &out_hostile, bool &out_friendly) const override;
 
 	private:
 
@@ -889,6 +891,8 @@ namespace wowpp
 		/// Gets the current status of a given quest by its id.
 		/// @returns Quest status.
 		game::QuestStatus getQuestStatus(UInt32 quest) const;
+		/// Gets the status data of all quests this character knows about.
+		const std::map<UInt32, QuestStatusData> &getQuests() const { return m_quests; }
 		/// Accepts a new quest.
 		/// @returns false if this wasn't possible (maybe questlog was full or not all requirements are met).
 		bool acceptQuest(UInt32 quest);
@@ -49,7 +49,7 @@ namespace wowpp
 
 		/// Executed when the unit entry was changed after this creature has spawned. This
 		/// can happen if the unit transforms.
-		simple::signal<void()> entryChanged;
+		LazySignal<void()> entryChanged;
 
 	public:
 
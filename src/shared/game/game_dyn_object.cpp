@@ -41,7 +41,7 @@ namespace wowpp
 		GameUnit &caster,
 		const proto::SpellEntry &entry,
 		const proto::SpellEffect &effect)
-		: GameObject(project)
+		: GameObject(project, dyn_object_fields::DynObjectFieldCount)
 		, m_timers(timers)
 		, m_caster(caster)
 		, m_entry(entry)
@@ -165,7 +165,7 @@ namespace wowpp
 				auto &universe = world->getUniverse();
 
 				// Create an aura spell slot
-				auto auraSlot = std::make_shared<AuraSpellSlot>(universe.getTimers(), m_entry);
+				auto auraSlot = std::make_shared<AuraSpellSlot>(universe.getTimers(), getProject(), m_entry);
 				auraSlot->setOwner(std::static_pointer_cast<GameUnit>(target.shared_from_this()));
 				auraSlot->setCaster(std::static_pointer_cast<GameUnit>(m_caster.shared_from_this()));
 
@@ -26,8 +26,8 @@
 
 namespace wowpp
 {
-	GameItem::GameItem(proto::Project &project, const proto::ItemEntry &entry)
-		: GameObject(project)
+	GameItem::GameItem(proto::Project &project, const proto::ItemEntry &entry, size_t fieldCount)
+		: GameObject(project, fieldCount)
 		, m_entry(entry)
 	{
 		// Resize values field
@@ -67,7 +67,7 @@ namespace wowpp
 	public:
 
 		///
-		explicit GameItem(proto::Project &project, const proto::ItemEntry &entry);
+		explicit GameItem(proto::Project &project, const proto::ItemEntry &entry, size_t fieldCount = item_fields::ItemFieldCount);
 		~GameItem();
 
 		virtual void initialize() override;
@@ -31,11 +31,31 @@
 #include "visibility_tile.h"
 #include "world_instance.h"
 #include "proto_data/project.h"
+#include "update_field_visibility.h"
+#ifdef _MSC_VER
+#	include <intrin.h>
+#endif
 
 namespace wowpp
 {
-	GameObject::GameObject(proto::Project &project)
+	namespace
+	{
+		/// Gets the index of the lowest set bit in a non-zero value.
+		inline UInt32 countTrailingZeros(UInt32 value)
+		{
+#ifdef _MSC_VER
+			unsigned long index = 0;
+			_BitScanForward(&index, value);
+			return static_cast<UInt32>(index);
+#else
+			return static_cast<UInt32>(__builtin_ctz(value));
+#endif
+		}
+	}
+
+	GameObject::GameObject(proto::Project &project, size_t fieldCount)
 		: m_project(project)
+		, m_projectReference(project)
 		, m_mapId(0)
 		, m_o(0.0f)
 		, m_lastFiredO(0.0f)
@@ -44,6 +64,8 @@ namespace wowpp
 		, m_updated(false)
 		, m_worldInstance(nullptr)
 	{
+		m_values.reserve(fieldCount);
+		m_valueBitset.reserve((fieldCount + 31) / 32);
 		m_values.resize(object_fields::ObjectFieldCount, 0);
 		m_valueBitset.resize((object_fields::ObjectFieldCount + 31) / 32, 0);
 	}
@@ -555,9 +577,16 @@ namespace wowpp
 	void GameObject::writeValueUpdateBlock(io::Writer &writer, GameCharacter &receiver, bool creation /*= true*/) const
 	{
 		// Number of UInt32 blocks used to represent all values as one bit
-		UInt8 blockCount = m_valueBitset.size();
+		const size_t blockCount = m_valueBitset.size();
 		writer
-		        << io::write<NetUInt8>(blockCount);
+		        << io::write<NetUInt8>(static_cast<UInt8>(blockCount));
+
+		// Mask of fields which may be sent to this receiver (nullptr: all fields)
+		const UInt32 *visibleMask = getUpdateFieldMask(getTypeId(), getUpdateFieldVisibility(receiver));
+
+		// Bits of all values which will be written (fixed size to avoid heap allocations)
+		std::array<UInt32, (character_fields::CharacterFieldCount + 31) / 32> bits;
+		ASSERT(blockCount <= bits.size());
 
 		if (creation)
 		{
@@ -566,51 +595,86 @@ namespace wowpp
 			// Create a new bitset which has set all bits to one where the field value
 			// isn't equal to 0, since this will be for a CREATE_OBJECT block (spawn) and not
 			// for an UPDATE_OBJECT block
-			std::vector<UInt32> creationBits(m_valueBitset.size(), 0);
-			for (size_t i = 0; i < m_values.size(); ++i)
+			for (size_t block = 0; block < blockCount; ++block)
 			{
-				if (m_values[i] ||
-				        (isWorldGO && i == world_object_fields::DynFlags))
-				{
-					// Calculate bit index
-					UInt16 bitIndex = i >> 3;
+				const size_t first = block << 5;
+				const size_t last = std::min(first + 32, m_values.size());
 
-					// Mark bit as changed
-					UInt8 &changed = (reinterpret_cast<UInt8 *>(&creationBits[0]))[bitIndex];
-					changed |= 1 << (i & 0x7);
+				UInt32 word = 0;
+				for (size_t i = first; i < last; ++i)
+				{
+					if (m_values[i] != 0)
+					{
+						word |= (1u << (i & 31));
+					}
 				}
-			}
 
-			// Write only the changed bits
-			writer
-			        << io::write_range(creationBits);
+				bits[block] = word;
+			}
 
-			// Write all values != zero
-			for (size_t i = 0; i < m_values.size(); ++i)
+			if (isWorldGO)
 			{
-				if (m_values[i] != 0 ||
-				        (isWorldGO && i == world_object_fields::DynFlags))
-				{
-					writeUpdateValue(writer, receiver, i);
-				}
+				bits[world_object_fields::DynFlags >> 5] |= (1u << (world_object_fields::DynFlags & 31));
 			}
 		}
 		else
 		{
-			// Write only the changed bits
-			writer
-			        << io::write_range(m_valueBitset);
+			// Use only the changed bits
+			std::copy(m_valueBitset.begin(), m_valueBitset.end(), bits.begin());
+		}
 
-			// Write all values marked as changed
-			for (size_t i = 0; i < m_values.size(); ++i)
+		// Strip all fields the receiver isn't allowed to see
+		if (visibleMask)
+		{
+			for (size_t block = 0; block < blockCount; ++block)
 			{
-				const UInt8 &changed = (reinterpret_cast<const UInt8 *>(&m_valueBitset[0]))[i >> 3];
-				if ((changed & (1 << (i & 0x7))) != 0)
-				{
-					writeUpdateValue(writer, receiver, i);
-				}
+				bits[block] &= visibleMask[block];
 			}
 		}
+
+		writer
+		        << io::write_range(bits.begin(), bits.begin() + blockCount);
+
+		// Write all values marked in the bitset
+		for (size_t block = 0; block < blockCount; ++block)
+		{
+			UInt32 word = bits[block];
+			while (word != 0)
+			{
+				const UInt32 bit = countTrailingZeros(word);
+				writeUpdateValue(writer, receiver, static_cast<UInt16>((block << 5) + bit));
+				word &= (word - 1);
+			}
+		}
+	}
+
+	UpdateFieldVisibility GameObject::getUpdateFieldVisibility(const GameCharacter &receiver) const
+	{
+		// Only units have private fields
+		if (!isCreature() && !isGameCharacter())
+		{
+			return update_field_visibility::Owner;
+		}
+
+		const UInt64 receiverGuid = receiver.getGuid();
+		if (receiverGuid == getGuid() ||
+		        getUInt64Value(unit_fields::SummonedBy) == receiverGuid ||
+		        getUInt64Value(unit_fields::CharmedBy) == receiverGuid ||
+		        getUInt64Value(unit_fields::CreatedBy) == receiverGuid)
+		{
+			return update_field_visibility::Owner;
+		}
+
+		if (isGameCharacter())
+		{
+			const UInt64 groupId = static_cast<const GameCharacter *>(this)->getGroupId();
+			if (groupId != 0 && groupId == receiver.getGroupId())
+			{
+				return update_field_visibility::Party;
+			}
+		}
+
+		return update_field_visibility::Public;
 	}
 
 	void GameObject::clearUpdateMask()
@@ -30,7 +30,9 @@
 #include "tile_index.h"
 #include "math/vector3.h"
 #include "common/macros.h"
+#include "common/lazy_signal.h"
 #include "shared/proto_data/variables.pb.h"
+#include "shared/proto_data/project_reference.h"
 
 namespace wowpp
 {
@@ -217,6 +219,23 @@ namespace wowpp
 
 	typedef object_type::Enum ObjectType;
 
+	namespace update_field_visibility
+	{
+		enum Type
+		{
+			/// Receiver may only see public fields.
+			Public = 0,
+			/// Receiver is in the same group and may also see party fields.
+			Party = 1,
+			/// Receiver owns the object and may see all fields.
+			Owner = 2,
+
+			Count_
+		};
+	}
+
+	typedef update_field_visibility::Type UpdateFieldVisibility;
+
 	// Forwards
 	class VisibilityTile;
 	class WorldInstance;
@@ -242,10 +261,10 @@ namespace wowpp
 	public:
 
 		/// Fired when the object was added to a world instance and spawned.
-		simple::signal<void()> spawned;
+		LazySignal<void()> spawned;
 		/// Fired when the object was removed from a world instance and despawned.
 		/// WARNING: DO NOT DESTROY THE OBJECT HERE, AS MORE SIGNALS MAY BE CONNECTED WHICH WANT TO BE EXECUTED,
-		simple::signal<void(GameObject &)> despawned;
+		LazySignal<void(GameObject &)> despawned;
 		/// Fired when the object should be destroyed. The object should be destroyed after this call.
 		std::function<void(GameObject &)> destroy;
 		/// Fired when the object moved, but before it's tile changed. Note that this will trigger a tile change.
@@ -253,13 +272,15 @@ namespace wowpp
 		/// Fired when a tile change is pending for this object, after it has been moved. Note that at this time,
 		/// the object does not belong to any tile and it's position already points to the new tile.
 		/// First parameter is a reference of the old tile, second references the new tile.
-		simple::signal<void(VisibilityTile &, VisibilityTile &)> tileChangePending;
+		LazySignal<void(VisibilityTile &, VisibilityTile &)> tileChangePending;
 
 	public:
 
 		/// Default constructor.
 		/// @param project Reference to the data project which is used to lookup entries.
-		explicit GameObject(proto::Project &project);
+		/// @param fieldCount Number of value fields of the final object type, so that the value
+		///                   arrays are allocated only once.
+		explicit GameObject(proto::Project &project, size_t fieldCount = object_fields::ObjectFieldCount);
 		/// Destructor provided because of inheritance.
 		virtual ~GameObject();
 
@@ -445,6 +466,8 @@ namespace wowpp
 		/// @param receiver The character of the player who will receive the update packet.
 		/// @param index Index of the field to write.
 		void writeUpdateValue(io::Writer &writer, GameCharacter &receiver, UInt16 index) const;
+		/// Determines which class of fields of this object may be sent to a receiver.
+		UpdateFieldVisibility getUpdateFieldVisibility(const GameCharacter &receiver) const;
 		/// Gets the targets location.
 		const math::Vector3 &getLocation() const {
 			return m_position;
@@ -547,6 +570,8 @@ namespace wowpp
 	protected:
 
 		proto::Project &m_project;		// TODO: Maybe move this, but right now, it's comfortable to use this
+		/// Keeps the project snapshot alive as long as this object references its data.
+		proto::ProjectReference m_projectReference;
 		std::vector<UInt32> m_values;
 		std::vector<UInt32> m_valueBitset;
 		UInt32 m_mapId;
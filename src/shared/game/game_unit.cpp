@@ -44,8 +44,9 @@ namespace wowpp
 
 	GameUnit::GameUnit(
 	    proto::Project &project,
-	    TimerQueue &timers)
-		: GameObject(project)
+	    TimerQueue &timers,
+	    size_t fieldCount)
+		: GameObject(project, fieldCount)
 		, m_timers(timers)
 		, m_raceEntry(nullptr)
 		, m_classEntry(nullptr)
@@ -717,9 +718,10 @@ namespace wowpp
 		game::server_write::attackStart(packet, getGuid(), m_victim->getGuid());
 
 		// Notify all tile subscribers about this event
-		forEachSubscriberInSight(
+		forEachSubscriberInSightOf(
 		    m_worldInstance->getGrid(),
 		    tileIndex,
+		    getGuid(),
 		    [&packet, &buffer](ITileSubscriber & subscriber)
 		{
 			subscriber.sendPacket(packet, buffer);
@@ -759,9 +761,10 @@ namespace wowpp
 		game::server_write::attackStop(packet, getGuid(), m_victim->getGuid());
 
 		// Notify all tile subscribers about this event
-		forEachSubscriberInSight(
+		forEachSubscriberInSightOf(
 		    m_worldInstance->getGrid(),
 		    tileIndex,
+		    getGuid(),
 		    [&packet, &buffer](ITileSubscriber & subscriber)
 		{
 			subscriber.sendPacket(packet, buffer);
@@ -1032,9 +1035,10 @@ namespace wowpp
 					game::server_write::attackStateUpdate(packet, getGuid(), victim->getGuid(), hitInfos[i], totalDamage, absorbed, resisted, blocked, victimStates[i], m_weaponAttack, 1);
 
 					// Notify all tile subscribers about this event
-					forEachSubscriberInSight(
+					forEachSubscriberInSightOf(
 					    m_worldInstance->getGrid(),
 					    tileIndex,
+					    getGuid(),
 					    [&packet, &buffer](ITileSubscriber & subscriber)
 					{
 						subscriber.sendPacket(packet, buffer);
@@ -2856,25 +2860,13 @@ namespace wowpp
 			return true;
 		}
 
-		for (int i = 0; i < m_factionTemplate->enemies_size(); ++i)
+		bool hostile = false, friendly = false;
+		if (getReactionOverride(faction, hostile, friendly))
 		{
-			const auto &enemy = m_factionTemplate->enemies(i);
-			if (enemy && enemy == faction.faction())
-			{
-				return false;
-			}
-		}
-
-		for (int i = 0; i < m_factionTemplate->friends_size(); ++i)
-		{
-			const auto &friendly = m_factionTemplate->friends(i);
-			if (friendly && friendly == faction.faction())
-			{
-				return true;
-			}
+			return friendly;
 		}
 
-		return ((m_factionTemplate->friendmask() & faction.selfmask()) != 0)/* || ((m_factionTemplate->selfmask() & faction.friendmask()) != 0)*/;
+		return m_project.factionReactions.isFriendly(*m_factionTemplate, faction);
 	}
 
 	bool GameUnit::isFriendlyTo(GameUnit &unit) const
@@ -2889,37 +2881,13 @@ namespace wowpp
 			return false;
 		}
 
-		for (int i = 0; i < m_factionTemplate->enemies_size(); ++i)
-		{
-			const auto &enemy = m_factionTemplate->enemies(i);
-			if (enemy && enemy == faction.faction())
-			{
-				return true;
-			}
-		}
-
-		for (int i = 0; i < m_factionTemplate->friends_size(); ++i)
+		bool hostile = false, friendly = false;
+		if (getReactionOverride(faction, hostile, friendly))
 		{
-			const auto &friendly = m_factionTemplate->friends(i);
-			if (friendly && friendly == faction.faction())
-			{
-				return false;
-			}
+			return hostile;
 		}
 
-		if (m_factionTemplate->enemymask() != 0 &&
-			(m_factionTemplate->enemymask() & faction.selfmask()) != 0)
-			return true;
-
-		// Not sure about this check, as it would only mean that the target is hostile against us, but
-		// not that WE are hostile AGAINST IT
-		// This causes some horde npcs, which are displayed as neutral, to attack alliance players and 
-		// vice versa (dark portal in blasted lands, the orc warlord for example).
-		/*if (faction.enemymask() != 0 &&
-			((m_factionTemplate->selfmask() & faction.enemymask()) != 0))
-			return true;*/
-
-		return false;
+		return m_project.factionReactions.isHostile(*m_factionTemplate, faction);
 	}
 
 	bool GameUnit::isHostileTo(const GameUnit &unit) const
@@ -3331,9 +3299,10 @@ namespace wowpp
 
 				const GameUnit* me = this;
 
-				forEachSubscriberInSight(
+				forEachSubscriberInSightOf(
 					m_worldInstance->getGrid(),
 					tileIndex,
+					getGuid(),
 					[&packet, &buffer, me](ITileSubscriber & subscriber)
 				{
 					if (subscriber.getControlledObject() != me)
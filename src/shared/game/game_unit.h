@@ -477,62 +477,62 @@ namespace wowpp
 
 		/// Fired when this unit was killed. Parameter: GameUnit* killer (may be nullptr if killer
 		/// information is not available (for example due to environmental damage))
-		simple::signal<void(GameUnit *)> killed;
+		LazySignal<void(GameUnit *)> killed;
 		/// Fired when an auto attack error occurred. Used in World Node by the Player class to
 		/// send network packets based on the error code.
-		simple::signal<void(AttackSwingError)> autoAttackError;
+		LazySignal<void(AttackSwingError)> autoAttackError;
 		/// Fired when a spell cast error occurred.
-		simple::signal<void(const proto::SpellEntry &, game::SpellCastResult)> spellCastError;
+		LazySignal<void(const proto::SpellEntry &, game::SpellCastResult)> spellCastError;
 		/// Fired when the unit level changed.
 		/// Parameters: Previous Level, Health gained, Mana gained, Stats gained (all 5 stats)
-		simple::signal<void(UInt32, Int32, Int32, Int32, Int32, Int32, Int32, Int32)> levelGained;
+		LazySignal<void(UInt32, Int32, Int32, Int32, Int32, Int32, Int32, Int32)> levelGained;
 		/// Fired when some aura information was updated.
 		/// Parameters: Slot, Spell-ID, Duration (ms), Max Duration (ms)
-		simple::signal<void(UInt8, UInt32, Int32, Int32)> auraUpdated;
+		LazySignal<void(UInt8, UInt32, Int32, Int32)> auraUpdated;
 		/// Fired when some aura information was updated on a target.
 		/// Parameters: Slot, Spell-ID, Duration (ms), Max Duration (ms)
-		simple::signal<void(UInt64, UInt8, UInt32, Int32, Int32)> targetAuraUpdated;
+		LazySignal<void(UInt64, UInt8, UInt32, Int32, Int32)> targetAuraUpdated;
 		/// Fired when the unit should be teleported. This event is only fired when the unit changes world.
 		/// Parameters: Target Map, X, Y, Z, O
-		simple::signal<void(UInt16, math::Vector3, float)> teleport;
+		LazySignal<void(UInt16, math::Vector3, float)> teleport;
 		/// Fired when the units faction changed. This might cause the unit to become friendly to attackers.
-		simple::signal<void(GameUnit &)> factionChanged;
+		LazySignal<void(GameUnit &)> factionChanged;
 		///
-		simple::signal<void(GameUnit &, float)> threatened;
+		LazySignal<void(GameUnit &, float)> threatened;
 		///
-		simple::signal<float(GameUnit &threatener)> getThreat;
+		LazySignal<float(GameUnit &threatener)> getThreat;
 		///
-		simple::signal<void(GameUnit &threatener, float amount)> setThreat;
+		LazySignal<void(GameUnit &threatener, float amount)> setThreat;
 		///
-		simple::signal<GameUnit *()> getTopThreatener;
+		LazySignal<GameUnit *()> getTopThreatener;
 		/// Fired when done an melee attack hit  (include miss/dodge...)
-		simple::signal<void(GameUnit *, game::VictimState)> doneMeleeAttack;
+		LazySignal<void(GameUnit *, game::VictimState)> doneMeleeAttack;
 		/// Fired when hit by a melee attack (include miss/dodge...)
-		simple::signal<void(GameUnit *, game::VictimState)> takenMeleeAttack;
+		LazySignal<void(GameUnit *, game::VictimState)> takenMeleeAttack;
 		/// Fired when hit by any damage.
-		simple::signal<void(GameUnit *, UInt32, game::DamageType)> takenDamage;
+		LazySignal<void(GameUnit *, UInt32, game::DamageType)> takenDamage;
 		/// Fired when this unit was healed by another unit.
-		simple::signal<void(GameUnit *, UInt32)> healed;
+		LazySignal<void(GameUnit *, UInt32)> healed;
 		/// Fired when unit enters water
-		simple::signal<void()> enteredWater;
+		LazySignal<void()> enteredWater;
 		/// Fired when unit started attacking
-		simple::signal<void()> startedAttacking;
+		LazySignal<void()> startedAttacking;
 		/// Fired when unit started active casting (excluding proc)
-		simple::signal<void(const proto::SpellEntry &)> startedCasting;
+		LazySignal<void(const proto::SpellEntry &)> startedCasting;
 		/// Fired when a unit trigger should be executed.
-		simple::signal<void(const proto::TriggerEntry &, GameUnit &, GameUnit *)> unitTrigger;
+		LazySignal<void(const proto::TriggerEntry &, GameUnit &, GameUnit *)> unitTrigger;
 		/// Fired when a unit state changed.
-		simple::signal<void(UInt32, bool)> unitStateChanged;
+		LazySignal<void(UInt32, bool)> unitStateChanged;
 		/// Fired when this unit enters or leaves stealth mode.
-		simple::signal<void(bool)> stealthStateChanged;
+		LazySignal<void(bool)> stealthStateChanged;
 		/// Fired when the movement speed of this unit changes.
-		simple::signal<void(MovementType)> speedChanged;
+		LazySignal<void(MovementType)> speedChanged;
 		/// Fired when a custom cooldown event was rised (for example, "Stealth" cooldown is only fired when stealth ends).
-		simple::signal<void(UInt32)> cooldownEvent;
+		LazySignal<void(UInt32)> cooldownEvent;
 		/// Fired when the units stand state changed.
-		simple::signal<void(UnitStandState)> standStateChanged;
+		LazySignal<void(UnitStandState)> standStateChanged;
 		/// Fired on any proc event (damage done, taken, healed, etc).
-		simple::signal<void(bool, GameUnit *, UInt32, UInt32, const proto::SpellEntry *, UInt32, UInt8, bool)> spellProcEvent;
+		LazySignal<void(bool, GameUnit *, UInt32, UInt32, const proto::SpellEntry *, UInt32, UInt8, bool)> spellProcEvent;
 		/// Fired when the unit expects a client ack.
 		//simple::signal<void(UInt32 opCode, UInt32 counter)> queueClientAck;
 
@@ -541,7 +541,8 @@ namespace wowpp
 		/// Creates a new instance of the GameUnit object, which will still be uninitialized.
 		explicit GameUnit(
 			proto::Project &project,
-			TimerQueue &timers);
+			TimerQueue &timers,
+			size_t fieldCount = unit_fields::UnitFieldCount);
 		virtual ~GameUnit();
 
 		/// @copydoc GameObject::initialize()
@@ -1097,6 +1098,9 @@ namespace wowpp
 		virtual void onThreat(GameUnit &threatener, float amount);
 		/// 
 		virtual void onRegeneration();
+		/// Gets a reaction towards a faction which overrides the precomputed faction template reaction.
+		/// @returns true if out_hostile and out_friendly have been set.
+		virtual bool getReactionOverride(const proto::FactionTemplateEntry &faction, bool &out_hostile, bool &out_friendly) const { return false; }
 
 	private:
 		/// 
@@ -37,7 +37,7 @@ namespace wowpp
 	    proto::Project &project,
 	    TimerQueue &timers,
 	    const proto::ObjectEntry &entry)
-		: GameObject(project)
+		: GameObject(project, world_object_fields::WorldObjectFieldCount)
 		, m_timers(timers)
 		, m_entry(entry)
 	{
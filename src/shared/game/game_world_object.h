@@ -164,7 +164,7 @@ namespace wowpp
 	public:
 
 		/// Fired when a world object trigger should be executed.
-		simple::signal<void(const proto::TriggerEntry &, WorldObject &)> objectTrigger;
+		LazySignal<void(const proto::TriggerEntry &, WorldObject &)> objectTrigger;
 
 	public:
 
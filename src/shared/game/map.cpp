@@ -44,7 +44,7 @@ namespace wowpp
 	std::map<String, std::shared_ptr<math::AABBTree>> aabbDoodadTreeById;
 
 	Map::Map(const proto::MapEntry &entry, boost::filesystem::path dataPath, bool loadDoodads/* = false*/)
-		: m_entry(entry)
+		: m_mapId(entry.id())
 		, m_dataPath(std::move(dataPath))
 		, m_tiles(64, 64)
 		, m_navMesh(nullptr)
@@ -57,12 +57,12 @@ namespace wowpp
 	void Map::setupNavMesh()
 	{
 		// Allocate navigation mesh
-		auto it = navMeshsPerMap.find(m_entry.id());
+		auto it = navMeshsPerMap.find(m_mapId);
 		if (it == navMeshsPerMap.end())
 		{
 			// Build file name
 			std::ostringstream strm;
-			strm << (m_dataPath / "maps").string() << "/" << m_entry.id() << ".map";
+			strm << (m_dataPath / "maps").string() << "/" << m_mapId << ".map";
 
 			const String file = strm.str();
 			if (!boost::filesystem::exists(file))
@@ -121,7 +121,7 @@ namespace wowpp
 			m_adtSlopeFilter.setIncludeFlags(1 | 2 | 4 | 8 | 16);
 			m_adtSlopeFilter.setExcludeFlags(32);
 
-			navMeshsPerMap[m_entry.id()] = std::move(navMesh);
+			navMeshsPerMap[m_mapId] = std::move(navMesh);
 		}
 	}
 
@@ -143,7 +143,7 @@ namespace wowpp
 		m_tiles.clear();
 
 		// Destroy nav mesh
-		auto it = navMeshsPerMap.find(m_entry.id());
+		auto it = navMeshsPerMap.find(m_mapId);
 		if (it != navMeshsPerMap.end())
 		{
 			it = navMeshsPerMap.erase(it);
@@ -693,7 +693,7 @@ namespace wowpp
 	Map::MapDataTilePtr Map::loadTile(const TileIndex2D & tileIndex)
 	{
 		std::ostringstream strm;
-		strm << m_dataPath.string() << "/maps/" << m_entry.id() << "/" << tileIndex[0] << "_" << tileIndex[1] << ".map";
+		strm << m_dataPath.string() << "/maps/" << m_mapId << "/" << tileIndex[0] << "_" << tileIndex[1] << ".map";
 
 		const String file = strm.str();
 		if (!boost::filesystem::exists(file))
@@ -85,9 +85,9 @@ namespace wowpp
 		/// Unloads all loaded map tiles of this map. Note that they may be reloaded if they
 		/// are required again after being unloaded.
 		void unloadAllTiles();
-		/// Gets the map entry data of this map.
-		const proto::MapEntry &getEntry() const {
-			return m_entry;
+		/// Gets the id of this map.
+		UInt32 getMapId() const {
+			return m_mapId;
 		}
 		/// Tries to get a specific data tile if it's loaded.
 		MapDataTile *getTile(const TileIndex2D &position);
@@ -141,7 +141,8 @@ namespace wowpp
 		
 	private:
 
-		const proto::MapEntry &m_entry;
+		/// The id of this map. Map data is shared between project snapshots, so the map entry itself isn't kept.
+		const UInt32 m_mapId;
 		const boost::filesystem::path m_dataPath;
 		// Note: We use a pointer here, because we don't need to load ALL height data
 		// of all tiles, and Grid allocates them immediatly.
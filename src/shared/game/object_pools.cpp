@@ -0,0 +1,51 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "object_pools.h"
+
+namespace wowpp
+{
+	namespace object_pools
+	{
+		// Pools are never destroyed, so that objects which are released during shutdown don't
+		// return their memory to a pool which no longer exists.
+
+		SlabPool &creatures()
+		{
+			static SlabPool &pool = *new SlabPool("GameCreature", 64);
+			return pool;
+		}
+
+		SlabPool &worldObjects()
+		{
+			static SlabPool &pool = *new SlabPool("WorldObject", 128);
+			return pool;
+		}
+
+		SlabPool &dynObjects()
+		{
+			static SlabPool &pool = *new SlabPool("DynObject", 32);
+			return pool;
+		}
+	}
+}
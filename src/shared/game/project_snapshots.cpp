@@ -0,0 +1,133 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "project_snapshots.h"
+#include "log/default_log_levels.h"
+
+namespace wowpp
+{
+	ProjectSnapshot::ProjectSnapshot(UInt32 epoch)
+		: epoch(epoch)
+	{
+	}
+
+	bool ProjectSnapshot::load(const String &dataPath)
+	{
+		if (!project.load(dataPath))
+		{
+			return false;
+		}
+
+		spellPlans.compile(project);
+		return true;
+	}
+
+	ProjectSnapshots::ProjectSnapshots(boost::asio::io_service &ioService)
+		: m_ioService(ioService)
+		, m_reloading(false)
+		, m_nextEpoch(1)
+	{
+	}
+
+	ProjectSnapshots::~ProjectSnapshots()
+	{
+		if (m_loader.joinable())
+		{
+			m_loader.join();
+		}
+	}
+
+	bool ProjectSnapshots::loadInitial(const String &dataPath)
+	{
+		auto snapshot = std::make_shared<ProjectSnapshot>(m_nextEpoch++);
+		if (!snapshot->load(dataPath))
+		{
+			return false;
+		}
+
+		m_current = std::move(snapshot);
+		return true;
+	}
+
+	bool ProjectSnapshots::beginReload(const String &dataPath)
+	{
+		if (m_reloading)
+		{
+			return false;
+		}
+
+		// The previous loader thread already finished its work
+		if (m_loader.joinable())
+		{
+			m_loader.join();
+		}
+
+		m_reloading = true;
+
+		// Captured here since m_current may be replaced on the io thread while loading
+		const UInt32 currentEpoch = m_current ? m_current->epoch : 0;
+		const UInt32 epoch = m_nextEpoch++;
+		m_loader = std::thread([this, epoch, currentEpoch, dataPath]()
+		{
+			auto snapshot = std::make_shared<ProjectSnapshot>(epoch);
+			if (!snapshot->load(dataPath))
+			{
+				ELOG("Could not reload data project - keeping project epoch " << currentEpoch);
+				m_reloading = false;
+				return;
+			}
+
+			m_ioService.post(std::bind(&ProjectSnapshots::activate, this, std::move(snapshot)));
+		});
+
+		return true;
+	}
+
+	void ProjectSnapshots::activate(SnapshotPtr snapshot)
+	{
+		ILOG("Activating data project epoch " << snapshot->epoch);
+
+		m_retired.push_back(std::move(m_current));
+		m_current = std::move(snapshot);
+		m_reloading = false;
+
+		snapshotActivated(*m_current);
+	}
+
+	size_t ProjectSnapshots::collectRetired()
+	{
+		const auto it = std::remove_if(m_retired.begin(), m_retired.end(), [](const SnapshotPtr &snapshot)
+		{
+			return snapshot->project.getReferenceCount() == 0;
+		});
+
+		const size_t collected = static_cast<size_t>(std::distance(it, m_retired.end()));
+		for (auto retired = it; retired != m_retired.end(); ++retired)
+		{
+			DLOG("Releasing data project epoch " << (*retired)->epoch);
+		}
+
+		m_retired.erase(it, m_retired.end());
+		return collected;
+	}
+}
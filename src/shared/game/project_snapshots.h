@@ -0,0 +1,117 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "proto_data/project.h"
+#include "spell_execution_plan.h"
+
+namespace wowpp
+{
+	/// One loaded version of the static game data together with everything that is precompiled
+	/// from it. Snapshots are never modified after they have been loaded.
+	struct ProjectSnapshot final
+	{
+	private:
+
+		ProjectSnapshot(const ProjectSnapshot &Other) = delete;
+		ProjectSnapshot &operator=(const ProjectSnapshot &Other) = delete;
+
+	public:
+
+		/// Increasing number which identifies this snapshot.
+		const UInt32 epoch;
+		/// The loaded game data.
+		proto::Project project;
+		/// Precompiled spell execution plans of this snapshot's spells.
+		SpellExecutionPlans spellPlans;
+
+		explicit ProjectSnapshot(UInt32 epoch);
+
+		/// Loads the game data and compiles the spell execution plans.
+		/// @param dataPath Path of the data directory.
+		bool load(const String &dataPath);
+	};
+
+	/// Manages the active project snapshot of a server and allows to reload the game data while
+	/// the server is running. New data is loaded by a background thread and activated on the
+	/// io service thread between two world updates. Outdated snapshots are retired and destroyed
+	/// as soon as no game object references their data any more.
+	class ProjectSnapshots final
+	{
+	private:
+
+		ProjectSnapshots(const ProjectSnapshots &Other) = delete;
+		ProjectSnapshots &operator=(const ProjectSnapshots &Other) = delete;
+
+	public:
+
+		typedef std::shared_ptr<ProjectSnapshot> SnapshotPtr;
+
+		/// Fired on the io service thread after a new snapshot became the current one.
+		simple::signal<void(ProjectSnapshot &)> snapshotActivated;
+
+	public:
+
+		explicit ProjectSnapshots(boost::asio::io_service &ioService);
+		/// Waits for a running reload to finish.
+		~ProjectSnapshots();
+
+		/// Synchronously loads the first snapshot.
+		/// @param dataPath Path of the data directory.
+		bool loadInitial(const String &dataPath);
+		/// Gets the snapshot which is used for new objects.
+		ProjectSnapshot &getCurrent() {
+			return *m_current;
+		}
+		/// Starts loading a new snapshot in the background. Does nothing if a reload is already running.
+		/// @param dataPath Path of the data directory.
+		/// @returns false if a reload is already running.
+		bool beginReload(const String &dataPath);
+		/// Determines whether a reload is running at the moment.
+		bool isReloading() const {
+			return m_reloading;
+		}
+		/// Destroys all retired snapshots which are no longer referenced.
+		/// @returns Number of destroyed snapshots.
+		size_t collectRetired();
+		/// Gets the number of retired snapshots which are still referenced by live objects.
+		size_t getRetiredCount() const {
+			return m_retired.size();
+		}
+
+	private:
+
+		/// Makes a loaded snapshot the current one. Called on the io service thread.
+		void activate(SnapshotPtr snapshot);
+
+	private:
+
+		boost::asio::io_service &m_ioService;
+		SnapshotPtr m_current;
+		std::vector<SnapshotPtr> m_retired;
+		std::thread m_loader;
+		std::atomic<bool> m_reloading;
+		UInt32 m_nextEpoch;
+	};
+}
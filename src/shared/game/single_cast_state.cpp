@@ -48,7 +48,9 @@ namespace wowpp
 {
 	SingleCastState::SingleCastState(SpellCast &cast, const proto::SpellEntry &spell, SpellTargetMap target, const game::SpellPointsArray &basePoints, GameTime castTime, bool isProc/* = false*/, UInt64 itemGuid/* = 0*/)
 		: m_cast(cast)
+		, m_project(cast.getExecuter().getProject())
 		, m_spell(spell)
+		, m_plan(nullptr)
 		, m_target(std::move(target))
 		, m_hasFinished(false)
 		, m_countdown(cast.getTimers())
@@ -76,6 +78,20 @@ namespace wowpp
 		auto &executer = m_cast.getExecuter();
 		auto *worldInstance = executer.getWorldInstance();
 
+		// Use the precompiled execution plan if available
+		const auto *spellPlans = worldInstance ? worldInstance->getUniverse().getSpellPlans() : nullptr;
+		if (spellPlans)
+		{
+			m_plan = spellPlans->getById(m_spell.id());
+		}
+		if (!m_plan || m_plan->spell != &m_spell)
+		{
+			// Spell entry is not part of the compiled project, so compile it now
+			const auto *category = m_spell.category() ? executer.getProject().spellCategories.getById(m_spell.category()) : nullptr;
+			m_ownPlan = make_unique<SpellExecutionPlan>(m_spell, category);
+			m_plan = m_ownPlan.get();
+		}
+
 		if (!m_itemGuid)
 		{
 			m_castTime *= executer.getFloatValue(unit_fields::ModCastSpeed);
@@ -1025,141 +1041,30 @@ namespace wowpp
 		// Make sure that this isn't destroyed during the effects
 		auto strong = shared_from_this();
 
-		std::vector<UInt32> effects;
-		for (int i = 0; i < m_spell.effects_size(); ++i)
-		{
-			effects.push_back(m_spell.effects(i).type());
-		}
-
-		if (!m_isProc && !m_itemGuid &&
-			!(m_spell.attributes(3) & game::spell_attributes_ex_c::DisableProc) &&
-			!(m_spell.attributes(0) & game::spell_attributes::Passive))
+		if (!m_isProc && !m_itemGuid && m_plan->canProc)
 		{
 			m_canTrigger = true;
 		}
-		else if (m_spell.attributes(2) & game::spell_attributes_ex_b::TriggeredCanProc ||
-			m_spell.attributes(3) & game::spell_attributes_ex_c::TriggeredCanProc2)
+		else if (m_plan->triggeredCanProc)
 		{
 			m_canTrigger = true;
 		}
 
-		switch (m_spell.dmgclass())
-		{
-		case game::spell_dmg_class::Melee:
-			m_attackerProc = game::spell_proc_flags::DoneSpellMeleeDmgClass;
-			m_victimProc = game::spell_proc_flags::TakenSpellMeleeDmgClass;
-			m_attackType = game::weapon_attack::BaseAttack;
-
-			if (m_spell.attributes(3) & game::spell_attributes_ex_c::ReqOffhand)
-			{
-				m_attackerProc |= game::spell_proc_flags::DoneOffhandAttack;
-				m_attackType = game::weapon_attack::OffhandAttack;
-			}
-			break;
-		case game::spell_dmg_class::Ranged:
-			if (m_spell.attributes(2) & game::spell_attributes_ex_b::AuroRepeat)
-			{
-				m_attackerProc = game::spell_proc_flags::DoneRangedAutoAttack;
-				m_victimProc = game::spell_proc_flags::TakenRangedAutoAttack;
-			}
-			else
-			{
-				m_attackerProc = game::spell_proc_flags::DoneSpellRangedDmgClass;
-				m_victimProc = game::spell_proc_flags::TakenSpellRangedDmgClass;
-			}
-
-			m_attackType = game::weapon_attack::RangedAttack;
-			break;
-		default:
-			bool isPositive = (m_spell.positive() != 0);
-			if (isPositive)
-			{
-				m_attackerProc = game::spell_proc_flags::DoneSpellMagicDmgClassPos;
-				m_victimProc = game::spell_proc_flags::TakenSpellMagicDmgClassPos;
-			}
-			else if (m_spell.attributes(2) & game::spell_attributes_ex_b::AuroRepeat)
-			{
-				m_attackerProc = game::spell_proc_flags::DoneRangedAutoAttack;
-				m_victimProc = game::spell_proc_flags::TakenRangedAutoAttack;
-				m_attackType = game::weapon_attack::RangedAttack;
-			}
-			else
-			{
-				m_attackerProc = game::spell_proc_flags::DoneSpellMagicDmgClassNeg;
-				m_victimProc = game::spell_proc_flags::TakenSpellMagicDmgClassNeg;
-			}
-
-			break;
-		}
+		m_attackerProc = m_plan->attackerProc;
+		m_victimProc = m_plan->victimProc;
+		m_attackType = m_plan->attackType;
 
 		// Needed for combat ratings
 		m_cast.getExecuter().setWeaponAttack(m_attackType);
 
-		// Execute spell immediatly
-		namespace se = game::spell_effects;
-		std::vector<std::pair<UInt32, EffectHandler>> instantMap{
-			{ se::Charge,				std::bind(&SingleCastState::spellEffectCharge, this, std::placeholders::_1) },
-		};
-
-		std::vector<std::pair<UInt32, EffectHandler>> delayedMap {
-			//ordered pairs to avoid 25% resists for binary spells like frostnova
-			{se::Dummy,					std::bind(&SingleCastState::spellEffectDummy, this, std::placeholders::_1) },
-			{se::InstantKill,			std::bind(&SingleCastState::spellEffectInstantKill, this, std::placeholders::_1)},
-			{se::PowerDrain,			std::bind(&SingleCastState::spellEffectDrainPower, this, std::placeholders::_1)},
-			{se::Heal,					std::bind(&SingleCastState::spellEffectHeal, this, std::placeholders::_1)},
-			{se::Bind,					std::bind(&SingleCastState::spellEffectBind, this, std::placeholders::_1)},
-			{se::QuestComplete,			std::bind(&SingleCastState::spellEffectQuestComplete, this, std::placeholders::_1)},
-			{se::Proficiency,			std::bind(&SingleCastState::spellEffectProficiency, this, std::placeholders::_1)},
-			{se::AddComboPoints,		std::bind(&SingleCastState::spellEffectAddComboPoints, this, std::placeholders::_1)},
-			{se::Duel,					std::bind(&SingleCastState::spellEffectDuel, this, std::placeholders::_1)},
-			{se::WeaponDamageNoSchool,	std::bind(&SingleCastState::spellEffectWeaponDamageNoSchool, this, std::placeholders::_1)},
-			{se::CreateItem,			std::bind(&SingleCastState::spellEffectCreateItem, this, std::placeholders::_1)},
-			{se::WeaponDamage,			std::bind(&SingleCastState::spellEffectWeaponDamage, this, std::placeholders::_1)},
-			{se::TeleportUnits,			std::bind(&SingleCastState::spellEffectTeleportUnits, this, std::placeholders::_1)},
-			{se::TriggerSpell,			std::bind(&SingleCastState::spellEffectTriggerSpell, this, std::placeholders::_1)},
-			{se::Energize,				std::bind(&SingleCastState::spellEffectEnergize, this, std::placeholders::_1)},
-			{se::WeaponPercentDamage,	std::bind(&SingleCastState::spellEffectWeaponPercentDamage, this, std::placeholders::_1)},
-			{se::PowerBurn,				std::bind(&SingleCastState::spellEffectPowerBurn, this, std::placeholders::_1)},
-			{se::OpenLock,				std::bind(&SingleCastState::spellEffectOpenLock, this, std::placeholders::_1)},
-			{se::OpenLockItem,			std::bind(&SingleCastState::spellEffectOpenLock, this, std::placeholders::_1) },
-			{se::ApplyAreaAuraParty,	std::bind(&SingleCastState::spellEffectApplyAreaAuraParty, this, std::placeholders::_1)},
-			{se::Dispel,				std::bind(&SingleCastState::spellEffectDispel, this, std::placeholders::_1)},
-			{se::Summon,				std::bind(&SingleCastState::spellEffectSummon, this, std::placeholders::_1)},
-			{se::SummonPet,				std::bind(&SingleCastState::spellEffectSummonPet, this, std::placeholders::_1) },
-			{se::ScriptEffect,			std::bind(&SingleCastState::spellEffectScript, this, std::placeholders::_1)},
-			{se::AttackMe,				std::bind(&SingleCastState::spellEffectAttackMe, this, std::placeholders::_1)},
-			{se::NormalizedWeaponDmg,	std::bind(&SingleCastState::spellEffectNormalizedWeaponDamage, this, std::placeholders::_1)},
-			{se::StealBeneficialBuff,	std::bind(&SingleCastState::spellEffectStealBeneficialBuff, this, std::placeholders::_1)},
-			{se::InterruptCast,			std::bind(&SingleCastState::spellEffectInterruptCast, this, std::placeholders::_1) },
-			{se::LearnSpell,			std::bind(&SingleCastState::spellEffectLearnSpell, this, std::placeholders::_1) },
-			{se::ScriptEffect,			std::bind(&SingleCastState::spellEffectScriptEffect, this, std::placeholders::_1) },
-			{se::DispelMechanic,		std::bind(&SingleCastState::spellEffectDispelMechanic, this, std::placeholders::_1) },
-			{se::Resurrect,				std::bind(&SingleCastState::spellEffectResurrect, this, std::placeholders::_1) },
-			{se::ResurrectNew,			std::bind(&SingleCastState::spellEffectResurrectNew, this, std::placeholders::_1) },
-			{se::KnockBack,				std::bind(&SingleCastState::spellEffectKnockBack, this, std::placeholders::_1) },
-			{se::TransDoor,				std::bind(&SingleCastState::spellEffectTransDoor, this, std::placeholders::_1) },
-			// Add all effects above here
-			{se::ApplyAura,				std::bind(&SingleCastState::spellEffectApplyAura, this, std::placeholders::_1)},
-			{se::PersistentAreaAura,	std::bind(&SingleCastState::spellEffectPersistentAreaAura, this, std::placeholders::_1) },
-			{se::ApplyAreaAuraParty,	std::bind(&SingleCastState::spellEffectApplyAura, this, std::placeholders::_1)},
-			{se::SchoolDamage,			std::bind(&SingleCastState::spellEffectSchoolDamage, this, std::placeholders::_1)}
-		};
-
 		// Make sure that the executer exists after all effects have been executed
 		auto strongCaster = std::static_pointer_cast<GameUnit>(m_cast.getExecuter().shared_from_this());
 
 		if (executeInstants && !m_instantsCast)
 		{
-			for (auto &effect : instantMap)
+			for (const auto &step : m_plan->instantEffects)
 			{
-				for (int k = 0; k < effects.size(); ++k)
-				{
-					if (effect.first == effects[k])
-					{
-						ASSERT(effect.second);
-						effect.second(m_spell.effects(k));
-					}
-				}
+				(this->*step.handler)(*step.effect);
 			}
 
 			m_instantsCast = true;
@@ -1167,16 +1072,9 @@ namespace wowpp
 
 		if (executeDelayed && !m_delayedCast)
 		{
-			for (auto &effect : delayedMap)
+			for (const auto &step : m_plan->delayedEffects)
 			{
-				for (int k = 0; k < effects.size(); ++k)
-				{
-					if (effect.first == effects[k])
-					{
-						ASSERT(effect.second);
-						effect.second(m_spell.effects(k));
-					}
-				}
+				(this->*step.handler)(*step.effect);
 			}
 
 			m_delayedCast = true;
@@ -1199,7 +1097,7 @@ namespace wowpp
 		m_auraSlots.clear();
 
 		// Consume combo points if required
-		if ((m_spell.attributes(1) & (game::spell_attributes_ex_a::ReqComboPoints_1 | game::spell_attributes_ex_a::ReqComboPoints_2)))
+		if (m_plan->requiresComboPoints)
 		{
 			// 0 will reset combo points
 			reinterpret_cast<GameCharacter&>(*strongCaster).addComboPoints(0, 0);
@@ -1243,7 +1141,7 @@ namespace wowpp
 		}
 
 		// Cast all additional spells if available
-		for (const auto &spell : m_spell.additionalspells())
+		for (const auto &spell : m_plan->additionalSpells)
 		{
 			strongCaster->castSpell(m_target, spell, { 0, 0, 0 }, 0, true);
 		}
@@ -1267,17 +1165,6 @@ namespace wowpp
 		}
 	}
 
-	bool SingleCastState::hasChargeEffect() const
-	{
-		for (const auto &eff : m_spell.effects())
-		{
-			if (eff.type() == game::spell_effects::Charge) 
-				return true;
-		}
-
-		return false;
-	}
-
 	bool SingleCastState::consumeItem(bool delayed/* = true*/)
 	{
 		if (m_tookCastItem && delayed)
@@ -1427,17 +1314,11 @@ namespace wowpp
 	void SingleCastState::applyCooldown(UInt64 cooldownTimeMS, UInt64 catCooldownTimeMS)
 	{
 		m_cast.getExecuter().setCooldown(m_spell.id(), static_cast<UInt32>(cooldownTimeMS));
-		if (m_spell.category() && catCooldownTimeMS)
+		if (catCooldownTimeMS)
 		{
-			auto *cat = m_cast.getExecuter().getProject().spellCategories.getById(m_spell.category());
-			if (cat)
+			for (const auto &spellId : m_plan->categorySpells)
 			{
-				for (const auto &spellId : cat->spells())
-				{
-					if (spellId != m_spell.id()) {
-						m_cast.getExecuter().setCooldown(spellId, static_cast<UInt32>(catCooldownTimeMS));
-					}
-				}
+				m_cast.getExecuter().setCooldown(spellId, static_cast<UInt32>(catCooldownTimeMS));
 			}
 		}
 	}
@@ -1572,9 +1453,10 @@ namespace wowpp
 					io::VectorSink sink(buffer);
 					game::Protocol::OutgoingPacket itemPacket(sink);
 					game::server_write::itemPushResult(itemPacket, target.getGuid(), std::cref(*inst), false, true, bag, subslot, slot.second, totalCount);
-					forEachSubscriberInSight(
+					forEachSubscriberInSightOf(
 						target.getWorldInstance()->getGrid(),
 						tile,
+						target.getGuid(),
 						[&](ITileSubscriber & subscriber)
 					{
 						auto subscriberGroup = subscriber.getControlledObject()->getGroupId();
@@ -28,6 +28,7 @@
 #include "world_instance.h"
 #include "shared/proto_data/spells.pb.h"
 #include "aura_spell_slot.h"
+#include "spell_execution_plan.h"
 #include "binary_io/vector_sink.h"
 
 namespace wowpp
@@ -39,6 +40,8 @@ namespace wowpp
 		: public SpellCast::CastState
 		, public std::enable_shared_from_this<SingleCastState>
 	{
+		friend struct SpellExecutionPlan;
+
 	private:
 
 		SingleCastState(const SingleCastState& Other) = delete;
@@ -87,9 +90,10 @@ namespace wowpp
 			game::Protocol::OutgoingPacket packet(sink);
 			generator(packet);
 
-			forEachSubscriberInSight(
+			forEachSubscriberInSightOf(
 				worldInstance->getGrid(),
 				tileIndex,
+				caster.getGuid(),
 				[&buffer, &packet](ITileSubscriber & subscriber)
 			{
 				subscriber.sendPacket(
@@ -116,9 +120,10 @@ namespace wowpp
 			game::Protocol::OutgoingPacket packet(sink);
 			generator(packet);
 
-			forEachSubscriberInSight(
+			forEachSubscriberInSightOf(
 				worldInstance->getGrid(),
 				tileIndex,
+				caster.getGuid(),
 				[&buffer, &packet, &caster](ITileSubscriber & subscriber)
 			{
 				if (reinterpret_cast<GameUnit*>(subscriber.getControlledObject()) == &caster)
@@ -135,9 +140,9 @@ namespace wowpp
 	public:
 
 		/// Determines if this spell is a channeled spell.
-		bool isChanneled() const { return (m_spell.attributes(1) & game::spell_attributes_ex_a::Channeled_1) || (m_spell.attributes(1) & game::spell_attributes_ex_a::Channeled_2); }
+		bool isChanneled() const { return m_plan->isChanneled; }
 		/// Determines if this spell has a charge effect.
-		bool hasChargeEffect() const;
+		bool hasChargeEffect() const { return m_plan->hasChargeEffect; }
 
 	private:
 
@@ -208,7 +213,12 @@ namespace wowpp
 	private:
 
 		SpellCast &m_cast;
+		/// The spell entry belongs to the executer's project, which might be retired and released
+		/// while this cast is still running.
+		proto::ProjectReference m_project;
 		const proto::SpellEntry &m_spell;
+		const SpellExecutionPlan *m_plan;
+		std::unique_ptr<SpellExecutionPlan> m_ownPlan;
 		SpellTargetMap m_target;
 		SpellCasting m_casting;
 		AttackTable m_attackTable;
@@ -251,7 +261,5 @@ namespace wowpp
 		void onTargetDespawned(GameObject &);
 		void onUserDamaged();
 		void executeMeleeAttack();	// deal damage stored in m_meleeDamage
-
-		typedef std::function<void(const wowpp::proto::SpellEffect &)> EffectHandler;
 	};
 }
@@ -0,0 +1,233 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "spawn_stream.h"
+#include "world_instance.h"
+#include "game_character.h"
+#include "each_tile_in_sight.h"
+#include "visibility_grid.h"
+#include "visibility_tile.h"
+#include "unit_mover.h"
+#include "binary_io/vector_sink.h"
+#include "game_protocol/game_protocol.h"
+
+namespace wowpp
+{
+	SpawnStream::SpawnStream(WorldInstance &instance, ITileSubscriber &subscriber)
+		: m_instance(instance)
+		, m_subscriber(subscriber)
+		, m_sorted(true)
+	{
+	}
+
+	SpawnStream::~SpawnStream()
+	{
+		m_instance.removeSpawnStream(*this);
+	}
+
+	void SpawnStream::queueTile(VisibilityTile &tile)
+	{
+		auto *character = m_subscriber.getControlledObject();
+		if (!character)
+		{
+			return;
+		}
+
+		for (auto *object : tile.getGameObjects().getElements())
+		{
+			ASSERT(object);
+			if (object == character)
+			{
+				continue;
+			}
+
+			// Objects might be queued twice if the subscriber crosses tiles back and forth
+			if (!m_pendingGuids.insert(object->getGuid()).second)
+			{
+				continue;
+			}
+
+			PendingSpawn spawn;
+			spawn.guid = object->getGuid();
+			spawn.distanceSq = character->getSquaredDistanceTo(*object, false);
+			m_queue.push_back(spawn);
+			m_sorted = false;
+		}
+
+		if (!m_queue.empty())
+		{
+			m_instance.addSpawnStream(*this);
+		}
+	}
+
+	void SpawnStream::changeTile(VisibilityTile &oldTile, VisibilityTile &newTile)
+	{
+		auto *character = m_subscriber.getControlledObject();
+		if (!character)
+		{
+			return;
+		}
+
+		auto &grid = m_instance.getGrid();
+
+		// Despawn old objects
+		forEachTileInSightWithout(
+			grid,
+			oldTile.getPosition(),
+			newTile.getPosition(),
+			[this, character](VisibilityTile &tile)
+		{
+			for (auto *object : tile.getGameObjects().getElements())
+			{
+				ASSERT(object);
+				if (!object->canSpawnForCharacter(*character))
+				{
+					continue;
+				}
+
+				// Objects which are still queued were never sent
+				if (isPending(object->getGuid()))
+				{
+					continue;
+				}
+
+				// Stealthed objects which can't be seen were never sent either
+				if (object->isCreature() || object->isGameCharacter())
+				{
+					GameUnit &unit = reinterpret_cast<GameUnit&>(*object);
+					if (unit.isStealthed() && !character->canDetectStealth(unit))
+					{
+						continue;
+					}
+				}
+
+				std::vector<char> buffer;
+				io::VectorSink sink(buffer);
+				game::Protocol::OutgoingPacket packet(sink);
+				game::server_write::destroyObject(packet, object->getGuid(), false);
+				m_subscriber.sendPacket(packet, buffer);
+			}
+		});
+
+		// Spawn new objects
+		forEachTileInSightWithout(
+			grid,
+			newTile.getPosition(),
+			oldTile.getPosition(),
+			[this](VisibilityTile &tile)
+		{
+			queueTile(tile);
+		});
+	}
+
+	void SpawnStream::clear()
+	{
+		m_queue.clear();
+		m_pendingGuids.clear();
+		m_sorted = true;
+
+		m_instance.removeSpawnStream(*this);
+	}
+
+	void SpawnStream::send(SpawnStreamBudget &budget)
+	{
+		auto *character = m_subscriber.getControlledObject();
+		TileIndex2D center;
+		if (!character ||
+			!character->getTileIndex(center))
+		{
+			return;
+		}
+
+		if (!m_sorted)
+		{
+			std::sort(m_queue.begin(), m_queue.end(), [](const PendingSpawn &a, const PendingSpawn &b)
+			{
+				return a.distanceSq > b.distanceSq;
+			});
+			m_sorted = true;
+		}
+
+		auto &grid = m_instance.getGrid();
+
+		std::vector<std::vector<char>> blocks;
+		std::vector<GameUnit*> units;
+		while (!m_queue.empty() && !budget.isExhausted())
+		{
+			const UInt64 guid = m_queue.back().guid;
+			m_queue.pop_back();
+			m_pendingGuids.erase(guid);
+
+			// The object might have been despawned or moved out of sight in the meantime
+			auto *object = m_instance.findObjectByGUID(guid);
+			if (!object ||
+				!object->canSpawnForCharacter(*character))
+			{
+				continue;
+			}
+
+			TileIndex2D objectTile;
+			if (!grid.getTilePosition(object->getLocation(), objectTile[0], objectTile[1]) ||
+				!isInSight(center, objectTile))
+			{
+				continue;
+			}
+
+			// Dont spawn stealthed targets that we can't see yet
+			if (object->isCreature() || object->isGameCharacter())
+			{
+				GameUnit &unit = reinterpret_cast<GameUnit&>(*object);
+				if (unit.isStealthed() && !character->canDetectStealth(unit))
+				{
+					continue;
+				}
+
+				units.push_back(&unit);
+			}
+
+			const size_t firstBlock = blocks.size();
+			createUpdateBlocks(*object, *character, blocks);
+			for (size_t i = firstBlock; i < blocks.size(); ++i)
+			{
+				budget.bytes -= std::min(budget.bytes, blocks[i].size());
+			}
+		}
+
+		if (blocks.empty())
+		{
+			return;
+		}
+
+		std::vector<char> buffer;
+		io::VectorSink sink(buffer);
+		game::Protocol::OutgoingPacket packet(sink);
+		game::server_write::compressedUpdateObject(packet, blocks, game::update_compression::Spawn);
+		m_subscriber.sendPacket(packet, buffer);
+
+		// Units might already be moving
+		for (auto *unit : units)
+		{
+			unit->getMover().sendMovementPackets(m_subscriber);
+		}
+	}
+}
@@ -0,0 +1,106 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include <unordered_set>
+#include <chrono>
+
+namespace wowpp
+{
+	class WorldInstance;
+	class VisibilityTile;
+	struct ITileSubscriber;
+
+	/// Limits how much work all spawn streams of a world instance may do within one update.
+	struct SpawnStreamBudget final
+	{
+		/// Uncompressed create block bytes which may still be sent.
+		size_t bytes;
+		/// Point in time at which no more create blocks may be built.
+		std::chrono::steady_clock::time_point deadline;
+
+		explicit SpawnStreamBudget(size_t bytes, std::chrono::microseconds time)
+			: bytes(bytes)
+			, deadline(std::chrono::steady_clock::now() + time)
+		{
+		}
+
+		/// Determines whether the budget is used up.
+		bool isExhausted() const
+		{
+			return bytes == 0 || std::chrono::steady_clock::now() >= deadline;
+		}
+	};
+
+	/// Sends the create blocks of the objects in sight to a tile subscriber, nearest first. Queued
+	/// objects are sent by the world instance on its updates, so that a player entering a crowded
+	/// area doesn't stall the world. Until an object has been sent, the client doesn't know it, so
+	/// no other packets about it should be sent to the subscriber (see isPending).
+	class SpawnStream final
+	{
+	private:
+
+		SpawnStream(const SpawnStream &Other) = delete;
+		SpawnStream &operator=(const SpawnStream &Other) = delete;
+
+	public:
+
+		/// @param instance The world instance which drives this stream.
+		/// @param subscriber The tile subscriber which receives the create blocks.
+		explicit SpawnStream(WorldInstance &instance, ITileSubscriber &subscriber);
+		~SpawnStream();
+
+		/// Queues all objects of a tile which aren't queued yet.
+		void queueTile(VisibilityTile &tile);
+		/// Destroys the objects which are no longer in sight after the subscriber moved to another
+		/// tile, and queues the objects which came into sight.
+		void changeTile(VisibilityTile &oldTile, VisibilityTile &newTile);
+		/// Determines whether an object is queued and thus unknown to the subscriber.
+		bool isPending(UInt64 guid) const { return m_pendingGuids.count(guid) != 0; }
+		/// Determines whether there are no queued objects left.
+		bool isEmpty() const { return m_queue.empty(); }
+		/// Drops all queued objects.
+		void clear();
+		/// Sends queued create blocks until either the queue or the budget is exhausted. All blocks
+		/// are batched into one compressed update packet.
+		void send(SpawnStreamBudget &budget);
+
+	private:
+
+		/// An object whose create block has not yet been sent.
+		struct PendingSpawn
+		{
+			UInt64 guid;
+			float distanceSq;
+		};
+
+		WorldInstance &m_instance;
+		ITileSubscriber &m_subscriber;
+		/// Sorted by descending distance once m_sorted is set, so that the nearest object is always
+		/// at the back.
+		std::vector<PendingSpawn> m_queue;
+		bool m_sorted;
+		std::unordered_set<UInt64> m_pendingGuids;
+	};
+}
@@ -30,6 +30,7 @@
 #include "each_tile_in_sight.h"
 #include "universe.h"
 #include "unit_mover.h"
+#include "object_pools.h"
 #include "log/default_log_levels.h"
 
 namespace wowpp
@@ -383,7 +384,7 @@ namespace wowpp
 				// Create a new slot for this unit if it didn't happen already
 				if (m_auraSlots.find(targetUnit->getGuid()) == m_auraSlots.end())
 				{
-					m_auraSlots[targetUnit->getGuid()] = std::make_shared<AuraSpellSlot>(targetUnit->getTimers(), m_spell, m_itemGuid);
+					m_auraSlots[targetUnit->getGuid()] = std::make_shared<AuraSpellSlot>(targetUnit->getTimers(), m_project.get(), m_spell, m_itemGuid);
 					m_auraSlots[targetUnit->getGuid()]->setOwner(std::static_pointer_cast<GameUnit>(targetUnit->shared_from_this()));
 					m_auraSlots[targetUnit->getGuid()]->setCaster(std::static_pointer_cast<GameUnit>(m_cast.getExecuter().shared_from_this()));
 				}
@@ -479,7 +480,8 @@ namespace wowpp
 		static UInt64 lowGuid = 1;
 
 		// Create a new dynamic object
-		auto dynObj = std::make_shared<DynObject>(
+		auto dynObj = allocateShared<DynObject>(
+			object_pools::dynObjects(),
 			caster.getProject(),
 			caster.getTimers(),
 			caster,
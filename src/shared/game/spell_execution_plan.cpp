@@ -0,0 +1,236 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "spell_execution_plan.h"
+#include "single_cast_state.h"
+#include "proto_data/project.h"
+#include "common/clock.h"
+#include "log/default_log_levels.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		struct EffectHandlerEntry
+		{
+			UInt32 effect;
+			SpellExecutionPlan::EffectHandler handler;
+		};
+	}
+
+	SpellExecutionPlan::SpellExecutionPlan(const proto::SpellEntry &spell, const proto::SpellCategoryEntry *category)
+		: spell(&spell)
+		, attackerProc(0)
+		, victimProc(0)
+		, attackType(game::weapon_attack::BaseAttack)
+		, isChanneled(false)
+		, hasChargeEffect(false)
+		, requiresComboPoints(false)
+		, canProc(false)
+		, triggeredCanProc(false)
+	{
+		namespace se = game::spell_effects;
+		typedef SingleCastState S;
+
+		// Effects executed immediatly
+		static const EffectHandlerEntry instantHandlers[] = {
+			{ se::Charge,				&S::spellEffectCharge },
+		};
+
+		// Execution order matters here, so don't sort these
+		static const EffectHandlerEntry delayedHandlers[] = {
+			//ordered pairs to avoid 25% resists for binary spells like frostnova
+			{ se::Dummy,				&S::spellEffectDummy },
+			{ se::InstantKill,			&S::spellEffectInstantKill },
+			{ se::PowerDrain,			&S::spellEffectDrainPower },
+			{ se::Heal,					&S::spellEffectHeal },
+			{ se::Bind,					&S::spellEffectBind },
+			{ se::QuestComplete,		&S::spellEffectQuestComplete },
+			{ se::Proficiency,			&S::spellEffectProficiency },
+			{ se::AddComboPoints,		&S::spellEffectAddComboPoints },
+			{ se::Duel,					&S::spellEffectDuel },
+			{ se::WeaponDamageNoSchool,	&S::spellEffectWeaponDamageNoSchool },
+			{ se::CreateItem,			&S::spellEffectCreateItem },
+			{ se::WeaponDamage,			&S::spellEffectWeaponDamage },
+			{ se::TeleportUnits,		&S::spellEffectTeleportUnits },
+			{ se::TriggerSpell,			&S::spellEffectTriggerSpell },
+			{ se::Energize,				&S::spellEffectEnergize },
+			{ se::WeaponPercentDamage,	&S::spellEffectWeaponPercentDamage },
+			{ se::PowerBurn,			&S::spellEffectPowerBurn },
+			{ se::OpenLock,				&S::spellEffectOpenLock },
+			{ se::OpenLockItem,			&S::spellEffectOpenLock },
+			{ se::ApplyAreaAuraParty,	&S::spellEffectApplyAreaAuraParty },
+			{ se::Dispel,				&S::spellEffectDispel },
+			{ se::Summon,				&S::spellEffectSummon },
+			{ se::SummonPet,			&S::spellEffectSummonPet },
+			{ se::ScriptEffect,			&S::spellEffectScript },
+			{ se::AttackMe,				&S::spellEffectAttackMe },
+			{ se::NormalizedWeaponDmg,	&S::spellEffectNormalizedWeaponDamage },
+			{ se::StealBeneficialBuff,	&S::spellEffectStealBeneficialBuff },
+			{ se::InterruptCast,		&S::spellEffectInterruptCast },
+			{ se::LearnSpell,			&S::spellEffectLearnSpell },
+			{ se::ScriptEffect,			&S::spellEffectScriptEffect },
+			{ se::DispelMechanic,		&S::spellEffectDispelMechanic },
+			{ se::Resurrect,			&S::spellEffectResurrect },
+			{ se::ResurrectNew,			&S::spellEffectResurrectNew },
+			{ se::KnockBack,			&S::spellEffectKnockBack },
+			{ se::TransDoor,			&S::spellEffectTransDoor },
+			// Add all effects above here
+			{ se::ApplyAura,			&S::spellEffectApplyAura },
+			{ se::PersistentAreaAura,	&S::spellEffectPersistentAreaAura },
+			{ se::ApplyAreaAuraParty,	&S::spellEffectApplyAura },
+			{ se::SchoolDamage,			&S::spellEffectSchoolDamage }
+		};
+
+		// Resolve handlers in the same order as they will be executed
+		for (const auto &entry : instantHandlers)
+		{
+			for (const auto &effect : spell.effects())
+			{
+				if (effect.type() == entry.effect)
+				{
+					instantEffects.push_back({ entry.handler, &effect });
+				}
+			}
+		}
+		for (const auto &entry : delayedHandlers)
+		{
+			for (const auto &effect : spell.effects())
+			{
+				if (effect.type() == entry.effect)
+				{
+					delayedEffects.push_back({ entry.handler, &effect });
+				}
+			}
+		}
+
+		for (const auto &effect : spell.effects())
+		{
+			if (effect.type() == se::Charge)
+			{
+				hasChargeEffect = true;
+				break;
+			}
+		}
+
+		if (category)
+		{
+			for (const auto &spellId : category->spells())
+			{
+				if (spellId != spell.id()) {
+					categorySpells.push_back(spellId);
+				}
+			}
+		}
+
+		additionalSpells.assign(spell.additionalspells().begin(), spell.additionalspells().end());
+
+		isChanneled = (spell.attributes(1) & (game::spell_attributes_ex_a::Channeled_1 | game::spell_attributes_ex_a::Channeled_2)) != 0;
+		requiresComboPoints = (spell.attributes(1) & (game::spell_attributes_ex_a::ReqComboPoints_1 | game::spell_attributes_ex_a::ReqComboPoints_2)) != 0;
+		canProc =
+			!(spell.attributes(3) & game::spell_attributes_ex_c::DisableProc) &&
+			!(spell.attributes(0) & game::spell_attributes::Passive);
+		triggeredCanProc =
+			(spell.attributes(2) & game::spell_attributes_ex_b::TriggeredCanProc) ||
+			(spell.attributes(3) & game::spell_attributes_ex_c::TriggeredCanProc2);
+
+		switch (spell.dmgclass())
+		{
+			case game::spell_dmg_class::Melee:
+				attackerProc = game::spell_proc_flags::DoneSpellMeleeDmgClass;
+				victimProc = game::spell_proc_flags::TakenSpellMeleeDmgClass;
+				attackType = game::weapon_attack::BaseAttack;
+
+				if (spell.attributes(3) & game::spell_attributes_ex_c::ReqOffhand)
+				{
+					attackerProc |= game::spell_proc_flags::DoneOffhandAttack;
+					attackType = game::weapon_attack::OffhandAttack;
+				}
+				break;
+			case game::spell_dmg_class::Ranged:
+				if (spell.attributes(2) & game::spell_attributes_ex_b::AuroRepeat)
+				{
+					attackerProc = game::spell_proc_flags::DoneRangedAutoAttack;
+					victimProc = game::spell_proc_flags::TakenRangedAutoAttack;
+				}
+				else
+				{
+					attackerProc = game::spell_proc_flags::DoneSpellRangedDmgClass;
+					victimProc = game::spell_proc_flags::TakenSpellRangedDmgClass;
+				}
+
+				attackType = game::weapon_attack::RangedAttack;
+				break;
+			default:
+				if (spell.positive() != 0)
+				{
+					attackerProc = game::spell_proc_flags::DoneSpellMagicDmgClassPos;
+					victimProc = game::spell_proc_flags::TakenSpellMagicDmgClassPos;
+				}
+				else if (spell.attributes(2) & game::spell_attributes_ex_b::AuroRepeat)
+				{
+					attackerProc = game::spell_proc_flags::DoneRangedAutoAttack;
+					victimProc = game::spell_proc_flags::TakenRangedAutoAttack;
+					attackType = game::weapon_attack::RangedAttack;
+				}
+				else
+				{
+					attackerProc = game::spell_proc_flags::DoneSpellMagicDmgClassNeg;
+					victimProc = game::spell_proc_flags::TakenSpellMagicDmgClassNeg;
+				}
+				break;
+		}
+	}
+
+	SpellExecutionPlans::SpellExecutionPlans()
+	{
+	}
+
+	void SpellExecutionPlans::compile(const proto::Project &project)
+	{
+		auto compileStart = getCurrentTime();
+
+		m_plans.clear();
+		m_plans.reserve(project.spells.getTemplates().entry_size());
+
+		for (const auto &spell : project.spells.getTemplates().entry())
+		{
+			const auto *category = spell.category() ? project.spellCategories.getById(spell.category()) : nullptr;
+			m_plans.emplace(std::piecewise_construct,
+				std::forward_as_tuple(spell.id()),
+				std::forward_as_tuple(spell, category));
+		}
+
+		ILOG("Compiled " << m_plans.size() << " spell execution plans in " << (getCurrentTime() - compileStart) << "ms");
+	}
+
+	const SpellExecutionPlan * SpellExecutionPlans::getById(UInt32 spellId) const
+	{
+		const auto it = m_plans.find(spellId);
+		if (it == m_plans.end()) {
+			return nullptr;
+		}
+
+		return &it->second;
+	}
+}
@@ -0,0 +1,107 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "game/defines.h"
+#include "shared/proto_data/spells.pb.h"
+#include "shared/proto_data/spell_categories.pb.h"
+
+namespace wowpp
+{
+	namespace proto
+	{
+		class Project;
+	}
+	class SingleCastState;
+
+	/// Contains everything of a spell entry that is needed while executing a cast, resolved
+	/// once so that SingleCastState doesn't have to walk the protobuf entry on every cast.
+	struct SpellExecutionPlan final
+	{
+		typedef void (SingleCastState::*EffectHandler)(const proto::SpellEffect &);
+
+		/// A single effect handler invocation in execution order.
+		struct EffectStep
+		{
+			EffectHandler handler;
+			const proto::SpellEffect *effect;
+		};
+
+		typedef std::vector<EffectStep> EffectSteps;
+
+		/// The spell entry this plan has been compiled from.
+		const proto::SpellEntry *spell;
+		/// Effects which are executed as soon as the cast finished (like Charge).
+		EffectSteps instantEffects;
+		/// Effects which are executed on impact.
+		EffectSteps delayedEffects;
+		/// Ids of all other spells which share the category cooldown of this spell.
+		std::vector<UInt32> categorySpells;
+		/// Ids of spells which are cast after all effects have been executed.
+		std::vector<UInt32> additionalSpells;
+		/// Proc flags of the caster and the victim depending on the damage class.
+		UInt32 attackerProc;
+		UInt32 victimProc;
+		/// Weapon attack type used for combat ratings.
+		game::WeaponAttack attackType;
+
+		bool isChanneled : 1;
+		bool hasChargeEffect : 1;
+		bool requiresComboPoints : 1;
+		/// Set if the spell may trigger procs when it isn't triggered itself.
+		bool canProc : 1;
+		/// Set if the spell may trigger procs even if it was triggered.
+		bool triggeredCanProc : 1;
+
+		/// Compiles the execution plan of a spell entry.
+		/// @param spell The spell entry to compile.
+		/// @param category The category entry of the spell or nullptr if there is none.
+		explicit SpellExecutionPlan(const proto::SpellEntry &spell, const proto::SpellCategoryEntry *category);
+	};
+
+	/// Holds the compiled execution plans of all spells of a project.
+	class SpellExecutionPlans final
+	{
+	private:
+
+		SpellExecutionPlans(const SpellExecutionPlans &Other) = delete;
+		SpellExecutionPlans &operator=(const SpellExecutionPlans &Other) = delete;
+
+	public:
+
+		SpellExecutionPlans();
+
+		/// Compiles the execution plans of all spells of the given project. Previously compiled
+		/// plans are discarded.
+		void compile(const proto::Project &project);
+		/// Gets the execution plan of a spell or nullptr if the spell hasn't been compiled.
+		const SpellExecutionPlan *getById(UInt32 spellId) const;
+		/// Gets the number of compiled plans.
+		size_t size() const { return m_plans.size(); }
+
+	private:
+
+		std::unordered_map<UInt32, SpellExecutionPlan> m_plans;
+	};
+}
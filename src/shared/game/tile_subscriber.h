@@ -38,6 +38,9 @@ namespace wowpp
 		virtual GameCharacter *getControlledObject() = 0;
 		/// Sends a packet to the tile subscriber.
 		virtual void sendPacket(game::Protocol::OutgoingPacket &packet, const std::vector<char> &buffer) = 0;
+		/// Determines whether the create block of an object still has to be sent to the subscriber.
+		/// Until then, the client doesn't know the object and no other packets about it should be sent.
+		virtual bool isSpawnPending(UInt64 guid) const = 0;
 
 		// TODO: We need to make sure that we know whose objects are spawned
 	};
@@ -44,6 +44,13 @@ namespace wowpp
 	{
 	}
 
+	void TiledUnitFinder::reset(const proto::MapEntry &map)
+	{
+		// Tiles are kept, they are empty once all units have been removed
+		ASSERT(m_units.empty());
+		UnitFinder::reset(map);
+	}
+
 	void TiledUnitFinder::addUnit(GameUnit &findable)
 	{
 		ASSERT(m_units.count(&findable) == 0);
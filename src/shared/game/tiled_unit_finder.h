@@ -33,6 +33,7 @@ namespace wowpp
 	public:
 
 		explicit TiledUnitFinder(const proto::MapEntry &map, game::Distance tileWidth);
+		virtual void reset(const proto::MapEntry &map) override;
 		virtual void addUnit(GameUnit &findable) override;
 		virtual void removeUnit(GameUnit &findable) override;
 		virtual void updatePosition(GameUnit &updated,
@@ -21,15 +21,21 @@
 
 #include "pch.h"
 #include "unit_finder.h"
+#include "shared/proto_data/maps.pb.h"
 
 namespace wowpp
 {
 	UnitFinder::UnitFinder(const proto::MapEntry &map)
-		: m_map(map)
+		: m_mapId(map.id())
 	{
 	}
 
 	UnitFinder::~UnitFinder()
 	{
 	}
+
+	void UnitFinder::reset(const proto::MapEntry &map)
+	{
+		m_mapId = map.id();
+	}
 }
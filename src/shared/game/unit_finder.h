@@ -45,10 +45,13 @@ namespace wowpp
 		/// Default destructor.
 		virtual ~UnitFinder();
 
-		///
-		const proto::MapEntry &getMapEntry() const {
-			return m_map;
+		/// Gets the id of the map this finder was created for.
+		UInt32 getMapId() const {
+			return m_mapId;
 		}
+		/// Prepares an empty unit finder to be used for another map instance.
+		/// @param map The map of the new instance.
+		virtual void reset(const proto::MapEntry &map);
 		///
 		/// @param findable
 		virtual void addUnit(GameUnit &findable) = 0;
@@ -69,6 +72,6 @@ namespace wowpp
 
 	private:
 
-		const proto::MapEntry &m_map;
+		UInt32 m_mapId;
 	};
 }
@@ -30,6 +30,7 @@
 #include "each_tile_in_sight.h"
 #include "tile_subscriber.h"
 #include "common/constants.h"
+#include "common/tick_profiler.h"
 
 namespace wowpp
 {
@@ -47,6 +48,8 @@ namespace wowpp
 	{
 		m_moveUpdated.ended.connect([this]()
 		{
+			TickProfileScope zone(tick_zone::Movement);
+
 			GameTime time = getCurrentTime();
 			if (time >= m_moveEnd) {
 				return;
@@ -125,6 +128,8 @@ namespace wowpp
 
 	bool UnitMover::moveTo(const math::Vector3 &target, float customSpeed, const IShape *clipping/* = nullptr*/)
 	{
+		TickProfileScope zone(tick_zone::Movement);
+
 		auto &moved = getMoved();
 
 		// Dead units can't move
@@ -225,9 +230,10 @@ namespace wowpp
 			io::VectorSink sink(buffer);
 			game::Protocol::OutgoingPacket packet(sink);
 			game::server_write::monsterMove(packet, moved.getGuid(), currentLoc, path, moveTime - m_moveStart);
-			forEachSubscriberInSight(
+			forEachSubscriberInSightOf(
 				moved.getWorldInstance()->getGrid(),
 			    tile,
+			    moved.getGuid(),
 			    [&packet, &buffer, &moved](ITileSubscriber & subscriber)
 			{
 				if (!moved.canSpawnForCharacter(*subscriber.getControlledObject()))
@@ -292,9 +298,10 @@ namespace wowpp
 				game::Protocol::OutgoingPacket packet(sink);
 				game::server_write::monsterMove(packet, moved.getGuid(), currentLoc, { currentLoc }, 0);
 
-				forEachSubscriberInSight(
+				forEachSubscriberInSightOf(
 					moved.getWorldInstance()->getGrid(),
 				    tile,
+				    moved.getGuid(),
 				    [&packet, &buffer, &moved](ITileSubscriber & subscriber)
 				{
 					if (!moved.canSpawnForCharacter(*subscriber.getControlledObject()))
@@ -326,7 +333,8 @@ namespace wowpp
 		if (!isMoving())
 			return;
 
-		if (!getMoved().canSpawnForCharacter(*subscriber.getControlledObject()))
+		if (!getMoved().canSpawnForCharacter(*subscriber.getControlledObject()) ||
+			subscriber.isSpawnPending(getMoved().getGuid()))
 			return;
 
 		GameTime now = getCurrentTime();
@@ -27,6 +27,7 @@ namespace wowpp
 	Universe::Universe(boost::asio::io_service &ioService, TimerQueue &timers)
 		: m_ioService(ioService)
 		, m_timers(timers)
+		, m_spellPlans(nullptr)
 	{
 	}
 }
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "common/timer_queue.h"
+#include "spell_execution_plan.h"
 
 
 namespace wowpp
@@ -41,6 +42,15 @@ namespace wowpp
 		TimerQueue &getTimers() {
 			return m_timers;
 		}
+		/// Gets the precompiled spell execution plans of the active project or nullptr if none are set.
+		const SpellExecutionPlans *getSpellPlans() const {
+			return m_spellPlans;
+		}
+		/// Sets the precompiled spell execution plans of the active project. The plans have to stay
+		/// alive as long as spell casts of their project are running.
+		void setSpellPlans(const SpellExecutionPlans *spellPlans) {
+			m_spellPlans = spellPlans;
+		}
 
 		template<class Work>
 		void post(Work &&work)
@@ -52,5 +62,6 @@ namespace wowpp
 
 		boost::asio::io_service &m_ioService;
 		TimerQueue &m_timers;
+		const SpellExecutionPlans *m_spellPlans;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,126 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "update_field_visibility.h"
+#include "game_unit.h"
+#include "game_character.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Describes the visibility of a range of fields [first, last).
+		struct FieldRange
+		{
+			UInt32 first;
+			UInt32 last;
+			UpdateFieldVisibility visibility;
+		};
+
+		namespace ufv = update_field_visibility;
+
+		// Fields not listed here are public
+		static const FieldRange unitFieldRanges[] = {
+			{ unit_fields::RangedAttackTime,		unit_fields::BoundingRadius,			ufv::Owner },
+			{ unit_fields::MinDamage,				unit_fields::Bytes1,					ufv::Owner },
+			{ unit_fields::PetExperience,			unit_fields::DynamicFlags,				ufv::Owner },
+			{ unit_fields::TrainingPoints,			unit_fields::BaseMana,					ufv::Owner },
+			{ unit_fields::BaseHealth,				unit_fields::Bytes2,					ufv::Owner },
+			{ unit_fields::AttackPower,				unit_fields::UnitFieldCount,			ufv::Owner },
+		};
+
+		static const FieldRange characterFieldRanges[] = {
+			{ character_fields::QuestLog1_1,		character_fields::VisibleItem1_CREATOR,	ufv::Party },
+			{ character_fields::Pad0,				character_fields::CharacterFieldCount,	ufv::Owner },
+		};
+
+		static const UInt32 unitBlockCount = (unit_fields::UnitFieldCount + 31) / 32;
+		static const UInt32 characterBlockCount = (character_fields::CharacterFieldCount + 31) / 32;
+
+		template<size_t BlockCount>
+		struct FieldMasks
+		{
+			std::array<std::array<UInt32, BlockCount>, ufv::Count_> masks;
+
+			explicit FieldMasks(UInt32 fieldCount, std::initializer_list<std::pair<const FieldRange *, const FieldRange *>> tables)
+			{
+				for (UInt32 visibility = 0; visibility < ufv::Count_; ++visibility)
+				{
+					auto &mask = masks[visibility];
+					mask.fill(0);
+
+					// Start with all fields being visible
+					for (UInt32 i = 0; i < fieldCount; ++i)
+					{
+						mask[i >> 5] |= (1u << (i & 31));
+					}
+
+					// Remove fields which require a higher visibility
+					for (const auto &table : tables)
+					{
+						for (const auto *range = table.first; range != table.second; ++range)
+						{
+							if (range->visibility <= visibility)
+								continue;
+
+							for (UInt32 i = range->first; i < range->last; ++i)
+							{
+								mask[i >> 5] &= ~(1u << (i & 31));
+							}
+						}
+					}
+				}
+			}
+		};
+	}
+
+	const UInt32 *getUpdateFieldMask(ObjectType typeId, UpdateFieldVisibility visibility)
+	{
+		// Owners may see everything
+		if (visibility == ufv::Owner)
+		{
+			return nullptr;
+		}
+
+		switch (typeId)
+		{
+			case object_type::Unit:
+			{
+				static const FieldMasks<unitBlockCount> unitMasks(unit_fields::UnitFieldCount, {
+					{ std::begin(unitFieldRanges), std::end(unitFieldRanges) }
+				});
+				return unitMasks.masks[visibility].data();
+			}
+			case object_type::Character:
+			{
+				static const FieldMasks<characterBlockCount> characterMasks(character_fields::CharacterFieldCount, {
+					{ std::begin(unitFieldRanges), std::end(unitFieldRanges) },
+					{ std::begin(characterFieldRanges), std::end(characterFieldRanges) }
+				});
+				return characterMasks.masks[visibility].data();
+			}
+			default:
+				return nullptr;
+		}
+	}
+}
@@ -0,0 +1,34 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "game_object.h"
+
+namespace wowpp
+{
+	/// Gets a bit mask (one bit per field value, in the same layout as the value update bitset)
+	/// of all fields of an object type which may be sent to a receiver of the given visibility
+	/// class. The masks are built once from static field visibility tables.
+	/// @returns nullptr if all fields of the object type are visible to the receiver.
+	const UInt32 *getUpdateFieldMask(ObjectType typeId, UpdateFieldVisibility visibility);
+}
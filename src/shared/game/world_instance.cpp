@@ -38,6 +38,8 @@
 #include "creature_ai.h"
 #include "universe.h"
 #include "unit_mover.h"
+#include "object_pools.h"
+#include "spawn_stream.h"
 
 // Set this to 1, to only spawn exactly one timber wolf in northshire, northern
 // to the human starting zone. This makes debugging creature stuff easier, as the
@@ -49,6 +51,11 @@ namespace wowpp
 {
 	namespace
 	{
+		/// Uncompressed create block bytes all spawn streams of an instance may send per update.
+		static const size_t SpawnStreamBytesPerUpdate = 64 * 1024;
+		/// Time all spawn streams of an instance may spend on building create blocks per update.
+		static const std::chrono::microseconds SpawnStreamTimePerUpdate(2000);
+
 		static TileIndex2D getObjectTile(GameObject &object, VisibilityGrid &grid)
 		{
 			TileIndex2D gridIndex;
@@ -103,17 +110,23 @@ namespace wowpp
 		, m_objectIdGenerator(objectIdGenerator)
 		, m_itemIdGenerator(1)		// Start at an id of 1 as 0 is invalid
 		, m_project(project)
-		, m_mapEntry(mapEntry)
+		, m_mapEntry(&mapEntry)
 		, m_id(id)
 		, m_map(nullptr)
+		, m_nextSpawnStream(0)
+		, m_spawnStreamBytes(SpawnStreamBytesPerUpdate)
+		, m_spawnStreamTime(SpawnStreamTimePerUpdate)
+		, m_playerCount(0)
+		, m_emptySince(getCurrentTime())
+		, m_updateTimes(TickProfiler::HistorySize)
 	{
 		// Create map instance if needed
-		auto mapIt = MapData.find(m_mapEntry.id());
+		auto mapIt = MapData.find(m_mapEntry->id());
 		if (mapIt == MapData.end())
 		{
 			// Load map
-			MapData.insert(std::make_pair(m_mapEntry.id(), Map(m_mapEntry, dataPath)));
-			mapIt = MapData.find(m_mapEntry.id());
+			MapData.insert(std::make_pair(m_mapEntry->id(), Map(*m_mapEntry, dataPath)));
+			mapIt = MapData.find(m_mapEntry->id());
 			if (mapIt != MapData.end()) {
 				m_map = &mapIt->second;
 			}
@@ -127,12 +140,12 @@ namespace wowpp
 		}
 
 		// Add object spawners
-		for (int i = 0; i < m_mapEntry.objectspawns_size(); ++i)
+		for (int i = 0; i < m_mapEntry->objectspawns_size(); ++i)
 		{
 			// Create a new spawner
-			const auto &spawn = m_mapEntry.objectspawns(i);
+			const auto &spawn = m_mapEntry->objectspawns(i);
 
-			const auto *objectEntry = m_project.objects.getById(spawn.objectentry());
+			const auto *objectEntry = m_project.get().objects.getById(spawn.objectentry());
 			ASSERT(objectEntry);
 
 			std::unique_ptr<WorldObjectSpawner> spawner(new WorldObjectSpawner(
@@ -154,12 +167,12 @@ namespace wowpp
 		}
 
 		// Add creature spawners
-		for (int i = 0; i < m_mapEntry.unitspawns_size(); ++i)
+		for (int i = 0; i < m_mapEntry->unitspawns_size(); ++i)
 		{
 			// Create a new spawner
-			const auto &spawn = m_mapEntry.unitspawns(i);
+			const auto &spawn = m_mapEntry->unitspawns(i);
 
-			const auto *unitEntry = m_project.units.getById(spawn.unitentry());
+			const auto *unitEntry = m_project.get().units.getById(spawn.unitentry());
 			ASSERT(unitEntry);
 
 #if UNIT_DEBUG_MODE
@@ -186,7 +199,123 @@ namespace wowpp
 #endif
 		}
 
-		ILOG("Created instance of map " << m_mapEntry.id());
+		ILOG("Created instance of map " << m_mapEntry->id());
+	}
+
+	WorldInstance::~WorldInstance()
+	{
+		// Objects which are still spawned forget about this instance
+		willBeDestroyed();
+
+		// Destroy spawned objects before the unit finder and grids they might still reference
+		m_creatureSummons.clear();
+		m_creatureSpawnsByName.clear();
+		m_creatureSpawners.clear();
+		m_objectSpawnsByName.clear();
+		m_objectSpawners.clear();
+	}
+
+	void WorldInstance::bindPlayer()
+	{
+		++m_playerCount;
+	}
+
+	void WorldInstance::unbindPlayer()
+	{
+		ASSERT(m_playerCount > 0);
+		if (--m_playerCount == 0)
+		{
+			m_emptySince = getCurrentTime();
+		}
+	}
+
+	void WorldInstance::unload(std::unique_ptr<UnitFinder> &out_unitFinder, std::unique_ptr<VisibilityGrid> &out_visibilityGrid)
+	{
+		ASSERT(m_playerCount == 0);
+
+		// Despawn everything the regular way, which leaves the unit finder and grid empty. Removing
+		// an object may remove others (like dynamic objects) as well, so always restart.
+		while (!m_objectsById.empty())
+		{
+			removeGameObject(*m_objectsById.begin()->second);
+		}
+
+		out_unitFinder = std::move(m_unitFinder);
+		out_visibilityGrid = std::move(m_visibilityGrid);
+
+		ILOG("Unloaded instance " << m_id << " of map " << m_mapEntry->id());
+	}
+
+	bool WorldInstance::setProject(proto::Project &project)
+	{
+		if (&project == &m_project.get())
+		{
+			return true;
+		}
+
+		const auto *mapEntry = project.maps.getById(m_mapEntry->id());
+		if (!mapEntry)
+		{
+			WLOG("Map " << m_mapEntry->id() << " no longer exists in reloaded project - instance " << m_id << " keeps its current data");
+			return false;
+		}
+
+		if (static_cast<size_t>(mapEntry->objectspawns_size()) != m_objectSpawners.size() ||
+			static_cast<size_t>(mapEntry->unitspawns_size()) != m_creatureSpawners.size())
+		{
+			WLOG("Spawns of map " << m_mapEntry->id() << " changed - instance " << m_id << " keeps its current data until it is recreated");
+			return false;
+		}
+
+		// Resolve all entries first, so that a failure doesn't leave spawners of different projects behind
+		std::vector<const proto::ObjectEntry *> objectEntries(m_objectSpawners.size(), nullptr);
+		for (int i = 0; i < mapEntry->objectspawns_size(); ++i)
+		{
+			objectEntries[i] = project.objects.getById(mapEntry->objectspawns(i).objectentry());
+			if (!objectEntries[i])
+			{
+				WLOG("Object spawn " << i << " of map " << m_mapEntry->id() << " references an unknown object - instance " << m_id << " keeps its current data");
+				return false;
+			}
+		}
+
+		std::vector<const proto::UnitEntry *> unitEntries(m_creatureSpawners.size(), nullptr);
+		for (int i = 0; i < mapEntry->unitspawns_size(); ++i)
+		{
+			unitEntries[i] = project.units.getById(mapEntry->unitspawns(i).unitentry());
+			if (!unitEntries[i])
+			{
+				WLOG("Unit spawn " << i << " of map " << m_mapEntry->id() << " references an unknown unit - instance " << m_id << " keeps its current data");
+				return false;
+			}
+		}
+
+		// Rebind spawners
+		m_objectSpawnsByName.clear();
+		for (int i = 0; i < mapEntry->objectspawns_size(); ++i)
+		{
+			const auto &spawn = mapEntry->objectspawns(i);
+			m_objectSpawners[i]->setEntry(*objectEntries[i]);
+			if (!spawn.name().empty())
+			{
+				m_objectSpawnsByName[spawn.name()] = m_objectSpawners[i].get();
+			}
+		}
+
+		m_creatureSpawnsByName.clear();
+		for (int i = 0; i < mapEntry->unitspawns_size(); ++i)
+		{
+			const auto &spawn = mapEntry->unitspawns(i);
+			m_creatureSpawners[i]->setEntries(*unitEntries[i], spawn);
+			if (!spawn.name().empty())
+			{
+				m_creatureSpawnsByName[spawn.name()] = m_creatureSpawners[i].get();
+			}
+		}
+
+		m_project = proto::ProjectReference(project);
+		m_mapEntry = mapEntry;
+		return true;
 	}
 
 	std::shared_ptr<GameCreature> WorldInstance::spawnCreature(
@@ -196,13 +325,14 @@ namespace wowpp
 	    float randomWalkRadius)
 	{
 		// Create the unit
-		auto spawned = std::make_shared<GameCreature>(
-		                   m_project,
+		auto spawned = allocateShared<GameCreature>(
+		                   object_pools::creatures(),
+		                   m_project.get(),
 		                   m_universe.getTimers(),
 		                   entry);
 		spawned->initialize();
 		spawned->setGuid(createEntryGUID(m_objectIdGenerator.generateId(), entry.id(), guid_type::Unit));	// RealmID (TODO: these spawns don't need to have a specific realm id)
-		spawned->setMapId(m_mapEntry.id());
+		spawned->setMapId(m_mapEntry->id());
 		spawned->relocate(position, o);
 
 #if UNIT_DEBUG_MODE
@@ -215,13 +345,14 @@ namespace wowpp
 	std::shared_ptr<GameCreature> WorldInstance::spawnSummonedCreature(const proto::UnitEntry &entry, math::Vector3 position, float o)
 	{
 		// Create the unit
-		auto spawned = std::make_shared<GameCreature>(
-		                   m_project,
+		auto spawned = allocateShared<GameCreature>(
+		                   object_pools::creatures(),
+		                   m_project.get(),
 		                   m_universe.getTimers(),
 		                   entry);
 		spawned->setGuid(createEntryGUID(m_objectIdGenerator.generateId(), entry.id(), guid_type::Unit));	// RealmID (TODO: these spawns don't need to have a specific realm id)
 		spawned->initialize();
-		spawned->setMapId(m_mapEntry.id());
+		spawned->setMapId(m_mapEntry->id());
 		spawned->relocate(position, o);
 
 		m_creatureSummons.insert(std::make_pair(spawned->getGuid(), spawned));
@@ -240,13 +371,14 @@ namespace wowpp
 	std::shared_ptr<WorldObject> WorldInstance::spawnWorldObject(const proto::ObjectEntry &entry, math::Vector3 position, float o, float radius)
 	{
 		// Create the unit
-		auto spawned = std::make_shared<WorldObject>(
-		                   m_project,
+		auto spawned = allocateShared<WorldObject>(
+		                   object_pools::worldObjects(),
+		                   m_project.get(),
 		                   m_universe.getTimers(),
 		                   entry);
 		spawned->setGuid(createEntryGUID(m_objectIdGenerator.generateId(), entry.id(), guid_type::GameObject));	// RealmID (TODO: these spawns don't need to have a specific realm id)
 		spawned->initialize();
-		spawned->setMapId(m_mapEntry.id());
+		spawned->setMapId(m_mapEntry->id());
 		spawned->relocate(position, o);
 
 		return spawned;
@@ -254,6 +386,8 @@ namespace wowpp
 
 	void WorldInstance::update()
 	{
+		TickProfileScope zone(tick_zone::ObjectUpdates);
+
 		// Iterate all game objects added to this world which need to be updated
 		if (!m_objectUpdates.empty())
 		{
@@ -264,10 +398,62 @@ namespace wowpp
 		}
 
 		m_objectUpdates.clear();
+
+		// Send queued object spawns to entering players
+		streamSpawns();
+	}
+
+	void WorldInstance::streamSpawns()
+	{
+		if (m_spawnStreams.empty())
+		{
+			return;
+		}
+
+		// Start with another stream on every update, so that the budget is shared fairly
+		SpawnStreamBudget budget(m_spawnStreamBytes, m_spawnStreamTime);
+		const size_t count = m_spawnStreams.size();
+		m_nextSpawnStream %= count;
+		for (size_t i = 0; i < count && !budget.isExhausted(); ++i)
+		{
+			m_spawnStreams[(m_nextSpawnStream + i) % count]->send(budget);
+		}
+		++m_nextSpawnStream;
+
+		// Finished streams are added again when they queue new objects
+		m_spawnStreams.erase(
+			std::remove_if(m_spawnStreams.begin(), m_spawnStreams.end(), [](const SpawnStream *stream)
+			{
+				return stream->isEmpty();
+			}),
+			m_spawnStreams.end());
+	}
+
+	void WorldInstance::addSpawnStream(SpawnStream &stream)
+	{
+		if (std::find(m_spawnStreams.begin(), m_spawnStreams.end(), &stream) == m_spawnStreams.end())
+		{
+			m_spawnStreams.push_back(&stream);
+		}
+	}
+
+	void WorldInstance::removeSpawnStream(SpawnStream &stream)
+	{
+		m_spawnStreams.erase(
+			std::remove(m_spawnStreams.begin(), m_spawnStreams.end(), &stream),
+			m_spawnStreams.end());
+	}
+
+	void WorldInstance::setSpawnStreamBudget(size_t bytes, std::chrono::microseconds time)
+	{
+		m_spawnStreamBytes = bytes;
+		m_spawnStreamTime = time;
 	}
 
 	void WorldInstance::flushObjectUpdate(UInt64 guid)
 	{
+		TickProfileScope zone(tick_zone::ObjectUpdates);
+
 		auto *object = findObjectByGUID(guid);
 		if (object)
 		{
@@ -315,7 +501,9 @@ namespace wowpp
 					continue;
 				}
 
-				if (!added.canSpawnForCharacter(*character))
+				// Objects which are still queued for the subscriber will be spawned by its stream
+				if (!added.canSpawnForCharacter(*character) ||
+					subscriber->isSpawnPending(added.getGuid()))
 				{
 					continue;
 				}
@@ -413,10 +601,16 @@ namespace wowpp
 		forEachTileInSight(
 		    *m_visibilityGrid,
 		    tile.getPosition(),
-		    [&packet, &buffer](VisibilityTile & tile)
+		    [&packet, &buffer, guid](VisibilityTile & tile)
 		{
 			for (auto *subscriber : tile.getWatchers().getElements())
 			{
+				// The client never saw objects which are still queued for it
+				if (subscriber->isSpawnPending(guid))
+				{
+					continue;
+				}
+
 				subscriber->sendPacket(packet, buffer);
 			}
 		});
@@ -441,6 +635,8 @@ namespace wowpp
 
 	void WorldInstance::onObjectMoved(GameObject &object, const math::Vector3 &oldPosition, float oldO)
 	{
+		TickProfileScope zone(tick_zone::Movement);
+
 		// Calculate old tile index
 		TileIndex2D oldIndex;
 		m_visibilityGrid->getTilePosition(oldPosition, oldIndex[0], oldIndex[1]);
@@ -484,6 +680,10 @@ namespace wowpp
 					if (!object.canSpawnForCharacter(*character))
 						continue;
 
+					// The client never saw objects which are still queued for it
+					if (subscriber->isSpawnPending(guid))
+						continue;
+
 					// Don't despawn invisible objects that we can't see
 					if (object.isCreature() || object.isGameCharacter())
 					{
@@ -524,6 +724,10 @@ namespace wowpp
 					if (!object.canSpawnForCharacter(*character))
 						continue;
 
+					// Objects which are still queued for the subscriber will be spawned by its stream
+					if (subscriber->isSpawnPending(object.getGuid()))
+						continue;
+
 					// Dont spawn stealthed targets that we can't see yet
 					if (object.isCreature() || object.isGameCharacter())
 					{
@@ -569,9 +773,11 @@ namespace wowpp
 	{
 		// Send updates to all subscribers in sight
 		TileIndex2D center = getObjectTile(object, *m_visibilityGrid);
-		forEachSubscriberInSight(
+		// The create block of queued objects will contain the current values
+		forEachSubscriberInSightOf(
 			*m_visibilityGrid,
 			center,
+			object.getGuid(),
 			[&object](ITileSubscriber & subscriber)
 		{
 			auto *character = subscriber.getControlledObject();
@@ -24,6 +24,7 @@
 #include "common/typedefs.h"
 #include "game/game_object.h"
 #include "common/id_generator.h"
+#include "common/tick_profiler.h"
 #include "shared/proto_data/maps.pb.h"
 #include "game/visibility_grid.h"
 #include "creature_spawner.h"
@@ -45,6 +46,7 @@ namespace wowpp
 	class GameCreature;
 	class WorldObject;
 	class Universe;
+	class SpawnStream;
 	namespace proto
 	{
 		class Project;
@@ -73,7 +75,7 @@ namespace wowpp
 
 	public:
 
-		/// Fired when the world instance is about to be destroyed. TODO: Not fired at the moment.
+		/// Fired when the world instance is about to be destroyed.
 		simple::signal<void()> willBeDestroyed;
 
 	public:
@@ -98,6 +100,7 @@ namespace wowpp
 		    IdGenerator<UInt64> &objectIdGenerator,
 		    const String &dataPath
 		);
+		~WorldInstance();
 
 		/// Creates a new creature which will belong to this world instance. However,
 		/// the creature won't be spawned yet. This method is used by CreatureSpawner.
@@ -115,7 +118,7 @@ namespace wowpp
 		}
 		/// Gets the map id of this instance.
 		UInt32 getMapId() const {
-			return m_mapEntry.id();
+			return m_mapEntry->id();
 		}
 		///
 		UnitFinder &getUnitFinder() {
@@ -133,6 +136,40 @@ namespace wowpp
 		Universe &getUniverse() {
 			return m_universe;
 		}
+		/// Gets the project snapshot which is used for new spawns in this instance.
+		proto::Project &getProject() const {
+			return m_project.get();
+		}
+		/// Switches this instance to another project snapshot. Spawners are rebound to the new
+		/// entries so that respawns use the reloaded data, while objects which are already spawned
+		/// keep the snapshot they were created from. The switch is refused if the spawn layout of the
+		/// map changed, as spawners can't be matched to their new spawn entries then.
+		/// @returns true if the instance now uses the new project.
+		bool setProject(proto::Project &project);
+		/// Notifies the instance that a player has been bound to it. As long as there are bound
+		/// players, the instance is never considered idle.
+		void bindPlayer();
+		/// Notifies the instance that a bound player left it.
+		void unbindPlayer();
+		/// Gets the number of players bound to this instance.
+		UInt32 getPlayerCount() const {
+			return m_playerCount;
+		}
+		/// Gets the time since when there are no players bound to this instance (see getCurrentTime()).
+		GameTime getEmptySince() const {
+			return m_emptySince;
+		}
+		/// Gets the durations of the most recent updates of this instance. Only filled while the
+		/// tick profiler of the world instance manager is enabled.
+		RollingHistogram &getUpdateTimes() {
+			return m_updateTimes;
+		}
+		const RollingHistogram &getUpdateTimes() const {
+			return m_updateTimes;
+		}
+		/// Despawns all objects and hands out the unit finder and the visibility grid so that they
+		/// can be reused by another instance. The instance has to be destroyed afterwards.
+		void unload(std::unique_ptr<UnitFinder> &out_unitFinder, std::unique_ptr<VisibilityGrid> &out_visibilityGrid);
 		/// Adds a game object to this world instance.
 		void addGameObject(GameObject &added);
 		/// Removes a specific game object from this world.
@@ -143,6 +180,14 @@ namespace wowpp
 		void update();
 		/// Flushes an object update.
 		void flushObjectUpdate(UInt64 guid);
+		/// Lets a spawn stream send its queued create blocks on the next updates, until its queue
+		/// is empty. All streams of this instance share one budget per update.
+		void addSpawnStream(SpawnStream &stream);
+		/// Stops sending the queued create blocks of a spawn stream.
+		void removeSpawnStream(SpawnStream &stream);
+		/// Sets how many create block bytes and how much time all spawn streams of this instance may
+		/// use per update.
+		void setSpawnStreamBudget(size_t bytes, std::chrono::microseconds time);
 		/// Gets the map data of this instance. Note that instances share the same map data to save
 		/// memory.
 		Map *getMapData() {
@@ -193,9 +238,10 @@ namespace wowpp
 			f(packet);
 
 			// Send packet to all players nearby
-			forEachSubscriberInSight(
+			forEachSubscriberInSightOf(
 				*m_visibilityGrid,
 				tile,
+				source.getGuid(),
 				[&source, &packet, buffer](ITileSubscriber &subscriber)
 			{
 				auto *character = subscriber.getControlledObject();
@@ -215,6 +261,7 @@ namespace wowpp
 
 		void onObjectMoved(GameObject &object, const math::Vector3 &oldPosition, float oldO);
 		void updateObject(GameObject &object);
+		void streamSpawns();
 
 	private:
 
@@ -226,8 +273,8 @@ namespace wowpp
 		IdGenerator<UInt64> &m_objectIdGenerator;
 		IdGenerator<UInt64> m_itemIdGenerator;
 		GameObjectsById m_objectsById;
-		proto::Project &m_project;
-		const proto::MapEntry &m_mapEntry;
+		proto::ProjectReference m_project;
+		const proto::MapEntry *m_mapEntry;
 		UInt32 m_id;
 		CreatureSpawners m_creatureSpawners;
 		std::map<String, CreatureSpawner *> m_creatureSpawnsByName;
@@ -236,5 +283,12 @@ namespace wowpp
 		SummonedCreatures m_creatureSummons;
 		Map *m_map;
 		std::set<GameObject*> m_objectUpdates;
+		std::vector<SpawnStream*> m_spawnStreams;
+		size_t m_nextSpawnStream;
+		size_t m_spawnStreamBytes;
+		std::chrono::microseconds m_spawnStreamTime;
+		UInt32 m_playerCount;
+		GameTime m_emptySince;
+		RollingHistogram m_updateTimes;
 	};
 }
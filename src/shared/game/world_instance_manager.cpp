@@ -31,6 +31,9 @@
 
 namespace wowpp
 {
+	/// Interval in which instances are checked for being idle.
+	static const GameTime IdleCheckInterval = constants::OneSecond * 10;
+
 	WorldInstanceManager::WorldInstanceManager(
 	    boost::asio::io_service &ioService,
 	    Universe &universe,
@@ -45,30 +48,66 @@ namespace wowpp
 		, m_idGenerator(idGenerator)
 		, m_objectIdGenerator(objectIdGenerator)
 		, m_updateTimer(ioService)
-		, m_project(project)
+		, m_project(&project)
 		, m_worldNodeId(worldNodeId)
 		, m_dataPath(dataPath)
+		, m_averageTickDuration(0)
+		, m_idleTimeout(0)
+		, m_nextIdleCheck(0)
 	{
 		// Trigger the first update
 		triggerUpdate();
 	}
 
+	WorldInstanceManager::~WorldInstanceManager()
+	{
+		if (m_tickProfiler && TickProfiler::getActive() == m_tickProfiler.get())
+		{
+			TickProfiler::setActive(nullptr);
+		}
+	}
+
 	WorldInstance *WorldInstanceManager::createInstance(const proto::MapEntry &map)
 	{
 		UInt32 instanceId = createMapGUID(m_idGenerator.generateId(), map.id());
 
+		// Reuse the grids of unloaded instances if possible, as they are quite large
+		std::unique_ptr<UnitFinder> unitFinder;
+		if (!m_unitFinderPool.empty())
+		{
+			unitFinder = std::move(m_unitFinderPool.back());
+			m_unitFinderPool.pop_back();
+			unitFinder->reset(map);
+		}
+		else
+		{
+			unitFinder.reset(new TiledUnitFinder(map, 33.3333f));
+		}
+
+		std::unique_ptr<VisibilityGrid> visibilityGrid;
+		if (!m_visibilityGridPool.empty())
+		{
+			visibilityGrid = std::move(m_visibilityGridPool.back());
+			m_visibilityGridPool.pop_back();
+		}
+		else
+		{
+			visibilityGrid.reset(new SolidVisibilityGrid(TileIndex2D(64, 64)));
+		}
+
 		// Create world instance
 		std::unique_ptr<WorldInstance> instance(new WorldInstance(
 		        *this,
 		        m_universe,
 		        m_triggerHandler,
-		        m_project,
+		        *m_project,
 		        map,
 		        instanceId,
-		        std::unique_ptr<UnitFinder>(new TiledUnitFinder(map, 33.3333f)),
-		        std::unique_ptr<VisibilityGrid>(new SolidVisibilityGrid(TileIndex2D(64, 64))),
+		        std::move(unitFinder),
+		        std::move(visibilityGrid),
 		        m_objectIdGenerator,
 		        m_dataPath));
+		m_instancesById[instanceId] = instance.get();
 		m_instances.push_back(std::move(instance));
 
 		// Return result
@@ -76,6 +115,22 @@ namespace wowpp
 		return m_instances.back().get();
 	}
 
+	void WorldInstanceManager::setProject(proto::Project &project)
+	{
+		m_project = &project;
+
+		size_t rebound = 0;
+		for (auto &instance : m_instances)
+		{
+			if (instance->setProject(project))
+			{
+				++rebound;
+			}
+		}
+
+		ILOG("Switched " << rebound << " of " << m_instances.size() << " world instances to the reloaded project");
+	}
+
 	void WorldInstanceManager::triggerUpdate()
 	{
 		// Wait for next update
@@ -100,35 +155,145 @@ namespace wowpp
 		}
 		else
 		{
-			// Iterate through every world instance and update it
-			for (auto &instance : m_instances)
+			updateInstances();
+
+			// Trigger the next update
+			triggerUpdate();
+		}
+	}
+
+	void WorldInstanceManager::updateInstances()
+	{
+		const auto tickStart = std::chrono::steady_clock::now();
+		if (m_tickProfiler)
+		{
+			m_tickProfiler->beginTick();
+		}
+
+		// Iterate through every world instance and update it
+		for (auto &instance : m_instances)
+		{
+			if (!m_tickProfiler)
 			{
 				instance->update();
+				continue;
 			}
 
-			// Trigger the next update
-			triggerUpdate();
+			const auto updateStart = std::chrono::steady_clock::now();
+			instance->update();
+			instance->getUpdateTimes().add(static_cast<UInt32>(std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - updateStart).count()));
+		}
+
+		// Smooth the tick duration so that single spikes don't affect the reported load too much
+		const auto tickDuration = static_cast<UInt32>(std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - tickStart).count());
+		m_averageTickDuration = (m_averageTickDuration * 7 + tickDuration) / 8;
+
+		// Check for idle instances from time to time
+		const GameTime now = getCurrentTime();
+		if (m_idleTimeout > 0 && now >= m_nextIdleCheck)
+		{
+			m_nextIdleCheck = now + IdleCheckInterval;
+			unloadIdleInstances();
+		}
+
+		if (m_tickProfiler)
+		{
+			m_tickProfiler->endTick();
 		}
 	}
 
-	WorldInstance *WorldInstanceManager::getInstanceById(UInt32 instanceId)
+	void WorldInstanceManager::enableTickProfiler(UInt32 budget)
 	{
-		const auto i = std::find_if(
-		                   m_instances.begin(),
-		                   m_instances.end(),
-		                   [instanceId](const std::unique_ptr<WorldInstance> &i)
+		m_tickProfiler.reset(new TickProfiler(budget));
+		TickProfiler::setActive(m_tickProfiler.get());
+	}
+
+	void WorldInstanceManager::writeTickProfile(std::ostream &out) const
+	{
+		out << "{\"node\":";
+		if (m_tickProfiler)
 		{
-			return (instanceId == i->getId());
-		});
+			m_tickProfiler->writeJson(out);
+		}
+		else
+		{
+			out << "null";
+		}
 
-		if (i != m_instances.end())
+		out << ",\"instances\":[";
+		for (size_t i = 0; i < m_instances.size(); ++i)
 		{
-			return (*i).get();
+			auto &instance = *m_instances[i];
+			if (i) out << ",";
+			out << "{\"id\":" << instance.getId()
+				<< ",\"map\":" << instance.getMapId()
+				<< ",\"players\":" << instance.getPlayerCount()
+				<< ",\"update\":";
+			instance.getUpdateTimes().writeJson(out);
+			out << "}";
+		}
+		out << "]}";
+	}
+
+	void WorldInstanceManager::stopUpdates()
+	{
+		m_updateTimer.cancel();
+	}
+
+	WorldInstance *WorldInstanceManager::getInstanceById(UInt32 instanceId)
+	{
+		const auto it = m_instancesById.find(instanceId);
+		if (it != m_instancesById.end())
+		{
+			return it->second;
 		}
 
 		return nullptr;
 	}
 
+	void WorldInstanceManager::unloadIdleInstances()
+	{
+		const GameTime now = getCurrentTime();
+
+		auto it = m_instances.begin();
+		while (it != m_instances.end())
+		{
+			auto &instance = **it;
+
+			// Global maps are always kept loaded
+			const auto *map = instance.getProject().maps.getById(instance.getMapId());
+			const bool isGlobal = !map || map->instancetype() == proto::MapEntry_MapInstanceType_GLOBAL;
+			if (isGlobal ||
+				instance.getPlayerCount() > 0 ||
+				now - instance.getEmptySince() < m_idleTimeout)
+			{
+				++it;
+				continue;
+			}
+
+			// Give others the chance to save instance state
+			instanceUnloading(instance);
+
+			std::unique_ptr<UnitFinder> unitFinder;
+			std::unique_ptr<VisibilityGrid> visibilityGrid;
+			instance.unload(unitFinder, visibilityGrid);
+
+			if (unitFinder && m_unitFinderPool.size() < MaxPooledGrids)
+			{
+				m_unitFinderPool.push_back(std::move(unitFinder));
+			}
+			if (visibilityGrid && m_visibilityGridPool.size() < MaxPooledGrids)
+			{
+				m_visibilityGridPool.push_back(std::move(visibilityGrid));
+			}
+
+			m_instancesById.erase(instance.getId());
+			it = m_instances.erase(it);
+		}
+	}
+
 	WorldInstance *WorldInstanceManager::getInstanceByMapId(UInt32 MapId)
 	{
 		const auto i = std::find_if(
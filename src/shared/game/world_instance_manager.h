@@ -51,6 +51,14 @@ namespace wowpp
 
 		typedef std::vector<std::unique_ptr<WorldInstance>> Instances;
 
+		/// Maximum number of unit finders and visibility grids kept for reuse.
+		static const size_t MaxPooledGrids = 4;
+
+	public:
+
+		/// Fired before an idle instance is unloaded, so that its state can be saved.
+		simple::signal<void(WorldInstance &)> instanceUnloading;
+
 	public:
 
 		explicit WorldInstanceManager(boost::asio::io_service &ioService,
@@ -61,22 +69,61 @@ namespace wowpp
 		                              proto::Project &project,
 		                              UInt32 worldNodeId,
 		                              const String &dataPath);
+		~WorldInstanceManager();
 
 		/// Creates a new world instance of a specific map id.
 		WorldInstance *createInstance(const proto::MapEntry &map);
 		/// Called once per frame to update all worlds.
 		void update(const boost::system::error_code &error);
+		/// Updates all world instances once. This is done by the update timer, but may also be
+		/// called directly after stopUpdates() to drive the world manually (benchmarks for example).
+		void updateInstances();
+		/// Stops the update timer, so that instances are no longer updated automatically.
+		void stopUpdates();
 		///
 		WorldInstance *getInstanceById(UInt32 instanceId);
 		///
 		WorldInstance *getInstanceByMapId(UInt32 MapId);
+		/// Sets the project which is used for new instances and passes it on to all existing instances.
+		void setProject(proto::Project &project);
+		/// Sets the time after which instanced (non-global) maps without players are unloaded.
+		/// @param timeout Timeout in milliseconds or 0 to keep instances forever.
+		void setIdleTimeout(GameTime timeout) {
+			m_idleTimeout = timeout;
+		}
 		Universe &getUniverse() {
 			return m_universe;
 		}
+		/// Gets all running world instances.
+		const Instances &getInstances() const {
+			return m_instances;
+		}
+		/// Gets the number of visibility grids of unloaded instances which are kept for reuse.
+		size_t getPooledGridCount() const {
+			return m_visibilityGridPool.size();
+		}
+		/// Gets the average duration of an update of all world instances in microseconds.
+		UInt32 getAverageTickDuration() const {
+			return m_averageTickDuration;
+		}
+		/// Enables the tick profiler, which records tick durations and the time spent in each
+		/// subsystem, and logs ticks which exceed the budget.
+		/// @param budget Tick duration in microseconds.
+		void enableTickProfiler(UInt32 budget);
+		/// Determines whether the tick profiler is enabled.
+		bool isTickProfilerEnabled() const {
+			return m_tickProfiler != nullptr;
+		}
+		/// Writes the tick profile of this node and the update times of all instances as json object.
+		void writeTickProfile(std::ostream &out) const;
 
 	private:
 
+		typedef std::unordered_map<UInt32, WorldInstance *> InstancesById;
+
 		void triggerUpdate();
+		/// Unloads all instanced maps which didn't have any players for the idle timeout.
+		void unloadIdleInstances();
 
 	private:
 
@@ -86,8 +133,15 @@ namespace wowpp
 		IdGenerator<UInt64> &m_objectIdGenerator;
 		boost::asio::deadline_timer m_updateTimer;
 		Instances m_instances;
-		proto::Project &m_project;
+		proto::Project *m_project;
 		UInt32 m_worldNodeId;
 		const String &m_dataPath;
+		UInt32 m_averageTickDuration;
+		InstancesById m_instancesById;
+		GameTime m_idleTimeout;
+		GameTime m_nextIdleCheck;
+		std::vector<std::unique_ptr<UnitFinder>> m_unitFinderPool;
+		std::vector<std::unique_ptr<VisibilityGrid>> m_visibilityGridPool;
+		std::unique_ptr<TickProfiler> m_tickProfiler;
 	};
 }
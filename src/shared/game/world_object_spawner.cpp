@@ -44,7 +44,7 @@ namespace wowpp
 	    UInt32 animProgress,
 	    UInt32 state)
 		: m_world(world)
-		, m_entry(entry)
+		, m_entry(&entry)
 		, m_maxCount(maxCount)
 		, m_respawnDelay(respawnDelay)
 		, m_center(center)
@@ -79,8 +79,8 @@ namespace wowpp
 		const float o = m_orientation ? *m_orientation : 0.0f;
 
 		// Spawn a new creature
-		auto spawned = m_world.spawnWorldObject(m_entry, position, o, m_radius);
-		spawned->setFloatValue(object_fields::ScaleX, m_entry.scale());
+		auto spawned = m_world.spawnWorldObject(*m_entry, position, o, m_radius);
+		spawned->setFloatValue(object_fields::ScaleX, m_entry->scale());
 		spawned->setFloatValue(world_object_fields::Rotation + 0, m_rotation[0]);
 		spawned->setFloatValue(world_object_fields::Rotation + 1, m_rotation[1]);
 		float rot2 = m_rotation[2], rot3 = m_rotation[3];
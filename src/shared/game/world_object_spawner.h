@@ -60,6 +60,11 @@ namespace wowpp
 		const OwnedObjects &getSpawnedObjects() const {
 			return m_objects;
 		}
+		/// Points this spawner to an entry of another project snapshot. Objects which are already
+		/// spawned keep their current data, new spawns will use the new entry.
+		void setEntry(const proto::ObjectEntry &entry) {
+			m_entry = &entry;
+		}
 
 	private:
 
@@ -76,7 +81,7 @@ namespace wowpp
 	private:
 
 		WorldInstance &m_world;
-		const proto::ObjectEntry &m_entry;
+		const proto::ObjectEntry *m_entry;
 		const size_t m_maxCount;
 		const GameTime m_respawnDelay;
 		const math::Vector3 m_center;
@@ -24,6 +24,7 @@
 
 #include "common/typedefs.h"
 #include "network/buffer.h"
+#include "network/receive_buffer.h"
 #include "network/receive_state.h"
 #include "common/assign_on_exit.h"
 #include "binary_io/string_sink.h"
@@ -130,6 +131,11 @@ namespace wowpp
 				beginSend();
 			}
 
+			void setReceiveSize(size_t size) override
+			{
+				m_received.setReadSize(size);
+			}
+
 			void close() override
 			{
 				if (m_isParsingIncomingData)
@@ -154,7 +160,7 @@ namespace wowpp
 
 			void sendBuffer(const Buffer &data)
 			{
-				m_sendBuffer(data.data(), data.size());
+				m_sendBuffer.append(data.data(), data.size());
 			}
 
 			MySocket &getSocket() {
@@ -168,15 +174,12 @@ namespace wowpp
 
 		private:
 
-			typedef std::array<char, 4096> ReceiveBuffer;
-
 			std::unique_ptr<Socket> m_socket;
 			Listener *m_listener;
 			Buffer m_sending;
 			Buffer m_sendBuffer;
-			Buffer m_received;
+			ReceiveBuffer m_received;
 			game::Crypt m_crypt;
-			ReceiveBuffer m_receiving;
 			bool m_isParsingIncomingData;
 			bool m_isClosedOnParsing;
 			size_t m_decryptedUntil;
@@ -210,8 +213,11 @@ namespace wowpp
 					return;
 
 				m_isReceiving = true;
+
+				// Read directly into the receive buffer
+				char *const writePos = m_received.prepare();
 				m_socket->async_read_some(
-				    boost::asio::buffer(m_receiving.data(), m_receiving.size()),
+				    boost::asio::buffer(writePos, m_received.getWritableSize()),
 				    std::bind(&CryptedConnection<P, Socket>::received, this->shared_from_this(), std::placeholders::_2));
 			}
 
@@ -219,17 +225,14 @@ namespace wowpp
 			{
 				m_isReceiving = false;
 
-				ASSERT(size <= m_receiving.size());
+				ASSERT(size <= m_received.getWritableSize());
 				if (size == 0)
 				{
 					disconnected();
 					return;
 				}
 
-				m_received.append(
-				    m_receiving.begin(),
-				    m_receiving.begin() + size);
-
+				m_received.commit(size);
 				parsePackets();
 			}
 			
@@ -251,14 +254,14 @@ namespace wowpp
 					if (m_decryptedUntil <= parsedUntil &&
 						availableSize >= game::Crypt::CryptedReceiveLength)
 					{
-						m_crypt.decryptReceive(reinterpret_cast<UInt8 *>(&m_received[0] + parsedUntil), game::Crypt::CryptedReceiveLength);
+						m_crypt.decryptReceive(reinterpret_cast<UInt8 *>(m_received.data() + parsedUntil), game::Crypt::CryptedReceiveLength);
 
 						// This will prevent double-decryption of the header (which would produce
 						// invalid packet sizes)
 						m_decryptedUntil = parsedUntil + game::Crypt::CryptedReceiveLength;
 					}
 
-					const char *const packetBegin = &m_received[0] + parsedUntil;
+					const char *const packetBegin = m_received.data() + parsedUntil;
 					const char *const streamEnd = packetBegin + availableSize;
 
 					io::MemorySource source(packetBegin, streamEnd);
@@ -273,7 +276,8 @@ namespace wowpp
 						case receive_state::Complete:
 							if (m_listener)
 							{
-								auto result = m_listener->connectionPacketReceived(packet);
+								auto result = this->dispatchReceivedPacket(*m_listener, packet,
+									static_cast<std::size_t>(source.getPosition() - source.getBegin()));
 								switch (result)
 								{
 								case PacketParseResult::Pass:
@@ -317,12 +321,10 @@ namespace wowpp
 				{
 					ASSERT(parsedUntil <= m_received.size());
 
-					m_received.erase(
-						m_received.begin(),
-						m_received.begin() + static_cast<std::ptrdiff_t>(parsedUntil));
+					m_received.consume(parsedUntil);
 
-					// Reset
-					m_decryptedUntil = 0;
+					// Keep track of an already decrypted header of the next, incomplete packet
+					m_decryptedUntil = (m_decryptedUntil > parsedUntil) ? m_decryptedUntil - parsedUntil : 0;
 				}
 
 				beginReceive();
@@ -522,45 +522,43 @@ namespace wowpp
 				out_packet.finish();
 			}
 
-			void compressedUpdateObject(game::OutgoingPacket &out_packet, const std::vector<std::vector<char>> &blocks)
+			void compressedUpdateObject(game::OutgoingPacket &out_packet, const std::vector<std::vector<char>> &blocks, UpdateCompression compression/* = update_compression::Update*/)
 			{
-				// Create buffer
-				std::stringstream strm;
-				io::StreamSink sink(strm);
-				io::Writer writer(sink);
-
-				// Write blocks
-				writer
-				        << io::write<NetUInt32>(blocks.size())
-				        << io::write<NetUInt8>(0x00);			// hasTransport = false
+				// Uncompressed header, built on the stack: little endian block count and hasTransport = false
+				const UInt32 blockCount = static_cast<UInt32>(blocks.size());
+				const std::array<char, 5> header =
+				{
+					static_cast<char>(blockCount & 0xFF),
+					static_cast<char>((blockCount >> 8) & 0xFF),
+					static_cast<char>((blockCount >> 16) & 0xFF),
+					static_cast<char>((blockCount >> 24) & 0xFF),
+					0x00
+				};
 
-				// Append blocks uncompressed
+				// Get original size
+				size_t origSize = header.size();
 				for (auto &block : blocks)
 				{
-					writer
-					        << io::write_range(block);
+					origSize += block.size();
 				}
 
-				// Get original size
-				size_t origSize = writer.sink().position();
-
-				// Compress using ZLib
-				boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-				in.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_compression));
-				in.push(strm);
-
-				// Copy to output stream
-				std::stringstream outStrm;
-				boost::iostreams::copy(in, outStrm);
-				outStrm.seekg(0, std::ios::beg);
-
-				String buffer = outStrm.str();
-
-				// Write packet
 				out_packet.start(server_packet::CompressedUpdateObject);
 				out_packet
-				        << io::write<NetUInt32>(origSize)
-				        << io::write_range(buffer);
+				        << io::write<NetUInt32>(origSize);
+
+				// Compress using ZLib directly into the packet buffer
+				auto &compressor = UpdateCompressor::getThreadInstance();
+				compressor.begin(out_packet.sink(), getUpdateCompressionLevel(compression));
+				compressor.write(header.data(), header.size());
+				for (auto &block : blocks)
+				{
+					if (!block.empty())
+					{
+						compressor.write(block.data(), block.size());
+					}
+				}
+				compressor.finish();
+
 				out_packet.finish();
 			}
 
@@ -34,6 +34,7 @@
 #include "game/spell_target_map.h"
 #include "proto_data/project.h"
 #include "op_codes.h"
+#include "update_compressor.h"
 #include "game/mail.h"
 
 namespace wowpp
@@ -1255,7 +1256,8 @@ namespace wowpp
 
 			void compressedUpdateObject(
 			    game::OutgoingPacket &out_packet,
-			    const std::vector<std::vector<char>> &blocks
+			    const std::vector<std::vector<char>> &blocks,
+			    UpdateCompression compression = update_compression::Update
 			);
 
 			void accountDataTimes(
@@ -0,0 +1,147 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "update_compressor.h"
+#include "common/macros.h"
+
+namespace wowpp
+{
+	namespace game
+	{
+		namespace
+		{
+			std::array<std::atomic<Int32>, update_compression::Count_> s_compressionLevels = {{
+				{ Z_BEST_SPEED },			// Update
+				{ Z_BEST_COMPRESSION }		// Spawn
+			}};
+		}
+
+		void setUpdateCompressionLevel(UpdateCompression type, Int32 level)
+		{
+			ASSERT(type < update_compression::Count_);
+			s_compressionLevels[type] = std::max<Int32>(Z_NO_COMPRESSION, std::min<Int32>(level, Z_BEST_COMPRESSION));
+		}
+
+		Int32 getUpdateCompressionLevel(UpdateCompression type)
+		{
+			ASSERT(type < update_compression::Count_);
+			return s_compressionLevels[type];
+		}
+
+		UpdateCompressor::UpdateCompressor()
+			: m_level(Z_BEST_COMPRESSION)
+			, m_sink(nullptr)
+		{
+			std::memset(&m_stream, 0, sizeof(m_stream));
+			if (deflateInit(&m_stream, m_level) != Z_OK)
+			{
+				throw std::runtime_error("Could not initialize zlib deflate stream");
+			}
+		}
+
+		UpdateCompressor::~UpdateCompressor()
+		{
+			deflateEnd(&m_stream);
+		}
+
+		void UpdateCompressor::begin(io::ISink &sink, Int32 level)
+		{
+			ASSERT(!m_sink);
+
+			m_sink = &sink;
+
+			// Reuse the existing zlib state instead of allocating a new one
+			deflateReset(&m_stream);
+			if (level != m_level)
+			{
+				// Some zlib versions (1.2.9 - 1.2.11) flush a block here even though nothing has been
+				// compressed yet, which writes the stream header. So this output has to be forwarded, too.
+				m_stream.next_in = nullptr;
+				m_stream.avail_in = 0;
+				m_stream.next_out = reinterpret_cast<Bytef *>(m_chunk.data());
+				m_stream.avail_out = static_cast<uInt>(m_chunk.size());
+
+				const int result = deflateParams(&m_stream, level, Z_DEFAULT_STRATEGY);
+				ASSERT(result == Z_OK);
+
+				const size_t produced = m_chunk.size() - m_stream.avail_out;
+				if (produced > 0)
+				{
+					m_sink->write(m_chunk.data(), produced);
+				}
+
+				m_level = level;
+			}
+		}
+
+		void UpdateCompressor::write(const char *data, size_t size)
+		{
+			ASSERT(m_sink);
+
+			m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+			m_stream.avail_in = static_cast<uInt>(size);
+			deflateInput(Z_NO_FLUSH);
+		}
+
+		void UpdateCompressor::finish()
+		{
+			ASSERT(m_sink);
+
+			m_stream.next_in = nullptr;
+			m_stream.avail_in = 0;
+			deflateInput(Z_FINISH);
+
+			m_sink = nullptr;
+		}
+
+		void UpdateCompressor::deflateInput(int flush)
+		{
+			for (;;)
+			{
+				m_stream.next_out = reinterpret_cast<Bytef *>(m_chunk.data());
+				m_stream.avail_out = static_cast<uInt>(m_chunk.size());
+
+				const int result = deflate(&m_stream, flush);
+				ASSERT(result != Z_STREAM_ERROR);
+
+				const size_t produced = m_chunk.size() - m_stream.avail_out;
+				if (produced > 0)
+				{
+					m_sink->write(m_chunk.data(), produced);
+				}
+
+				// Output buffer wasn't filled completely, so all input has been consumed
+				if (flush == Z_FINISH ? (result == Z_STREAM_END) : (m_stream.avail_out != 0))
+				{
+					break;
+				}
+			}
+		}
+
+		UpdateCompressor &UpdateCompressor::getThreadInstance()
+		{
+			static thread_local UpdateCompressor compressor;
+			return compressor;
+		}
+	}
+}
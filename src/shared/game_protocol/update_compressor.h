@@ -0,0 +1,89 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "binary_io/sink.h"
+#include <zlib.h>
+
+namespace wowpp
+{
+	namespace game
+	{
+		namespace update_compression
+		{
+			enum Type
+			{
+				/// Object updates and spawns while playing, which are sent very frequently.
+				Update,
+				/// Spawn bursts like the initial world enter, where bandwidth matters more than cpu time.
+				Spawn,
+
+				Count_
+			};
+		}
+
+		typedef update_compression::Type UpdateCompression;
+
+		/// Sets the zlib compression level (0-9) used for a class of update packets.
+		void setUpdateCompressionLevel(UpdateCompression type, Int32 level);
+		/// Gets the zlib compression level used for a class of update packets.
+		Int32 getUpdateCompressionLevel(UpdateCompression type);
+
+		/// Reusable zlib deflate stream which writes its output directly into a sink. The
+		/// internal zlib state is only allocated once and reset for every new stream.
+		class UpdateCompressor final
+		{
+		public:
+
+			explicit UpdateCompressor();
+			~UpdateCompressor();
+
+			UpdateCompressor(const UpdateCompressor &Other) = delete;
+			UpdateCompressor &operator=(const UpdateCompressor &Other) = delete;
+
+			/// Starts a new zlib stream.
+			/// @param sink The sink which will receive the compressed data.
+			/// @param level The zlib compression level to use.
+			void begin(io::ISink &sink, Int32 level);
+			/// Compresses a chunk of data.
+			void write(const char *data, size_t size);
+			/// Flushes all pending output and ends the current zlib stream.
+			void finish();
+
+			/// Gets the compressor instance of the calling thread.
+			static UpdateCompressor &getThreadInstance();
+
+		private:
+
+			void deflateInput(int flush);
+
+		private:
+
+			z_stream m_stream;
+			Int32 m_level;
+			io::ISink *m_sink;
+			std::array<char, 8192> m_chunk;
+		};
+	}
+}
@@ -31,6 +31,8 @@ namespace wowpp
 			{
 				std::string host;
 				std::string document;
+				/// If not zero, only the bytes starting at this offset are requested.
+				boost::uintmax_t rangeBegin = 0;
 			};
 		}
 	}
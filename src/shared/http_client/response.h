@@ -32,6 +32,7 @@ namespace wowpp
 				enum
 				{
 				    Ok = 200,
+				    PartialContent = 206,
 				    NotFound = 404
 				};
 
@@ -0,0 +1,100 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "async_log_sink.h"
+#include "default_log_levels.h"
+
+namespace wowpp
+{
+	AsyncLogSink::AsyncLogSink(Handler handler, size_t capacity/* = 8192*/)
+		: m_ring(capacity)
+		, m_handler(std::move(handler))
+		, m_reportedDrops(0)
+		, m_pushed(0)
+		, m_handled(0)
+		, m_stop(false)
+	{
+		m_worker = std::thread(std::bind(&AsyncLogSink::run, this));
+	}
+
+	AsyncLogSink::~AsyncLogSink()
+	{
+		m_stop = true;
+		m_worker.join();
+	}
+
+	bool AsyncLogSink::push(const LogEntry &entry)
+	{
+		if (!m_ring.tryPush(LogEntry(entry)))
+		{
+			return false;
+		}
+
+		++m_pushed;
+		return true;
+	}
+
+	void AsyncLogSink::flush()
+	{
+		const UInt64 pushed = m_pushed;
+		while (m_handled < pushed)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	void AsyncLogSink::run()
+	{
+		while (!m_stop)
+		{
+			drain();
+
+			// Producers never wait for us, so we poll instead of being notified
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		// Write everything which has been queued until now
+		drain();
+	}
+
+	void AsyncLogSink::drain()
+	{
+		LogEntry entry;
+		while (m_ring.tryPop(entry))
+		{
+			m_handler(entry);
+			++m_handled;
+		}
+
+		// Report dropped entries in the log itself
+		const UInt64 dropped = m_ring.getDroppedCount();
+		if (dropped != m_reportedDrops)
+		{
+			std::ostringstream strm;
+			strm << (dropped - m_reportedDrops) << " log entries were dropped because the log queue was full (" << dropped << " total)";
+			m_handler(LogEntry(g_WarningLevel, strm.str(), std::chrono::system_clock::now()));
+
+			m_reportedDrops = dropped;
+		}
+	}
+}
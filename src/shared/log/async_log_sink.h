@@ -0,0 +1,75 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "log_ring.h"
+#include <functional>
+#include <thread>
+
+namespace wowpp
+{
+	/// Hands log entries over to a background thread through a lock-free ring buffer, so
+	/// that threads which produce log messages never wait for slow sinks like files.
+	class AsyncLogSink final
+	{
+	public:
+
+		typedef std::function<void(const LogEntry &)> Handler;
+
+		/// Starts the background thread.
+		/// @param handler Called by the background thread for every queued entry.
+		/// @param capacity Maximum number of pending entries. Further entries are dropped.
+		explicit AsyncLogSink(Handler handler, size_t capacity = 8192);
+		/// Writes all pending entries and stops the background thread.
+		~AsyncLogSink();
+
+		AsyncLogSink(const AsyncLogSink &Other) = delete;
+		AsyncLogSink &operator=(const AsyncLogSink &Other) = delete;
+
+		/// Queues a log entry without blocking.
+		/// @returns false if the queue was full and the entry has been dropped.
+		bool push(const LogEntry &entry);
+		/// Waits until all entries which have been queued until now have been handled.
+		void flush();
+		/// Gets the total number of entries which were dropped because the queue was full.
+		UInt64 getDroppedCount() const {
+			return m_ring.getDroppedCount();
+		}
+
+	private:
+
+		void run();
+		void drain();
+
+	private:
+
+		LogRing m_ring;
+		Handler m_handler;
+		UInt64 m_reportedDrops;
+		std::atomic<UInt64> m_pushed;
+		std::atomic<UInt64> m_handled;
+		std::atomic<bool> m_stop;
+		std::thread m_worker;
+	};
+}
@@ -35,13 +35,16 @@ namespace wowpp
 #define WOWPP_LOG_FORMATTER_NAME _wowpp_log_formatter_
 #define WOWPP_LOG(level, message) \
 	{ \
-		::std::basic_ostringstream<char> WOWPP_LOG_FORMATTER_NAME; \
-		WOWPP_LOG_FORMATTER_NAME << message; \
-		::wowpp::g_DefaultLog.signal()( \
-		                                ::wowpp::LogEntry(level, \
-		                                        WOWPP_LOG_FORMATTER_NAME.str(), \
-		                                        ::std::chrono::system_clock::now() \
-		                                                 ) \
-		                              ); \
+		if (::wowpp::g_DefaultLog.isEnabled(level)) \
+		{ \
+			::std::basic_ostringstream<char> WOWPP_LOG_FORMATTER_NAME; \
+			WOWPP_LOG_FORMATTER_NAME << message; \
+			::wowpp::g_DefaultLog.signal()( \
+			                                ::wowpp::LogEntry(level, \
+			                                        WOWPP_LOG_FORMATTER_NAME.str(), \
+			                                        ::std::chrono::system_clock::now() \
+			                                                 ) \
+			                              ); \
+		} \
 	}
 }
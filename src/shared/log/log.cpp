@@ -25,6 +25,7 @@
 namespace wowpp
 {
 	Log::Log()
+		: m_minimumImportance(log_importance::Low)
 	{
 	}
 
@@ -42,4 +43,14 @@ namespace wowpp
 	{
 		return m_formatter;
 	}
+
+	void Log::setMinimumImportance(LogImportance importance)
+	{
+		m_minimumImportance.store(importance, std::memory_order_relaxed);
+	}
+
+	LogImportance Log::getMinimumImportance() const
+	{
+		return static_cast<LogImportance>(m_minimumImportance.load(std::memory_order_relaxed));
+	}
 }
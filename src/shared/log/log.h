@@ -23,6 +23,7 @@
 
 #include "common/typedefs.h"
 #include "log_level.h"
+#include <atomic>
 
 namespace wowpp
 {
@@ -41,10 +42,20 @@ namespace wowpp
 		Signal &signal();
 		const Signal &signal() const;
 		Formatter &getFormatter();
+		/// Sets the minimum importance a log level needs to have so that its messages are
+		/// formatted and emitted at all.
+		void setMinimumImportance(LogImportance importance);
+		LogImportance getMinimumImportance() const;
+		/// Determines whether messages of the given level are emitted. This is checked
+		/// before a message is formatted, so disabled messages are (almost) free.
+		bool isEnabled(const LogLevel &level) const {
+			return level.importance >= m_minimumImportance.load(std::memory_order_relaxed);
+		}
 
 	private:
 
 		Signal m_signal;
 		Formatter m_formatter;
+		std::atomic<int> m_minimumImportance;
 	};
 }
@@ -0,0 +1,100 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "log_ring.h"
+
+namespace wowpp
+{
+	LogRing::LogRing(size_t capacity)
+		: m_mask(0)
+		, m_enqueuePos(0)
+		, m_dequeuePos(0)
+		, m_dropped(0)
+	{
+		size_t size = 2;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		m_cells.reset(new Cell[size]);
+		m_mask = size - 1;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			m_cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	bool LogRing::tryPush(LogEntry &&entry)
+	{
+		Cell *cell = nullptr;
+		size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			cell = &m_cells[pos & m_mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+			if (diff == 0)
+			{
+				// Cell is free: try to claim it
+				if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				// Ring is full
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				// Another producer claimed this cell in the meantime
+				pos = m_enqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->entry = std::move(entry);
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool LogRing::tryPop(LogEntry &out_entry)
+	{
+		Cell &cell = m_cells[m_dequeuePos & m_mask];
+		const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		if (sequence != m_dequeuePos + 1)
+		{
+			// Empty, or the producer hasn't finished writing this cell yet
+			return false;
+		}
+
+		out_entry = std::move(cell.entry);
+		cell.entry.message.clear();
+		cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+		++m_dequeuePos;
+		return true;
+	}
+}
@@ -0,0 +1,78 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "log_entry.h"
+#include <atomic>
+#include <memory>
+
+namespace wowpp
+{
+	/// Bounded lock-free queue of log entries which supports multiple producer threads
+	/// and a single consumer thread. Entries which don't fit into the queue are dropped
+	/// and counted instead of blocking the producer.
+	class LogRing final
+	{
+	public:
+
+		/// Initializes the ring buffer.
+		/// @param capacity Number of entries the ring can hold. Rounded up to a power of two.
+		explicit LogRing(size_t capacity);
+
+		LogRing(const LogRing &Other) = delete;
+		LogRing &operator=(const LogRing &Other) = delete;
+
+		/// Tries to enqueue an entry. May be called by any thread.
+		/// @returns false if the ring is full and the entry has been dropped.
+		bool tryPush(LogEntry &&entry);
+		/// Tries to dequeue the oldest entry. May only be called by the consumer thread.
+		/// @returns false if the ring is empty.
+		bool tryPop(LogEntry &out_entry);
+		/// Gets the total number of dropped entries.
+		UInt64 getDroppedCount() const {
+			return m_dropped.load(std::memory_order_relaxed);
+		}
+		/// Gets the number of entries the ring can hold.
+		size_t getCapacity() const {
+			return m_mask + 1;
+		}
+
+	private:
+
+		struct Cell
+		{
+			std::atomic<size_t> sequence;
+			LogEntry entry;
+		};
+
+		std::unique_ptr<Cell[]> m_cells;
+		size_t m_mask;
+		// Producer and consumer positions are kept on different cache lines
+		char m_pad0[64];
+		std::atomic<size_t> m_enqueuePos;
+		char m_pad1[64];
+		size_t m_dequeuePos;
+		std::atomic<UInt64> m_dropped;
+	};
+}
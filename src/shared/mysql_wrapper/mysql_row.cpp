@@ -30,11 +30,13 @@ namespace wowpp
 		Row::Row(Select &select)
 			: m_row(nullptr)
 			, m_length(0)
+			, m_fieldLengths(nullptr)
 		{
 			if (select.nextRow(m_row))
 			{
 				assert(m_row);
 				m_length = select.getFieldCount();
+				m_fieldLengths = select.getFieldLengths();
 			}
 		}
 
@@ -54,6 +56,12 @@ namespace wowpp
 			return m_row[index];
 		}
 
+		std::size_t Row::getFieldLength(std::size_t index) const
+		{
+			assert(index < m_length);
+			return (m_fieldLengths ? m_fieldLengths[index] : 0);
+		}
+
 		Row Row::next(Select &select)
 		{
 			return Row(select);
@@ -37,6 +37,9 @@ namespace wowpp
 			operator bool () const;
 			std::size_t getLength() const;
 			const char *getField(std::size_t index) const;
+			/// Returns the length of a field in bytes. Needed to read binary fields, which may
+			/// contain null characters.
+			std::size_t getFieldLength(std::size_t index) const;
 
 			template <class T, class F = T>
 			bool getField(std::size_t index, T &value) const
@@ -86,6 +89,7 @@ namespace wowpp
 
 			MYSQL_ROW m_row;
 			std::size_t m_length;
+			const unsigned long *m_fieldLengths;
 		};
 	}
 }
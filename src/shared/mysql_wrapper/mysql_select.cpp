@@ -77,5 +77,11 @@ namespace wowpp
 			assert(m_result);
 			return ::mysql_num_fields(m_result);
 		}
+
+		const unsigned long *Select::getFieldLengths() const
+		{
+			assert(m_result);
+			return ::mysql_fetch_lengths(m_result);
+		}
 	}
 }
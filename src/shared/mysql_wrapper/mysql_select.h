@@ -45,6 +45,8 @@ namespace wowpp
 			bool success() const;
 			bool nextRow(MYSQL_ROW &row);
 			std::size_t getFieldCount() const;
+			/// Returns the byte lengths of the fields of the row last fetched by nextRow.
+			const unsigned long *getFieldLengths() const;
 
 		private:
 
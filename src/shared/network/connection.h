@@ -24,7 +24,9 @@
 
 #include "common/typedefs.h"
 #include "buffer.h"
+#include "receive_buffer.h"
 #include "receive_state.h"
+#include "packet_statistics.h"
 #include "common/assign_on_exit.h"
 #include "binary_io/string_sink.h"
 #include "binary_io/memory_source.h"
@@ -68,6 +70,12 @@ namespace wowpp
 
 	public:
 
+		AbstractConnection()
+			: m_receivedStatistics(nullptr)
+			, m_sentStatistics(nullptr)
+		{
+		}
+
 		virtual ~AbstractConnection()
 		{
 		}
@@ -80,15 +88,59 @@ namespace wowpp
 		virtual void resumeParsing() = 0;
 		virtual void flush() = 0;
 		virtual void close() = 0;
+		/// Sets the number of bytes which should at least be read from the socket at once.
+		virtual void setReceiveSize(size_t size) = 0;
 
 		template<class F>
 		void sendSinglePacket(F generator)
 		{
 			io::StringSink sink(getSendBuffer());
+			const size_t packetBegin = sink.position();
 			typename Protocol::OutgoingPacket packet(sink);
 			generator(packet);
+			countSentPacket(getPacketOpCode(packet), sink.position() - packetBegin);
 			flush();
 		}
+
+		/// Sets the statistics which count the packets of this connection. Pass nullptr to not count packets.
+		void setPacketStatistics(PacketStatistics *received, PacketStatistics *sent)
+		{
+			m_receivedStatistics = received;
+			m_sentStatistics = sent;
+		}
+		/// Counts a packet which was written to the send buffer without using sendSinglePacket.
+		void countSentPacket(UInt32 opCode, size_t size)
+		{
+			if (m_sentStatistics && m_sentStatistics->isEnabled())
+			{
+				m_sentStatistics->addPacket(opCode, size);
+			}
+		}
+
+	protected:
+
+		/// Passes a received packet to the listener and counts it if enabled.
+		template<class Packet>
+		PacketParseResult dispatchReceivedPacket(IConnectionListener<P> &listener, Packet &packet, size_t size)
+		{
+			if (!m_receivedStatistics || !m_receivedStatistics->isEnabled())
+			{
+				return listener.connectionPacketReceived(packet);
+			}
+
+			const UInt32 opCode = getPacketOpCode(packet);
+			m_receivedStatistics->addPacket(opCode, size);
+
+			const auto handlerStart = PacketStatistics::Clock::now();
+			const auto result = listener.connectionPacketReceived(packet);
+			m_receivedStatistics->addHandlerTime(opCode, PacketStatistics::Clock::now() - handlerStart);
+			return result;
+		}
+
+	private:
+
+		PacketStatistics *m_receivedStatistics;
+		PacketStatistics *m_sentStatistics;
 	};
 
 
@@ -183,6 +235,11 @@ namespace wowpp
 			beginSend();
 		}
 
+		void setReceiveSize(size_t size) override
+		{
+			m_received.setReadSize(size);
+		}
+
 		void close() override
 		{
 			if (!m_sending.empty())
@@ -216,7 +273,7 @@ namespace wowpp
 
 		void sendBuffer(const Buffer &data)
 		{
-			m_sendBuffer(data.data(), data.size());
+			m_sendBuffer.append(data.data(), data.size());
 		}
 
 		MySocket &getSocket() {
@@ -230,14 +287,11 @@ namespace wowpp
 
 	private:
 
-		typedef std::array<char, 4096> ReceiveBuffer;
-
 		std::unique_ptr<Socket> m_socket;
 		Listener *m_listener;
 		Buffer m_sending;
 		Buffer m_sendBuffer;
-		Buffer m_received;
-		ReceiveBuffer m_receiving;
+		ReceiveBuffer m_received;
 		bool m_isParsingIncomingData;
 		bool m_isClosedOnParsing;
 		bool m_isClosedOnSend;
@@ -283,8 +337,10 @@ namespace wowpp
 
 			m_isReceiving = true;
 
+			// Read directly into the receive buffer
+			char *const writePos = m_received.prepare();
 			m_socket->async_read_some(
-			    boost::asio::buffer(m_receiving.data(), m_receiving.size()),
+			    boost::asio::buffer(writePos, m_received.getWritableSize()),
 			    std::bind(&Connection<P, Socket>::received, this->shared_from_this(), std::placeholders::_2));
 		}
 
@@ -292,17 +348,14 @@ namespace wowpp
 		{
 			m_isReceiving = false;
 
-			ASSERT(size <= m_receiving.size());
+			ASSERT(size <= m_received.getWritableSize());
 			if (size == 0)
 			{
 				disconnected();
 				return;
 			}
 
-			m_received.append(
-			    m_receiving.begin(),
-			    m_receiving.begin() + size);
-
+			m_received.commit(size);
 			parsePackets();
 		}
 
@@ -319,7 +372,7 @@ namespace wowpp
 				nextPacket = false;
 
 				const size_t availableSize = (m_received.size() - parsedUntil);
-				const char *const packetBegin = &m_received[0] + parsedUntil;
+				const char *const packetBegin = m_received.data() + parsedUntil;
 				const char *const streamEnd = packetBegin + availableSize;
 
 				io::MemorySource source(packetBegin, streamEnd);
@@ -334,7 +387,8 @@ namespace wowpp
 					case receive_state::Complete:
 						if (m_listener)
 						{
-							auto result = m_listener->connectionPacketReceived(packet);
+							auto result = this->dispatchReceivedPacket(*m_listener, packet,
+								static_cast<std::size_t>(source.getPosition() - source.getBegin()));
 							switch (result)
 							{
 							case PacketParseResult::Pass:
@@ -374,9 +428,7 @@ namespace wowpp
 			{
 				ASSERT(parsedUntil <= m_received.size());
 
-				m_received.erase(
-					m_received.begin(),
-					m_received.begin() + static_cast<std::ptrdiff_t>(parsedUntil));
+				m_received.consume(parsedUntil);
 			}
 
 			beginReceive();
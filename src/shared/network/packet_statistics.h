@@ -0,0 +1,195 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+
+namespace wowpp
+{
+	/// Counts packets, bytes and handler times per opcode for one direction of one kind of connection.
+	/// Counting is disabled by default, in which case every hook costs a single relaxed atomic load.
+	class PacketStatistics final
+	{
+	private:
+
+		PacketStatistics(const PacketStatistics &Other) = delete;
+		PacketStatistics &operator=(const PacketStatistics &Other) = delete;
+
+	public:
+
+		typedef std::chrono::steady_clock Clock;
+
+		/// Number of handler time histogram buckets. Bucket i counts handler calls which took less
+		/// than 10^(i+1) microseconds, the last bucket counts everything slower.
+		static const size_t HandlerTimeBuckets = 6;
+
+		/// Counters of one opcode.
+		struct OpCodeCounters final
+		{
+			std::atomic<UInt64> count;
+			std::atomic<UInt64> bytes;
+			std::atomic<UInt64> handlerMicroseconds;
+			std::array<std::atomic<UInt64>, HandlerTimeBuckets> handlerTimes;
+		};
+
+	public:
+
+		/// @param opCodeCount Number of distinct opcodes. Packets with larger opcodes are counted as the last opcode.
+		explicit PacketStatistics(size_t opCodeCount)
+			: m_opCodeCount(opCodeCount)
+			, m_opCodes(new OpCodeCounters[opCodeCount])
+			, m_enabled(false)
+		{
+			reset();
+		}
+
+		/// Determines whether packets are counted at the moment.
+		bool isEnabled() const {
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+		/// Enables or disables counting. Existing counters are kept.
+		void setEnabled(bool enabled) {
+			m_enabled.store(enabled, std::memory_order_relaxed);
+		}
+		/// Resets all counters to zero.
+		void reset()
+		{
+			for (size_t i = 0; i < m_opCodeCount; ++i)
+			{
+				auto &counters = m_opCodes[i];
+				counters.count.store(0, std::memory_order_relaxed);
+				counters.bytes.store(0, std::memory_order_relaxed);
+				counters.handlerMicroseconds.store(0, std::memory_order_relaxed);
+				for (auto &bucket : counters.handlerTimes)
+				{
+					bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+		/// Counts a packet of the given size in bytes including its header.
+		void addPacket(UInt32 opCode, size_t bytes)
+		{
+			auto &counters = getCounters(opCode);
+			counters.count.fetch_add(1, std::memory_order_relaxed);
+			counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+		/// Counts the time a packet handler took.
+		void addHandlerTime(UInt32 opCode, Clock::duration duration)
+		{
+			const UInt64 microseconds = static_cast<UInt64>(
+				std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+			size_t bucket = 0;
+			for (UInt64 limit = 10; bucket < HandlerTimeBuckets - 1 && microseconds >= limit; limit *= 10)
+			{
+				++bucket;
+			}
+
+			auto &counters = getCounters(opCode);
+			counters.handlerMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+			counters.handlerTimes[bucket].fetch_add(1, std::memory_order_relaxed);
+		}
+		/// Writes all opcodes which have been counted at least once as a json object.
+		void writeJson(std::ostream &out) const
+		{
+			out << "{\"enabled\":" << (isEnabled() ? "true" : "false") << ",\"opcodes\":[";
+
+			bool first = true;
+			for (size_t i = 0; i < m_opCodeCount; ++i)
+			{
+				const auto &counters = m_opCodes[i];
+				const UInt64 count = counters.count.load(std::memory_order_relaxed);
+				if (count == 0)
+				{
+					continue;
+				}
+
+				if (!first) out << ",";
+				first = false;
+
+				out << "{\"opcode\":" << i
+					<< ",\"count\":" << count
+					<< ",\"bytes\":" << counters.bytes.load(std::memory_order_relaxed)
+					<< ",\"handlerMicroseconds\":" << counters.handlerMicroseconds.load(std::memory_order_relaxed)
+					<< ",\"handlerTimes\":[";
+				for (size_t bucket = 0; bucket < HandlerTimeBuckets; ++bucket)
+				{
+					if (bucket) out << ",";
+					out << counters.handlerTimes[bucket].load(std::memory_order_relaxed);
+				}
+				out << "]}";
+			}
+
+			out << "]}";
+		}
+
+	private:
+
+		OpCodeCounters &getCounters(UInt32 opCode)
+		{
+			return m_opCodes[std::min<size_t>(opCode, m_opCodeCount - 1)];
+		}
+
+	private:
+
+		const size_t m_opCodeCount;
+		std::unique_ptr<OpCodeCounters[]> m_opCodes;
+		std::atomic<bool> m_enabled;
+	};
+
+	namespace detail
+	{
+		/// Gets the opcode of a packet for PacketStatistics. Protocols whose packets have no
+		/// opcode (like http) are counted as opcode 0.
+		template<class Packet, class = void>
+		struct PacketOpCode
+		{
+			static UInt32 get(const Packet &) { return 0; }
+		};
+
+		template<class Packet>
+		struct PacketOpCode<Packet, decltype(void(std::declval<const Packet &>().getId()))>
+		{
+			static UInt32 get(const Packet &packet) { return static_cast<UInt32>(packet.getId()); }
+		};
+
+		template<class Packet>
+		struct PacketOpCode<Packet, decltype(void(std::declval<const Packet &>().getOpCode()))>
+		{
+			static UInt32 get(const Packet &packet) { return static_cast<UInt32>(packet.getOpCode()); }
+		};
+	}
+
+	/// Gets the opcode of an incoming or outgoing packet for PacketStatistics.
+	template<class Packet>
+	UInt32 getPacketOpCode(const Packet &packet)
+	{
+		return detail::PacketOpCode<Packet>::get(packet);
+	}
+}
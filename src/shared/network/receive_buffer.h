@@ -0,0 +1,151 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "common/macros.h"
+#include <vector>
+#include <cstring>
+
+namespace wowpp
+{
+	/// Contiguous receive buffer for connections. Data is read directly into the free space at the
+	/// end of the buffer and consumed from the front by advancing an offset, so that parsed packets
+	/// don't cause the remaining bytes to be moved on every read. Pending bytes are only moved to the
+	/// front when the free space runs out and at least as many bytes have been consumed as are still
+	/// pending, which keeps the cost per received byte constant even for large bursts.
+	class ReceiveBuffer final
+	{
+	private:
+
+		ReceiveBuffer(const ReceiveBuffer &Other) = delete;
+		ReceiveBuffer &operator=(const ReceiveBuffer &Other) = delete;
+
+	public:
+
+		/// Default number of bytes which should at least be available for a single read.
+		static const size_t DefaultReadSize = 4096;
+
+	public:
+
+		explicit ReceiveBuffer(size_t readSize = DefaultReadSize)
+			: m_begin(0)
+			, m_end(0)
+			, m_readSize(readSize)
+		{
+			ASSERT(m_readSize > 0);
+		}
+
+		/// Sets the number of bytes which should at least be available for a single read.
+		void setReadSize(size_t readSize)
+		{
+			ASSERT(readSize > 0);
+			m_readSize = readSize;
+		}
+		/// Gets the number of bytes which should at least be available for a single read.
+		size_t getReadSize() const {
+			return m_readSize;
+		}
+		/// Makes sure that at least getReadSize() bytes can be written and returns the write position.
+		/// The writable space may be larger than the read size. Must not be called while a read
+		/// into previously prepared memory is still in progress.
+		char *prepare()
+		{
+			if (m_begin == m_end)
+			{
+				// Nothing pending, so we can start at the front again for free
+				m_begin = m_end = 0;
+			}
+
+			if (m_storage.size() - m_end < m_readSize)
+			{
+				const size_t pending = size();
+				if (m_begin >= pending &&
+					m_storage.size() - pending >= m_readSize)
+				{
+					// Move the pending bytes to the front. Since at least as many bytes have been
+					// consumed since the last move, this is amortized constant per byte.
+					std::memmove(&m_storage[0], &m_storage[m_begin], pending);
+				}
+				else
+				{
+					std::vector<char> storage(std::max(m_storage.size() * 2, pending + m_readSize));
+					if (pending)
+					{
+						std::memcpy(&storage[0], &m_storage[m_begin], pending);
+					}
+					m_storage.swap(storage);
+				}
+
+				m_begin = 0;
+				m_end = pending;
+			}
+
+			return &m_storage[m_end];
+		}
+		/// Gets the number of bytes which can be written at the position returned by prepare().
+		size_t getWritableSize() const {
+			return m_storage.size() - m_end;
+		}
+		/// Marks bytes written at the position returned by prepare() as received.
+		void commit(size_t size)
+		{
+			ASSERT(size <= getWritableSize());
+			m_end += size;
+		}
+		/// Removes bytes from the front of the pending data. This never moves any data, so it may
+		/// be called while a read into the memory returned by prepare() is still in progress.
+		void consume(size_t size)
+		{
+			ASSERT(size <= this->size());
+			m_begin += size;
+		}
+		/// Gets the pending data. Only valid until the next call to prepare().
+		char *data() {
+			return m_storage.empty() ? nullptr : &m_storage[m_begin];
+		}
+		/// Gets the pending data. Only valid until the next call to prepare().
+		const char *data() const {
+			return m_storage.empty() ? nullptr : &m_storage[m_begin];
+		}
+		/// Gets the number of pending bytes.
+		size_t size() const {
+			return m_end - m_begin;
+		}
+		/// Determines whether there are no pending bytes.
+		bool empty() const {
+			return m_begin == m_end;
+		}
+		/// Gets the number of bytes allocated by this buffer.
+		size_t capacity() const {
+			return m_storage.size();
+		}
+
+	private:
+
+		std::vector<char> m_storage;
+		size_t m_begin;
+		size_t m_end;
+		size_t m_readSize;
+	};
+}
@@ -70,7 +70,7 @@ namespace wowpp
 				mState->Acceptor->bind(boost::asio::ip::tcp::endpoint(
 				                           boost::asio::ip::tcp::v4(),
 				                           static_cast<UInt16>(Port)));
-				mState->Acceptor->listen(16);
+				mState->Acceptor->listen(boost::asio::socket_base::max_connections);
 			}
 			catch (const boost::system::system_error &)
 			{
@@ -0,0 +1,206 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+// Content from PCH since we can't use them here
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "simple/simple.hpp"
+#include "faction_reactions.h"
+#include "shared/proto_data/faction_templates.pb.h"
+#include "log/default_log_levels.h"
+
+namespace wowpp
+{
+	namespace proto
+	{
+		FactionReactions::FactionReactions()
+			: m_baseId(0)
+		{
+		}
+
+		void FactionReactions::build(const FactionTemplates &templates)
+		{
+			clear();
+			if (templates.entry_size() == 0)
+			{
+				return;
+			}
+
+			UInt32 minId = std::numeric_limits<UInt32>::max(), maxId = 0;
+			for (const auto &entry : templates.entry())
+			{
+				minId = std::min(minId, entry.id());
+				maxId = std::max(maxId, entry.id());
+			}
+
+			const size_t count = static_cast<size_t>(templates.entry_size());
+			const size_t idRange = static_cast<size_t>(maxId - minId) + 1;
+			if (count > MaxTemplates || idRange > count * MaxIdRangePerTemplate)
+			{
+				WLOG("Faction reaction matrix disabled: " << count << " faction templates with ids " << minId << "-" << maxId);
+				return;
+			}
+
+			m_baseId = minId;
+			// Copied into a temporary, as binding the static constant to a reference would require a definition
+			m_indexById.assign(idRange, static_cast<UInt32>(InvalidIndex));
+			m_entries.reserve(count);
+			for (const auto &entry : templates.entry())
+			{
+				// Later duplicates win, like in the template index
+				UInt32 &index = m_indexById[entry.id() - m_baseId];
+				if (index == InvalidIndex)
+				{
+					index = static_cast<UInt32>(m_entries.size());
+					m_entries.push_back(&entry);
+				}
+				else
+				{
+					m_entries[index] = &entry;
+				}
+			}
+
+			const size_t indexed = m_entries.size();
+			m_reactions.assign((indexed * indexed + 3) / 4, 0);
+			for (size_t from = 0; from < indexed; ++from)
+			{
+				for (size_t to = 0; to < indexed; ++to)
+				{
+					UInt8 reaction = 0;
+					if (calculateHostile(*m_entries[from], *m_entries[to])) reaction |= HostileBit;
+					if (calculateFriendly(*m_entries[from], *m_entries[to])) reaction |= FriendlyBit;
+
+					const size_t cell = from * indexed + to;
+					m_reactions[cell >> 2] |= static_cast<UInt8>(reaction << ((cell & 3) << 1));
+				}
+			}
+		}
+
+		void FactionReactions::clear()
+		{
+			m_baseId = 0;
+			m_indexById.clear();
+			m_entries.clear();
+			m_reactions.clear();
+		}
+
+		bool FactionReactions::isHostile(const FactionTemplateEntry &from, const FactionTemplateEntry &to) const
+		{
+			const UInt32 fromIndex = getIndex(from), toIndex = getIndex(to);
+			if (fromIndex == InvalidIndex || toIndex == InvalidIndex)
+			{
+				return calculateHostile(from, to);
+			}
+
+			return (getReaction(fromIndex, toIndex) & HostileBit) != 0;
+		}
+
+		bool FactionReactions::isFriendly(const FactionTemplateEntry &from, const FactionTemplateEntry &to) const
+		{
+			const UInt32 fromIndex = getIndex(from), toIndex = getIndex(to);
+			if (fromIndex == InvalidIndex || toIndex == InvalidIndex)
+			{
+				return calculateFriendly(from, to);
+			}
+
+			return (getReaction(fromIndex, toIndex) & FriendlyBit) != 0;
+		}
+
+		UInt32 FactionReactions::getIndex(const FactionTemplateEntry &entry) const
+		{
+			const UInt32 offset = entry.id() - m_baseId;
+			if (entry.id() < m_baseId || offset >= m_indexById.size())
+			{
+				return InvalidIndex;
+			}
+
+			// Entries of another project or entries added after the matrix was built aren't indexed
+			const UInt32 index = m_indexById[offset];
+			if (index == InvalidIndex || m_entries[index] != &entry)
+			{
+				return InvalidIndex;
+			}
+
+			return index;
+		}
+
+		bool FactionReactions::calculateHostile(const FactionTemplateEntry &from, const FactionTemplateEntry &to)
+		{
+			if (from.id() == to.id())
+			{
+				return false;
+			}
+
+			for (const auto &enemy : from.enemies())
+			{
+				if (enemy && enemy == to.faction())
+				{
+					return true;
+				}
+			}
+
+			for (const auto &friendly : from.friends())
+			{
+				if (friendly && friendly == to.faction())
+				{
+					return false;
+				}
+			}
+
+			// Only our own enemy mask is checked. Also checking whether the target is hostile against us
+			// causes some horde npcs, which are displayed as neutral, to attack alliance players and
+			// vice versa (dark portal in blasted lands, the orc warlord for example).
+			return (from.enemymask() & to.selfmask()) != 0;
+		}
+
+		bool FactionReactions::calculateFriendly(const FactionTemplateEntry &from, const FactionTemplateEntry &to)
+		{
+			if (from.id() == to.id())
+			{
+				return true;
+			}
+
+			for (const auto &enemy : from.enemies())
+			{
+				if (enemy && enemy == to.faction())
+				{
+					return false;
+				}
+			}
+
+			for (const auto &friendly : from.friends())
+			{
+				if (friendly && friendly == to.faction())
+				{
+					return true;
+				}
+			}
+
+			return (from.friendmask() & to.selfmask()) != 0;
+		}
+	}
+}
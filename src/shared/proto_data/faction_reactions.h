@@ -0,0 +1,92 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include <vector>
+
+namespace wowpp
+{
+	namespace proto
+	{
+		class FactionTemplates;
+		class FactionTemplateEntry;
+
+		/// Precomputed reactions between all pairs of faction templates, so that hostility checks
+		/// don't have to walk the enemy and friend lists of a template on every call.
+		class FactionReactions final
+		{
+		public:
+
+			/// Templates with sparser ids than this (id range per template) aren't indexed.
+			static const size_t MaxIdRangePerTemplate = 16;
+			/// Upper limit of indexed templates to keep the matrix size reasonable (16 MB).
+			static const size_t MaxTemplates = 8192;
+
+		public:
+
+			FactionReactions();
+
+			/// Rebuilds the matrix from the given faction templates.
+			void build(const FactionTemplates &templates);
+			/// Removes all precomputed reactions.
+			void clear();
+			/// Determines whether a unit of faction template "from" is hostile towards units of template "to".
+			bool isHostile(const FactionTemplateEntry &from, const FactionTemplateEntry &to) const;
+			/// Determines whether a unit of faction template "from" is friendly towards units of template "to".
+			bool isFriendly(const FactionTemplateEntry &from, const FactionTemplateEntry &to) const;
+			/// Gets the number of indexed faction templates.
+			size_t size() const {
+				return m_entries.size();
+			}
+
+			/// Calculates the hostility from the template data without using the matrix.
+			static bool calculateHostile(const FactionTemplateEntry &from, const FactionTemplateEntry &to);
+			/// Calculates the friendliness from the template data without using the matrix.
+			static bool calculateFriendly(const FactionTemplateEntry &from, const FactionTemplateEntry &to);
+
+		private:
+
+			static const UInt32 InvalidIndex = 0xffffffff;
+			static const UInt8 HostileBit = 0x01;
+			static const UInt8 FriendlyBit = 0x02;
+
+			/// Gets the matrix index of a template or InvalidIndex if it isn't part of the matrix.
+			UInt32 getIndex(const FactionTemplateEntry &entry) const;
+			/// Gets the reaction bits of a pair of templates.
+			UInt8 getReaction(UInt32 from, UInt32 to) const
+			{
+				const size_t cell = static_cast<size_t>(from) * m_entries.size() + to;
+				return (m_reactions[cell >> 2] >> ((cell & 3) << 1)) & 0x03;
+			}
+
+		private:
+
+			UInt32 m_baseId;
+			std::vector<UInt32> m_indexById;
+			std::vector<const FactionTemplateEntry *> m_entries;
+			/// Two reaction bits per template pair, four pairs per byte.
+			std::vector<UInt8> m_reactions;
+		};
+	}
+}
@@ -55,3 +55,38 @@ bool wowpp::canStackSpellRanksInSpellBook(const proto::SpellEntry & spell)
 
 	return true;
 }
+
+namespace wowpp
+{
+	namespace proto
+	{
+		ProjectReference::ProjectReference(Project &project)
+			: m_project(&project)
+		{
+			++m_project->m_referenceCount;
+		}
+
+		ProjectReference::ProjectReference(const ProjectReference &Other)
+			: m_project(Other.m_project)
+		{
+			++m_project->m_referenceCount;
+		}
+
+		ProjectReference &ProjectReference::operator=(const ProjectReference &Other)
+		{
+			if (m_project != Other.m_project)
+			{
+				++Other.m_project->m_referenceCount;
+				--m_project->m_referenceCount;
+				m_project = Other.m_project;
+			}
+
+			return *this;
+		}
+
+		ProjectReference::~ProjectReference()
+		{
+			--m_project->m_referenceCount;
+		}
+	}
+}
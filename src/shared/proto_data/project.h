@@ -21,8 +21,11 @@
 
 #pragma once
 
+#include <atomic>
 #include "project_loader.h"
 #include "project_saver.h"
+#include "project_reference.h"
+#include "faction_reactions.h"
 #include "proto_template.h"
 #include "log/default_log_levels.h"
 #include "virtual_directory/file_system_reader.h"
@@ -142,16 +145,28 @@ namespace wowpp
 			NpcTextManager npcTexts;
 			GossipMenuManager gossipMenus;
 
+			// Precomputed data
+
+			/// Reactions between all faction templates. Rebuilt whenever the project is loaded.
+			FactionReactions factionReactions;
+
 		private:
 
+			friend class ProjectReference;
+
 			String m_lastPath;
+			/// Number of live ProjectReference instances of this project.
+			std::atomic<size_t> m_referenceCount;
 
 		public:
 
 			/// Gets the path that was used to load this project.
 			const String &getLastPath() const { return m_lastPath; }
+			/// Gets the number of live objects which still reference data of this project.
+			size_t getReferenceCount() const { return m_referenceCount; }
 
 			Project()
+				: m_referenceCount(0)
 			{
 			}
 			/// Loads the project.
@@ -228,6 +243,8 @@ namespace wowpp
 					return false;
 				}
 
+				factionReactions.build(factionTemplates.getTemplates());
+
 				auto loadEnd = getCurrentTime();
 				ILOG("Loading finished in " << (loadEnd - loadStart) << "ms");
 
@@ -27,6 +27,10 @@
 #include "simple_file_format/sff_load_file.h"
 #include "log/default_log_levels.h"
 #include <google/protobuf/io/coded_stream.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace wowpp
 {
@@ -90,13 +94,13 @@ namespace wowpp
 				    T &manager
 				)
 					: name(name)
-					, load([this, name, &manager](
+					, load([name, &manager](
 					           std::istream & file,
 					           const String & fileName,
 								const String & hash,
 					           Context & context) mutable -> bool
 				{
-					return this->loadManagerFromFile(file, fileName, hash, context, manager, name);
+					return loadManagerFromFile(file, fileName, hash, context, manager, name);
 				})
 				{
 				}
@@ -121,7 +125,9 @@ namespace wowpp
 
 			typedef String::const_iterator StringIterator;
 
-			static bool load(virtual_dir::IReader &directory, const Managers &managers, Context &context)
+			/// Loads all managers listed in the project file of the given directory.
+			/// @param workerCount Number of threads used to parse manager files. 0 uses one per core.
+			static bool load(virtual_dir::IReader &directory, const Managers &managers, Context &context, size_t workerCount = 0)
 			{
 				const virtual_dir::Path projectFilePath = "project.txt";
 				const auto projectFile = directory.readFile(projectFilePath, false);
@@ -146,12 +152,17 @@ namespace wowpp
 					return false;
 				}
 
+				// Resolve and open all manager files on this thread first, since readers are not
+				// required to be thread-safe.
+				std::vector<PendingManager> pending;
+				pending.reserve(managers.size());
+
 				bool success = true;
 
 				for (const auto &manager : managers)
 				{
-					String relativeFileName;
-					String hashString;
+					PendingManager entry;
+					entry.manager = &manager;
 
 					auto *table = fileTable.getTable(manager.name);
 					if (!table)
@@ -162,7 +173,7 @@ namespace wowpp
 						continue;
 					}
 
-					if (!table->tryGetString("file", relativeFileName))
+					if (!table->tryGetString("file", entry.fileName))
 					{
 						success = false;
 
@@ -170,27 +181,140 @@ namespace wowpp
 						continue;
 					}
 
-					table->tryGetString("sha1", hashString);
+					table->tryGetString("sha1", entry.hashString);
 
-					const auto managerFile = directory.readFile(relativeFileName, false);
-					if (!managerFile)
+					entry.file = directory.readFile(entry.fileName, false);
+					if (!entry.file)
 					{
 						success = false;
 
-						ELOG("Could not open file '" << relativeFileName << "'");
+						ELOG("Could not open file '" << entry.fileName << "'");
 						continue;
 					}
-					if (!manager.load(*managerFile, relativeFileName, hashString, context))
+
+					pending.push_back(std::move(entry));
+				}
+
+				// Every manager only writes to its own data, so they can be parsed concurrently.
+				// Cross references between managers are resolved afterwards in the load later phase.
+				const auto parseStart = std::chrono::steady_clock::now();
+				const size_t threadCount = getWorkerCount(workerCount, pending.size());
+
+				std::atomic<size_t> nextIndex(0);
+				const auto parseWorker = [&pending, &nextIndex, &context]()
+				{
+					for (;;)
+					{
+						const size_t index = nextIndex.fetch_add(1);
+						if (index >= pending.size())
+						{
+							break;
+						}
+
+						auto &entry = pending[index];
+						const auto start = std::chrono::steady_clock::now();
+						entry.loaded = entry.manager->load(*entry.file, entry.fileName, entry.hashString, context);
+						entry.duration = std::chrono::steady_clock::now() - start;
+						entry.file.reset();
+					}
+				};
+
+				std::vector<std::thread> threads;
+				threads.reserve(threadCount > 0 ? threadCount - 1 : 0);
+				for (size_t i = 1; i < threadCount; ++i)
+				{
+					threads.emplace_back(parseWorker);
+				}
+
+				parseWorker();
+				for (auto &thread : threads)
+				{
+					thread.join();
+				}
+
+				const auto parseDuration = std::chrono::steady_clock::now() - parseStart;
+
+				for (const auto &entry : pending)
+				{
+					if (!entry.loaded)
 					{
-						ELOG("Could not load '" << manager.name << "'");
+						ELOG("Could not load '" << entry.manager->name << "'");
 						success = false;
 					}
 				}
 
-				return success &&
-				       context.executeLoadLater();
+				// Report per-manager timings, slowest first
+				std::vector<const PendingManager *> byDuration;
+				byDuration.reserve(pending.size());
+				for (const auto &entry : pending)
+				{
+					byDuration.push_back(&entry);
+				}
+				std::sort(byDuration.begin(), byDuration.end(),
+				          [](const PendingManager *a, const PendingManager *b)
+				{
+					return a->duration > b->duration;
+				});
+
+				for (const auto *entry : byDuration)
+				{
+					DLOG("Loaded '" << entry->manager->name << "' in " << toMilliseconds(entry->duration) << "ms");
+				}
+
+				ILOG("Parsed " << pending.size() << " data files on " << threadCount << " threads in " <<
+				     toMilliseconds(parseDuration) << "ms" <<
+				     (byDuration.empty() ? String() : " (slowest: '" + byDuration.front()->manager->name + "')"));
+
+				if (!success)
+				{
+					return false;
+				}
+
+				const auto fixupStart = std::chrono::steady_clock::now();
+				const bool fixedUp = context.executeLoadLater();
+				ILOG("Resolved data references in " << toMilliseconds(std::chrono::steady_clock::now() - fixupStart) << "ms");
+
+				return fixedUp;
+			}
+
+		private:
+
+			/// A manager whose file has been opened and which is waiting to be parsed.
+			struct PendingManager
+			{
+				const ManagerEntry *manager;
+				String fileName;
+				String hashString;
+				std::unique_ptr<std::istream> file;
+				std::chrono::steady_clock::duration duration;
+				bool loaded;
+
+				PendingManager()
+					: manager(nullptr)
+					, duration(std::chrono::steady_clock::duration::zero())
+					, loaded(false)
+				{
+				}
+			};
+
+			static size_t getWorkerCount(size_t requested, size_t managerCount)
+			{
+				size_t count = requested;
+				if (count == 0)
+				{
+					count = std::max<size_t>(1, std::thread::hardware_concurrency());
+				}
+
+				return std::max<size_t>(1, std::min(count, managerCount));
+			}
+
+			static double toMilliseconds(std::chrono::steady_clock::duration duration)
+			{
+				return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.0;
 			}
 
+		public:
+
 			template <class FileName>
 			static bool loadSffFile(
 			    sff::read::tree::Table<StringIterator> &fileTable,
@@ -0,0 +1,55 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+namespace wowpp
+{
+	namespace proto
+	{
+		class Project;
+
+		/// Marks the data of a project as being in use by a live object. Objects keep raw references
+		/// into the protobuf data of the project they were created from, so after a hot reload the
+		/// outdated project must not be destroyed until no reference to it is left.
+		class ProjectReference final
+		{
+		public:
+
+			/// Adds a reference to the given project.
+			explicit ProjectReference(Project &project);
+			ProjectReference(const ProjectReference &Other);
+			ProjectReference &operator=(const ProjectReference &Other);
+			/// Releases the reference.
+			~ProjectReference();
+
+			/// Gets the referenced project.
+			Project &get() const {
+				return *m_project;
+			}
+
+		private:
+
+			Project *m_project;
+		};
+	}
+}
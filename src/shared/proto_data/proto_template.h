@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "template_index.h"
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
@@ -44,7 +45,7 @@ namespace wowpp
 		private:
 
 			T1 m_data;
-			std::map<wowpp::UInt32, T2 *> m_templatesById;
+			TemplateIndex<T2> m_templatesById;
 
 		public:
 
@@ -70,11 +71,14 @@ namespace wowpp
 				}*/
 
 				// Iterate through all data entries and store ids for quick id lookup
+				std::vector<typename TemplateIndex<T2>::Entry> entries;
+				entries.reserve(m_data.entry_size());
 				for (int i = 0; i < m_data.entry_size(); ++i)
 				{
 					T2 *entry = m_data.mutable_entry(i);
-					m_templatesById[entry->id()] = entry;
+					entries.push_back(std::make_pair(entry->id(), entry));
 				}
+				m_templatesById.assign(std::move(entries));
 
 				return true;
 			}
@@ -119,7 +123,7 @@ namespace wowpp
 				added->set_id(id);
 
 				// Store in array and return
-				m_templatesById[id] = added;
+				m_templatesById.insert(id, added);
 				return added;
 			}
 
@@ -127,11 +131,7 @@ namespace wowpp
 			void remove(UInt32 id)
 			{
 				// Remove entry from id list
-				auto it = m_templatesById.find(id);
-				if (it != m_templatesById.end())
-				{
-					m_templatesById.erase(it);
-				}
+				m_templatesById.erase(id);
 
 				// Remove entry from m_data
 				for (int i = 0; i < m_data.entry_size();)
@@ -151,21 +151,16 @@ namespace wowpp
 			/// Retrieves a pointer to an object by its id.
 			const T2 *getById(UInt32 id) const
 			{
-				const auto it = m_templatesById.find(id);
-				if (it == m_templatesById.end()) {
-					return nullptr;
-				}
-
-				return it->second;
+				return m_templatesById.find(id);
 			}
 			T2 *getById(UInt32 id)
 			{
-				const auto it = m_templatesById.find(id);
-				if (it == m_templatesById.end()) {
-					return nullptr;
-				}
-
-				return it->second;
+				return m_templatesById.find(id);
+			}
+			/// Gets the layout which was chosen for the id lookup table.
+			TemplateIndexLayout getIndexLayout() const
+			{
+				return m_templatesById.getLayout();
 			}
 		};
 	}
@@ -0,0 +1,287 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace wowpp
+{
+	namespace proto
+	{
+		namespace template_index_layout
+		{
+			enum Type
+			{
+				/// No entries are stored.
+				Empty,
+				/// Entries are stored in an array which is directly indexed by (id - lowest id).
+				Dense,
+				/// Entries are stored in an array sorted by id and found using a binary search.
+				Sorted
+			};
+		}
+
+		typedef template_index_layout::Type TemplateIndexLayout;
+
+		/// Maps template ids to entries. The layout is chosen based on how compact the
+		/// id space is: Compact id ranges use a direct index, sparse ones a sorted array.
+		template<class T>
+		class TemplateIndex final
+		{
+		public:
+
+			typedef std::pair<UInt32, T *> Entry;
+
+			/// Maximum number of slots per stored entry for the dense layout to be used.
+			static const size_t MaxSlotsPerEntry = 4;
+			/// Id ranges up to this size always use the dense layout.
+			static const size_t MinDenseSlots = 256;
+
+		public:
+
+			TemplateIndex()
+				: m_layout(template_index_layout::Empty)
+				, m_base(0)
+				, m_count(0)
+			{
+			}
+
+			/// Rebuilds the index from the given entries. If an id is used more than once,
+			/// the last entry wins.
+			void assign(std::vector<Entry> entries)
+			{
+				clear();
+				if (entries.empty())
+				{
+					return;
+				}
+
+				std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+				{
+					return a.first < b.first;
+				});
+
+				// Remove duplicates, keeping the last entry of each id
+				std::vector<Entry> unique;
+				unique.reserve(entries.size());
+				for (const auto &entry : entries)
+				{
+					if (!unique.empty() && unique.back().first == entry.first)
+					{
+						unique.back() = entry;
+					}
+					else
+					{
+						unique.push_back(entry);
+					}
+				}
+
+				const UInt32 minId = unique.front().first;
+				const UInt32 maxId = unique.back().first;
+				m_count = unique.size();
+
+				if (isDenseRange(minId, maxId, m_count))
+				{
+					m_layout = template_index_layout::Dense;
+					m_base = minId;
+					m_dense.assign(static_cast<size_t>(maxId - minId) + 1, nullptr);
+					for (const auto &entry : unique)
+					{
+						m_dense[entry.first - m_base] = entry.second;
+					}
+				}
+				else
+				{
+					m_layout = template_index_layout::Sorted;
+					m_sorted = std::move(unique);
+				}
+			}
+
+			/// Adds or replaces an entry.
+			void insert(UInt32 id, T *entry)
+			{
+				switch (m_layout)
+				{
+					case template_index_layout::Dense:
+						{
+							const UInt32 offset = id - m_base;
+							if (id >= m_base && offset < m_dense.size())
+							{
+								if (!m_dense[offset])
+								{
+									++m_count;
+								}
+								m_dense[offset] = entry;
+								return;
+							}
+
+							// Appending behind the current range is the common case when adding new entries
+							if (id >= m_base && isDenseRange(m_base, id, m_count + 1))
+							{
+								m_dense.resize(static_cast<size_t>(offset) + 1, nullptr);
+								m_dense[offset] = entry;
+								++m_count;
+								return;
+							}
+							break;
+						}
+					case template_index_layout::Sorted:
+						{
+							auto it = lowerBound(id);
+							if (it != m_sorted.end() && it->first == id)
+							{
+								it->second = entry;
+							}
+							else
+							{
+								m_sorted.insert(it, Entry(id, entry));
+								++m_count;
+							}
+							return;
+						}
+					default:
+						break;
+				}
+
+				// The current layout can't take the entry, so choose a new one
+				auto entries = getEntries();
+				entries.push_back(Entry(id, entry));
+				assign(std::move(entries));
+			}
+
+			/// Removes an entry if it exists.
+			void erase(UInt32 id)
+			{
+				switch (m_layout)
+				{
+					case template_index_layout::Dense:
+						{
+							const UInt32 offset = id - m_base;
+							if (id >= m_base && offset < m_dense.size() && m_dense[offset])
+							{
+								m_dense[offset] = nullptr;
+								--m_count;
+							}
+							break;
+						}
+					case template_index_layout::Sorted:
+						{
+							auto it = lowerBound(id);
+							if (it != m_sorted.end() && it->first == id)
+							{
+								m_sorted.erase(it);
+								--m_count;
+							}
+							break;
+						}
+					default:
+						break;
+				}
+			}
+
+			/// Removes all entries.
+			void clear()
+			{
+				m_layout = template_index_layout::Empty;
+				m_base = 0;
+				m_count = 0;
+				m_dense.clear();
+				m_sorted.clear();
+			}
+
+			/// Finds an entry by its id or returns nullptr if it doesn't exist.
+			T *find(UInt32 id) const
+			{
+				if (m_layout == template_index_layout::Dense)
+				{
+					// Ids below the base wrap around and fail the range check
+					const UInt32 offset = id - m_base;
+					return offset < m_dense.size() ? m_dense[offset] : nullptr;
+				}
+
+				if (m_layout == template_index_layout::Sorted)
+				{
+					const auto it = std::lower_bound(m_sorted.begin(), m_sorted.end(), id, [](const Entry &entry, UInt32 id)
+					{
+						return entry.first < id;
+					});
+					return (it != m_sorted.end() && it->first == id) ? it->second : nullptr;
+				}
+
+				return nullptr;
+			}
+
+			/// Gets the currently used layout.
+			TemplateIndexLayout getLayout() const { return m_layout; }
+			/// Gets the number of stored entries.
+			size_t size() const { return m_count; }
+
+		private:
+
+			static bool isDenseRange(UInt32 minId, UInt32 maxId, size_t count)
+			{
+				const size_t slots = static_cast<size_t>(maxId - minId) + 1;
+				return slots <= MinDenseSlots || slots <= count * MaxSlotsPerEntry;
+			}
+
+			typename std::vector<Entry>::iterator lowerBound(UInt32 id)
+			{
+				return std::lower_bound(m_sorted.begin(), m_sorted.end(), id, [](const Entry &entry, UInt32 id)
+				{
+					return entry.first < id;
+				});
+			}
+
+			std::vector<Entry> getEntries() const
+			{
+				if (m_layout == template_index_layout::Sorted)
+				{
+					return m_sorted;
+				}
+
+				std::vector<Entry> entries;
+				entries.reserve(m_count);
+				for (size_t i = 0; i < m_dense.size(); ++i)
+				{
+					if (m_dense[i])
+					{
+						entries.push_back(Entry(m_base + static_cast<UInt32>(i), m_dense[i]));
+					}
+				}
+
+				return entries;
+			}
+
+		private:
+
+			TemplateIndexLayout m_layout;
+			UInt32 m_base;
+			size_t m_count;
+			std::vector<T *> m_dense;
+			std::vector<Entry> m_sorted;
+		};
+	}
+}
@@ -19,6 +19,7 @@
 // and lore are copyrighted by Blizzard Entertainment, Inc.
 //
 
+
 #include "pch.h"
 #include "compile_directory.h"
 #include "common/macros.h"
@@ -26,6 +27,7 @@
 #include "simple_file_format/sff_load_file.h"
 #include "simple_file_format/sff_read_tree.h"
 #include "simple_file_format/sff_write_table.h"
+#include "simple_file_format/sff_write_array.h"
 #include "virtual_directory/reader.h"
 #include "virtual_directory/writer.h"
 
@@ -39,18 +41,365 @@ namespace wowpp
 			typedef sff::read::tree::Table<Iterator> Table;
 			typedef sff::write::Table<char> TableWriter;
 
+			/// Name of the file in the cache directory which remembers the state of all
+			/// compiled files for the next compilation.
+			const virtual_dir::Path CacheFileName = "compile_cache.txt";
+			const unsigned CacheFileVersion = 1;
+
+			/// State of an output file as it was written by a previous compilation.
+			struct CachedFile
+			{
+				virtual_dir::FileInfo source;
+				std::string sha1;
+				std::uintmax_t originalSize;
+				std::uintmax_t outputSize;
+
+				CachedFile()
+					: originalSize(0)
+					, outputSize(0)
+				{
+				}
+			};
+
+			typedef std::map<virtual_dir::Path, CachedFile> CachedFiles;
+
+			/// A single source file which has to be written to the output.
+			struct FileJob
+			{
+				virtual_dir::Path source;
+				virtual_dir::Path output;
+				std::string compressedName;
+
+				bool hasSourceInfo;
+				virtual_dir::FileInfo sourceInfo;
+				std::uintmax_t originalSize;
+				std::string sha1;
+				std::uintmax_t compressedSize;
+				bool reused;
+
+				FileJob()
+					: hasSourceInfo(false)
+					, originalSize(0)
+					, compressedSize(0)
+					, reused(false)
+				{
+				}
+			};
+
+			/// Compilation happens in two passes over the source description: The first one
+			/// collects all files, which are then processed in parallel. The second one writes
+			/// the list file in the same order, so its content does not depend on timing.
+			struct CompileContext
+			{
+				virtual_dir::IReader &sourceRoot;
+				virtual_dir::IWriter &outputRoot;
+				const CompileOptions &options;
+				bool isCollecting;
+				std::vector<FileJob> files;
+				size_t nextFile;
+
+				CompileContext(virtual_dir::IReader &sourceRoot, virtual_dir::IWriter &outputRoot, const CompileOptions &options)
+					: sourceRoot(sourceRoot)
+					, outputRoot(outputRoot)
+					, options(options)
+					, isCollecting(true)
+					, nextFile(0)
+				{
+				}
+			};
+
+			std::string hashToString(const SHA1Hash &hash)
+			{
+				std::ostringstream formatter;
+				sha1PrintHex(formatter, hash);
+				return formatter.str();
+			}
+
+			CachedFiles loadCache(virtual_dir::IReader &previousCache)
+			{
+				CachedFiles cache;
+
+				const auto cacheFile = previousCache.readFile(CacheFileName, false);
+				if (!cacheFile)
+				{
+					return cache;
+				}
+
+				try
+				{
+					std::string cacheContent;
+					Table cacheTable;
+					sff::loadTableFromFile(cacheTable, cacheContent, *cacheFile);
+
+					if (cacheTable.getInteger<unsigned>("version", 0) != CacheFileVersion)
+					{
+						return cache;
+					}
+
+					const auto *const files = cacheTable.getArray("files");
+					if (!files)
+					{
+						return cache;
+					}
+
+					for (size_t i = 0, c = files->getSize(); i < c; ++i)
+					{
+						const auto *const file = files->getTable(i);
+						if (!file)
+						{
+							continue;
+						}
+
+						CachedFile entry;
+						const auto name = file->getString("name", "");
+						entry.source.size = file->getInteger<std::uintmax_t>("size", 0);
+						entry.source.lastWriteTime = file->getInteger<std::time_t>("lastWriteTime", 0);
+						entry.sha1 = file->getString("sha1", "");
+						entry.originalSize = file->getInteger<std::uintmax_t>("originalSize", 0);
+						entry.outputSize = file->getInteger<std::uintmax_t>("outputSize", 0);
+						if (!name.empty() && !entry.sha1.empty())
+						{
+							cache[name] = entry;
+						}
+					}
+				}
+				catch (const sff::read::ParseException<Iterator> &)
+				{
+					// A damaged cache only means that everything is compiled again
+					cache.clear();
+				}
+
+				return cache;
+			}
+
+			void saveCache(virtual_dir::IWriter &cacheRoot, const std::vector<FileJob> &files, bool isZLibCompressed)
+			{
+				const auto cacheFile = cacheRoot.writeFile(CacheFileName, false, true);
+				if (!cacheFile)
+				{
+					throw std::runtime_error("Could not open output cache file " + CacheFileName);
+				}
+
+				sff::write::Writer<char> cacheWriter(*cacheFile);
+				TableWriter cacheTable(cacheWriter, sff::write::MultiLine);
+				cacheTable.addKey("version", CacheFileVersion);
+
+				sff::write::Array<char> filesOutput(cacheTable, "files", sff::write::MultiLine);
+				for (const auto &file : files)
+				{
+					if (!file.hasSourceInfo)
+					{
+						continue;
+					}
+
+					TableWriter fileOutput(filesOutput, sff::write::Comma);
+					fileOutput.addKey("name", file.output);
+					fileOutput.addKey("size", file.sourceInfo.size);
+					fileOutput.addKey("lastWriteTime", file.sourceInfo.lastWriteTime);
+					fileOutput.addKey("sha1", file.sha1);
+					fileOutput.addKey("originalSize", file.originalSize);
+					fileOutput.addKey("outputSize", isZLibCompressed ? file.compressedSize : file.originalSize);
+					fileOutput.finish();
+				}
+				filesOutput.finish();
+				cacheTable.finish();
+			}
+
+			/// Checks whether the output of a previous compilation can be used for a file.
+			bool tryReuse(
+			    CompileContext &context,
+			    const CachedFiles &cache,
+			    std::mutex &ioMutex,
+			    FileJob &job)
+			{
+				const auto cached = cache.find(job.output);
+				if (cached == cache.end() ||
+				        !job.hasSourceInfo ||
+				        cached->second.source.size != job.sourceInfo.size)
+				{
+					return false;
+				}
+
+				// The output has to be intact as well
+				virtual_dir::FileInfo outputInfo;
+				{
+					std::lock_guard<std::mutex> lock(ioMutex);
+					if (!context.options.previousOutput->getFileInfo(job.output, outputInfo) ||
+					        outputInfo.size != cached->second.outputSize)
+					{
+						return false;
+					}
+				}
+
+				// If only the modification time changed, the content might still be the same
+				if (cached->second.source.lastWriteTime != job.sourceInfo.lastWriteTime)
+				{
+					std::unique_ptr<std::istream> sourceFile;
+					{
+						std::lock_guard<std::mutex> lock(ioMutex);
+						sourceFile = context.sourceRoot.readFile(job.source, false);
+					}
+
+					if (!sourceFile ||
+					        hashToString(sha1(*sourceFile)) != cached->second.sha1)
+					{
+						return false;
+					}
+				}
+
+				job.sha1 = cached->second.sha1;
+				job.originalSize = cached->second.originalSize;
+				job.compressedSize = cached->second.outputSize;
+				job.reused = true;
+				return true;
+			}
+
+			/// Hashes a source file and writes it to the output.
+			void processFile(
+			    CompileContext &context,
+			    const CachedFiles &cache,
+			    std::mutex &ioMutex,
+			    FileJob &job)
+			{
+				{
+					std::lock_guard<std::mutex> lock(ioMutex);
+					job.hasSourceInfo = context.sourceRoot.getFileInfo(job.source, job.sourceInfo);
+				}
+
+				if (context.options.previousOutput &&
+				        tryReuse(context, cache, ioMutex, job))
+				{
+					return;
+				}
+
+				std::unique_ptr<std::istream> sourceFile;
+				{
+					std::lock_guard<std::mutex> lock(ioMutex);
+					sourceFile = context.sourceRoot.readFile(job.source, false);
+				}
+
+				if (!sourceFile)
+				{
+					throw std::runtime_error(
+					    "Could not open source file " +
+					    job.source);
+				}
+
+				sourceFile->seekg(0, std::ios::end);
+				job.originalSize = static_cast<std::uintmax_t>(sourceFile->tellg());
+
+				sourceFile->seekg(0, std::ios::beg);
+				job.sha1 = hashToString(sha1(*sourceFile));
+
+				//workaround:
+				std::unique_ptr<std::ostream> outputFile;
+				{
+					std::lock_guard<std::mutex> lock(ioMutex);
+					outputFile = context.outputRoot.writeFile(
+					                 job.output,
+					                 false,
+					                 true
+					             );
+				}
+
+				if (!outputFile)
+				{
+					throw std::runtime_error(
+					    "Could not open output file " +
+					    job.output);
+				}
+
+				sourceFile->clear();
+				sourceFile->seekg(0, std::ios::beg);
+
+				{
+					boost::iostreams::filtering_ostream compressor;
+
+					if (context.options.isZLibCompressed)
+					{
+						compressor.push(boost::iostreams::zlib_compressor());
+					}
+
+					compressor.push(*outputFile);
+					compressor << sourceFile->rdbuf();
+				}
+
+				if (context.options.isZLibCompressed)
+				{
+					job.compressedSize = static_cast<std::uintmax_t>(outputFile->tellp());
+				}
+			}
+
+			/// Processes all collected files on a number of worker threads.
+			void processFiles(CompileContext &context, const CachedFiles &cache)
+			{
+				size_t threadCount = context.options.threadCount;
+				if (threadCount == 0)
+				{
+					threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+				}
+				threadCount = std::max<size_t>(1, std::min(threadCount, context.files.size()));
+
+				std::mutex ioMutex;
+				std::mutex errorMutex;
+				std::exception_ptr error;
+				std::atomic<size_t> nextIndex(0);
+
+				const auto worker = [&]()
+				{
+					for (;;)
+					{
+						const size_t index = nextIndex.fetch_add(1);
+						if (index >= context.files.size())
+						{
+							break;
+						}
+
+						try
+						{
+							processFile(context, cache, ioMutex, context.files[index]);
+						}
+						catch (...)
+						{
+							std::lock_guard<std::mutex> lock(errorMutex);
+							if (!error)
+							{
+								error = std::current_exception();
+							}
+
+							// Stop all workers
+							nextIndex = context.files.size();
+						}
+					}
+				};
+
+				std::vector<std::thread> threads;
+				for (size_t i = 1; i < threadCount; ++i)
+				{
+					threads.emplace_back(worker);
+				}
+
+				worker();
+				for (auto &thread : threads)
+				{
+					thread.join();
+				}
+
+				if (error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
 
 			void compileFile(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
 			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed,
 			    const std::string &fileName
 			)
 			{
-				const auto type = sourceRoot.getType(fromLocation);
+				const auto type = context.sourceRoot.getType(fromLocation);
 
 				if (type == virtual_dir::file_type::Directory)
 				{
@@ -59,7 +408,7 @@ namespace wowpp
 					    "entries",
 					    sff::write::MultiLine);
 
-					const auto entries = sourceRoot.queryEntries(
+					const auto entries = context.sourceRoot.queryEntries(
 					                         fromLocation
 					                     );
 
@@ -70,12 +419,10 @@ namespace wowpp
 						entryOutput.addKey("name", entry);
 
 						compileFile(
-						    sourceRoot,
-						    outputRoot,
+						    context,
 						    virtual_dir::joinPaths(fromLocation, entry),
 						    entryOutput,
 						    virtual_dir::joinPaths(destinationDir, entry),
-						    isZLibCompressed,
 						    entry
 						);
 
@@ -86,101 +433,58 @@ namespace wowpp
 				}
 				else if (type == virtual_dir::file_type::File)
 				{
-					const auto sourceFile = sourceRoot.readFile(
-					                            fromLocation,
-					                            false
-					                        );
-
-					if (!sourceFile)
-					{
-						throw std::runtime_error(
-						    "Could not open source file " +
-						    fromLocation);
-					}
-
-					auto compressedNameFull = destinationDir;
-					if (isZLibCompressed)
-					{
-						const auto compressedName = fileName + ".z";
-						outputDescription.addKey("compressedName", compressedName);
-
-						compressedNameFull += ".z";
-					}
-
+					if (context.isCollecting)
 					{
-						sourceFile->seekg(0, std::ios::end);
+						FileJob job;
+						job.source = fromLocation;
+						job.output = destinationDir;
+						if (context.options.isZLibCompressed)
 						{
-							const std::streamoff originalSize = sourceFile->tellg();
-							outputDescription.addKey("originalSize", originalSize);
+							job.compressedName = fileName + ".z";
+							job.output += ".z";
 						}
 
-						sourceFile->seekg(0, std::ios::beg);
-						{
-							const auto hashCode = sha1(*sourceFile);
-							std::ostringstream formatter;
-							sha1PrintHex(formatter, hashCode);
-							outputDescription.addKey("sha1", formatter.str());
-						}
+						context.files.push_back(std::move(job));
+						return;
 					}
 
-					//workaround:
-					const auto outputFile = outputRoot.writeFile(
-					                            compressedNameFull,
-					                            false,
-					                            true
-					                        );
-
-					if (!outputFile)
+					if (context.nextFile >= context.files.size() ||
+					        context.files[context.nextFile].source != fromLocation)
 					{
-						throw std::runtime_error(
-						    "Could not open output file " +
-						    compressedNameFull);
+						throw std::runtime_error("Source directory changed during compilation: " + fromLocation);
 					}
 
-					sourceFile->clear();
-					sourceFile->seekg(0, std::ios::beg);
-
+					const auto &job = context.files[context.nextFile++];
+					if (context.options.isZLibCompressed)
 					{
-						boost::iostreams::filtering_ostream compressor;
-
-						if (isZLibCompressed)
-						{
-							boost::iostreams::zlib_params params;
-							params.noheader = false;
-							compressor.push(boost::iostreams::zlib_compressor());
-							outputDescription.addKey("compression", "zlib");
-						}
-
-						compressor.push(*outputFile);
-						compressor << sourceFile->rdbuf();
+						outputDescription.addKey("compressedName", job.compressedName);
 					}
 
-					if (isZLibCompressed)
+					outputDescription.addKey("originalSize", job.originalSize);
+					outputDescription.addKey("sha1", job.sha1);
+
+					if (context.options.isZLibCompressed)
 					{
-						const boost::uintmax_t compressedSize = outputFile->tellp();
-						outputDescription.addKey("compressedSize", compressedSize);
+						outputDescription.addKey("compression", "zlib");
+						outputDescription.addKey("compressedSize", job.compressedSize);
 					}
 				}
 			}
 
 			void compileIf(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			);
 
 			void compileEntry(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			)
 			{
 				const auto type = inputDescription.getString("type");
@@ -189,13 +493,11 @@ namespace wowpp
 				if (type == "if")
 				{
 					compileIf(
-					    sourceRoot,
-					    outputRoot,
+					    context,
 					    inputDescription,
 					    fromLocation,
 					    outputDescription,
-					    destinationDir,
-					    isZLibCompressed
+					    destinationDir
 					);
 				}
 				else
@@ -232,13 +534,11 @@ namespace wowpp
 							    sff::write::Comma);
 
 							compileEntry(
-							    sourceRoot,
-							    outputRoot,
+							    context,
 							    *entryDescription,
 							    subFromLocation,
 							    entryDescriptionOutput,
-							    subDestinationDir,
-							    isZLibCompressed
+							    subDestinationDir
 							);
 
 							entryDescriptionOutput.finish();
@@ -249,12 +549,10 @@ namespace wowpp
 					else
 					{
 						compileFile(
-						    sourceRoot,
-						    outputRoot,
+						    context,
 						    subFromLocation,
 						    outputDescription,
 						    subDestinationDir,
-						    isZLibCompressed,
 						    to
 						);
 					}
@@ -262,13 +560,11 @@ namespace wowpp
 			}
 
 			void compileIf(
-			    virtual_dir::IReader &sourceRoot,
-			    virtual_dir::IWriter &outputRoot,
+			    CompileContext &context,
 			    const Table &inputDescription,
 			    const virtual_dir::Path &fromLocation,
 			    TableWriter &outputDescription,
-			    const virtual_dir::Path &destinationDir,
-			    bool isZLibCompressed
+			    const virtual_dir::Path &destinationDir
 			)
 			{
 				{
@@ -292,23 +588,21 @@ namespace wowpp
 				    sff::write::Comma);
 
 				compileEntry(
-				    sourceRoot,
-				    outputRoot,
+				    context,
 				    *value,
 				    fromLocation,
 				    valueOutput,
-				    destinationDir,
-				    isZLibCompressed
+				    destinationDir
 				);
 
 				valueOutput.finish();
 			}
 		}
 
-		void compileDirectory(
+		CompileStatistics compileDirectory(
 		    virtual_dir::IReader &sourceDir,
 		    virtual_dir::IWriter &destinationDir,
-		    bool isZLibCompressed
+		    const CompileOptions &options
 		)
 		{
 			const virtual_dir::Path fullSourceFileName = "source.txt";
@@ -323,14 +617,48 @@ namespace wowpp
 			sff::loadTableFromFile(sourceTable, sourceContent, *sourceFile);
 
 			const auto version = sourceTable.getInteger<unsigned>("version", 0);
-			if (version == 0)
+			if (version != 0)
 			{
-				const auto *const root = sourceTable.getTable("root");
-				if (!root)
-				{
-					throw std::runtime_error("Root directory entry is missing");
-				}
+				throw std::runtime_error("Unsupported source list version");
+			}
+
+			const auto *const root = sourceTable.getTable("root");
+			if (!root)
+			{
+				throw std::runtime_error("Root directory entry is missing");
+			}
+
+			CompileContext context(sourceDir, destinationDir, options);
+
+			// Collect all files. The description written in this pass is discarded.
+			{
+				std::ostringstream discarded;
+				sff::write::Writer<char> listWriter(discarded);
+				TableWriter listTable(listWriter, sff::write::MultiLine);
+
+				TableWriter rootEntry(listTable, "root", sff::write::Comma);
+				compileEntry(
+				    context,
+				    *root,
+				    "",
+				    rootEntry,
+				    ""
+				);
+				rootEntry.finish();
+			}
+
+			// Load the cache before any output is written
+			CachedFiles cache;
+			if (options.previousOutput && options.previousCache)
+			{
+				cache = loadCache(*options.previousCache);
+			}
+
+			processFiles(context, cache);
 
+			// Write the list of all files in source order
+			context.isCollecting = false;
+			{
 				const virtual_dir::Path fullListFileName = "list.txt";
 				const auto listFile = destinationDir.writeFile(
 				                          fullListFileName, false, true);
@@ -348,20 +676,34 @@ namespace wowpp
 
 				TableWriter rootEntry(listTable, "root", sff::write::Comma);
 				compileEntry(
-				    sourceDir,
-				    destinationDir,
+				    context,
 				    *root,
 				    "",
 				    rootEntry,
-				    "",
-				    isZLibCompressed
+				    ""
 				);
 				rootEntry.finish();
 			}
-			else
+
+			if (options.cache)
 			{
-				throw std::runtime_error("Unsupported source list version");
+				saveCache(*options.cache, context.files, options.isZLibCompressed);
+			}
+
+			CompileStatistics statistics;
+			for (const auto &file : context.files)
+			{
+				if (file.reused)
+				{
+					++statistics.reusedFiles;
+				}
+				else
+				{
+					++statistics.compiledFiles;
+				}
 			}
+
+			return statistics;
 		}
 	}
 }
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace wowpp
 {
 	namespace virtual_dir
@@ -31,10 +33,52 @@ namespace wowpp
 
 	namespace updating
 	{
-		void compileDirectory(
+		/// Settings of an update compilation.
+		struct CompileOptions
+		{
+			/// Whether output files are compressed using zlib.
+			bool isZLibCompressed;
+			/// Number of threads used to hash and compress files. 0 uses one per core.
+			size_t threadCount;
+			/// Optional reader of the output directory of a previous compilation. If set,
+			/// files which did not change since then are not compressed and written again.
+			virtual_dir::IReader *previousOutput;
+			/// Optional reader of the directory which holds the cache written by the previous
+			/// compilation. Only used together with previousOutput.
+			virtual_dir::IReader *previousCache;
+			/// Optional writer of the directory which receives the cache for the next compilation.
+			/// This should be outside of the output directory, which is published to clients.
+			virtual_dir::IWriter *cache;
+
+			CompileOptions()
+				: isZLibCompressed(false)
+				, threadCount(0)
+				, previousOutput(nullptr)
+				, previousCache(nullptr)
+				, cache(nullptr)
+			{
+			}
+		};
+
+		/// Results of an update compilation.
+		struct CompileStatistics
+		{
+			/// Number of files which were hashed and written.
+			size_t compiledFiles;
+			/// Number of files which were reused from the previous compilation.
+			size_t reusedFiles;
+
+			CompileStatistics()
+				: compiledFiles(0)
+				, reusedFiles(0)
+			{
+			}
+		};
+
+		CompileStatistics compileDirectory(
 		    virtual_dir::IReader &sourceDir,
 		    virtual_dir::IWriter &destinationDir,
-		    bool isZLibCompressed
+		    const CompileOptions &options
 		);
 	}
 }
@@ -47,6 +47,8 @@
 #include <fstream>
 #include <set>
 #include <thread>
+#include <mutex>
+#include <atomic>
 
 // Boost Libraies
 #include <boost/optional.hpp>
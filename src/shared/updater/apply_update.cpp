@@ -0,0 +1,216 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "apply_update.h"
+#include "prepared_update.h"
+#include "update_parameters.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+
+namespace wowpp
+{
+	namespace updating
+	{
+		namespace
+		{
+			/// Lets the steps use the update source of the original parameters.
+			struct SharedUpdateSource : IUpdateSource
+			{
+				explicit SharedUpdateSource(IUpdateSource &source)
+					: m_source(source)
+				{
+				}
+
+				virtual UpdateSourceFile readFile(
+				    const std::string &path
+				) override
+				{
+					return m_source.readFile(path);
+				}
+
+				virtual UpdateSourceFile readFileRange(
+				    const std::string &path,
+				    boost::uintmax_t offset
+				) override
+				{
+					return m_source.readFileRange(path, offset);
+				}
+
+			private:
+
+				IUpdateSource &m_source;
+			};
+
+			/// Serializes progress reports of concurrent downloads and sums them up.
+			struct ConcurrentProgressHandler : IUpdaterProgressHandler
+			{
+				typedef std::chrono::steady_clock Clock;
+
+				explicit ConcurrentProgressHandler(IUpdaterProgressHandler &target, boost::uintmax_t totalSize)
+					: m_target(target)
+					, m_totalSize(totalSize)
+					, m_loaded(0)
+					, m_downloaded(0)
+					, m_start(Clock::now())
+				{
+				}
+
+				virtual void updateFile(const std::string &name, boost::uintmax_t size, boost::uintmax_t loaded) override
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+
+					// The first report of a file contains the bytes resumed from a previous
+					// download, which don't count as received from the network.
+					const auto file = m_files.find(name);
+					if (file == m_files.end())
+					{
+						m_files[name] = loaded;
+						m_loaded += loaded;
+					}
+					else if (loaded >= file->second)
+					{
+						m_loaded += loaded - file->second;
+						m_downloaded += loaded - file->second;
+						file->second = loaded;
+					}
+
+					m_target.updateFile(name, size, loaded);
+					m_target.updateTotal(m_totalSize, m_loaded, getBytesPerSecond());
+				}
+
+				boost::uintmax_t getDownloaded()
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					return m_downloaded;
+				}
+
+				double getSeconds() const
+				{
+					return std::chrono::duration<double>(Clock::now() - m_start).count();
+				}
+
+			private:
+
+				double getBytesPerSecond() const
+				{
+					const double seconds = getSeconds();
+					return seconds > 0.0 ? static_cast<double>(m_downloaded) / seconds : 0.0;
+				}
+
+			private:
+
+				IUpdaterProgressHandler &m_target;
+				const boost::uintmax_t m_totalSize;
+				std::mutex m_mutex;
+				std::map<std::string, boost::uintmax_t> m_files;
+				boost::uintmax_t m_loaded;
+				boost::uintmax_t m_downloaded;
+				const Clock::time_point m_start;
+			};
+		}
+
+		UpdateStatistics::UpdateStatistics()
+			: downloadedBytes(0)
+			, seconds(0.0)
+		{
+		}
+
+		double UpdateStatistics::getBytesPerSecond() const
+		{
+			return seconds > 0.0 ? static_cast<double>(downloadedBytes) / seconds : 0.0;
+		}
+
+		UpdateStatistics applyUpdate(
+		    const PreparedUpdate &preparedUpdate,
+		    const UpdateParameters &parameters,
+		    size_t connectionCount
+		)
+		{
+			ConcurrentProgressHandler progress(parameters.progressHandler, preparedUpdate.estimates.downloadSize);
+			const UpdateParameters stepParameters(
+			    std::unique_ptr<IUpdateSource>(new SharedUpdateSource(*parameters.source)),
+			    parameters.doUnpackArchives,
+			    progress
+			);
+
+			const auto &steps = preparedUpdate.steps;
+			const size_t threadCount = std::max<size_t>(1, std::min(connectionCount, steps.size()));
+
+			std::atomic<size_t> nextStep(0);
+			std::mutex errorMutex;
+			std::exception_ptr error;
+
+			const auto worker = [&]()
+			{
+				for (;;)
+				{
+					const size_t index = nextStep.fetch_add(1);
+					if (index >= steps.size())
+					{
+						break;
+					}
+
+					try
+					{
+						while (steps[index].step(stepParameters)) {
+							;
+						}
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(errorMutex);
+						if (!error)
+						{
+							error = std::current_exception();
+						}
+
+						// Don't start any more downloads
+						nextStep = steps.size();
+					}
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (size_t i = 1; i < threadCount; ++i)
+			{
+				threads.emplace_back(worker);
+			}
+
+			worker();
+			for (auto &thread : threads)
+			{
+				thread.join();
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+
+			UpdateStatistics statistics;
+			statistics.downloadedBytes = progress.getDownloaded();
+			statistics.seconds = progress.getSeconds();
+			return statistics;
+		}
+	}
+}
@@ -0,0 +1,54 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+namespace wowpp
+{
+	namespace updating
+	{
+		struct PreparedUpdate;
+		struct UpdateParameters;
+
+
+		struct UpdateStatistics
+		{
+			/// Number of bytes received from the update source.
+			boost::uintmax_t downloadedBytes;
+			/// Time needed to apply the update.
+			double seconds;
+
+			UpdateStatistics();
+			double getBytesPerSecond() const;
+		};
+
+
+		/// Applies all steps of a prepared update using a number of concurrent connections
+		/// to the update source. Progress is reported per file and in total.
+		/// @param connectionCount Maximum number of files downloaded at the same time.
+		UpdateStatistics applyUpdate(
+		    const PreparedUpdate &preparedUpdate,
+		    const UpdateParameters &parameters,
+		    size_t connectionCount
+		);
+	}
+}
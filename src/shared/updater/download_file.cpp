@@ -0,0 +1,255 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "download_file.h"
+#include "update_parameters.h"
+#include "update_source.h"
+#include "updater_progress_handler.h"
+
+namespace wowpp
+{
+	namespace updating
+	{
+		namespace
+		{
+			/// Number of times a download is resumed after the connection broke.
+			const unsigned MaxDownloadAttempts = 3;
+
+			/// Writes data to a file while calculating its hash and size.
+			class VerifyingSink final
+			{
+			public:
+
+				typedef char char_type;
+				typedef boost::iostreams::sink_tag category;
+
+			public:
+
+				VerifyingSink(std::ostream &sink, Boost_SHA1HashSink &hash, boost::uintmax_t &size)
+					: m_sink(&sink)
+					, m_hash(&hash)
+					, m_size(&size)
+				{
+				}
+
+				std::streamsize write(const char *data, std::streamsize length)
+				{
+					m_sink->write(data, length);
+					if (!*m_sink)
+					{
+						throw std::runtime_error("Could not write to output file");
+					}
+
+					m_hash->write(data, length);
+					*m_size += static_cast<boost::uintmax_t>(length);
+					return length;
+				}
+
+			private:
+
+				std::ostream *m_sink;
+				Boost_SHA1HashSink *m_hash;
+				boost::uintmax_t *m_size;
+			};
+
+			/// Thrown if the received data is invalid, so the partial download can't be resumed.
+			struct DamagedDownload : std::runtime_error
+			{
+				explicit DamagedDownload(const std::string &message)
+					: std::runtime_error(message)
+				{
+				}
+			};
+
+			boost::uintmax_t getPartialSize(const boost::filesystem::path &partPath, boost::uintmax_t compressedSize)
+			{
+				boost::system::error_code error;
+				const auto size = boost::filesystem::file_size(partPath, error);
+				if (error)
+				{
+					return 0;
+				}
+
+				if (size > compressedSize)
+				{
+					boost::filesystem::remove(partPath, error);
+					return 0;
+				}
+
+				return size;
+			}
+
+			/// Downloads the missing part of a file. Data already received in a previous
+			/// attempt is read from the partial file, so only new bytes use the network.
+			void tryDownload(
+			    const UpdateParameters &parameters,
+			    const std::string &source,
+			    const std::string &destination,
+			    const boost::filesystem::path &partPath,
+			    boost::uintmax_t originalSize,
+			    const SHA1Hash &sha1,
+			    boost::uintmax_t compressedSize,
+			    bool doZLibUncompress)
+			{
+				std::ofstream sinkFile(destination, std::ios::binary | std::ios::trunc);
+				if (!sinkFile)
+				{
+					throw std::runtime_error("Could not open output file " + destination);
+				}
+
+				Boost_SHA1HashSink hash;
+				boost::uintmax_t uncompressedSize = 0;
+
+				boost::iostreams::filtering_ostream output;
+				if (doZLibUncompress)
+				{
+					output.push(boost::iostreams::zlib_decompressor());
+				}
+				output.push(VerifyingSink(sinkFile, hash, uncompressedSize));
+
+				std::array<char, 1024 * 16> buffer;
+
+				// Replay the data of a previous attempt
+				boost::uintmax_t written = getPartialSize(partPath, compressedSize);
+				if (written > 0)
+				{
+					std::ifstream partFile(partPath.string(), std::ios::binary);
+					boost::uintmax_t replayed = 0;
+					while (replayed < written && partFile)
+					{
+						partFile.read(buffer.data(), static_cast<std::streamsize>(
+						                  std::min<boost::uintmax_t>(buffer.size(), written - replayed)));
+						output.write(buffer.data(), partFile.gcount());
+						replayed += partFile.gcount();
+					}
+
+					if (replayed != written)
+					{
+						throw std::runtime_error("Could not read partial download " + partPath.string());
+					}
+				}
+
+				parameters.progressHandler.updateFile(source, compressedSize, written);
+
+				if (written < compressedSize)
+				{
+					auto sourceFile = parameters.source->readFileRange(source, written);
+					checkExpectedFileSize(source, compressedSize - written, sourceFile);
+
+					std::ofstream partFile(partPath.string(), std::ios::binary | std::ios::app);
+					if (!partFile)
+					{
+						throw std::runtime_error("Could not open output file " + partPath.string());
+					}
+
+					for (;;)
+					{
+						sourceFile.content->read(buffer.data(), buffer.size());
+						const auto readSize = sourceFile.content->gcount();
+						if ((written + readSize) > compressedSize)
+						{
+							throw DamagedDownload(source + ": Received more than expected");
+						}
+
+						partFile.write(buffer.data(), readSize);
+						output.write(buffer.data(), readSize);
+						written += readSize;
+
+						parameters.progressHandler.updateFile(source, compressedSize, written);
+
+						if (!*sourceFile.content)
+						{
+							break;
+						}
+					}
+
+					partFile.flush();
+					if (!partFile)
+					{
+						throw std::runtime_error("Could not write to " + partPath.string());
+					}
+
+					if (written < compressedSize)
+					{
+						throw std::runtime_error(source + ": Received incomplete file");
+					}
+				}
+
+				output.reset();
+				sinkFile.close();
+
+				if (uncompressedSize != originalSize ||
+				        hash.finalizeHash() != sha1)
+				{
+					throw DamagedDownload(source + ": Downloaded file is damaged");
+				}
+			}
+		}
+
+		void downloadFile(
+		    const UpdateParameters &parameters,
+		    const std::string &source,
+		    const std::string &destination,
+		    boost::uintmax_t originalSize,
+		    const SHA1Hash &sha1,
+		    boost::uintmax_t compressedSize,
+		    bool doZLibUncompress
+		)
+		{
+			const boost::filesystem::path partPath = destination + ".part";
+
+			for (unsigned attempt = 1;; ++attempt)
+			{
+				try
+				{
+					tryDownload(parameters, source, destination, partPath, originalSize, sha1, compressedSize, doZLibUncompress);
+					break;
+				}
+				catch (const DamagedDownload &)
+				{
+					// The partial data can't be trusted anymore
+					boost::system::error_code error;
+					boost::filesystem::remove(partPath, error);
+					throw;
+				}
+				catch (const boost::iostreams::zlib_error &)
+				{
+					boost::system::error_code error;
+					boost::filesystem::remove(partPath, error);
+					throw;
+				}
+				catch (const std::exception &)
+				{
+					// Most likely a broken connection: Keep the partial file and request the rest
+					if (attempt >= MaxDownloadAttempts)
+					{
+						throw;
+					}
+				}
+			}
+
+			boost::system::error_code error;
+			boost::filesystem::remove(partPath, error);
+		}
+	}
+}
@@ -0,0 +1,48 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/sha1.h"
+
+namespace wowpp
+{
+	namespace updating
+	{
+		struct UpdateParameters;
+
+
+		/// Downloads a file from the update source and writes its uncompressed content to the
+		/// destination. Received bytes are inflated and hashed while they arrive. The raw
+		/// download is kept in "<destination>.part" until the file is verified, so that a broken
+		/// connection only requests the missing bytes again, both immediately and in later runs.
+		void downloadFile(
+		    const UpdateParameters &parameters,
+		    const std::string &source,
+		    const std::string &destination,
+		    boost::uintmax_t originalSize,
+		    const SHA1Hash &sha1,
+		    boost::uintmax_t compressedSize,
+		    bool doZLibUncompress
+		);
+	}
+}
@@ -24,7 +24,7 @@
 #include "prepare_parameters.h"
 #include "prepare_progress_handler.h"
 #include "update_source.h"
-#include "copy_with_progress.h"
+#include "download_file.h"
 #include "parse_directory_entries.h"
 #include "common/macros.h"
 
@@ -103,12 +103,9 @@ namespace wowpp
 				update.estimates.updateSize = originalSize;
 				update.steps.push_back(PreparedUpdateStep(
 				                           destination,
-				                           [source, destination, compression, compressedSize]
+				                           [source, destination, originalSize, sha1, compression, compressedSize]
 				                           (const UpdateParameters & parameters) -> bool
 				{
-					const auto sourceFile = parameters.source->readFile(source);
-					checkExpectedFileSize(source, compressedSize, sourceFile);
-
 					bool doZLibUncompress = false;
 
 					if (compression == "zlib")
@@ -121,16 +118,12 @@ namespace wowpp
 						    "Unsupported compression type " + compression);
 					}
 
-					std::ofstream sinkFile(destination, std::ios::binary);
-					if (!sinkFile)
-					{
-						throw std::runtime_error("Could not open output file " + destination);
-					}
-					copyWithProgress(
+					downloadFile(
 					    parameters,
-					    *sourceFile.content,
-					    sinkFile,
 					    source,
+					    destination,
+					    originalSize,
+					    sha1,
 					    compressedSize,
 					    doZLibUncompress
 					);
@@ -51,5 +51,23 @@ namespace wowpp
 
 			return UpdateSourceFile(internalData, std::move(file), size);
 		}
+
+		UpdateSourceFile FileSystemUpdateSource::readFileRange(
+		    const std::string &path,
+		    boost::uintmax_t offset
+		)
+		{
+			auto file = readFile(path);
+			if (offset > 0)
+			{
+				file.content->seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+				if (!*file.content)
+				{
+					throw std::runtime_error(path + ": File is smaller than expected");
+				}
+			}
+
+			return file;
+		}
 	}
 }
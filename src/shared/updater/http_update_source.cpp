@@ -42,10 +42,19 @@ namespace wowpp
 		UpdateSourceFile HTTPUpdateSource::readFile(
 		    const std::string &path
 		)
+		{
+			return readFileRange(path, 0);
+		}
+
+		UpdateSourceFile HTTPUpdateSource::readFileRange(
+		    const std::string &path,
+		    boost::uintmax_t offset
+		)
 		{
 			net::http_client::Request request;
 			request.host = m_host;
 			request.document = m_path;
+			request.rangeBegin = offset;
 			virtual_dir::appendPath(request.document, path);
 
 			auto response = net::http_client::sendRequest(
@@ -53,18 +62,27 @@ namespace wowpp
 			                    m_port,
 			                    request);
 
-			if (response.status != net::http_client::Response::Ok)
+			const bool isPartial = (offset > 0 && response.status == net::http_client::Response::PartialContent);
+			if (response.status != net::http_client::Response::Ok && !isPartial)
 			{
 				throw std::runtime_error(
 				    path + ": HTTP response " +
 				    boost::lexical_cast<std::string>(response.status));
 			}
 
-			return UpdateSourceFile(
-			           response.getInternalData(),
-			           std::move(response.body),
-			           response.bodySize
-			       );
+			UpdateSourceFile file(
+			    response.getInternalData(),
+			    std::move(response.body),
+			    response.bodySize
+			);
+
+			// Servers without range support send the whole file
+			if (!isPartial)
+			{
+				skipSourceBytes(path, file, offset);
+			}
+
+			return file;
 		}
 	}
 }
@@ -40,6 +40,10 @@ namespace wowpp
 			virtual UpdateSourceFile readFile(
 			    const std::string &path
 			) override;
+			virtual UpdateSourceFile readFileRange(
+			    const std::string &path,
+			    boost::uintmax_t offset
+			) override;
 
 		private:
 
@@ -47,6 +47,9 @@
 #include <fstream>
 #include <set>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 
 // Boost Libraies
 #include <boost/optional.hpp>
@@ -29,5 +29,15 @@ namespace wowpp
 		IUpdateSource::~IUpdateSource()
 		{
 		}
+
+		UpdateSourceFile IUpdateSource::readFileRange(
+		    const std::string &path,
+		    boost::uintmax_t offset
+		)
+		{
+			auto file = readFile(path);
+			skipSourceBytes(path, file, offset);
+			return file;
+		}
 	}
 }
@@ -33,6 +33,13 @@ namespace wowpp
 			virtual UpdateSourceFile readFile(
 			    const std::string &path
 			) = 0;
+			/// Opens a file and skips the first bytes, which is used to resume downloads.
+			/// The default implementation reads and discards the skipped bytes.
+			/// @returns The file content starting at offset. The size is the remaining size.
+			virtual UpdateSourceFile readFileRange(
+			    const std::string &path,
+			    boost::uintmax_t offset
+			);
 		};
 
 	}
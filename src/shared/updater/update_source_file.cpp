@@ -78,5 +78,36 @@ namespace wowpp
 				    boost::lexical_cast<std::string>(*found.size));
 			}
 		}
+
+		void skipSourceBytes(
+		    const std::string &fileName,
+		    UpdateSourceFile &file,
+		    boost::uintmax_t count
+		)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			std::array<char, 1024 * 16> buffer;
+			boost::uintmax_t skipped = 0;
+			while (skipped < count)
+			{
+				const auto chunk = static_cast<std::streamsize>(
+				                       std::min<boost::uintmax_t>(buffer.size(), count - skipped));
+				file.content->read(buffer.data(), chunk);
+				if (file.content->gcount() != chunk)
+				{
+					throw std::runtime_error(fileName + ": File is smaller than expected");
+				}
+				skipped += chunk;
+			}
+
+			if (file.size)
+			{
+				file.size = (*file.size > count ? *file.size - count : 0);
+			}
+		}
 	}
 }
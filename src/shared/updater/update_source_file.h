@@ -49,5 +49,12 @@ namespace wowpp
 		    boost::uintmax_t expected,
 		    const UpdateSourceFile &found
 		);
+
+		/// Discards the first bytes of a source file and adjusts its remaining size.
+		void skipSourceBytes(
+		    const std::string &fileName,
+		    UpdateSourceFile &file,
+		    boost::uintmax_t count
+		);
 	}
 }
@@ -29,5 +29,9 @@ namespace wowpp
 		IUpdaterProgressHandler::~IUpdaterProgressHandler()
 		{
 		}
+
+		void IUpdaterProgressHandler::updateTotal(boost::uintmax_t /*size*/, boost::uintmax_t /*loaded*/, double /*bytesPerSecond*/)
+		{
+		}
 	}
 }
@@ -29,6 +29,9 @@ namespace wowpp
 		{
 			virtual ~IUpdaterProgressHandler();
 			virtual void updateFile(const std::string &name, boost::uintmax_t size, boost::uintmax_t loaded) = 0;
+			/// Reports the progress of all files which are downloaded concurrently.
+			/// @param bytesPerSecond Average network throughput since the update started.
+			virtual void updateTotal(boost::uintmax_t size, boost::uintmax_t loaded, double bytesPerSecond);
 		};
 	}
 }
@@ -85,5 +85,29 @@ namespace wowpp
 
 			return entries;
 		}
+
+		bool FileSystemReader::getFileInfo(
+		    const Path &fileName,
+		    FileInfo &out_info)
+		{
+			const auto fullPath = m_directory / fileName;
+
+			boost::system::error_code error;
+			const auto size = boost::filesystem::file_size(fullPath, error);
+			if (error)
+			{
+				return false;
+			}
+
+			const auto lastWriteTime = boost::filesystem::last_write_time(fullPath, error);
+			if (error)
+			{
+				return false;
+			}
+
+			out_info.size = size;
+			out_info.lastWriteTime = lastWriteTime;
+			return true;
+		}
 	}
 }
@@ -29,5 +29,13 @@ namespace wowpp
 		IReader::~IReader()
 		{
 		}
+
+		bool IReader::getFileInfo(
+		    const Path &/*fileName*/,
+		    FileInfo &/*out_info*/
+		)
+		{
+			return false;
+		}
 	}
 }
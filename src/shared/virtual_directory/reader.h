@@ -22,6 +22,8 @@
 #pragma once
 
 #include "path.h"
+#include <cstdint>
+#include <ctime>
 #include <memory>
 #include <set>
 
@@ -39,6 +41,20 @@ namespace wowpp
 		}
 
 
+		/// Meta data of a file which can be used to detect modifications.
+		struct FileInfo
+		{
+			std::uintmax_t size;
+			std::time_t lastWriteTime;
+
+			FileInfo()
+				: size(0)
+				, lastWriteTime(0)
+			{
+			}
+		};
+
+
 		struct IReader
 		{
 			virtual ~IReader();
@@ -52,6 +68,12 @@ namespace wowpp
 			virtual std::set<Path> queryEntries(
 			    const Path &fileName
 			) = 0;
+			/// Gets the size and modification time of a file if the reader supports it.
+			/// @returns false if the file doesn't exist or the information is not available.
+			virtual bool getFileInfo(
+			    const Path &fileName,
+			    FileInfo &out_info
+			);
 		};
 	}
 }
@@ -65,5 +65,14 @@ namespace wowpp
 			const auto fullPath = joinPaths(m_relation, fileName);
 			return m_parent.queryEntries(fullPath);
 		}
+
+		bool RelativeReader::getFileInfo(
+		    const Path &fileName,
+		    FileInfo &out_info
+		)
+		{
+			const auto fullPath = joinPaths(m_relation, fileName);
+			return m_parent.getFileInfo(fullPath, out_info);
+		}
 	}
 }
@@ -44,6 +44,10 @@ namespace wowpp
 			virtual std::set<Path> queryEntries(
 			    const Path &fileName
 			) override;
+			virtual bool getFileInfo(
+			    const Path &fileName,
+			    FileInfo &out_info
+			) override;
 
 		private:
 
@@ -29,11 +29,14 @@ namespace wowpp
 	{
 		OutgoingPacket::OutgoingPacket(io::ISink &sink)
 			: io::Writer(sink)
+			, m_opCode(0)
 		{
 		}
 
 		void OutgoingPacket::start(PacketId id)
 		{
+			m_opCode = id;
+
 			*this
 			        << io::write<NetPacketBegin>(constants::PacketBegin)
 			        << io::write<NetUInt8>(id);
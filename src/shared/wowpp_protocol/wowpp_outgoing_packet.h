@@ -37,10 +37,15 @@ namespace wowpp
 			void start(PacketId id);
 			void finish();
 
+			PacketId getOpCode() const {
+				return m_opCode;
+			}
+
 		private:
 
 			std::size_t m_sizePosition;
 			std::size_t m_bodyPosition;
+			PacketId m_opCode;
 		};
 	}
 }
@@ -193,6 +193,35 @@ namespace wowpp
 						;
 					out_packet.finish();
 				}
+
+				void worldLoad(pp::OutgoingPacket &out_packet, UInt32 playerCount, UInt32 instanceCount, UInt32 tickDuration)
+				{
+					out_packet.start(world_packet::WorldLoad);
+					out_packet
+						<< io::write<NetUInt32>(playerCount)
+						<< io::write<NetUInt32>(instanceCount)
+						<< io::write<NetUInt32>(tickDuration)
+						;
+					out_packet.finish();
+				}
+
+				void worldInstanceUnloaded(pp::OutgoingPacket &out_packet, UInt32 instanceId)
+				{
+					out_packet.start(world_packet::WorldInstanceUnloaded);
+					out_packet
+						<< io::write<NetUInt32>(instanceId)
+						;
+					out_packet.finish();
+				}
+
+				void worldTickProfile(pp::OutgoingPacket &out_packet, const String &profile)
+				{
+					out_packet.start(world_packet::WorldTickProfile);
+					out_packet
+						<< io::write_dynamic_range<NetUInt32>(profile)
+						;
+					out_packet.finish();
+				}
 			}
 
 			namespace realm_write
@@ -469,6 +498,29 @@ namespace wowpp
 						>> io::read<NetUInt32>(out_mailId)
 						;
 				}
+
+				bool worldLoad(io::Reader &packet, UInt32 &out_playerCount, UInt32 &out_instanceCount, UInt32 &out_tickDuration)
+				{
+					return packet
+						>> io::read<NetUInt32>(out_playerCount)
+						>> io::read<NetUInt32>(out_instanceCount)
+						>> io::read<NetUInt32>(out_tickDuration)
+						;
+				}
+
+				bool worldInstanceUnloaded(io::Reader &packet, UInt32 &out_instanceId)
+				{
+					return packet
+						>> io::read<NetUInt32>(out_instanceId)
+						;
+				}
+
+				bool worldTickProfile(io::Reader &packet, String &out_profile)
+				{
+					return packet
+						>> io::read_container<NetUInt32>(out_profile)
+						;
+				}
 			}
 
 			namespace realm_read
@@ -36,7 +36,7 @@ namespace wowpp
 	{
 		namespace world_realm
 		{
-			static const UInt32 ProtocolVersion = 0x19;
+			static const UInt32 ProtocolVersion = 0x1C;
 
 			namespace world_instance_error
 			{
@@ -97,7 +97,13 @@ namespace wowpp
 					/// Sent by the world server when a player requests its mails.
 					MailGetList,
 					/// Sent by the world server when a player marks a mail as read.
-					MailMarkAsRead
+					MailMarkAsRead,
+					/// Sent periodically by the world server to report its current load.
+					WorldLoad,
+					/// Sent by the world server when an idle world instance has been unloaded.
+					WorldInstanceUnloaded,
+					/// Sent periodically by the world server if its tick profiler is enabled.
+					WorldTickProfile
 				};
 			}
 
@@ -289,6 +295,34 @@ namespace wowpp
 					DatabaseId characterId,
 					UInt32 mailId
 				);
+
+				/// Reports the current load of the world node.
+				/// @param out_packet Packet buffer where the data will be written to.
+				/// @param playerCount Number of players connected to this world node.
+				/// @param instanceCount Number of running world instances on this world node.
+				/// @param tickDuration Average duration of a world update in microseconds.
+				void worldLoad(
+					pp::OutgoingPacket &out_packet,
+					UInt32 playerCount,
+					UInt32 instanceCount,
+					UInt32 tickDuration
+				);
+
+				/// Notifies the realm that a world instance no longer exists.
+				/// @param out_packet Packet buffer where the data will be written to.
+				/// @param instanceId Id of the unloaded instance.
+				void worldInstanceUnloaded(
+					pp::OutgoingPacket &out_packet,
+					UInt32 instanceId
+				);
+
+				/// Reports the tick profile of the world node.
+				/// @param out_packet Packet buffer where the data will be written to.
+				/// @param profile Tick and subsystem histograms as json object.
+				void worldTickProfile(
+					pp::OutgoingPacket &out_packet,
+					const String &profile
+				);
 			}
 
 			/// Contains methods for writing packets from the realm server.
@@ -506,6 +540,32 @@ namespace wowpp
 					DatabaseId &out_characterId,
 					UInt32 &out_mailId
 				);
+
+				/// Reads the load report of a world node.
+				/// @returns false if the packet has not enough data or if there was an error
+				/// reading the packet's content.
+				bool worldLoad(
+					io::Reader &packet,
+					UInt32 &out_playerCount,
+					UInt32 &out_instanceCount,
+					UInt32 &out_tickDuration
+				);
+
+				/// Reads the id of an unloaded world instance.
+				/// @returns false if the packet has not enough data or if there was an error
+				/// reading the packet's content.
+				bool worldInstanceUnloaded(
+					io::Reader &packet,
+					UInt32 &out_instanceId
+				);
+
+				/// Reads the tick profile of a world node.
+				/// @returns false if the packet has not enough data or if there was an error
+				/// reading the packet's content.
+				bool worldTickProfile(
+					io::Reader &packet,
+					String &out_profile
+				);
 			}
 
 			/// Contains methods for reading packets coming from the realm server.
@@ -0,0 +1,297 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "common/constants.h"
+#include "log/default_log.h"
+#include "log/log_std_stream.h"
+#include "log/default_log_levels.h"
+#include "mysql_wrapper/mysql_connection.h"
+#include "mysql_wrapper/mysql_row.h"
+#include "mysql_wrapper/mysql_select.h"
+#include "binary_io/string_sink.h"
+#include "game/character_state.h"
+
+namespace wowpp
+{
+	/// Reads and locks the rows of the character_auras table of a character.
+	static bool readAuras(MySQL::Connection &connection, UInt32 characterId, std::vector<AuraData> &out_auras)
+	{
+		MySQL::Select select(connection, fmt::format(
+			"SELECT `caster_guid`,`item_guid`,`spell`,`stack_count`,`remain_charges`,`basepoints_0`,`basepoints_1`,`basepoints_2`,`periodictime_0`,`periodictime_1`,`periodictime_2`,`max_duration`,`remain_time`,`eff_index_mask` FROM `character_auras` WHERE `guid`={0} FOR UPDATE"
+			, characterId));
+		if (!select.success())
+		{
+			return false;
+		}
+
+		MySQL::Row row(select);
+		while (row)
+		{
+			Int32 fieldIndex = 0;
+
+			AuraData data;
+			row.getField(fieldIndex++, data.casterGuid);
+			row.getField(fieldIndex++, data.itemGuid);
+			row.getField(fieldIndex++, data.spell);
+			row.getField(fieldIndex++, data.stackCount);
+			row.getField(fieldIndex++, data.remainingCharges);
+			row.getField(fieldIndex++, data.basePoints[0]);
+			row.getField(fieldIndex++, data.basePoints[1]);
+			row.getField(fieldIndex++, data.basePoints[2]);
+			row.getField(fieldIndex++, data.periodicTime[0]);
+			row.getField(fieldIndex++, data.periodicTime[1]);
+			row.getField(fieldIndex++, data.periodicTime[2]);
+			row.getField(fieldIndex++, data.maxDuration);
+			row.getField(fieldIndex++, data.remainingTime);
+			row.getField(fieldIndex++, data.effectIndexMask);
+			out_auras.push_back(std::move(data));
+
+			row = row.next(select);
+		}
+
+		return true;
+	}
+
+	/// Reads and locks the rows of the character_quests table of a character. The lock also
+	/// prevents new quest rows of the character from being inserted.
+	static bool readQuests(MySQL::Connection &connection, UInt32 characterId, CharacterState::QuestMap &out_quests)
+	{
+		MySQL::Select select(connection, fmt::format(
+			"SELECT `quest`, `status`, `explored`, "
+			"`unitcount1`, `unitcount2`, `unitcount3`, `unitcount4`, "
+			"`objectcount1`, `objectcount2`, `objectcount3`, `objectcount4`, "
+			"`itemcount1`, `itemcount2`, `itemcount3`, `itemcount4`, `timer` "
+			"FROM `character_quests` WHERE `guid`={0} FOR UPDATE"
+			, characterId));
+		if (!select.success())
+		{
+			return false;
+		}
+
+		MySQL::Row row(select);
+		while (row)
+		{
+			UInt32 questId = 0, status = 0, index = 0;
+			QuestStatusData data;
+			row.getField(index++, questId);
+			row.getField(index++, status);
+			data.status = static_cast<game::QuestStatus>(status);
+			row.getField(index++, data.explored);
+			for (auto &count : data.creatures) row.getField(index++, count);
+			for (auto &count : data.objects) row.getField(index++, count);
+			for (auto &count : data.items) row.getField(index++, count);
+			row.getField(index++, data.expiration);
+			out_quests[questId] = data;
+
+			row = row.next(select);
+		}
+
+		return true;
+	}
+
+	enum class MigrationResult
+	{
+		Migrated,
+		/// The character got a state blob in the meantime, e.g. because the realm saved it, or was deleted.
+		Skipped,
+		Failed
+	};
+
+	/// Converts the relational state of a character into a state blob. Quest rows are removed
+	/// afterwards, since the realm treats remaining quest rows as newer than the blob.
+	static MigrationResult migrateCharacter(MySQL::Connection &connection, UInt32 characterId)
+	{
+		// The realm might be running, so everything is read and locked inside the transaction.
+		// Otherwise rows which the realm writes after they were read would be deleted below
+		// without being part of the blob. The transaction is rolled back when leaving the scope.
+		MySQL::Transaction transaction(connection);
+
+		CharacterState state;
+		{
+			MySQL::Select select(connection, fmt::format(
+				"SELECT `explored_zones`, `state` IS NULL FROM `character` WHERE `id`={0} FOR UPDATE"
+				, characterId));
+			if (!select.success())
+			{
+				return MigrationResult::Failed;
+			}
+
+			// The character was deleted or got a state blob in the meantime
+			MySQL::Row row(select);
+			UInt32 hasNoState = 0;
+			if (row)
+			{
+				row.getField(1, hasNoState);
+			}
+			if (!hasNoState)
+			{
+				return MigrationResult::Skipped;
+			}
+
+			String exploredZones;
+			row.getField(0, exploredZones);
+			if (!exploredZones.empty())
+			{
+				std::stringstream strm(exploredZones);
+				for (auto &zone : state.exploredZones)
+				{
+					strm >> zone;
+				}
+			}
+		}
+
+		if (!readAuras(connection, characterId, state.auras) ||
+			!readQuests(connection, characterId, state.quests))
+		{
+			return MigrationResult::Failed;
+		}
+
+		String buffer;
+		io::StringSink sink(buffer);
+		io::Writer writer(sink);
+		writer << state;
+		if (buffer.size() > CharacterState::MaxSerializedSize)
+		{
+			ELOG("State of character " << characterId << " is too large to be saved (" << buffer.size() << " bytes)");
+			return MigrationResult::Failed;
+		}
+
+		if (!connection.execute(fmt::format(
+			"UPDATE `character` SET `state`='{1}' WHERE `id`={0};"
+			, characterId
+			, connection.escapeString(buffer))))
+		{
+			return MigrationResult::Failed;
+		}
+
+		if (!connection.execute(fmt::format(
+			"DELETE FROM `character_quests` WHERE `guid`={0};"
+			, characterId)))
+		{
+			return MigrationResult::Failed;
+		}
+
+		transaction.commit();
+		return MigrationResult::Migrated;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	using namespace ::wowpp;
+	namespace po = ::boost::program_options;
+
+	static const std::string VersionStr = "WoW++ Character State Migrator 1.0";
+
+	MySQL::DatabaseInfo connectionInfo("127.0.0.1", constants::DefaultMySQLPort, "wow-pp", "test", "wowpp_realm");
+
+	po::options_description desc(VersionStr + ", available options");
+	desc.add_options()
+	("help", "produce help message")
+	("version", "display the application's name and version")
+	("host", po::value<std::string>(&connectionInfo.host), "mysql server host (default: 127.0.0.1)")
+	("port", po::value<NetPort>(&connectionInfo.port), "mysql server port")
+	("user,u", po::value<std::string>(&connectionInfo.user), "mysql user (default: wow-pp)")
+	("password,p", po::value<std::string>(&connectionInfo.password), "mysql password")
+	("database,d", po::value<std::string>(&connectionInfo.database), "realm database (default: wowpp_realm)")
+	;
+
+	po::variables_map vm;
+	try
+	{
+		po::store(
+		    po::command_line_parser(argc, argv).options(desc).run(),
+		    vm);
+		po::notify(vm);
+	}
+	catch (const po::error &e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+
+	if (vm.count("version"))
+	{
+		std::cerr << VersionStr << '\n';
+	}
+
+	if (vm.count("help"))
+	{
+		std::cerr << desc << "\n";
+		return 0;
+	}
+
+	g_DefaultLog.signal().connect(std::bind(
+		printLogEntry,
+		std::ref(std::cout), std::placeholders::_1, g_DefaultConsoleLogOptions));
+
+	MySQL::Connection connection;
+	if (!connection.connect(connectionInfo))
+	{
+		ELOG("Could not connect to the realm database");
+		ELOG(connection.getErrorMessage());
+		return 1;
+	}
+
+	// Collect the characters first, as the result set can't stay open while migrating
+	std::vector<UInt32> characters;
+	{
+		MySQL::Select select(connection, "SELECT `id` FROM `character` WHERE `state` IS NULL");
+		if (!select.success())
+		{
+			ELOG("Could not read characters: " << connection.getErrorMessage());
+			return 1;
+		}
+
+		MySQL::Row row(select);
+		while (row)
+		{
+			UInt32 id = 0;
+			row.getField(0, id);
+			characters.push_back(id);
+
+			row = row.next(select);
+		}
+	}
+
+	size_t migrated = 0, skipped = 0;
+	for (const auto &character : characters)
+	{
+		switch (migrateCharacter(connection, character))
+		{
+			case MigrationResult::Migrated:
+				++migrated;
+				break;
+			case MigrationResult::Skipped:
+				WLOG("Character " << character << " has been saved with a state blob or deleted in the meantime - skipped");
+				++skipped;
+				break;
+			default:
+				ELOG("Could not migrate character " << character << ": " << connection.getErrorMessage());
+				break;
+		}
+	}
+
+	ILOG("Migrated " << migrated << " of " << characters.size() << " characters (" << skipped << " skipped)");
+	return (migrated + skipped == characters.size() ? 0 : 1);
+}
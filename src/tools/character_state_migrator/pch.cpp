@@ -19,22 +19,5 @@
 // and lore are copyrighted by Blizzard Entertainment, Inc.
 //
 
-#pragma once
+#include "pch.h"
 
-#include "update_parameters.h"
-#include "updater_progress_handler.h"
-
-namespace wowpp
-{
-	namespace updating
-	{
-		void copyWithProgress(
-		    const UpdateParameters &parameters,
-		    std::istream &source,
-		    std::ostream &sink,
-		    const std::string &name,
-		    boost::uintmax_t compressedSize,
-		    bool doZLibUncompress
-		);
-	}
-}
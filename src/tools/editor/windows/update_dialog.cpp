@@ -31,6 +31,7 @@
 #include "updater/prepare_update.h"
 #include "updater/update_source.h"
 #include "updater/update_application.h"
+#include "updater/apply_update.h"
 #include "common/create_process.h"
 #include <thread>
 
@@ -60,7 +61,6 @@ namespace wowpp
 			: QDialog()
 			, m_ui(new Ui::UpdateDialog)
 			, m_app(app)
-			, m_lastLoaded(0)
 			, m_loaded(0)
 		{
 			// Setup auto generated ui
@@ -77,27 +77,16 @@ namespace wowpp
 
 		void UpdateDialog::updateFile(const std::string &name, boost::uintmax_t size, boost::uintmax_t loaded)
 		{
-			if (m_lastLoaded == 0)
+			// Files are downloaded concurrently, so only show the one which started last
+			if (name != m_currentFile && loaded < size)
 			{
+				m_currentFile = name;
+
 				std::stringstream statusStream;
 				statusStream << "Updating file " << name << "...";
 				emit setStatusMessage(statusStream.str().c_str());
 			}
 
-			// Increment download counter
-			if (loaded >= m_lastLoaded)
-			{
-				m_loaded += loaded - m_lastLoaded;
-				const float percent = static_cast<float>(m_loaded) / static_cast<float>(updateSize);
-				emit setProgress(percent);
-			}
-			m_lastLoaded = loaded;
-
-			if (loaded >= size)
-			{
-				m_lastLoaded = 0;
-			}
-
 			/*
 			// Status string
 			std::stringstream statusStream;
@@ -127,6 +116,15 @@ namespace wowpp
 			}*/
 		}
 
+		void UpdateDialog::updateTotal(boost::uintmax_t size, boost::uintmax_t loaded, double /*bytesPerSecond*/)
+		{
+			m_loaded = loaded;
+			if (size > 0)
+			{
+				emit setProgress(static_cast<float>(loaded) / static_cast<float>(size));
+			}
+		}
+
 		void UpdateDialog::beginCheckLocalCopy(const std::string &name)
 		{
 
@@ -189,42 +187,14 @@ namespace wowpp
 					*this
 				);
 
-				{
-					boost::asio::io_service dispatcher;
-					for (const auto & step : preparedUpdate.steps)
-					{
-						dispatcher.post(
-							[&]()
-						{
-							std::string errorMessage;
-							try
-							{
-								while (step.step(updateParameters)) {
-									;
-								}
-
-								return;
-							}
-							catch (const std::exception &ex)
-							{
-								errorMessage = ex.what();
-							}
-							catch (...)
-							{
-								errorMessage = "Caught an exception not derived from std::exception";
-							}
-
-							dispatcher.stop();
-							dispatcher.post([errorMessage]()
-							{
-								throw std::runtime_error(errorMessage);
-							});
-						});
-					}
-
-					dispatcher.run();
-				}
+				const auto statistics = wowpp::updating::applyUpdate(
+					preparedUpdate,
+					updateParameters,
+					4
+				);
 
+				ILOG("Downloaded " << statistics.downloadedBytes << " bytes in " << statistics.seconds << "s (" <<
+					static_cast<UInt64>(statistics.getBytesPerSecond() / 1024.0) << " KB/s)");
 				DLOG("Updated " << m_loaded << " / " << updateSize << " bytes");
 			}
 			catch (const std::exception &e)
@@ -53,6 +53,8 @@ namespace wowpp
 			/// @copydoc 
 			virtual void updateFile(const std::string &name, boost::uintmax_t size, boost::uintmax_t loaded) override;
 			/// @copydoc 
+			virtual void updateTotal(boost::uintmax_t size, boost::uintmax_t loaded, double bytesPerSecond) override;
+			/// @copydoc 
 			virtual void beginCheckLocalCopy(const std::string &name) override;
 
 		signals:
@@ -82,7 +84,7 @@ namespace wowpp
 
 			Ui::UpdateDialog *m_ui;
 			EditorApplication &m_app;
-			size_t m_lastLoaded;
+			std::string m_currentFile;
 			size_t m_loaded;
 		};
 	}
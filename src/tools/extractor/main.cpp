@@ -39,6 +39,8 @@
 #include "file_io.h"
 #include "binary_io/writer.h"
 #include "binary_io/stream_sink.h"
+#include "binary_io/reader.h"
+#include "binary_io/stream_source.h"
 #include "common/make_unique.h"
 #include "game/map.h"
 #include "math/matrix3.h"
@@ -47,17 +49,21 @@
 #include "math/quaternion.h"
 #include "math/aabb_tree.h"
 #include "common/linear_set.h"
+#include "common/sha1.h"
 using namespace std;
 using namespace wowpp;
 
 //////////////////////////////////////////////////////////////////////////
 // Calls:
-//	For Each Map... (separate thread for each map, up to #cpu-cores)
+//	For Each Map... (task on the shared dispatcher)
 //		convertMap
 //			createNavMesh
-//			For Each Tile...
-//				convertADT
-//					createNavTile
+//			For Each Tile... (task on the shared dispatcher, up to #cpu-cores at once)
+//				convertTile
+//					convertADT
+//						loadADTWmos / loadADTDoodads (shared model cache)
+//						createNavChunk
+//				finishMap (executed by the last finished tile of the map)
 
 //////////////////////////////////////////////////////////////////////////
 // Shortcuts
@@ -69,6 +75,13 @@ namespace po = boost::program_options;
 static const fs::path inputPath(".");
 static const fs::path outputPath("maps");
 static const fs::path bvhOutputPath("bvh");
+static const fs::path fingerprintPath("fingerprints");
+
+//////////////////////////////////////////////////////////////////////////
+// Fingerprints
+/// Increase this whenever the generated data changes in a way which isn't covered by the
+/// input fingerprints (for example if the extractor code changes), to rebuild all files.
+static const UInt32 ExtractorFingerprintVersion = 1;
 
 //////////////////////////////////////////////////////////////////////////
 // DBC files
@@ -82,19 +95,11 @@ static Int32 buildOnlyMap = -1;
 static Int32 buildOnlyTileX = -1;
 static Int32 buildOnlyTileY = -1;
 static bool generateDebugFiles = false;
+static bool forceRebuild = false;
 
 //////////////////////////////////////////////////////////////////////////
 // Caches
 std::map<UInt32, UInt32> areaFlags;
-std::map<UInt32, LinearSet<UInt32>> tilesByMap;
-
-// Loaded WMO and M2 models used for navigation mesh calculations
-std::map<UInt32, std::shared_ptr<math::AABBTree>> wmoTrees;
-std::map<UInt32, std::shared_ptr<math::AABBTree>> doodadTrees;
-
-std::mutex wmoMutex, doodadMutex;
-LinearSet<String> serializedWMOs, serializedDoodads;
-std::map<String, std::shared_ptr<math::AABBTree>> doodadIdsByFile, wmoIdsByFile;
 
 //////////////////////////////////////////////////////////////////////////
 // Helper functions
@@ -117,6 +122,107 @@ namespace
 	using SmartPolyMeshPtr = std::unique_ptr<rcPolyMesh, decltype(&rcFreePolyMesh)>;
 	using SmartPolyMeshDetailPtr = std::unique_ptr<rcPolyMeshDetail, decltype(&rcFreePolyMeshDetail)>;
 
+	/// A loaded WMO or M2 model.
+	struct CachedModel final
+	{
+		/// Collision tree of the model.
+		std::shared_ptr<math::AABBTree> tree;
+		/// Hash of the raw model data, used to fingerprint the tiles referencing this model.
+		SHA1Hash contentHash;
+	};
+
+	/// Models of the WMOs or doodads referenced by a single ADT tile, indexed by their unique id.
+	typedef std::map<UInt32, std::shared_ptr<const CachedModel>> ModelMap;
+
+	/// Thread-safe cache of WMO or M2 models, indexed by their file name. Tile tasks
+	/// share these models: The first task which requests a model builds it (outside of the lock,
+	/// so that other models can be built at the same time) and every other task requesting
+	/// the same model waits for that result.
+	class ModelCache final
+	{
+	public:
+
+		typedef std::shared_ptr<const CachedModel> ModelPtr;
+		typedef std::function<ModelPtr()> ModelBuilder;
+
+	public:
+
+		ModelCache() = default;
+		ModelCache(const ModelCache &Other) = delete;
+		ModelCache &operator=(const ModelCache &Other) = delete;
+
+		/// Gets a model, building it if it has not been requested before.
+		/// @param filename File name of the model, used as the cache key.
+		/// @param builder Builds the model on the first request.
+		/// @returns The cached model or nullptr, if the model could not be built.
+		ModelPtr get(const String &filename, const ModelBuilder &builder)
+		{
+			std::promise<ModelPtr> promise;
+			std::shared_future<ModelPtr> result;
+			bool isFirstRequest = false;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+
+				auto it = m_trees.find(filename);
+				if (it == m_trees.end())
+				{
+					result = promise.get_future().share();
+					m_trees.insert(std::make_pair(filename, result));
+					isFirstRequest = true;
+				}
+				else
+				{
+					result = it->second;
+				}
+			}
+
+			if (isFirstRequest)
+			{
+				promise.set_value(builder());
+			}
+
+			return result.get();
+		}
+
+	private:
+
+		std::mutex m_mutex;
+		std::map<String, std::shared_future<ModelPtr>> m_trees;
+	};
+
+	// Loaded WMO and M2 models used for navigation mesh calculations
+	ModelCache wmoCache, doodadCache;
+	// Serializes access to bvh files, since different models may share the same file name stem
+	std::mutex bvhFileMutex;
+
+	/// State of a map whose adt tiles are converted by multiple tile tasks at the same time.
+	/// The last finished tile task completes the map.
+	struct MapJob final
+	{
+		UInt32 mapId;
+		String mapName;
+		/// Number of tile tasks which haven't finished yet.
+		std::atomic<size_t> pendingTiles;
+		/// Number of tile tasks which failed.
+		std::atomic<size_t> failedTiles;
+		/// Number of tiles which were skipped because their inputs did not change.
+		std::atomic<size_t> upToDateTiles;
+		/// Number of tile tasks which were started.
+		size_t totalTiles;
+		std::chrono::steady_clock::time_point startTime;
+
+		explicit MapJob(UInt32 mapId_, const String &mapName_, size_t tileCount)
+			: mapId(mapId_)
+			, mapName(mapName_)
+			, pendingTiles(tileCount)
+			, failedTiles(0)
+			, upToDateTiles(0)
+			, totalTiles(tileCount)
+			, startTime(std::chrono::steady_clock::now())
+		{
+		}
+	};
+
 	/// Converts a tiles x and y coordinate into a single number (tile id).
 	/// @param tileX The x coordinate of the tile.
 	/// @param tileY The y coordinate of the tile.
@@ -137,10 +243,10 @@ namespace
 	}
 
 	/// This method calculates the boundaries of a given map.
-	static void calculateMapBounds(UInt32 mapId, UInt32 &out_minX, UInt32 &out_minY, UInt32 &out_maxX, UInt32 &out_maxY)
+	/// @param tiles Packed tile ids of all existing tiles of the map.
+	static void calculateMapBounds(const LinearSet<UInt32> &tiles, UInt32 &out_minX, UInt32 &out_minY, UInt32 &out_maxX, UInt32 &out_maxY)
 	{
-		auto it = tilesByMap.find(mapId);
-		if (it == tilesByMap.end())
+		if (tiles.empty())
 			return;
 
 		out_minX = std::numeric_limits<UInt32>::max();
@@ -148,7 +254,7 @@ namespace
 		out_minY = std::numeric_limits<UInt32>::max();
 		out_maxY = std::numeric_limits<UInt32>::lowest();
 
-		for (auto &tile : it->second)
+		for (auto &tile : tiles)
 		{
 			UInt32 tileX = 0, tileY = 0;
 			unpackTileID(tile, tileX, tileY);
@@ -478,12 +584,12 @@ namespace
 
 	/// Prepares the navmesh of a given map id by calculating the map bounds and the tile count.
 	/// @param mapId Id of the map this nav mesh belongs to.
+	/// @param tiles Packed tile ids of all existing tiles of the map.
 	/// @param navMesh The nav mesh that will be initialized.
 	/// @returns false if something went wrong.
-	static bool createNavMesh(UInt32 mapId, dtNavMesh &navMesh)
+	static bool createNavMesh(UInt32 mapId, const LinearSet<UInt32> &tiles, dtNavMesh &navMesh)
 	{
 		// Look for tiles
-		auto &tiles = tilesByMap[mapId];
 		if (tiles.empty())
 		{
 			ILOG("No tiles found for map " << mapId);
@@ -491,7 +597,7 @@ namespace
 		}
 
 		UInt32 minX = 0, minY = 0, maxX = 0, maxY = 0;
-		calculateMapBounds(mapId, minX, minY, maxX, maxY);
+		calculateMapBounds(tiles, minX, minY, maxX, maxY);
 
 		float bmin[3], bmax[3];
 		calculateADTTileBounds(minX, minY, bmin, bmax);
@@ -527,17 +633,31 @@ namespace
 		return true;
 	}
 
+	/// Gets the file name of an adt cell which is loaded as neighbour of another adt cell,
+	/// to add the terrain borders to the navigation mesh.
+	/// @param mapName Name of the map.
+	/// @param tileX X tile coordinate of the neighbour adt cell.
+	/// @param tileY Y tile coordinate of the neighbour adt cell.
+	static String getNeighbourADTFileName(const String &mapName, UInt32 tileX, UInt32 tileY)
+	{
+		const boost::filesystem::path adtPath = boost::filesystem::path("World\\Maps") / mapName / mapName;
+		return adtPath.leaf().append(fmt::sprintf("%d_%d.adt", tileY, tileX)).string();
+	}
+
 	/// Generates a navigation tile.
 	/// @param mapName Name of the map which is used for debug file generation.
 	/// @param mapId Id of the map.
 	/// @param tileX X tile coordinate of the adt cell.
 	/// @param tileY Y tile coordinate of the adt cell.
-	/// @param navMesh The nav mesh which will be updated.
 	/// @param adt The parsed adt file.
+	/// @param wmos WMO placements of this adt cell.
+	/// @param wmoModels Models of the placed WMOs.
+	/// @param doodads Doodad placements of this adt cell.
+	/// @param doodadModels Models of the placed doodads.
 	/// @param out_chunk Navigation chunk which will hold the serialized nav mesh data of this till and
 	///                  will be written to the generated map file.
 	/// @return false on error, true on success.
-	static bool createNavChunk(const String &mapName, UInt32 mapId, UInt32 tileX, UInt32 tileY, dtNavMesh &navMesh, const ADTFile &adt, const MapWMOChunk &wmos, const MapDoodadChunk &doodads, MapNavigationChunk &out_chunk)
+	static bool createNavChunk(const String &mapName, UInt32 mapId, UInt32 tileX, UInt32 tileY, const ADTFile &adt, const MapWMOChunk &wmos, const ModelMap &wmoModels, const MapDoodadChunk &doodads, const ModelMap &doodadModels, MapNavigationChunk &out_chunk)
 	{
 		// Min and max height values used for recast
 		float minZ = std::numeric_limits<float>::max(), maxZ = std::numeric_limits<float>::lowest();
@@ -554,10 +674,10 @@ namespace
 			size_t indexOffset = 0;
 			for (const auto &wmo : wmos.entries)
 			{
-				auto it = wmoTrees.find(wmo.uniqueId);
-				if (it != wmoTrees.end())
+				auto it = wmoModels.find(wmo.uniqueId);
+				if (it != wmoModels.end())
 				{
-					for (const auto &vert : it->second->getVertices())
+					for (const auto &vert : it->second->tree->getVertices())
 					{
 						math::Vector3 transformed = (wmo.transform * vert);
 						auto recastCoord = wowToRecastCoord(transformed);
@@ -567,7 +687,7 @@ namespace
 					}
 
 					size_t i = 0;
-					for (auto &tri : it->second->getIndices())
+					for (auto &tri : it->second->tree->getIndices())
 					{
 						wmoMesh.solidTris.push_back(tri + indexOffset);
 						if (++i == 3)
@@ -590,14 +710,12 @@ namespace
 		MeshData adtMesh;
 		{
 			// Now we add adts
-			boost::filesystem::path adtPath;
 			if (addTerrainMesh(adt, tileX, tileY, ENTIRE, adtMesh))
 			{
 				std::unique_ptr<ADTFile> adtInst;
 
 #define LOAD_TERRAIN(x, y, spot) \
-				adtPath = boost::filesystem::path("World\\Maps") / mapName / mapName; \
-				adtInst = make_unique<ADTFile>(adtPath.leaf().append(fmt::sprintf("%d_%d.adt", y, x)).string()); \
+				adtInst = make_unique<ADTFile>(getNeighbourADTFileName(mapName, (x), (y))); \
 				if (adtInst->load()) \
 				{ \
 					addTerrainMesh(*adtInst, (x), (y), spot, adtMesh); \
@@ -617,10 +735,10 @@ namespace
 			size_t indexOffset = 0;
 			for (const auto &doodad : doodads.entries)
 			{
-				auto it = doodadTrees.find(doodad.uniqueId);
-				if (it != doodadTrees.end())
+				auto it = doodadModels.find(doodad.uniqueId);
+				if (it != doodadModels.end())
 				{
-					for (const auto &vert : it->second->getVertices())
+					for (const auto &vert : it->second->tree->getVertices())
 					{
 						math::Vector3 transformed = (doodad.transform * vert);
 						auto recastCoord = wowToRecastCoord(transformed);
@@ -630,7 +748,7 @@ namespace
 					}
 
 					size_t i = 0;
-					for (auto &tri : it->second->getIndices())
+					for (auto &tri : it->second->tree->getIndices())
 					{
 						doodadMesh.solidTris.push_back(tri + indexOffset);
 						if (++i == 3)
@@ -783,10 +901,266 @@ namespace
 		return true;
 	}
 
-	/// Loads all WMOs of a given ADT file into the global wmo storage and builds their
+	/// Gets the path of the file which stores the input fingerprint of a generated file.
+	/// @param outputFile Path of the generated file.
+	static fs::path getFingerprintPath(const fs::path &outputFile)
+	{
+		return fingerprintPath / (outputFile.string() + ".sha1");
+	}
+
+	/// Reads a previously stored fingerprint.
+	/// @param file Path of the fingerprint file.
+	/// @param out_hash The fingerprint will be stored here.
+	/// @returns false if there is no valid fingerprint stored.
+	static bool readFingerprint(const fs::path &file, SHA1Hash &out_hash)
+	{
+		std::ifstream strm(file.string().c_str(), std::ios::in);
+		if (!strm)
+		{
+			return false;
+		}
+
+		out_hash = sha1ParseHex(strm);
+		return !strm.fail();
+	}
+
+	/// Stores a fingerprint.
+	/// @param file Path of the fingerprint file.
+	/// @param hash The fingerprint to store.
+	static void writeFingerprint(const fs::path &file, const SHA1Hash &hash)
+	{
+		std::ofstream strm(file.string().c_str(), std::ios::out | std::ios::trunc);
+		sha1PrintHex(strm, hash);
+		if (!strm)
+		{
+			WLOG("Could not write fingerprint file " << file);
+		}
+	}
+
+	/// Removes a stored fingerprint, so that the generated file will be rebuilt on the next run.
+	/// @param file Path of the fingerprint file.
+	static void removeFingerprint(const fs::path &file)
+	{
+		boost::system::error_code error;
+		fs::remove(file, error);
+	}
+
+	/// Checks whether a generated file is up to date.
+	/// @param outputFile Path of the generated file.
+	/// @param fingerprint Fingerprint of the current inputs of the generated file.
+	/// @returns true if the file exists and was generated from the same inputs.
+	static bool isUpToDate(const fs::path &outputFile, const SHA1Hash &fingerprint)
+	{
+		if (forceRebuild || !fs::exists(outputFile))
+		{
+			return false;
+		}
+
+		SHA1Hash storedFingerprint;
+		return readFingerprint(getFingerprintPath(outputFile), storedFingerprint) &&
+			storedFingerprint == fingerprint;
+	}
+
+	/// Adds a plain old data value to a fingerprint.
+	template<typename T>
+	static void hashPOD(Boost_SHA1HashSink &hash, const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed");
+		hash.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	/// Adds raw file content to a fingerprint, prefixed by its size.
+	static void hashContent(Boost_SHA1HashSink &hash, const std::vector<char> &content)
+	{
+		hashPOD(hash, static_cast<UInt64>(content.size()));
+		if (!content.empty())
+		{
+			hash.write(content.data(), static_cast<std::streamsize>(content.size()));
+		}
+	}
+
+	/// Serializes a collision tree into a bvh file and stores the fingerprint of the model it was built from.
+	/// @param tree The collision tree to serialize.
+	/// @param filePath Path of the bvh file which will be created.
+	/// @param contentHash Hash of the model data which the tree was built from.
+	/// @returns false if the file could not be created.
+	static bool serializeTree(const math::AABBTree &tree, const fs::path &filePath, const SHA1Hash &contentHash)
+	{
+		std::lock_guard<std::mutex> lock(bvhFileMutex);
+
+		const fs::path treeFingerprintPath = getFingerprintPath(filePath);
+		removeFingerprint(treeFingerprintPath);
+
+		std::ofstream file(filePath.string().c_str(), std::ios::out | std::ios::binary);
+		if (!file)
+		{
+			ELOG("Failed to create output file " << filePath);
+			return false;
+		}
+
+		io::StreamSink fileSink(file);
+		io::Writer fileWriter(fileSink);
+		fileWriter << tree;
+
+		file.close();
+		if (file.fail())
+		{
+			ELOG("Failed to write output file " << filePath);
+			return false;
+		}
+
+		writeFingerprint(treeFingerprintPath, contentHash);
+		return true;
+	}
+
+	/// Loads a collision tree from a bvh file of a previous run, if it was built from the same model data.
+	/// @param filePath Path of the bvh file.
+	/// @param contentHash Hash of the current model data.
+	/// @returns The collision tree or nullptr, if the tree needs to be rebuilt.
+	static std::shared_ptr<math::AABBTree> loadSerializedTree(const fs::path &filePath, const SHA1Hash &contentHash)
+	{
+		std::lock_guard<std::mutex> lock(bvhFileMutex);
+
+		if (!isUpToDate(filePath, contentHash))
+		{
+			return nullptr;
+		}
+
+		std::ifstream file(filePath.string().c_str(), std::ios::in | std::ios::binary);
+		if (!file)
+		{
+			return nullptr;
+		}
+
+		io::StreamSource fileSource(file);
+		io::Reader fileReader(fileSource);
+
+		auto tree = std::make_shared<math::AABBTree>();
+		if (!(fileReader >> *tree))
+		{
+			WLOG("Could not read " << filePath << ", rebuilding it");
+			return nullptr;
+		}
+
+		return tree;
+	}
+
+	/// Loads a WMO file and builds its collision tree, unless an up to date bvh file exists already.
+	/// @param filename File name of the root wmo.
+	/// @param filePath Path of the bvh file which will be created.
+	/// @returns The model or nullptr on error.
+	static ModelCache::ModelPtr loadWMOModel(const String &filename, const fs::path &filePath)
+	{
+		auto wmoFile = std::make_shared<WMOFile>(filename);
+		if (!wmoFile->load())
+		{
+			ELOG("Error loading wmo: " << filename);
+			return nullptr;
+		}
+
+		// Hash the raw data of the root file and all of its groups
+		Boost_SHA1HashSink hash;
+		hashPOD(hash, ExtractorFingerprintVersion);
+		hashContent(hash, wmoFile->getContent());
+		for (const auto &group : wmoFile->getGroups())
+		{
+			hashContent(hash, group->getContent());
+		}
+
+		auto model = std::make_shared<CachedModel>();
+		model->contentHash = hash.finalizeHash();
+
+		// Reuse the bvh file of a previous run if possible
+		model->tree = loadSerializedTree(filePath, model->contentHash);
+		if (model->tree)
+		{
+			return model;
+		}
+
+		// Build AABBTree and serialize it
+		ILOG("\tBuilding WMO " << wmoFile->getBaseName());
+		std::vector<math::AABBTree::Vertex> vertices;
+		std::vector<math::AABBTree::Index> indices;
+		if (wmoFile->isRootWMO())
+		{
+			for (const auto &group : wmoFile->getGroups())
+			{
+				vertices.reserve(vertices.size() + group->getVertices().size());
+				indices.reserve(indices.size() + group->getIndices().size());
+
+				math::AABBTree::Index offset = vertices.size();
+				for (const auto &v : group->getVertices())
+				{
+					vertices.push_back(v);
+				}
+
+				for (UInt32 index = 0; index < group->getIndices().size(); index += 3)
+				{
+					if (!group->isCollisionTriangle(index / 3))
+					{
+						continue;
+					}
+
+					const auto &groupInds = group->getIndices();
+					indices.push_back(groupInds[index + 0] + offset);
+					indices.push_back(groupInds[index + 1] + offset);
+					indices.push_back(groupInds[index + 2] + offset);
+				}
+			}
+		}
+
+		model->tree = std::make_shared<math::AABBTree>(vertices, indices);
+		if (!serializeTree(*model->tree, filePath, model->contentHash))
+		{
+			return nullptr;
+		}
+
+		return model;
+	}
+
+	/// Loads an M2 file and builds its collision tree, unless an up to date bvh file exists already.
+	/// @param filename File name of the m2 model.
+	/// @param filePath Path of the bvh file which will be created.
+	/// @returns The model or nullptr on error.
+	static ModelCache::ModelPtr loadDoodadModel(const String &filename, const fs::path &filePath)
+	{
+		auto doodadFile = std::make_shared<M2File>(filename);
+		if (!doodadFile->load())
+		{
+			ELOG("Error loading M2: " << filename);
+			return nullptr;
+		}
+
+		Boost_SHA1HashSink hash;
+		hashPOD(hash, ExtractorFingerprintVersion);
+		hashContent(hash, doodadFile->getContent());
+
+		auto model = std::make_shared<CachedModel>();
+		model->contentHash = hash.finalizeHash();
+
+		// Reuse the bvh file of a previous run if possible
+		model->tree = loadSerializedTree(filePath, model->contentHash);
+		if (model->tree)
+		{
+			return model;
+		}
+
+		// Build AABBTree and serialize it
+		ILOG("\tBuilding doodad " << doodadFile->getBaseName());
+		model->tree = std::make_shared<math::AABBTree>(doodadFile->getVertices(), doodadFile->getIndices());
+		if (!serializeTree(*model->tree, filePath, model->contentHash))
+		{
+			return nullptr;
+		}
+
+		return model;
+	}
+
+	/// Loads all WMOs of a given ADT file into the shared wmo cache and builds their
 	/// bvh trees.
 	/// @param adt The parsed adt file infos.
-	static bool loadADTWmos(const ADTFile &adt, MapWMOChunk &out_chunk)
+	/// @param out_models Models of all placed WMOs will be stored here.
+	static bool loadADTWmos(const ADTFile &adt, MapWMOChunk &out_chunk, ModelMap &out_models)
 	{
 		// Reset chunk structure
 		out_chunk.entries.clear();
@@ -807,77 +1181,15 @@ namespace
 			// Build file path
 			fs::path filePath = bvhOutputPath / ("WMO_" + fs::path(filename).stem().string() + ".bvh");
 
-			// Load wmo if not happened already
-			std::lock_guard<std::mutex> lock(wmoMutex);
-			if (!serializedWMOs.contains(filename))
+			// Load wmo if not happened already (or wait for the task which is loading it)
+			auto wmoModel = wmoCache.get(filename, std::bind(loadWMOModel, filename, filePath));
+			if (!wmoModel)
 			{
-				serializedWMOs.add(filename);
-
-				auto wmoFile = std::make_shared<WMOFile>(filename);
-				if (!wmoFile->load())
-				{
-					ELOG("Error loading wmo: " << filename);
-					return false;
-				}
-
-				// Build AABBTree and serialize it
-				ILOG("\tBuilding WMO " << wmoFile->getBaseName());
-				std::vector<math::AABBTree::Vertex> vertices;
-				std::vector<math::AABBTree::Index> indices;
-				if (wmoFile->isRootWMO())
-				{
-					for (const auto &group : wmoFile->getGroups())
-					{
-						vertices.reserve(vertices.size() + group->getVertices().size());
-						indices.reserve(indices.size() + group->getIndices().size());
-
-						math::AABBTree::Index offset = vertices.size();
-						for (const auto &v : group->getVertices())
-						{
-							vertices.push_back(v);
-						}
-
-						for (UInt32 index = 0; index < group->getIndices().size(); index += 3)
-						{
-							if (!group->isCollisionTriangle(index / 3))
-							{
-								continue;
-							}
-
-							const auto &groupInds = group->getIndices();
-							indices.push_back(groupInds[index + 0] + offset);
-							indices.push_back(groupInds[index + 1] + offset);
-							indices.push_back(groupInds[index + 2] + offset);
-						}
-					}
-				}
-
-				auto wmoTree = std::make_shared<math::AABBTree>(vertices, indices);
-				wmoTrees[chunk.uniqueId] = wmoTree;
-				wmoIdsByFile[filename] = wmoTree;
-
-				// Serialize it
-				std::ofstream file(filePath.string().c_str(), std::ios::out | std::ios::binary);
-				if (!file)
-				{
-					ELOG("Failed to create output file " << filePath);
-					return false;
-				}
-
-				io::StreamSink fileSink(file);
-				io::Writer fileWriter(fileSink);
-				fileWriter << *wmoTree;
+				ELOG("Could not build collision tree of wmo " << filename);
+				return false;
 			}
-			else
-			{
-				auto it = wmoIdsByFile.find(filename);
-				if (it == wmoIdsByFile.end())
-				{
-					WLOG("Could not find wmo id for file " << filename);
-				}
 
-				wmoTrees[chunk.uniqueId] = it->second;
-			}
+			out_models[chunk.uniqueId] = wmoModel;
 
 			// Add a new WMO entry
 			MapWMOChunk::WMOEntry entry;
@@ -903,7 +1215,7 @@ namespace
 
 			entry.transform = matFinal;
 			entry.inverse = matFinal.inverse();
-			entry.bounds = wmoTrees[chunk.uniqueId]->getBoundingBox();
+			entry.bounds = wmoModel->tree->getBoundingBox();
 			entry.bounds.transform(matFinal);
 
 			out_chunk.entries.push_back(std::move(entry));
@@ -914,10 +1226,11 @@ namespace
 		return true;
 	}
 
-	/// Loads all Doodads of a given ADT file into the global doodad storage and builds
+	/// Loads all Doodads of a given ADT file into the shared doodad cache and builds
 	/// their bvh trees.
 	/// @param adt The parsed adt file infos.
-	static bool loadADTDoodads(const ADTFile &adt, MapDoodadChunk &out_chunk)
+	/// @param out_models Models of all placed doodads will be stored here.
+	static bool loadADTDoodads(const ADTFile &adt, MapDoodadChunk &out_chunk, ModelMap &out_models)
 	{
 		// Reset chunk structure
 		out_chunk.entries.clear();
@@ -926,53 +1239,21 @@ namespace
 
 		for (const auto &chunk : adt.getMDDFChunk().entries)
 		{
-			std::lock_guard<std::mutex> lock(doodadMutex);
-
 			// Retrieve Doodad file name
 			const String filename = fs::path(adt.getMDX(chunk.mmidEntry)).replace_extension(".m2").string();
 
 			// Build file path
 			const fs::path filePath = bvhOutputPath / ("Doodad_" + fs::path(filename).stem().string() + ".bvh");
 
-			if (!serializedDoodads.contains(filename))
+			// Load doodad if not happened already (or wait for the task which is loading it)
+			auto doodadModel = doodadCache.get(filename, std::bind(loadDoodadModel, filename, filePath));
+			if (!doodadModel)
 			{
-				serializedDoodads.add(filename);
-
-				auto doodadFile = std::make_shared<M2File>(filename);
-				if (!doodadFile->load())
-				{
-					ELOG("Error loading M2: " << filename);
-					return false;
-				}
-
-				// Build AABBTree and serialize it
-				ILOG("\tBuilding doodad " << doodadFile->getBaseName());
-				auto doodadTree = std::make_shared<math::AABBTree>(doodadFile->getVertices(), doodadFile->getIndices());
-				doodadTrees[chunk.uniqueId] = doodadTree;
-				doodadIdsByFile[filename] = doodadTree;
-
-				// Serialize it
-				std::ofstream file(filePath.string().c_str(), std::ios::out | std::ios::binary);
-				if (!file)
-				{
-					ELOG("Failed to create output file " << filePath);
-					return false;
-				}
-
-				io::StreamSink fileSink(file);
-				io::Writer fileWriter(fileSink);
-				fileWriter << *doodadTree;
+				ELOG("Could not build collision tree of doodad " << filename);
+				return false;
 			}
-			else
-			{
-				auto it = doodadIdsByFile.find(filename);
-				if (it == doodadIdsByFile.end())
-				{
-					WLOG("Could not find doodad id for file " << filename);
-				}
 
-				doodadTrees[chunk.uniqueId] = it->second;
-			}
+			out_models[chunk.uniqueId] = doodadModel;
 
 			// Add a new Doodad entry
 			MapDoodadChunk::DoodadEntry entry;
@@ -1000,7 +1281,7 @@ namespace
 
 			entry.transform = matFinal;
 			entry.inverse = matFinal.inverse();
-			entry.bounds = doodadTrees[chunk.uniqueId]->getBoundingBox();
+			entry.bounds = doodadModel->tree->getBoundingBox();
 			entry.bounds.transform(entry.transform);
 
 			out_chunk.entries.push_back(std::move(entry));
@@ -1037,41 +1318,79 @@ namespace
 		}
 	}
 
-	/// Generates all required map files of a given ADT cell.
+	/// Calculates the fingerprint of all inputs of an adt cell's map file. If the fingerprint
+	/// did not change since the last run, the map file doesn't need to be generated again.
+	/// @param mapName Name of the map.
+	/// @param tileX X tile coordinate of the adt cell.
+	/// @param tileY Y tile coordinate of the adt cell.
+	/// @param adt The adt file of the cell.
+	/// @param areas The area chunk of the cell.
+	/// @param wmos WMO placements of the cell.
+	/// @param wmoModels Models of the placed WMOs.
+	/// @param doodads Doodad placements of the cell.
+	/// @param doodadModels Models of the placed doodads.
+	/// @returns The fingerprint.
+	static SHA1Hash calculateTileFingerprint(const String &mapName, UInt32 tileX, UInt32 tileY, const ADTFile &adt, const MapAreaChunk &areas, const MapWMOChunk &wmos, const ModelMap &wmoModels, const MapDoodadChunk &doodads, const ModelMap &doodadModels)
+	{
+		Boost_SHA1HashSink hash;
+
+		// Output format and navigation mesh settings
+		const UInt32 mapFormat = MapHeaderChunk::MapFormat;
+		hashPOD(hash, ExtractorFingerprintVersion);
+		hashPOD(hash, mapFormat);
+
+		rcConfig config;
+		initializeRecastConfig(config);
+		hashPOD(hash, config);
+
+		const float agentSettings[] = {
+			MeshSettings::WalkableHeight,
+			MeshSettings::WalkableRadius,
+			MeshSettings::WalkableClimb,
+			MeshSettings::AdtSize
+		};
+		hashPOD(hash, agentSettings);
+
+		// Area ids and flags of the cell
+		hashPOD(hash, areas);
+
+		// Terrain of the cell and of it's neighbours, which is used for the borders
+		hashContent(hash, adt.getContent());
+		hashContent(hash, ADTFile(getNeighbourADTFileName(mapName, tileX + 1, tileY)).getContent());
+		hashContent(hash, ADTFile(getNeighbourADTFileName(mapName, tileX - 1, tileY)).getContent());
+		hashContent(hash, ADTFile(getNeighbourADTFileName(mapName, tileX, tileY + 1)).getContent());
+		hashContent(hash, ADTFile(getNeighbourADTFileName(mapName, tileX, tileY - 1)).getContent());
+
+		// Placed models (placements themselves are part of the adt data)
+		for (const auto &entry : wmos.entries)
+		{
+			hashPOD(hash, entry.uniqueId);
+			hashPOD(hash, wmoModels.at(entry.uniqueId)->contentHash);
+		}
+		for (const auto &entry : doodads.entries)
+		{
+			hashPOD(hash, entry.uniqueId);
+			hashPOD(hash, doodadModels.at(entry.uniqueId)->contentHash);
+		}
+
+		return hash.finalizeHash();
+	}
+
+	/// Generates all required map files of a given ADT cell. The adt cell has to exist.
+	/// This method is called from multiple threads!
 	/// @param mapId The map id of the wdt file.
 	/// @param mapName Name of the map used for file name generation.
-	/// @param wdt Parsed WDT file information which is required to determine if the adt cell should exists.
 	/// @param packedTileIndex The packed index of the tile.
-	/// @param navMesh The nav mesh that will be updated.
+	/// @param out_upToDate Set to true if the map file was skipped because its inputs didn't change.
 	/// @return true on success, false on error.
-	static bool convertADT(UInt32 mapId, const String &mapName, WDTFile &wdt, UInt32 packedTileIndex, dtNavMesh &navMesh)
+	static bool convertADT(UInt32 mapId, const String &mapName, UInt32 packedTileIndex, bool &out_upToDate)
 	{
-		// Check tile
-		auto &adtTiles = wdt.getMAINChunk().adt;
-		if (adtTiles[packedTileIndex].exist == 0)
-		{
-			// Nothing to do here since there is no ADT file for this map tile
-			return true;
-		}
+		out_upToDate = false;
 
 		// Calcualte cell index
 		const UInt32 cellX = packedTileIndex / 64;
 		const UInt32 cellY = packedTileIndex % 64;
 
-		// Only filter cells if we are on the specified map id (and if a map id has been specified)
-		if (buildOnlyMap >= 0 && mapId == buildOnlyMap)
-		{
-			if (buildOnlyTileX >= 0 && buildOnlyTileY >= 0)
-			{
-				// Not our tile to build
-				if (cellX != buildOnlyTileX || cellY != buildOnlyTileY)
-					return false;
-			}
-		}
-
-		// Build NavMesh tiles
-		ILOG("\tBuilding adt cell [" << cellX << "," << cellY << "] ...");
-
 		// File name formattings
 		const String cellName = fmt::format("{0}_{1}_{2}", mapName, cellY, cellX);
 		const String adtFileName = fmt::format("World\\Maps\\{0}\\{1}.adt", mapName, cellName);
@@ -1084,10 +1403,41 @@ namespace
 			return false;
 		}
 
+        // Create map adt area chunk
+        MapAreaChunk areaHeader;
+		createAreaChunk(adt, areaHeader);
+
+		// Load WMOs and Doodads
+		MapWMOChunk wmoChunk;
+		ModelMap wmoModels;
+		if (!loadADTWmos(adt, wmoChunk, wmoModels))
+			return false;
+		MapDoodadChunk doodadChunk;
+		ModelMap doodadModels;
+		if (!loadADTDoodads(adt, doodadChunk, doodadModels))
+			return false;
+
+		// Skip this cell if none of its inputs changed since the map file was generated. Debug
+		// files are only written while building, so they always require a rebuild.
+		const fs::path mapFilePath =
+			(outputPath / (fmt::format("{0}", mapId))) / (fmt::format("{0}_{1}.map", cellX, cellY));
+		const fs::path mapFingerprintPath = getFingerprintPath(mapFilePath);
+		const SHA1Hash fingerprint = calculateTileFingerprint(mapName, cellX, cellY, adt, areaHeader, wmoChunk, wmoModels, doodadChunk, doodadModels);
+		if (!generateDebugFiles && isUpToDate(mapFilePath, fingerprint))
+		{
+			DLOG("\t[Map " << mapId << "] Adt cell [" << cellX << "," << cellY << "] is up to date");
+			out_upToDate = true;
+			return true;
+		}
+
+		// Build NavMesh tiles
+		ILOG("\t[Map " << mapId << "] Building adt cell [" << cellX << "," << cellY << "] ...");
+
+		// The old fingerprint is invalid as soon as the map file is overwritten
+		removeFingerprint(mapFingerprintPath);
+
 		// Create map file
-		const String mapFileName =
-			((outputPath / (fmt::format("{0}", mapId))) / (fmt::format("{0}_{1}.map", cellX, cellY))).string();
-		std::ofstream fileStrm(mapFileName, std::ios::out | std::ios::binary);
+		std::ofstream fileStrm(mapFilePath.string(), std::ios::out | std::ios::binary);
 		io::StreamSink sink(fileStrm);
 		io::Writer writer(sink);
 		
@@ -1099,21 +1449,11 @@ namespace
 		createHeaderChunk(header);
 		writer.writePOD(header);
 
-        // Create map adt area chunk
-        MapAreaChunk areaHeader;
-		createAreaChunk(adt, areaHeader);
+		// Write map adt area chunk
 		header.offsAreaTable = sink.position();
 		writer.writePOD(areaHeader);
 		header.areaTableSize = sink.position() - header.offsAreaTable;
 
-		// Load WMOs and Doodads
-		MapWMOChunk wmoChunk;
-		if (!loadADTWmos(adt, wmoChunk))
-			return false;
-		MapDoodadChunk doodadChunk;
-		if (!loadADTDoodads(adt, doodadChunk))
-			return false;
-
 		// Serialize WMO chunk
 		header.offsWmos = sink.position();
 		header.wmoSize = wmoChunk.header.size;
@@ -1153,7 +1493,8 @@ namespace
 
 		// Prepare navigation chunk
 		MapNavigationChunk navChunk;
-		if (!createNavChunk(mapName, mapId, cellX, cellY, navMesh, adt, wmoChunk, doodadChunk, navChunk))
+		const bool navChunkCreated = createNavChunk(mapName, mapId, cellX, cellY, adt, wmoChunk, wmoModels, doodadChunk, doodadModels, navChunk);
+		if (!navChunkCreated)
 		{
 			ELOG("Could not create nav chunk for cell " << cellX << "," << cellY);
 		}
@@ -1185,14 +1526,70 @@ namespace
 
 		// Overwrite header chunk with new values
 		writer.writePOD(headerChunkPos, header);
+
+		fileStrm.close();
+		if (fileStrm.fail())
+		{
+			ELOG("Could not write map file " << mapFilePath);
+			return false;
+		}
+
+		// Remember the inputs of this map file, unless it has to be generated again on the next run
+		if (navChunkCreated)
+		{
+			writeFingerprint(mapFingerprintPath, fingerprint);
+		}
+
 		return true;
 	}
 	
-	/// Generates all required data of a given map by it's index in the map dbc file.
+	/// Completes a map after all of its adt tiles have been converted.
+	/// @param job The finished map job.
+	static void finishMap(const MapJob &job)
+	{
+		const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - job.startTime);
+
+		if (job.failedTiles > 0)
+		{
+			WLOG("[Map " << job.mapId << "] Finished " << job.mapName << " with " << job.failedTiles << " of " << job.totalTiles << " failed tiles in " << duration.count() << " ms");
+		}
+		else
+		{
+			ILOG("[Map " << job.mapId << "] Finished " << job.mapName << " (" << job.totalTiles << " tiles, " << job.upToDateTiles << " up to date) in " << duration.count() << " ms");
+		}
+	}
+
+	/// Converts a single adt tile of a map. This is a task which is executed by the
+	/// dispatcher and thus called from multiple threads!
+	/// @param job The map job this tile belongs to.
+	/// @param packedTileIndex The packed index of the tile.
+	static void convertTile(const std::shared_ptr<MapJob> &job, UInt32 packedTileIndex)
+	{
+		bool upToDate = false;
+		if (!convertADT(job->mapId, job->mapName, packedTileIndex, upToDate))
+		{
+			++job->failedTiles;
+		}
+		else if (upToDate)
+		{
+			++job->upToDateTiles;
+		}
+
+		// The last finished tile completes the map
+		if (--job->pendingTiles == 0)
+		{
+			finishMap(*job);
+		}
+	}
+
+	/// Generates all required data of a given map by it's index in the map dbc file. Every
+	/// adt tile of the map is converted by a separate task, posted to the given dispatcher.
 	/// This method is called from multiple threads!
 	/// @param dbcRow Row id in the map dbc file.
+	/// @param dispatcher The dispatcher which executes the tile tasks.
 	/// @return false on error, true on success.
-	static bool convertMap(UInt32 dbcRow)
+	static bool convertMap(UInt32 dbcRow, boost::asio::io_service &dispatcher)
 	{
 		// Get Map values
 		UInt32 mapId = 0;
@@ -1243,6 +1640,18 @@ namespace
 			}
 		}
 
+		// Create the fingerprint directory of this map (if it doesn't exist)
+		const fs::path mapFingerprintPath = fingerprintPath / mapPath;
+		if (!fs::is_directory(mapFingerprintPath))
+		{
+			boost::system::error_code error;
+			if (!fs::create_directories(mapFingerprintPath, error))
+			{
+				ELOG("Could not create fingerprint directory " << mapFingerprintPath);
+				return false;
+			}
+		}
+
 		// Load the WDT file and get infos out of there
 		const String wdtFileName = fmt::format("World\\Maps\\{0}\\{0}.wdt", mapName);
 		WDTFile mapWDT(wdtFileName);
@@ -1258,6 +1667,8 @@ namespace
 		auto &adtTiles = mapWDT.getMAINChunk().adt;
 		
 		// Filter tiles we don't need
+		LinearSet<UInt32> tiles;
+		std::vector<UInt32> tilesToBuild;
 		for (UInt32 tile = 0; tile < adtTiles.size(); ++tile)
 		{
 			if (adtTiles[tile].exist > 0)
@@ -1265,16 +1676,26 @@ namespace
 				// Calcualte cell index
 				const UInt32 cellX = tile / 64;
 				const UInt32 cellY = tile % 64;
-				tilesByMap[mapId].add(packTileID(cellX, cellY));
+				tiles.add(packTileID(cellX, cellY));
+
+				// Only filter cells if we are on the specified map id (and if a map id has been specified)
+				if (buildOnlyMap >= 0 && buildOnlyTileX >= 0 && buildOnlyTileY >= 0)
+				{
+					// Not our tile to build
+					if (cellX != buildOnlyTileX || cellY != buildOnlyTileY)
+						continue;
+				}
+
+				tilesToBuild.push_back(tile);
 			}
 		}
 
-		ILOG("Found " << tilesByMap[mapId].size() << " adt tiles");
+		ILOG("Found " << tiles.size() << " adt tiles");
 
 		// Create nav mesh
 		auto freeNavMesh = [](dtNavMesh* ptr) { dtFreeNavMesh(ptr); };
 		std::unique_ptr<dtNavMesh, decltype(freeNavMesh)> navMesh(dtAllocNavMesh(), freeNavMesh);
-		if (!createNavMesh(mapId, *navMesh))
+		if (!createNavMesh(mapId, tiles, *navMesh))
 		{
 			ELOG("Failed creating the navigation mesh!");
 			return false;
@@ -1295,14 +1716,18 @@ namespace
 			return false;
 		}
 
-		// Iterate through all tiles and create those which are available
-		bool succeeded = true;
-		for (UInt32 tile = 0; tile < adtTiles.size(); ++tile)
+		if (tilesToBuild.empty())
 		{
-			if (!convertADT(mapId, mapName, mapWDT, tile, *navMesh))
-			{
-				succeeded = false;
-			}
+			return true;
+		}
+
+		// Create a task for every tile which needs to be built. These tasks are executed by all
+		// worker threads, so that large maps don't keep a single thread busy for hours.
+		auto job = std::make_shared<MapJob>(mapId, mapName, tilesToBuild.size());
+		for (const auto &tile : tilesToBuild)
+		{
+			dispatcher.post(
+				std::bind(convertTile, job, tile));
 		}
 
 		return true;
@@ -1434,6 +1859,7 @@ int main(int argc, char* argv[])
 		("tileX,x", po::value(&buildOnlyTileX), "build only this specific x tile of the specified map")
 		("tileY,y", po::value(&buildOnlyTileY), "build only this specific y tile of the specified map")
 		("debug,d", po::value(&generateDebugFiles), "produce *.obj mesh files for debugging")
+		("rebuild,r", "ignore the fingerprints of the previous run and build all files again")
 		;
 
 	po::variables_map vm;
@@ -1453,6 +1879,7 @@ int main(int argc, char* argv[])
 
 	// Limit cpu count
 	concurrency = std::max<size_t>(1, concurrency);
+	forceRebuild = (vm.count("rebuild") != 0);
 
 	// Display help message
 	if (vm.count("help"))
@@ -1489,6 +1916,20 @@ int main(int argc, char* argv[])
 		}
 	}
 
+	// Try to create fingerprint directories, which are used to skip files whose inputs didn't change
+	for (const auto &path : { fingerprintPath / outputPath, fingerprintPath / bvhOutputPath })
+	{
+		if (!fs::is_directory(path))
+		{
+			boost::system::error_code error;
+			if (!fs::create_directories(path, error))
+			{
+				ELOG("Could not create fingerprint path: " << path);
+				return 1;
+			}
+		}
+	}
+
 	// Detect client localization
 	String currentLocale;
 	if (!detectLocale(currentLocale))
@@ -1514,17 +1955,17 @@ int main(int argc, char* argv[])
 	ILOG("Found " << dbcAreaTable->getRecordCount() << " areas");
 	ILOG("Found " << dbcLiquidType->getRecordCount() << " liquid types");
 
-	// Create work jobs for every map that exists
+	// Create work jobs for every map that exists. Each map job posts a task for every
+	// adt tile of the map to the same dispatcher, so that all threads keep working on
+	// tiles until the last map is done.
 	boost::asio::io_service dispatcher;
 	for (UInt32 i = 0; i < dbcMap->getRecordCount(); ++i)
 	{
 		dispatcher.post(
-			std::bind(convertMap, i));
+			std::bind(convertMap, i, std::ref(dispatcher)));
 	}
 
-	// Determine the amount of available cpu cores, and use just as many. However,
-	// right now, this will only convert multiple maps at the same time, not multiple
-	// tiles - but still A LOT faster than single threaded.
+	// Determine the amount of available cpu cores, and use just as many.
 	ILOG("Using " << concurrency << " threads");
 
 	// Do the work!
@@ -54,6 +54,8 @@ namespace wowpp
 		const String &getFileName() const { return m_fileName; }
 		/// Returns the files base name (without path and extension).
 		const String &getBaseName() const { return m_baseName; }
+		/// Returns the raw file content as it was read from the MPQ archive.
+		const std::vector<char> &getContent() const { return m_buffer; }
 
 	protected:
 
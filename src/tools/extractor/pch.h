@@ -50,6 +50,8 @@
 #include <type_traits>
 #include <thread>
 #include <mutex>
+#include <future>
+#include <chrono>
 
 // Boost Libraies
 #include <boost/optional.hpp>
@@ -61,6 +63,8 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <boost/ptr_container/ptr_map.hpp>
 #include <boost/type_traits/is_float.hpp>
+#include <boost/iostreams/concepts.hpp>
+#include <boost/uuid/sha1.hpp>
 
 // Cppformat
 #include "cppformat/cppformat/format.h"
@@ -0,0 +1,90 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "allocation_counter.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<wowpp::UInt64> allocationCount(0);
+	std::atomic<wowpp::UInt64> allocationBytes(0);
+
+	void *countedAllocate(std::size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+		void *result = std::malloc(size ? size : 1);
+		if (!result)
+		{
+			throw std::bad_alloc();
+		}
+
+		return result;
+	}
+}
+
+void *operator new(std::size_t size)
+{
+	return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+	return countedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace wowpp
+{
+	namespace allocation_counter
+	{
+		Snapshot get()
+		{
+			Snapshot result;
+			result.count = allocationCount.load(std::memory_order_relaxed);
+			result.bytes = allocationBytes.load(std::memory_order_relaxed);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,234 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "benchmark_player.h"
+#include "game/world_instance.h"
+#include "game/game_character.h"
+#include "game/each_tile_in_region.h"
+#include "game/visibility_grid.h"
+#include "game/visibility_tile.h"
+#include "game/unit_finder.h"
+#include "game/unit_mover.h"
+#include "game/circle.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	/// Minimum and maximum number of ticks between two scripted actions.
+	static const UInt32 MinActionDelay = 10;
+	static const UInt32 MaxActionDelay = 60;
+	/// Maximum distance to the home point used for random movement.
+	static const float WanderRadius = 20.0f;
+	/// Range in which enemies are searched.
+	static const float AggroRange = 30.0f;
+
+	BenchmarkPlayer::BenchmarkPlayer(
+		WorldInstance &instance,
+		std::shared_ptr<GameCharacter> character,
+		std::vector<const proto::SpellEntry*> spells,
+		UInt32 seed)
+		: m_instance(instance)
+		, m_character(std::move(character))
+		, m_spells(std::move(spells))
+		, m_random(seed)
+		, m_home(m_character->getLocation())
+		, m_nextAction(0)
+		, m_packetCount(0)
+		, m_byteCount(0)
+		, m_spawnStream(instance, *this)
+	{
+		m_characterSignals.append({
+			m_character->spawned.connect(this, &BenchmarkPlayer::onSpawned),
+			m_character->tileChangePending.connect(this, &BenchmarkPlayer::onTileChangePending)
+		});
+	}
+
+	BenchmarkPlayer::~BenchmarkPlayer()
+	{
+		m_characterSignals.disconnect();
+
+		if (m_character->getWorldInstance())
+		{
+			m_instance.getGrid().requireTile(getTileIndex()).getWatchers().remove(this);
+			m_instance.removeGameObject(*m_character);
+		}
+	}
+
+	void BenchmarkPlayer::spawn()
+	{
+		m_character->setWorldInstance(&m_instance);
+		m_instance.addGameObject(*m_character);
+	}
+
+	void BenchmarkPlayer::update(UInt32 tick)
+	{
+		if (tick < m_nextAction)
+		{
+			return;
+		}
+
+		m_nextAction = tick + std::uniform_int_distribution<UInt32>(MinActionDelay, MaxActionDelay)(m_random);
+
+		if (!m_character->isAlive())
+		{
+			m_character->revive(
+				m_character->getUInt32Value(unit_fields::MaxHealth),
+				m_character->getUInt32Value(unit_fields::MaxPower1));
+			return;
+		}
+
+		// Roughly half of the actions are combat, the rest is movement
+		switch (std::uniform_int_distribution<UInt32>(0, 3)(m_random))
+		{
+			case 0:
+				if (castSpell())
+				{
+					return;
+				}
+				break;
+			case 1:
+				if (attackEnemy())
+				{
+					return;
+				}
+				break;
+			default:
+				break;
+		}
+
+		moveRandomly();
+	}
+
+	void BenchmarkPlayer::sendPacket(game::Protocol::OutgoingPacket &packet, const std::vector<char> &buffer)
+	{
+		++m_packetCount;
+		m_byteCount += buffer.size();
+	}
+
+	TileIndex2D BenchmarkPlayer::getTileIndex() const
+	{
+		TileIndex2D tile;
+		m_instance.getGrid().getTilePosition(m_character->getLocation(), tile[0], tile[1]);
+		return tile;
+	}
+
+	void BenchmarkPlayer::onSpawned()
+	{
+		VisibilityTile &tile = m_instance.getGrid().requireTile(getTileIndex());
+		tile.getWatchers().add(this);
+
+		forEachTileInSight(
+			m_instance.getGrid(),
+			tile.getPosition(),
+			[this](VisibilityTile &sightTile)
+		{
+			m_spawnStream.queueTile(sightTile);
+		});
+	}
+
+	void BenchmarkPlayer::onTileChangePending(VisibilityTile &oldTile, VisibilityTile &newTile)
+	{
+		oldTile.getWatchers().remove(this);
+		m_spawnStream.changeTile(oldTile, newTile);
+		newTile.getWatchers().add(this);
+	}
+
+	GameUnit *BenchmarkPlayer::findNearestEnemy(float range)
+	{
+		const math::Vector3 location(m_character->getLocation());
+
+		GameUnit *nearest = nullptr;
+		float nearestDistanceSq = range * range;
+		m_instance.getUnitFinder().findUnits(Circle(location.x, location.y, range), [this, &nearest, &nearestDistanceSq](GameUnit &unit) -> bool
+		{
+			if (&unit == m_character.get() ||
+				!unit.isCreature() ||
+				!unit.isAlive() ||
+				!m_character->isHostileTo(unit))
+			{
+				return true;
+			}
+
+			const float distanceSq = m_character->getSquaredDistanceTo(unit, false);
+			if (distanceSq < nearestDistanceSq)
+			{
+				nearest = &unit;
+				nearestDistanceSq = distanceSq;
+			}
+
+			return true;
+		});
+
+		return nearest;
+	}
+
+	void BenchmarkPlayer::moveRandomly()
+	{
+		std::uniform_real_distribution<float> offset(-WanderRadius, WanderRadius);
+
+		math::Vector3 target(m_home);
+		target.x += offset(m_random);
+		target.y += offset(m_random);
+		m_character->getMover().moveTo(target);
+	}
+
+	bool BenchmarkPlayer::attackEnemy()
+	{
+		GameUnit *enemy = findNearestEnemy(AggroRange);
+		if (!enemy)
+		{
+			return false;
+		}
+
+		m_character->setVictim(enemy);
+		m_character->startAttack();
+		m_character->getMover().moveTo(enemy->getLocation());
+		return true;
+	}
+
+	bool BenchmarkPlayer::castSpell()
+	{
+		if (m_spells.empty())
+		{
+			return false;
+		}
+
+		const auto *spell = m_spells[std::uniform_int_distribution<size_t>(0, m_spells.size() - 1)(m_random)];
+
+		SpellTargetMap target;
+		GameUnit *enemy = findNearestEnemy(AggroRange);
+		if (enemy)
+		{
+			target.m_targetMap = game::spell_cast_target_flags::Unit;
+			target.m_unitTarget = enemy->getGuid();
+		}
+		else
+		{
+			target.m_targetMap = game::spell_cast_target_flags::Self;
+			target.m_unitTarget = m_character->getGuid();
+		}
+
+		m_character->castSpell(std::move(target), spell->id());
+		return true;
+	}
+}
@@ -0,0 +1,113 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#pragma once
+
+#include "common/typedefs.h"
+#include "game/tile_subscriber.h"
+#include "game/spawn_stream.h"
+#include "game/tile_index.h"
+#include "math/vector3.h"
+
+namespace wowpp
+{
+	namespace proto
+	{
+		class SpellEntry;
+	}
+
+	class WorldInstance;
+	class VisibilityTile;
+	class GameCharacter;
+	class GameUnit;
+
+	/// A player without a client connection. Its character is driven by scripted movement,
+	/// combat and spell inputs and all packets sent to it are only counted.
+	class BenchmarkPlayer final : public ITileSubscriber
+	{
+	private:
+
+		BenchmarkPlayer(const BenchmarkPlayer &Other) = delete;
+		BenchmarkPlayer &operator=(const BenchmarkPlayer &Other) = delete;
+
+	public:
+
+		/// Creates a new benchmark player.
+		/// @param instance The world instance the character will be spawned in.
+		/// @param character The character, which has to be fully initialized but not yet spawned.
+		/// @param spells Spells which are cast by the script.
+		/// @param seed Seed of the random generator which drives the script.
+		explicit BenchmarkPlayer(
+			WorldInstance &instance,
+			std::shared_ptr<GameCharacter> character,
+			std::vector<const proto::SpellEntry*> spells,
+			UInt32 seed);
+		~BenchmarkPlayer();
+
+		/// Adds the character to the world instance.
+		void spawn();
+		/// Executes the scripted input of this player.
+		/// @param tick Number of the current tick.
+		void update(UInt32 tick);
+
+		/// Gets the number of packets sent to this player.
+		UInt64 getPacketCount() const { return m_packetCount; }
+		/// Gets the number of bytes sent to this player.
+		UInt64 getByteCount() const { return m_byteCount; }
+
+	public:
+
+		/// @copydoc ITileSubscriber::isIgnored()
+		bool isIgnored(UInt64 guid) const override { return false; }
+		/// @copydoc ITileSubscriber::convertTimestamp()
+		UInt32 convertTimestamp(UInt32 otherTimestamp, UInt32 otherTicks) const override { return otherTimestamp; }
+		/// @copydoc ITileSubscriber::getControlledObject()
+		GameCharacter *getControlledObject() override { return m_character.get(); }
+		/// @copydoc ITileSubscriber::sendPacket()
+		void sendPacket(game::Protocol::OutgoingPacket &packet, const std::vector<char> &buffer) override;
+		/// @copydoc ITileSubscriber::isSpawnPending()
+		bool isSpawnPending(UInt64 guid) const override { return m_spawnStream.isPending(guid); }
+
+	private:
+
+		TileIndex2D getTileIndex() const;
+		void onSpawned();
+		void onTileChangePending(VisibilityTile &oldTile, VisibilityTile &newTile);
+		GameUnit *findNearestEnemy(float range);
+		void moveRandomly();
+		bool attackEnemy();
+		bool castSpell();
+
+	private:
+
+		WorldInstance &m_instance;
+		std::shared_ptr<GameCharacter> m_character;
+		std::vector<const proto::SpellEntry*> m_spells;
+		std::mt19937 m_random;
+		simple::scoped_connection_container m_characterSignals;
+		math::Vector3 m_home;
+		UInt32 m_nextAction;
+		UInt64 m_packetCount;
+		UInt64 m_byteCount;
+		SpawnStream m_spawnStream;
+	};
+}
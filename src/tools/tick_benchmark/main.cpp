@@ -0,0 +1,275 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include "allocation_counter.h"
+#include "benchmark_player.h"
+#include "common/constants.h"
+#include "common/timer_queue.h"
+#include "common/clock.h"
+#include "common/id_generator.h"
+#include "log/default_log.h"
+#include "log/log_std_stream.h"
+#include "proto_data/project.h"
+#include "game/universe.h"
+#include "game/project_snapshots.h"
+#include "game/trigger_handler.h"
+#include "game/world_instance_manager.h"
+#include "game/world_instance.h"
+#include "game/game_character.h"
+
+namespace wowpp
+{
+	/// Triggers aren't part of the benchmark and are ignored.
+	struct NullTriggerHandler final : game::ITriggerHandler
+	{
+		void executeTrigger(const proto::TriggerEntry &entry, game::TriggerContext context, UInt32 actionOffset, bool ignoreProbability) override
+		{
+		}
+	};
+
+	/// Gets the value of a sorted sample set at the given percentile.
+	static UInt32 getPercentile(const std::vector<UInt32> &sorted, UInt32 percentile)
+	{
+		if (sorted.empty())
+		{
+			return 0;
+		}
+
+		const size_t index = std::min(sorted.size() - 1, sorted.size() * percentile / 100);
+		return sorted[index];
+	}
+}
+
+int main(int argc, char **argv)
+{
+	using namespace ::wowpp;
+	namespace po = ::boost::program_options;
+
+	static const std::string VersionStr = "WoW++ Tick Benchmark 1.0";
+
+	std::string dataPath = "data";
+	UInt32 playerCount = 100;
+	UInt32 tickCount = 1000;
+	UInt32 seed = 1;
+	UInt32 raceId = 1;
+	UInt32 classId = 1;
+	UInt32 level = 10;
+	float radius = 50.0f;
+	UInt32 step = 30;
+
+	po::options_description desc(VersionStr + ", available options");
+	desc.add_options()
+	("help", "produce help message")
+	("version", "display the application's name and version")
+	("data,d", po::value<std::string>(&dataPath), "path of the data directory (default: data)")
+	("players,p", po::value<UInt32>(&playerCount), "number of emulated players (default: 100)")
+	("ticks,t", po::value<UInt32>(&tickCount), "number of measured world ticks (default: 1000)")
+	("seed,s", po::value<UInt32>(&seed), "seed of the scripted player input (default: 1)")
+	("race", po::value<UInt32>(&raceId), "race of the emulated players, which also selects the map (default: 1)")
+	("class", po::value<UInt32>(&classId), "class of the emulated players (default: 1)")
+	("level", po::value<UInt32>(&level), "level of the emulated players (default: 10)")
+	("radius,r", po::value<float>(&radius), "radius around the race start position in which players are spawned (default: 50)")
+	("step", po::value<UInt32>(&step), "game time in milliseconds which passes per tick (default: 30)")
+	;
+
+	po::variables_map vm;
+	try
+	{
+		po::store(
+		    po::command_line_parser(argc, argv).options(desc).run(),
+		    vm);
+		po::notify(vm);
+	}
+	catch (const po::error &e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+
+	if (vm.count("version"))
+	{
+		std::cerr << VersionStr << '\n';
+	}
+
+	if (vm.count("help"))
+	{
+		std::cerr << desc << "\n";
+		return 0;
+	}
+
+	// Only warnings and errors are of interest, everything else would distort the measurement
+	g_DefaultLog.setMinimumImportance(log_importance::High);
+	g_DefaultLog.signal().connect(std::bind(
+		printLogEntry,
+		std::ref(std::cout), std::placeholders::_1, g_DefaultConsoleLogOptions));
+
+	ProjectSnapshot snapshot(1);
+	if (!snapshot.load(dataPath))
+	{
+		std::cerr << "Could not load data project from " << dataPath << "\n";
+		return 1;
+	}
+
+	proto::Project &project = snapshot.project;
+	const auto *race = project.races.getById(raceId);
+	if (!race)
+	{
+		std::cerr << "Unknown race " << raceId << "\n";
+		return 1;
+	}
+
+	const auto *map = project.maps.getById(race->startmap());
+	if (!map)
+	{
+		std::cerr << "Unknown start map " << race->startmap() << " of race " << raceId << "\n";
+		return 1;
+	}
+
+	// Spells which the players will cast
+	std::vector<const proto::SpellEntry*> spells;
+	const auto initialSpells = race->initialspells().find(classId);
+	if (initialSpells != race->initialspells().end())
+	{
+		for (const auto &spellId : initialSpells->second.spells())
+		{
+			const auto *spell = project.spells.getById(spellId);
+			if (spell && !(spell->attributes(0) & game::spell_attributes::Passive))
+			{
+				spells.push_back(spell);
+			}
+		}
+	}
+
+	// Game time advances by a fixed step per tick instead of following the wall clock, so that
+	// timers fire the same way on every run, no matter how long the ticks take
+	enableSimulatedTime(getCurrentTime());
+
+	boost::asio::io_service service;
+	TimerQueue timers(service);
+	Universe universe(service, timers);
+	universe.setSpellPlans(&snapshot.spellPlans);
+
+	NullTriggerHandler triggerHandler;
+	IdGenerator<UInt32> instanceIdGenerator;
+	IdGenerator<UInt64> objectIdGenerator(0x01);
+
+	WorldInstanceManager manager(service, universe, triggerHandler, instanceIdGenerator, objectIdGenerator, project, 0, dataPath);
+	manager.stopUpdates();
+
+	WorldInstance *instance = manager.createInstance(*map);
+	ASSERT(instance);
+
+	// Spawn the emulated players
+	std::mt19937 placement(seed);
+	std::uniform_real_distribution<float> offset(-radius, radius);
+	std::vector<std::unique_ptr<BenchmarkPlayer>> players;
+	players.reserve(playerCount);
+	for (UInt32 i = 0; i < playerCount; ++i)
+	{
+		std::shared_ptr<GameCharacter> character(new GameCharacter(project, timers));
+		character->initialize();
+		character->setGuid(createRealmGUID(i + 1, 0, guid_type::Player));
+		character->setName("Bench" + std::to_string(i + 1));
+		character->setRace(raceId);
+		character->setClass(classId);
+		character->setGender(game::gender::Male);
+		character->setLevel(level);
+
+		const math::Vector3 location(
+			race->startposx() + offset(placement),
+			race->startposy() + offset(placement),
+			race->startposz());
+		character->relocate(location, race->startrotation());
+		character->setMapId(map->id());
+		character->setHome(map->id(), location, race->startrotation());
+
+		for (const auto *spell : spells)
+		{
+			character->addSpell(*spell);
+		}
+
+		players.push_back(std::unique_ptr<BenchmarkPlayer>(
+			new BenchmarkPlayer(*instance, std::move(character), spells, seed + i)));
+		players.back()->spawn();
+	}
+
+	// Run the measured ticks
+	std::vector<UInt32> tickDurations;
+	tickDurations.reserve(tickCount);
+	const auto allocationsBefore = allocation_counter::get();
+	for (UInt32 tick = 0; tick < tickCount; ++tick)
+	{
+		const auto tickStart = std::chrono::steady_clock::now();
+
+		advanceSimulatedTime(step);
+		timers.processEvents();
+
+		for (auto &player : players)
+		{
+			player->update(tick);
+		}
+
+		service.poll();
+		manager.updateInstances();
+
+		const auto tickEnd = std::chrono::steady_clock::now();
+		tickDurations.push_back(static_cast<UInt32>(
+			std::chrono::duration_cast<std::chrono::microseconds>(tickEnd - tickStart).count()));
+	}
+	const auto allocationsAfter = allocation_counter::get();
+
+	// Report results as key: value lines, so that they can easily be compared between builds
+	UInt64 packets = 0, bytes = 0;
+	for (const auto &player : players)
+	{
+		packets += player->getPacketCount();
+		bytes += player->getByteCount();
+	}
+
+	UInt64 totalDuration = 0;
+	for (const auto &duration : tickDurations)
+	{
+		totalDuration += duration;
+	}
+
+	std::sort(tickDurations.begin(), tickDurations.end());
+	const UInt64 ticks = std::max<UInt64>(1, tickCount);
+
+	std::cout
+	        << "players: " << playerCount << "\n"
+	        << "ticks: " << tickCount << "\n"
+	        << "seed: " << seed << "\n"
+	        << "tick_p50_us: " << getPercentile(tickDurations, 50) << "\n"
+	        << "tick_p90_us: " << getPercentile(tickDurations, 90) << "\n"
+	        << "tick_p99_us: " << getPercentile(tickDurations, 99) << "\n"
+	        << "tick_max_us: " << (tickDurations.empty() ? 0 : tickDurations.back()) << "\n"
+	        << "tick_mean_us: " << totalDuration / ticks << "\n"
+	        << "allocations_per_tick: " << (allocationsAfter.count - allocationsBefore.count) / ticks << "\n"
+	        << "allocated_bytes_per_tick: " << (allocationsAfter.bytes - allocationsBefore.bytes) / ticks << "\n"
+	        << "packets_sent: " << packets << "\n"
+	        << "bytes_sent: " << bytes << "\n";
+
+	// Players have to be removed before their world instance is destroyed
+	players.clear();
+	return 0;
+}
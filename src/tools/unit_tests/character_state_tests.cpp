@@ -0,0 +1,161 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "game/character_state.h"
+#include "binary_io/memory_source.h"
+#include "binary_io/string_sink.h"
+
+namespace wowpp
+{
+	static String writeState(const CharacterState &state)
+	{
+		String buffer;
+		io::StringSink sink(buffer);
+		io::Writer writer(sink);
+		writer << state;
+		return buffer;
+	}
+
+	BOOST_AUTO_TEST_CASE(CharacterState_round_trip)
+	{
+		CharacterState state;
+		state.exploredZones[0] = 0x00000002;
+		state.exploredZones[63] = 0x80000000;
+
+		AuraData aura;
+		aura.casterGuid = 0x0000000000000042;
+		aura.spell = 1243;
+		aura.stackCount = 1;
+		aura.basePoints = { { 5, 0, -3 } };
+		aura.periodicTime = { { 0, 3000, 0 } };
+		aura.maxDuration = 1800000;
+		aura.remainingTime = 1234567;
+		aura.effectIndexMask = 0x05;
+		state.auras.push_back(aura);
+
+		state.cooldowns.emplace_back(2687, 45000);
+
+		QuestStatusData quest;
+		quest.status = game::quest_status::Incomplete;
+		quest.expiration = 1500000000;
+		quest.creatures = { { 3, 0, 0, 8 } };
+		state.quests[33] = quest;
+
+		const String buffer = writeState(state);
+
+		CharacterState loaded;
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+		BOOST_REQUIRE(reader >> loaded);
+
+		BOOST_CHECK(loaded.exploredZones == state.exploredZones);
+		BOOST_REQUIRE(loaded.auras.size() == 1);
+		BOOST_CHECK(loaded.auras[0].casterGuid == aura.casterGuid);
+		BOOST_CHECK(loaded.auras[0].spell == aura.spell);
+		BOOST_CHECK(loaded.auras[0].basePoints == aura.basePoints);
+		BOOST_CHECK(loaded.auras[0].periodicTime == aura.periodicTime);
+		BOOST_CHECK(loaded.auras[0].remainingTime == aura.remainingTime);
+		BOOST_CHECK(loaded.auras[0].effectIndexMask == aura.effectIndexMask);
+		BOOST_CHECK(loaded.cooldowns == state.cooldowns);
+		BOOST_REQUIRE(loaded.quests.count(33) == 1);
+		BOOST_CHECK(loaded.quests[33].status == quest.status);
+		BOOST_CHECK(loaded.quests[33].expiration == quest.expiration);
+		BOOST_CHECK(loaded.quests[33].creatures == quest.creatures);
+	}
+
+	BOOST_AUTO_TEST_CASE(CharacterState_round_trip_long_quest_history)
+	{
+		// Rewarded quests are never removed, so the quest history of a character keeps growing
+		CharacterState state;
+		for (UInt32 questId = 1; questId <= 5000; ++questId)
+		{
+			QuestStatusData quest;
+			quest.status = game::quest_status::Rewarded;
+			quest.items = { { static_cast<UInt16>(questId), 0, 0, 1 } };
+			state.quests[questId] = quest;
+		}
+
+		const String buffer = writeState(state);
+
+		// Exceeds the 64 KB of a plain BLOB column, but fits into the MEDIUMBLOB column
+		BOOST_CHECK(buffer.size() > 0xFFFF);
+		BOOST_CHECK(buffer.size() <= CharacterState::MaxSerializedSize);
+
+		CharacterState loaded;
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+		BOOST_REQUIRE(reader >> loaded);
+		BOOST_REQUIRE(loaded.quests.size() == state.quests.size());
+		for (const auto &pair : state.quests)
+		{
+			const auto it = loaded.quests.find(pair.first);
+			BOOST_REQUIRE(it != loaded.quests.end());
+			BOOST_CHECK(it->second.status == pair.second.status);
+			BOOST_CHECK(it->second.items == pair.second.items);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(CharacterState_skips_unknown_sections)
+	{
+		CharacterState state;
+		state.cooldowns.emplace_back(100, 1000);
+		String buffer = writeState(state);
+
+		// Append a section of a future version
+		const char unknownSection[] = { 99, 3, 0, 0, 0, 1, 2, 3 };
+		buffer.append(unknownSection, sizeof(unknownSection));
+
+		CharacterState loaded;
+		io::MemorySource source(buffer);
+		io::Reader reader(source);
+		BOOST_REQUIRE(reader >> loaded);
+		BOOST_CHECK(loaded.cooldowns == state.cooldowns);
+	}
+
+	BOOST_AUTO_TEST_CASE(CharacterState_rejects_invalid_data)
+	{
+		String buffer = writeState(CharacterState());
+
+		// Newer format version
+		{
+			String newer = buffer;
+			newer[0] = static_cast<char>(CharacterState::Version + 1);
+
+			CharacterState loaded;
+			io::MemorySource source(newer);
+			io::Reader reader(source);
+			BOOST_CHECK(!(reader >> loaded));
+		}
+
+		// Truncated section
+		{
+			String truncated = buffer.substr(0, buffer.size() - 1);
+
+			CharacterState loaded;
+			io::MemorySource source(truncated);
+			io::Reader reader(source);
+			BOOST_CHECK(!(reader >> loaded));
+		}
+	}
+}
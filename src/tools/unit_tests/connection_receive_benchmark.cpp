@@ -0,0 +1,153 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include "common/constants.h"
+#include "network/receive_buffer.h"
+#include "wowpp_protocol/wowpp_connection.h"
+#include "binary_io/string_sink.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Creates a stream of wowpp protocol packets with the given body size.
+		String createPacketStream(size_t packetCount, size_t bodySize)
+		{
+			String stream;
+			io::StringSink sink(stream);
+			const String body(bodySize, 'x');
+			for (size_t i = 0; i < packetCount; ++i)
+			{
+				pp::OutgoingPacket packet(sink);
+				packet.start(static_cast<PacketId>(i % 0x100));
+				packet << io::write_range(body);
+				packet.finish();
+			}
+
+			return stream;
+		}
+
+		/// Counts received packets and their body bytes.
+		struct CountingListener : pp::IConnectionListener
+		{
+			size_t packets = 0;
+			size_t bytes = 0;
+			bool lost = false;
+
+			virtual void connectionLost() override
+			{
+				lost = true;
+			}
+			virtual void connectionMalformedPacket() override
+			{
+				lost = true;
+			}
+			virtual PacketParseResult connectionPacketReceived(pp::IncomingPacket &packet) override
+			{
+				packets++;
+				bytes += packet.getSource()->size();
+				return PacketParseResult::Pass;
+			}
+		};
+
+		/// Sends the stream over a loopback socket to a pp::Connection and returns the elapsed seconds.
+		double receiveOverLoopback(const String &stream, size_t receiveSize, CountingListener &listener)
+		{
+			using boost::asio::ip::tcp;
+
+			boost::asio::io_service service;
+			tcp::acceptor acceptor(service, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+			tcp::socket client(service);
+			client.connect(acceptor.local_endpoint());
+
+			auto connection = pp::Connection::create(service, &listener);
+			acceptor.accept(connection->getSocket());
+			connection->setReceiveSize(receiveSize);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+
+			// The client socket is only used by this thread while the io service runs
+			std::thread writer([&client, &stream]()
+			{
+				boost::asio::write(client, boost::asio::buffer(stream));
+				client.shutdown(tcp::socket::shutdown_send);
+			});
+
+			connection->startReceiving();
+			service.run();
+			writer.join();
+
+			const auto end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<double>(end - start).count();
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(ReceiveBuffer_keeps_pending_data)
+	{
+		ReceiveBuffer buffer(16);
+
+		// Fill a partial packet which has to survive compaction and growth
+		for (size_t round = 0; round < 100; ++round)
+		{
+			char *const writePos = buffer.prepare();
+			BOOST_REQUIRE(buffer.getWritableSize() >= 16);
+			for (size_t i = 0; i < 10; ++i)
+			{
+				writePos[i] = static_cast<char>(round * 10 + i);
+			}
+			buffer.commit(10);
+
+			// Consume less than received, so that there are always pending bytes left
+			buffer.consume(7);
+			BOOST_REQUIRE(buffer.size() == (round + 1) * 3);
+			BOOST_CHECK(buffer.data()[buffer.size() - 1] == static_cast<char>(round * 10 + 9));
+		}
+
+		buffer.consume(buffer.size());
+		BOOST_CHECK(buffer.empty());
+	}
+
+	// Only run on request: unit_tests --run_test=@benchmark
+	BOOST_AUTO_TEST_CASE(Connection_loopback_throughput_benchmark, *boost::unit_test::label("benchmark") * boost::unit_test::disabled())
+	{
+		const size_t packetCount = 200000;
+		const size_t bodySize = 200;
+		const String stream = createPacketStream(packetCount, bodySize);
+
+		for (const size_t receiveSize : { ReceiveBuffer::DefaultReadSize, constants::ServerLinkReceiveSize })
+		{
+			CountingListener listener;
+			const double seconds = receiveOverLoopback(stream, receiveSize, listener);
+
+			BOOST_CHECK(listener.packets == packetCount);
+			BOOST_CHECK(listener.bytes == packetCount * bodySize);
+
+			BOOST_TEST_MESSAGE("Receive size " << receiveSize << ": " << (stream.size() / (1024.0 * 1024.0) / seconds) << " MB/s, "
+				<< (packetCount / seconds) << " packets/s");
+		}
+	}
+}
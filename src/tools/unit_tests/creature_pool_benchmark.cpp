@@ -0,0 +1,135 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include "common/slab_pool.h"
+#include "common/timer_queue.h"
+#include "game/game_creature.h"
+#include "game/creature_ai.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+		/// Spawns creatures, despawns a random half of them a few times and respawns them like
+		/// creature spawners do, then despawns everything. Returns the elapsed milliseconds.
+		template<class Create>
+		double spawnAndDespawn(size_t count, Create create)
+		{
+			std::vector<std::shared_ptr<GameCreature>> creatures(count);
+			std::mt19937 random(12345);
+			std::uniform_int_distribution<size_t> index(0, count - 1);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (auto &creature : creatures)
+			{
+				creature = create();
+			}
+
+			for (size_t round = 0; round < 4; ++round)
+			{
+				for (size_t i = 0; i < count / 2; ++i)
+				{
+					creatures[index(random)].reset();
+				}
+				for (auto &creature : creatures)
+				{
+					if (!creature)
+					{
+						creature = create();
+					}
+				}
+			}
+
+			creatures.clear();
+			return Milliseconds(std::chrono::high_resolution_clock::now() - start).count();
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(SlabPool_reuses_blocks)
+	{
+		SlabPool pool("Test", 4);
+
+		void *first = pool.allocate(24);
+		void *second = pool.allocate(24);
+		BOOST_CHECK(first != second);
+
+		auto stats = pool.getStats();
+		BOOST_CHECK(stats.blockSize >= 24);
+		BOOST_CHECK(stats.usedBlocks == 2);
+		BOOST_CHECK(stats.freeBlocks == 2);
+		BOOST_CHECK(stats.slabCount == 1);
+
+		// Freed blocks are handed out again before new slabs are allocated
+		pool.deallocate(first, 24);
+		BOOST_CHECK(pool.allocate(24) == first);
+
+		// Larger requests don't fit into a block
+		void *large = pool.allocate(stats.blockSize + 1);
+		pool.deallocate(large, stats.blockSize + 1);
+		BOOST_CHECK(pool.getStats().fallbackAllocations == 1);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			pool.allocate(24);
+		}
+		BOOST_CHECK(pool.getStats().slabCount == 2);
+	}
+
+	// Only run on request: unit_tests --run_test=@benchmark
+	BOOST_AUTO_TEST_CASE(Creature_spawn_despawn_benchmark, *boost::unit_test::label("benchmark") * boost::unit_test::disabled())
+	{
+		const size_t creatureCount = 100000;
+
+		proto::Project project;
+		proto::UnitEntry entry;
+		entry.set_id(1);
+
+		boost::asio::io_service service;
+		TimerQueue timers(service);
+
+		SlabPool pool("Benchmark", 64);
+
+		const double defaultTime = spawnAndDespawn(creatureCount, [&]()
+		{
+			return std::make_shared<GameCreature>(project, timers, entry);
+		});
+		const double pooledTime = spawnAndDespawn(creatureCount, [&]()
+		{
+			return allocateShared<GameCreature>(pool, project, timers, entry);
+		});
+
+		const auto stats = pool.getStats();
+		BOOST_CHECK(stats.usedBlocks == 0);
+		BOOST_CHECK(stats.fallbackAllocations == 0);
+
+		BOOST_TEST_MESSAGE("Spawning and despawning " << creatureCount << " creatures: make_shared " << defaultTime
+			<< " ms, slab pool " << pooledTime << " ms (" << (stats.reservedBytes / (1024 * 1024)) << " MB reserved)");
+	}
+}
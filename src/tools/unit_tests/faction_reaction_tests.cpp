@@ -0,0 +1,199 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Hostility check of GameUnit::isHostileTo before the reaction matrix existed.
+		bool legacyIsHostile(const proto::FactionTemplateEntry &from, const proto::FactionTemplateEntry &faction)
+		{
+			if (from.id() == faction.id())
+			{
+				return false;
+			}
+
+			for (int i = 0; i < from.enemies_size(); ++i)
+			{
+				const auto &enemy = from.enemies(i);
+				if (enemy && enemy == faction.faction())
+				{
+					return true;
+				}
+			}
+
+			for (int i = 0; i < from.friends_size(); ++i)
+			{
+				const auto &friendly = from.friends(i);
+				if (friendly && friendly == faction.faction())
+				{
+					return false;
+				}
+			}
+
+			if (from.enemymask() != 0 &&
+				(from.enemymask() & faction.selfmask()) != 0)
+				return true;
+
+			return false;
+		}
+
+		/// Friendliness check of GameUnit::isFriendlyTo before the reaction matrix existed.
+		bool legacyIsFriendly(const proto::FactionTemplateEntry &from, const proto::FactionTemplateEntry &faction)
+		{
+			if (from.id() == faction.id())
+			{
+				return true;
+			}
+
+			for (int i = 0; i < from.enemies_size(); ++i)
+			{
+				const auto &enemy = from.enemies(i);
+				if (enemy && enemy == faction.faction())
+				{
+					return false;
+				}
+			}
+
+			for (int i = 0; i < from.friends_size(); ++i)
+			{
+				const auto &friendly = from.friends(i);
+				if (friendly && friendly == faction.faction())
+				{
+					return true;
+				}
+			}
+
+			return ((from.friendmask() & faction.selfmask()) != 0);
+		}
+
+		void addTemplate(proto::Project &project, UInt32 id, UInt32 faction, UInt32 selfMask, UInt32 friendMask, UInt32 enemyMask,
+			std::initializer_list<UInt32> friends = {}, std::initializer_list<UInt32> enemies = {})
+		{
+			auto &entry = *project.factionTemplates.add(id);
+			entry.set_flags(0);
+			entry.set_faction(faction);
+			entry.set_selfmask(selfMask);
+			entry.set_friendmask(friendMask);
+			entry.set_enemymask(enemyMask);
+			for (const auto &friendly : friends)
+			{
+				entry.add_friends(friendly);
+			}
+			for (const auto &enemy : enemies)
+			{
+				entry.add_enemies(enemy);
+			}
+		}
+
+		/// Adds faction templates which cover the mask checks as well as the friend and enemy lists.
+		void addTemplates(proto::Project &project, UInt32 idStep)
+		{
+			const UInt32 player = 0x01, alliance = 0x02, horde = 0x04, monster = 0x08;
+
+			UInt32 id = 1;
+			// Alliance and horde players
+			addTemplate(project, id, 1, player | alliance, alliance, horde); id += idStep;
+			addTemplate(project, id, 2, player | horde, horde, alliance); id += idStep;
+			// Alliance guard: friend list overrides the enemy mask, enemy list overrides the friend mask
+			addTemplate(project, id, 3, alliance, alliance, horde | monster, { 2 }, { 1 }); id += idStep;
+			// Monsters which are hostile to everyone but themselves
+			addTemplate(project, id, 4, monster, 0, player | alliance | horde); id += idStep;
+			// Another template of the same monster faction
+			addTemplate(project, id, 4, monster, monster, player); id += idStep;
+			// Neutral creature without any masks
+			addTemplate(project, id, 5, 0, 0, 0); id += idStep;
+			// Zero entries in the lists are ignored, a faction in both lists is an enemy
+			addTemplate(project, id, 6, horde, horde, 0, { 0, 4, 5 }, { 0, 5 }); id += idStep;
+			// Enemy mask without self mask of anyone else
+			addTemplate(project, id, 7, 0x10, 0x10, 0x20); id += idStep;
+		}
+
+		void checkAllPairs(const proto::Project &project)
+		{
+			size_t pairs = 0;
+			for (const auto &from : project.factionTemplates.getTemplates().entry())
+			{
+				for (const auto &to : project.factionTemplates.getTemplates().entry())
+				{
+					BOOST_CHECK_MESSAGE(project.factionReactions.isHostile(from, to) == legacyIsHostile(from, to),
+						"hostility of " << from.id() << " towards " << to.id());
+					BOOST_CHECK_MESSAGE(project.factionReactions.isFriendly(from, to) == legacyIsFriendly(from, to),
+						"friendliness of " << from.id() << " towards " << to.id());
+					++pairs;
+				}
+			}
+
+			BOOST_CHECK(pairs == 64);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(FactionReactions_match_legacy_checks)
+	{
+		proto::Project project;
+		addTemplates(project, 1);
+		project.factionReactions.build(project.factionTemplates.getTemplates());
+		BOOST_REQUIRE(project.factionReactions.size() == 8);
+
+		checkAllPairs(project);
+
+		// A few well known reactions
+		const auto &templates = project.factionTemplates;
+		BOOST_CHECK(project.factionReactions.isHostile(*templates.getById(1), *templates.getById(2)));
+		BOOST_CHECK(!project.factionReactions.isHostile(*templates.getById(3), *templates.getById(2)));
+		BOOST_CHECK(!project.factionReactions.isFriendly(*templates.getById(3), *templates.getById(1)));
+		BOOST_CHECK(!project.factionReactions.isHostile(*templates.getById(4), *templates.getById(4)));
+		BOOST_CHECK(project.factionReactions.isFriendly(*templates.getById(5), *templates.getById(4)));
+		BOOST_CHECK(!project.factionReactions.isFriendly(*templates.getById(7), *templates.getById(6)));
+	}
+
+	BOOST_AUTO_TEST_CASE(FactionReactions_fall_back_for_unindexed_templates)
+	{
+		// Sparse ids disable the matrix, so every check falls back to the calculation
+		proto::Project sparse;
+		addTemplates(sparse, 1000);
+		sparse.factionReactions.build(sparse.factionTemplates.getTemplates());
+		BOOST_CHECK(sparse.factionReactions.size() == 0);
+		checkAllPairs(sparse);
+
+		// Templates of another project with the same ids aren't looked up in the matrix
+		proto::Project project;
+		addTemplates(project, 1);
+		project.factionReactions.build(project.factionTemplates.getTemplates());
+
+		proto::Project other;
+		addTemplates(other, 1);
+		other.factionTemplates.getById(1)->set_enemymask(0);
+		for (const auto &from : other.factionTemplates.getTemplates().entry())
+		{
+			for (const auto &to : project.factionTemplates.getTemplates().entry())
+			{
+				BOOST_CHECK(project.factionReactions.isHostile(from, to) == legacyIsHostile(from, to));
+				BOOST_CHECK(project.factionReactions.isFriendly(from, to) == legacyIsFriendly(from, to));
+			}
+		}
+	}
+}
@@ -0,0 +1,63 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/lazy_signal.h"
+
+namespace wowpp
+{
+	BOOST_AUTO_TEST_CASE(LazySignal_allocates_on_first_connect)
+	{
+		LazySignal<void(int)> signal;
+		LazySignal<float()> query;
+
+		// Invoking without connections does nothing and returns an empty result
+		signal(1);
+		BOOST_CHECK(!query());
+		BOOST_CHECK(!signal.isAllocated());
+
+		int sum = 0;
+		simple::connection connection = signal.connect([&sum](int value) { sum += value; });
+		BOOST_CHECK(signal.isAllocated());
+
+		signal(2);
+		BOOST_CHECK(sum == 2);
+
+		// Connections behave like those of simple::signal
+		connection.disconnect();
+		signal(3);
+		BOOST_CHECK(sum == 2);
+
+		{
+			const simple::scoped_connection scoped(query.connect([]() { return 4.0f; }));
+			BOOST_REQUIRE(query());
+			BOOST_CHECK(*query() == 4.0f);
+		}
+		BOOST_CHECK(!query());
+
+		BOOST_TEST_MESSAGE("Unconnected signal: " << sizeof(LazySignal<void(int)>) << " bytes instead of "
+			<< sizeof(simple::signal<void(int)>) << " bytes and two heap allocated list nodes");
+	}
+}
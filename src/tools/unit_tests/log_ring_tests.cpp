@@ -0,0 +1,199 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "log/log_ring.h"
+#include "log/async_log_sink.h"
+#include "log/default_log_levels.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		LogEntry makeEntry(const String &message)
+		{
+			return LogEntry(g_InfoLevel, message, std::chrono::system_clock::now());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(LogRing_keeps_order_of_single_producer)
+	{
+		LogRing ring(16);
+		BOOST_CHECK(ring.getCapacity() == 16);
+
+		// Wrap around the ring a few times
+		size_t next = 0;
+		for (size_t round = 0; round < 5; ++round)
+		{
+			for (size_t i = 0; i < 10; ++i)
+			{
+				BOOST_REQUIRE(ring.tryPush(makeEntry(std::to_string(round * 10 + i))));
+			}
+
+			LogEntry entry;
+			while (ring.tryPop(entry))
+			{
+				BOOST_CHECK_EQUAL(entry.message, std::to_string(next));
+				BOOST_CHECK(entry.level == &g_InfoLevel);
+				++next;
+			}
+		}
+
+		BOOST_CHECK(next == 50);
+		BOOST_CHECK(ring.getDroppedCount() == 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(LogRing_drops_entries_when_full)
+	{
+		LogRing ring(4);
+		for (size_t i = 0; i < 4; ++i)
+		{
+			BOOST_REQUIRE(ring.tryPush(makeEntry(std::to_string(i))));
+		}
+
+		BOOST_CHECK(!ring.tryPush(makeEntry("4")));
+		BOOST_CHECK(!ring.tryPush(makeEntry("5")));
+		BOOST_CHECK(ring.getDroppedCount() == 2);
+
+		// Popping an entry makes room for exactly one more
+		LogEntry entry;
+		BOOST_REQUIRE(ring.tryPop(entry));
+		BOOST_CHECK_EQUAL(entry.message, "0");
+		BOOST_CHECK(ring.tryPush(makeEntry("6")));
+		BOOST_CHECK(!ring.tryPush(makeEntry("7")));
+		BOOST_CHECK(ring.getDroppedCount() == 3);
+
+		std::vector<String> remaining;
+		while (ring.tryPop(entry))
+		{
+			remaining.push_back(entry.message);
+		}
+
+		const std::vector<String> expected = { "1", "2", "3", "6" };
+		BOOST_CHECK_EQUAL_COLLECTIONS(remaining.begin(), remaining.end(), expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(LogRing_multiple_producers_lose_nothing)
+	{
+		const size_t producerCount = 4;
+		const size_t entriesPerProducer = 20000;
+
+		// Small ring, so that producers regularly find it full while the consumer runs
+		LogRing ring(256);
+
+		std::vector<std::thread> producers;
+		for (size_t p = 0; p < producerCount; ++p)
+		{
+			producers.emplace_back([&ring, p, entriesPerProducer]()
+			{
+				for (size_t i = 0; i < entriesPerProducer; ++i)
+				{
+					const String message = std::to_string(p) + ":" + std::to_string(i);
+					while (!ring.tryPush(makeEntry(message)))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		// Entries of one producer have to arrive in the order they were pushed
+		std::vector<size_t> nextIndex(producerCount, 0);
+		size_t received = 0;
+		LogEntry entry;
+		while (received < producerCount * entriesPerProducer)
+		{
+			if (!ring.tryPop(entry))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			const size_t separator = entry.message.find(':');
+			BOOST_REQUIRE(separator != String::npos);
+
+			const size_t producer = std::stoul(entry.message.substr(0, separator));
+			const size_t index = std::stoul(entry.message.substr(separator + 1));
+			BOOST_REQUIRE(producer < producerCount);
+			BOOST_REQUIRE_EQUAL(index, nextIndex[producer]);
+
+			++nextIndex[producer];
+			++received;
+		}
+
+		for (auto &producer : producers)
+		{
+			producer.join();
+		}
+
+		// Nothing left over, and every producer delivered all of its entries
+		BOOST_CHECK(!ring.tryPop(entry));
+		for (size_t p = 0; p < producerCount; ++p)
+		{
+			BOOST_CHECK_EQUAL(nextIndex[p], entriesPerProducer);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(AsyncLogSink_drains_on_flush)
+	{
+		std::vector<String> handled;
+		AsyncLogSink sink([&handled](const LogEntry &entry)
+		{
+			handled.push_back(entry.message);
+		});
+
+		for (size_t i = 0; i < 1000; ++i)
+		{
+			BOOST_REQUIRE(sink.push(makeEntry(std::to_string(i))));
+		}
+
+		sink.flush();
+
+		BOOST_REQUIRE(handled.size() == 1000);
+		for (size_t i = 0; i < handled.size(); ++i)
+		{
+			BOOST_CHECK_EQUAL(handled[i], std::to_string(i));
+		}
+		BOOST_CHECK(sink.getDroppedCount() == 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(AsyncLogSink_drains_on_destruction)
+	{
+		std::vector<String> handled;
+		{
+			AsyncLogSink sink([&handled](const LogEntry &entry)
+			{
+				handled.push_back(entry.message);
+			});
+
+			for (size_t i = 0; i < 1000; ++i)
+			{
+				BOOST_REQUIRE(sink.push(makeEntry(std::to_string(i))));
+			}
+		}
+
+		BOOST_REQUIRE(handled.size() == 1000);
+		BOOST_CHECK_EQUAL(handled.front(), "0");
+		BOOST_CHECK_EQUAL(handled.back(), "999");
+	}
+}
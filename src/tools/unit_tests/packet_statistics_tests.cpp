@@ -0,0 +1,128 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "network/packet_statistics.h"
+#include "servers/realm/realm_packet_statistics.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		String toJson(const PacketStatistics &statistics)
+		{
+			std::ostringstream strm;
+			statistics.writeJson(strm);
+			return strm.str();
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(PacketStatistics_counts_packets_per_opcode)
+	{
+		PacketStatistics statistics(4);
+		BOOST_CHECK(!statistics.isEnabled());
+		BOOST_CHECK_EQUAL(toJson(statistics), "{\"enabled\":false,\"opcodes\":[]}");
+
+		statistics.setEnabled(true);
+		statistics.addPacket(1, 10);
+		statistics.addPacket(1, 20);
+		statistics.addPacket(2, 5);
+		// Opcodes out of range are counted as the last opcode
+		statistics.addPacket(3, 1);
+		statistics.addPacket(1000, 2);
+
+		BOOST_CHECK_EQUAL(toJson(statistics),
+			"{\"enabled\":true,\"opcodes\":["
+			"{\"opcode\":1,\"count\":2,\"bytes\":30,\"handlerMicroseconds\":0,\"handlerTimes\":[0,0,0,0,0,0]},"
+			"{\"opcode\":2,\"count\":1,\"bytes\":5,\"handlerMicroseconds\":0,\"handlerTimes\":[0,0,0,0,0,0]},"
+			"{\"opcode\":3,\"count\":2,\"bytes\":3,\"handlerMicroseconds\":0,\"handlerTimes\":[0,0,0,0,0,0]}"
+			"]}");
+
+		// Reset keeps the enabled state
+		statistics.reset();
+		BOOST_CHECK(statistics.isEnabled());
+		BOOST_CHECK_EQUAL(toJson(statistics), "{\"enabled\":true,\"opcodes\":[]}");
+	}
+
+	BOOST_AUTO_TEST_CASE(PacketStatistics_handler_time_buckets)
+	{
+		typedef std::chrono::microseconds us;
+
+		PacketStatistics statistics(2);
+		statistics.addPacket(1, 4);
+
+		// Bucket i counts handler calls below 10^(i+1) microseconds, the last one everything slower
+		const UInt64 durations[] = { 0, 9, 10, 99, 100, 999, 1000, 10000, 99999, 100000, 1000000, 60000000 };
+		UInt64 total = 0;
+		for (const auto duration : durations)
+		{
+			statistics.addHandlerTime(1, us(duration));
+			total += duration;
+		}
+
+		std::ostringstream expected;
+		expected
+			<< "{\"enabled\":false,\"opcodes\":["
+			<< "{\"opcode\":1,\"count\":1,\"bytes\":4,\"handlerMicroseconds\":" << total
+			<< ",\"handlerTimes\":[2,2,2,1,2,3]}"
+			<< "]}";
+		BOOST_CHECK_EQUAL(toJson(statistics), expected.str());
+
+		// Sub microsecond handler times are counted as zero
+		PacketStatistics fast(2);
+		fast.addPacket(0, 1);
+		fast.addHandlerTime(0, std::chrono::nanoseconds(999));
+		BOOST_CHECK_EQUAL(toJson(fast),
+			"{\"enabled\":false,\"opcodes\":["
+			"{\"opcode\":0,\"count\":1,\"bytes\":1,\"handlerMicroseconds\":0,\"handlerTimes\":[1,0,0,0,0,0]}"
+			"]}");
+	}
+
+	BOOST_AUTO_TEST_CASE(RealmPacketStatistics_json)
+	{
+		RealmPacketStatistics statistics;
+		statistics.setEnabled(true);
+		BOOST_CHECK(statistics.clientReceived.isEnabled() && statistics.clientSent.isEnabled());
+		BOOST_CHECK(statistics.worldReceived.isEnabled() && statistics.worldSent.isEnabled());
+
+		statistics.clientReceived.addPacket(0x1DC, 12);
+		statistics.worldSent.addPacket(0x02, 8);
+
+		std::ostringstream strm;
+		statistics.writeJson(strm);
+		BOOST_CHECK_EQUAL(strm.str(),
+			"{\"client\":{"
+			"\"received\":{\"enabled\":true,\"opcodes\":[{\"opcode\":476,\"count\":1,\"bytes\":12,\"handlerMicroseconds\":0,\"handlerTimes\":[0,0,0,0,0,0]}]},"
+			"\"sent\":{\"enabled\":true,\"opcodes\":[]}},"
+			"\"world\":{"
+			"\"received\":{\"enabled\":true,\"opcodes\":[]},"
+			"\"sent\":{\"enabled\":true,\"opcodes\":[{\"opcode\":2,\"count\":1,\"bytes\":8,\"handlerMicroseconds\":0,\"handlerTimes\":[0,0,0,0,0,0]}]}}}");
+
+		statistics.reset();
+		statistics.setEnabled(false);
+		strm.str("");
+		statistics.writeJson(strm);
+		BOOST_CHECK(strm.str().find("\"count\"") == String::npos);
+		BOOST_CHECK(!statistics.clientReceived.isEnabled());
+	}
+}
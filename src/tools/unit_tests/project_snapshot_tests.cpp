@@ -0,0 +1,79 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/timer_queue.h"
+#include "game/project_snapshots.h"
+#include "game/aura_spell_slot.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	BOOST_AUTO_TEST_CASE(ProjectSnapshots_keep_retired_snapshot_while_aura_is_active)
+	{
+		// An empty data project is enough, the spell entry is added after loading
+		const auto dataPath = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("wowpp-snapshots-%%%%%%%%");
+		{
+			// The project is saved into the wowpp subdirectory which has to exist
+			BOOST_REQUIRE(boost::filesystem::create_directories(dataPath / "wowpp"));
+
+			proto::Project empty;
+			BOOST_REQUIRE(empty.save(dataPath.string()));
+		}
+
+		boost::asio::io_service ioService;
+		TimerQueue timers(ioService);
+		ProjectSnapshots snapshots(ioService);
+		BOOST_REQUIRE(snapshots.loadInitial(dataPath.string()));
+
+		auto &oldProject = snapshots.getCurrent().project;
+		auto *spell = oldProject.spells.add(1);
+		BOOST_REQUIRE(spell);
+
+		auto aura = std::make_shared<AuraSpellSlot>(timers, oldProject, *spell);
+
+		// The new snapshot is activated on the io service thread
+		BOOST_REQUIRE(snapshots.beginReload(dataPath.string()));
+		while (snapshots.isReloading())
+		{
+			ioService.poll();
+			ioService.reset();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		BOOST_REQUIRE(&snapshots.getCurrent().project != &oldProject);
+		BOOST_CHECK(snapshots.getRetiredCount() == 1);
+
+		// The aura still uses the spell entry of the retired snapshot
+		BOOST_CHECK(snapshots.collectRetired() == 0);
+		BOOST_CHECK(snapshots.getRetiredCount() == 1);
+		BOOST_CHECK(aura->getSpell().id() == 1);
+
+		aura.reset();
+		BOOST_CHECK(snapshots.collectRetired() == 1);
+		BOOST_CHECK(snapshots.getRetiredCount() == 0);
+
+		boost::filesystem::remove_all(dataPath);
+	}
+}
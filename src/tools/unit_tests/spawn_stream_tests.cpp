@@ -0,0 +1,309 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/timer_queue.h"
+#include "common/id_generator.h"
+#include "proto_data/project.h"
+#include "game/universe.h"
+#include "game/trigger_handler.h"
+#include "game/world_instance_manager.h"
+#include "game/world_instance.h"
+#include "game/game_character.h"
+#include "game/spawn_stream.h"
+#include "game/visibility_tile.h"
+#include "game/each_tile_in_sight.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Triggers aren't used by these tests.
+		struct NullTriggerHandler final : game::ITriggerHandler
+		{
+			void executeTrigger(const proto::TriggerEntry &entry, game::TriggerContext context, UInt32 actionOffset, bool ignoreProbability) override
+			{
+			}
+		};
+
+		/// A world instance of an empty map without any spawns.
+		struct TestWorld final
+		{
+			boost::asio::io_service ioService;
+			TimerQueue timers;
+			proto::Project project;
+			Universe universe;
+			NullTriggerHandler triggerHandler;
+			IdGenerator<UInt32> instanceIdGenerator;
+			IdGenerator<UInt64> objectIdGenerator;
+			WorldInstanceManager manager;
+			WorldInstance *instance;
+			std::vector<std::shared_ptr<GameCharacter>> objects;
+
+			TestWorld()
+				: timers(ioService)
+				, universe(ioService, timers)
+				, objectIdGenerator(0x01)
+				, manager(ioService, universe, triggerHandler, instanceIdGenerator, objectIdGenerator, project, 0, "")
+				, instance(nullptr)
+			{
+				manager.stopUpdates();
+
+				// Data required to initialize characters
+				auto *factionTemplate = project.factionTemplates.add(1);
+				factionTemplate->set_flags(0);
+				factionTemplate->set_faction(1);
+				project.races.add(1)->set_faction(1);
+				project.classes.add(1);
+
+				const auto *map = project.maps.add(0);
+				instance = manager.createInstance(*map);
+				BOOST_REQUIRE(instance);
+			}
+
+			~TestWorld()
+			{
+				for (auto &object : objects)
+				{
+					instance->removeGameObject(*object);
+				}
+			}
+
+			std::shared_ptr<GameCharacter> createCharacter(const math::Vector3 &location)
+			{
+				auto character = std::make_shared<GameCharacter>(project, timers);
+				character->initialize();
+				character->setGuid(createRealmGUID(objectIdGenerator.generateId(), 0, guid_type::Player));
+				character->relocate(location, 0.0f);
+				return character;
+			}
+
+			/// Spawns a character at the given location.
+			GameCharacter &addObject(const math::Vector3 &location)
+			{
+				auto character = createCharacter(location);
+				instance->addGameObject(*character);
+				objects.push_back(character);
+				return *character;
+			}
+
+			VisibilityTile &getTile(const math::Vector3 &location)
+			{
+				TileIndex2D index;
+				BOOST_REQUIRE(instance->getGrid().getTilePosition(location, index[0], index[1]));
+				return instance->getGrid().requireTile(index);
+			}
+		};
+
+		/// Records the packets it receives and streams spawns through its own spawn stream.
+		struct StubSubscriber final : ITileSubscriber
+		{
+			std::shared_ptr<GameCharacter> character;
+			std::vector<UInt16> opCodes;
+			SpawnStream stream;
+
+			explicit StubSubscriber(TestWorld &world, const math::Vector3 &location)
+				: character(world.createCharacter(location))
+				, stream(*world.instance, *this)
+			{
+				// The subscriber itself isn't spawned, so that it doesn't appear in other streams
+				character->setWorldInstance(world.instance);
+			}
+
+			bool isIgnored(UInt64 guid) const override
+			{
+				return false;
+			}
+			UInt32 convertTimestamp(UInt32 otherTimestamp, UInt32 otherTicks) const override
+			{
+				return otherTimestamp;
+			}
+			GameCharacter *getControlledObject() override
+			{
+				return character.get();
+			}
+			void sendPacket(game::Protocol::OutgoingPacket &packet, const std::vector<char> &buffer) override
+			{
+				opCodes.push_back(packet.getOpCode());
+			}
+			bool isSpawnPending(UInt64 guid) const override
+			{
+				return stream.isPending(guid);
+			}
+
+			size_t countPackets(UInt16 opCode) const
+			{
+				return static_cast<size_t>(std::count(opCodes.begin(), opCodes.end(), opCode));
+			}
+		};
+
+		/// Lets a send build exactly one create block, as the first block uses up all bytes.
+		SpawnStreamBudget oneObjectBudget()
+		{
+			return SpawnStreamBudget(1, std::chrono::seconds(60));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(SpawnStream_sends_nearest_first_within_budget)
+	{
+		TestWorld world;
+		StubSubscriber subscriber(world, math::Vector3(0.0f, 0.0f, 0.0f));
+
+		auto &far = world.addObject(math::Vector3(-20.0f, 0.0f, 0.0f));
+		auto &near = world.addObject(math::Vector3(-5.0f, 0.0f, 0.0f));
+		auto &middle = world.addObject(math::Vector3(-12.0f, 0.0f, 0.0f));
+
+		subscriber.stream.queueTile(world.getTile(subscriber.character->getLocation()));
+		BOOST_CHECK(!subscriber.stream.isEmpty());
+		BOOST_CHECK(subscriber.isSpawnPending(far.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(near.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(middle.getGuid()));
+
+		auto budget = oneObjectBudget();
+		subscriber.stream.send(budget);
+		BOOST_CHECK(budget.isExhausted());
+		BOOST_CHECK(subscriber.countPackets(game::server_packet::CompressedUpdateObject) == 1);
+		BOOST_CHECK(!subscriber.isSpawnPending(near.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(middle.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(far.getGuid()));
+
+		// An exhausted budget doesn't send anything
+		subscriber.stream.send(budget);
+		BOOST_CHECK(subscriber.countPackets(game::server_packet::CompressedUpdateObject) == 1);
+		BOOST_CHECK(subscriber.isSpawnPending(middle.getGuid()));
+
+		budget = oneObjectBudget();
+		subscriber.stream.send(budget);
+		BOOST_CHECK(!subscriber.isSpawnPending(middle.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(far.getGuid()));
+
+		budget = oneObjectBudget();
+		subscriber.stream.send(budget);
+		BOOST_CHECK(!subscriber.isSpawnPending(far.getGuid()));
+		BOOST_CHECK(subscriber.stream.isEmpty());
+		BOOST_CHECK(subscriber.countPackets(game::server_packet::CompressedUpdateObject) == 3);
+	}
+
+	BOOST_AUTO_TEST_CASE(SpawnStream_queues_objects_once_when_crossing_tiles)
+	{
+		TestWorld world;
+		StubSubscriber subscriber(world, math::Vector3(0.0f, 0.0f, 0.0f));
+
+		const math::Vector3 farLocation(-200.0f, 0.0f, 0.0f);
+		auto &first = world.addObject(math::Vector3(-5.0f, 0.0f, 0.0f));
+		auto &second = world.addObject(math::Vector3(-10.0f, 0.0f, 0.0f));
+		auto &distant = world.addObject(farLocation);
+
+		auto &tileA = world.getTile(subscriber.character->getLocation());
+		auto &tileB = world.getTile(farLocation);
+		BOOST_REQUIRE(&tileA != &tileB);
+
+		// Cross from A to B and back again before anything has been sent
+		subscriber.stream.queueTile(tileA);
+		subscriber.stream.queueTile(tileA);
+		subscriber.stream.changeTile(tileA, tileB);
+		subscriber.stream.changeTile(tileB, tileA);
+		BOOST_CHECK(subscriber.isSpawnPending(first.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(second.getGuid()));
+		BOOST_CHECK(subscriber.isSpawnPending(distant.getGuid()));
+
+		// Objects which were never sent are not destroyed
+		BOOST_CHECK(subscriber.countPackets(game::server_packet::DestroyObject) == 0);
+
+		for (size_t i = 0; i < 10 && !subscriber.stream.isEmpty(); ++i)
+		{
+			auto budget = oneObjectBudget();
+			subscriber.stream.send(budget);
+		}
+
+		// Every object in sight is sent exactly once, the distant one is out of sight again
+		BOOST_CHECK(subscriber.stream.isEmpty());
+		BOOST_CHECK(subscriber.countPackets(game::server_packet::CompressedUpdateObject) == 2);
+		BOOST_CHECK(!subscriber.isSpawnPending(distant.getGuid()));
+	}
+
+	BOOST_AUTO_TEST_CASE(SpawnStream_instance_rotates_between_streams)
+	{
+		TestWorld world;
+		world.instance->setSpawnStreamBudget(1, std::chrono::seconds(60));
+
+		StubSubscriber first(world, math::Vector3(0.0f, 0.0f, 0.0f));
+		StubSubscriber second(world, math::Vector3(0.0f, 0.0f, 0.0f));
+		for (UInt32 i = 0; i < 3; ++i)
+		{
+			world.addObject(math::Vector3(-5.0f - i, 0.0f, 0.0f));
+		}
+
+		auto &tile = world.getTile(first.character->getLocation());
+		first.stream.queueTile(tile);
+		second.stream.queueTile(tile);
+
+		// Every update the budget is enough for one object, and the streams take turns
+		for (size_t update = 1; update <= 6; ++update)
+		{
+			world.instance->update();
+
+			const size_t firstCount = first.countPackets(game::server_packet::CompressedUpdateObject);
+			const size_t secondCount = second.countPackets(game::server_packet::CompressedUpdateObject);
+			BOOST_CHECK_EQUAL(firstCount + secondCount, update);
+			BOOST_CHECK(firstCount >= secondCount && firstCount - secondCount <= 1);
+		}
+
+		BOOST_CHECK(first.stream.isEmpty());
+		BOOST_CHECK(second.stream.isEmpty());
+
+		// Finished streams don't send anything anymore
+		world.instance->update();
+		BOOST_CHECK(first.countPackets(game::server_packet::CompressedUpdateObject) == 3);
+		BOOST_CHECK(second.countPackets(game::server_packet::CompressedUpdateObject) == 3);
+	}
+
+	BOOST_AUTO_TEST_CASE(SpawnStream_broadcasts_skip_pending_objects)
+	{
+		TestWorld world;
+		StubSubscriber subscriber(world, math::Vector3(0.0f, 0.0f, 0.0f));
+		auto &known = world.addObject(math::Vector3(-5.0f, 0.0f, 0.0f));
+		auto &pending = world.addObject(math::Vector3(-10.0f, 0.0f, 0.0f));
+
+		auto &tile = world.getTile(subscriber.character->getLocation());
+		tile.getWatchers().add(&subscriber);
+		subscriber.stream.queueTile(tile);
+
+		// Only the nearest object is sent, the other one is still pending
+		auto budget = oneObjectBudget();
+		subscriber.stream.send(budget);
+		BOOST_REQUIRE(!subscriber.isSpawnPending(known.getGuid()));
+		BOOST_REQUIRE(subscriber.isSpawnPending(pending.getGuid()));
+
+		TileIndex2D center;
+		BOOST_REQUIRE(world.instance->getGrid().getTilePosition(subscriber.character->getLocation(), center[0], center[1]));
+
+		size_t knownCalls = 0, pendingCalls = 0;
+		forEachSubscriberInSightOf(world.instance->getGrid(), center, known.getGuid(), [&knownCalls](ITileSubscriber &) { ++knownCalls; });
+		forEachSubscriberInSightOf(world.instance->getGrid(), center, pending.getGuid(), [&pendingCalls](ITileSubscriber &) { ++pendingCalls; });
+		BOOST_CHECK_EQUAL(knownCalls, 1);
+		BOOST_CHECK_EQUAL(pendingCalls, 0);
+
+		tile.getWatchers().remove(&subscriber);
+	}
+}
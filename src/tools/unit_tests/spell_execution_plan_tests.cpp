@@ -0,0 +1,187 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "game/spell_execution_plan.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		namespace se = game::spell_effects;
+
+		/// Effect type order of the instant effect map which was built by every cast.
+		const UInt32 legacyInstantOrder[] = {
+			se::Charge
+		};
+
+		/// Effect type order of the delayed effect map which was built by every cast.
+		const UInt32 legacyDelayedOrder[] = {
+			se::Dummy, se::InstantKill, se::PowerDrain, se::Heal, se::Bind, se::QuestComplete,
+			se::Proficiency, se::AddComboPoints, se::Duel, se::WeaponDamageNoSchool, se::CreateItem,
+			se::WeaponDamage, se::TeleportUnits, se::TriggerSpell, se::Energize, se::WeaponPercentDamage,
+			se::PowerBurn, se::OpenLock, se::OpenLockItem, se::ApplyAreaAuraParty, se::Dispel, se::Summon,
+			se::SummonPet, se::ScriptEffect, se::AttackMe, se::NormalizedWeaponDmg, se::StealBeneficialBuff,
+			se::InterruptCast, se::LearnSpell, se::ScriptEffect, se::DispelMechanic, se::Resurrect,
+			se::ResurrectNew, se::KnockBack, se::TransDoor,
+			se::ApplyAura, se::PersistentAreaAura, se::ApplyAreaAuraParty, se::SchoolDamage
+		};
+
+		/// Walks the effects of a spell like SingleCastState did on every cast before plans existed.
+		template<size_t N>
+		std::vector<const proto::SpellEffect *> walkLegacyEffects(const proto::SpellEntry &spell, const UInt32 (&order)[N])
+		{
+			std::vector<const proto::SpellEffect *> effects;
+			for (const auto type : order)
+			{
+				for (int k = 0; k < spell.effects_size(); ++k)
+				{
+					if (spell.effects(k).type() == type)
+					{
+						effects.push_back(&spell.effects(k));
+					}
+				}
+			}
+
+			return effects;
+		}
+
+		std::vector<const proto::SpellEffect *> getPlanEffects(const SpellExecutionPlan::EffectSteps &steps)
+		{
+			std::vector<const proto::SpellEffect *> effects;
+			for (const auto &step : steps)
+			{
+				BOOST_CHECK(step.handler != nullptr);
+				effects.push_back(step.effect);
+			}
+
+			return effects;
+		}
+
+		proto::SpellEntry &addSpell(proto::Project &project, UInt32 id, std::initializer_list<UInt32> effectTypes, UInt32 category = 0)
+		{
+			auto &spell = *project.spells.add(id);
+			for (UInt32 i = 0; i < 4; ++i)
+			{
+				spell.add_attributes(0);
+			}
+
+			UInt32 index = 0;
+			for (const auto type : effectTypes)
+			{
+				auto &effect = *spell.add_effects();
+				effect.set_index(index++);
+				effect.set_type(type);
+			}
+
+			spell.set_category(category);
+			return spell;
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(SpellExecutionPlan_matches_legacy_effect_walk)
+	{
+		proto::Project project;
+
+		// Effects in an order which differs from the execution order, including effects which
+		// appear twice in the delayed map and an effect without any handler
+		addSpell(project, 1, { se::SchoolDamage, se::Charge, se::ApplyAura, se::Dummy });
+		addSpell(project, 2, { se::ApplyAreaAuraParty, se::ScriptEffect, se::Heal });
+		addSpell(project, 3, { se::ApplyAura, se::ApplyAura, se::TriggerSpell });
+		addSpell(project, 4, { });
+		addSpell(project, 5, { se::Charge, se::Charge });
+
+		SpellExecutionPlans plans;
+		plans.compile(project);
+		BOOST_REQUIRE(plans.size() == 5);
+
+		for (const auto &spell : project.spells.getTemplates().entry())
+		{
+			const auto *plan = plans.getById(spell.id());
+			BOOST_REQUIRE(plan);
+			BOOST_CHECK(plan->spell == &spell);
+
+			const auto instant = getPlanEffects(plan->instantEffects);
+			const auto legacyInstant = walkLegacyEffects(spell, legacyInstantOrder);
+			BOOST_CHECK_EQUAL_COLLECTIONS(instant.begin(), instant.end(), legacyInstant.begin(), legacyInstant.end());
+
+			const auto delayed = getPlanEffects(plan->delayedEffects);
+			const auto legacyDelayed = walkLegacyEffects(spell, legacyDelayedOrder);
+			BOOST_CHECK_EQUAL_COLLECTIONS(delayed.begin(), delayed.end(), legacyDelayed.begin(), legacyDelayed.end());
+
+			BOOST_CHECK(plan->hasChargeEffect == !legacyInstant.empty());
+		}
+
+		// Effects which appear twice in the delayed map are executed twice
+		BOOST_CHECK(plans.getById(2)->delayedEffects.size() == 5);
+		BOOST_CHECK(plans.getById(5)->instantEffects.size() == 2);
+		BOOST_CHECK(plans.getById(4)->instantEffects.empty() && plans.getById(4)->delayedEffects.empty());
+	}
+
+	BOOST_AUTO_TEST_CASE(SpellExecutionPlan_category_cooldown_spells)
+	{
+		proto::Project project;
+
+		auto &category = *project.spellCategories.add(7);
+		category.add_spells(10);
+		category.add_spells(11);
+		category.add_spells(12);
+
+		addSpell(project, 10, { se::Dummy }, 7);
+		addSpell(project, 11, { se::Dummy }, 7);
+		addSpell(project, 12, { se::Dummy }, 7);
+		addSpell(project, 13, { se::Dummy });
+		// Category which doesn't exist
+		addSpell(project, 14, { se::Dummy }, 8);
+
+		SpellExecutionPlans plans;
+		plans.compile(project);
+
+		for (const auto &spell : project.spells.getTemplates().entry())
+		{
+			// Spells which had their cooldown set by the old per cast category lookup
+			std::vector<UInt32> legacySpells;
+			const auto *cat = spell.category() ? project.spellCategories.getById(spell.category()) : nullptr;
+			if (cat)
+			{
+				for (const auto &spellId : cat->spells())
+				{
+					if (spellId != spell.id())
+					{
+						legacySpells.push_back(spellId);
+					}
+				}
+			}
+
+			const auto *plan = plans.getById(spell.id());
+			BOOST_REQUIRE(plan);
+			BOOST_CHECK_EQUAL_COLLECTIONS(plan->categorySpells.begin(), plan->categorySpells.end(), legacySpells.begin(), legacySpells.end());
+		}
+
+		const std::vector<UInt32> expected = { 10, 12 };
+		BOOST_CHECK_EQUAL_COLLECTIONS(plans.getById(11)->categorySpells.begin(), plans.getById(11)->categorySpells.end(), expected.begin(), expected.end());
+		BOOST_CHECK(plans.getById(13)->categorySpells.empty());
+		BOOST_CHECK(plans.getById(14)->categorySpells.empty());
+	}
+}
@@ -0,0 +1,163 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Creates a random lookup sequence from the ids of a manager. About one in eight
+		/// lookups uses an id which does not exist.
+		template<class Manager>
+		std::vector<UInt32> createLookups(const Manager &manager, size_t count)
+		{
+			std::vector<UInt32> ids;
+			for (const auto &entry : manager.getTemplates().entry())
+			{
+				ids.push_back(entry.id());
+			}
+
+			std::vector<UInt32> lookups;
+			if (ids.empty())
+			{
+				return lookups;
+			}
+
+			std::mt19937 random(12345);
+			std::uniform_int_distribution<size_t> index(0, ids.size() - 1);
+			lookups.reserve(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				lookups.push_back((i % 8 == 7) ? ids[index(random)] + 0x100000 : ids[index(random)]);
+			}
+
+			return lookups;
+		}
+
+		/// Compares lookup throughput of a managers index against a std::map with the same entries.
+		template<class Manager>
+		void benchmarkManager(const String &name, const Manager &manager)
+		{
+			typedef typename Manager::EntryType EntryType;
+
+			const auto lookups = createLookups(manager, 1000000);
+			if (lookups.empty())
+			{
+				return;
+			}
+
+			std::map<UInt32, const EntryType *> baseline;
+			for (const auto &entry : manager.getTemplates().entry())
+			{
+				baseline[entry.id()] = &entry;
+			}
+
+			size_t mapHits = 0;
+			auto start = std::chrono::high_resolution_clock::now();
+			for (const auto id : lookups)
+			{
+				const auto it = baseline.find(id);
+				mapHits += (it != baseline.end() && it->second) ? 1 : 0;
+			}
+			const double mapSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+			size_t indexHits = 0;
+			start = std::chrono::high_resolution_clock::now();
+			for (const auto id : lookups)
+			{
+				indexHits += manager.getById(id) ? 1 : 0;
+			}
+			const double indexSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+			const char *layout = manager.getIndexLayout() == proto::template_index_layout::Dense ? "dense" : "sorted";
+			BOOST_TEST_MESSAGE(name << " (" << baseline.size() << " entries, " << layout << "): map " <<
+			                   (lookups.size() / mapSeconds / 1000000.0) << " M/s, index " <<
+			                   (lookups.size() / indexSeconds / 1000000.0) << " M/s");
+
+			BOOST_CHECK(mapHits == indexHits);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(TemplateIndex_layout_test)
+	{
+		proto::SpellManager dense;
+		for (UInt32 id = 1; id <= 1000; ++id)
+		{
+			dense.add(id);
+		}
+		BOOST_CHECK(dense.getIndexLayout() == proto::template_index_layout::Dense);
+		BOOST_CHECK(dense.getById(0) == nullptr);
+		BOOST_CHECK(dense.getById(500) && dense.getById(500)->id() == 500);
+		BOOST_CHECK(dense.getById(1001) == nullptr);
+
+		dense.remove(500);
+		BOOST_CHECK(dense.getById(500) == nullptr);
+		BOOST_CHECK(dense.getById(501) && dense.getById(501)->id() == 501);
+
+		// A far away id makes the id space sparse
+		dense.add(10000000);
+		BOOST_CHECK(dense.getIndexLayout() == proto::template_index_layout::Sorted);
+		BOOST_CHECK(dense.getById(10000000) && dense.getById(10000000)->id() == 10000000);
+		BOOST_CHECK(dense.getById(1) && dense.getById(1)->id() == 1);
+		BOOST_CHECK(dense.getById(500) == nullptr);
+		BOOST_CHECK(dense.add(1) == nullptr);
+	}
+
+	// Only run on request: unit_tests --run_test=@benchmark
+	BOOST_AUTO_TEST_CASE(TemplateIndex_lookup_benchmark, *boost::unit_test::label("benchmark") * boost::unit_test::disabled())
+	{
+		// Uses the real data set if available, otherwise synthetic id spaces
+		const char *dataPath = std::getenv("WOWPP_DATA_PATH");
+		if (dataPath)
+		{
+			proto::Project project;
+			BOOST_REQUIRE(project.load(dataPath));
+
+			benchmarkManager("spells", project.spells);
+			benchmarkManager("items", project.items);
+			benchmarkManager("units", project.units);
+			benchmarkManager("faction_templates", project.factionTemplates);
+			benchmarkManager("skills", project.skills);
+			return;
+		}
+
+		proto::SpellManager compact;
+		for (UInt32 id = 1; id <= 40000; id += 2)
+		{
+			compact.add(id);
+		}
+		benchmarkManager("compact", compact);
+
+		std::mt19937 random(54321);
+		proto::SpellManager sparse;
+		for (size_t i = 0; i < 20000; ++i)
+		{
+			sparse.add(random());
+		}
+		benchmarkManager("sparse", sparse);
+	}
+}
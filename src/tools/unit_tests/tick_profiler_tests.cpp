@@ -0,0 +1,91 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/tick_profiler.h"
+
+namespace wowpp
+{
+	BOOST_AUTO_TEST_CASE(RollingHistogram_keeps_recent_samples)
+	{
+		RollingHistogram histogram(4);
+		BOOST_CHECK(histogram.getSampleCount() == 0);
+		BOOST_CHECK(histogram.getPercentile(50) == 0);
+
+		for (UInt32 sample : { 100, 200, 300, 400, 500, 600 })
+		{
+			histogram.add(sample);
+		}
+
+		// Only the last four samples are kept
+		BOOST_CHECK(histogram.getSampleCount() == 4);
+		BOOST_CHECK(histogram.getMax() == 600);
+		BOOST_CHECK(histogram.getMean() == 450);
+		BOOST_CHECK(histogram.getPercentile(0) == 300);
+		BOOST_CHECK(histogram.getPercentile(99) == 600);
+	}
+
+	BOOST_AUTO_TEST_CASE(TickProfiler_accounts_nested_zones_exclusively)
+	{
+		TickProfiler profiler(1000000);
+		TickProfiler::setActive(&profiler);
+
+		// Zone time between ticks is accounted to the next tick
+		{
+			TickProfileScope timers(tick_zone::Timers);
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+
+		profiler.beginTick();
+		{
+			TickProfileScope updates(tick_zone::ObjectUpdates);
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			{
+				TickProfileScope sends(tick_zone::ProxySends);
+				std::this_thread::sleep_for(std::chrono::milliseconds(4));
+			}
+		}
+		profiler.endTick();
+		TickProfiler::setActive(nullptr);
+
+		// Without an active profiler, zones are ignored
+		{
+			TickProfileScope ignored(tick_zone::Movement);
+		}
+
+		const UInt32 timers = profiler.getZone(tick_zone::Timers).getMax();
+		const UInt32 updates = profiler.getZone(tick_zone::ObjectUpdates).getMax();
+		const UInt32 sends = profiler.getZone(tick_zone::ProxySends).getMax();
+		BOOST_CHECK(timers >= 2000);
+		BOOST_CHECK(updates >= 2000);
+		BOOST_CHECK(sends >= 4000);
+		BOOST_CHECK(profiler.getZone(tick_zone::Movement).getMax() == 0);
+
+		// Nested zones are exclusive: if the updates zone included the sends, the zones would
+		// add up to more than the measured tick time. Only lower bounds are checked, since
+		// sleeps may overshoot on busy machines.
+		BOOST_REQUIRE(profiler.getTicks().getSampleCount() == 1);
+		BOOST_CHECK(profiler.getTicks().getMax() >= timers + updates + sends);
+		BOOST_CHECK(profiler.getSlowTickCount() == 0);
+	}
+}
@@ -0,0 +1,170 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include "game/game_character.h"
+#include "binary_io/vector_sink.h"
+#include "common/timer_queue.h"
+#include "proto_data/project.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Serializer used before visibility masks were introduced: builds the creation bits one
+		/// byte at a time into a heap allocated vector and tests every field, without filtering
+		/// any fields. Kept here as the baseline of the benchmark.
+		void writeLegacyCreationBlock(const GameObject &object, io::Writer &writer, GameCharacter &receiver)
+		{
+			const size_t valueCount = object.getValueCount();
+			const UInt8 blockCount = static_cast<UInt8>((valueCount + 31) / 32);
+			writer
+				<< io::write<NetUInt8>(blockCount);
+
+			const bool isWorldGO = object.isWorldObject();
+			std::vector<UInt32> creationBits(blockCount, 0);
+			for (size_t i = 0; i < valueCount; ++i)
+			{
+				if (object.getUInt32Value(i) ||
+					(isWorldGO && i == world_object_fields::DynFlags))
+				{
+					UInt8 &changed = (reinterpret_cast<UInt8 *>(&creationBits[0]))[i >> 3];
+					changed |= 1 << (i & 0x7);
+				}
+			}
+
+			writer
+				<< io::write_range(creationBits);
+
+			for (size_t i = 0; i < valueCount; ++i)
+			{
+				if (object.getUInt32Value(i) != 0 ||
+					(isWorldGO && i == world_object_fields::DynFlags))
+				{
+					object.writeUpdateValue(writer, receiver, i);
+				}
+			}
+		}
+
+		/// Writes a number of creation value update blocks of an object for a receiver.
+		/// @returns The last written block.
+		template<class F>
+		std::vector<char> writeCreationBlocks(F writeBlock, size_t iterations, double &out_seconds)
+		{
+			std::vector<char> buffer;
+			buffer.reserve(16384);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				buffer.clear();
+
+				io::VectorSink sink(buffer);
+				io::Writer writer(sink);
+				writeBlock(writer);
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			out_seconds = std::chrono::duration<double>(end - start).count();
+			return buffer;
+		}
+	}
+
+	namespace
+	{
+		/// Fills every field of a character with a non-zero value so that every field is part
+		/// of a creation block.
+		void fillCharacterFields(GameCharacter &object)
+		{
+			for (UInt16 i = 0; i < character_fields::CharacterFieldCount; ++i)
+			{
+				object.setUInt32Value(i, i + 1);
+			}
+			object.setUInt64Value(object_fields::Guid, 1);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(UpdateBlock_visibility_test)
+	{
+		boost::asio::io_service ioService;
+		TimerQueue timers(ioService);
+		proto::Project project;
+
+		GameCharacter object(project, timers);
+		GameCharacter other(project, timers);
+		fillCharacterFields(object);
+		other.setUInt64Value(object_fields::Guid, 2);
+
+		double seconds = 0.0;
+		const auto legacyBlock = writeCreationBlocks([&](io::Writer &writer) {
+			writeLegacyCreationBlock(object, writer, object);
+		}, 1, seconds);
+		const auto ownerBlock = writeCreationBlocks([&](io::Writer &writer) {
+			object.writeValueUpdateBlock(writer, object, true);
+		}, 1, seconds);
+		const auto publicBlock = writeCreationBlocks([&](io::Writer &writer) {
+			object.writeValueUpdateBlock(writer, other, true);
+		}, 1, seconds);
+
+		// Owners still receive every field, exactly like before
+		BOOST_CHECK(ownerBlock == legacyBlock);
+
+		// Private fields are no longer sent to other players
+		BOOST_CHECK(publicBlock.size() < legacyBlock.size());
+	}
+
+	// Only run on request: unit_tests --run_test=@benchmark
+	BOOST_AUTO_TEST_CASE(UpdateBlock_visibility_benchmark, *boost::unit_test::label("benchmark") * boost::unit_test::disabled())
+	{
+		boost::asio::io_service ioService;
+		TimerQueue timers(ioService);
+		proto::Project project;
+
+		GameCharacter object(project, timers);
+		GameCharacter other(project, timers);
+		fillCharacterFields(object);
+		other.setUInt64Value(object_fields::Guid, 2);
+
+		const size_t iterations = 10000;
+
+		double legacySeconds = 0.0;
+		const auto legacyBlock = writeCreationBlocks([&](io::Writer &writer) {
+			writeLegacyCreationBlock(object, writer, object);
+		}, iterations, legacySeconds);
+
+		double ownerSeconds = 0.0;
+		const auto ownerBlock = writeCreationBlocks([&](io::Writer &writer) {
+			object.writeValueUpdateBlock(writer, object, true);
+		}, iterations, ownerSeconds);
+
+		double publicSeconds = 0.0;
+		const auto publicBlock = writeCreationBlocks([&](io::Writer &writer) {
+			object.writeValueUpdateBlock(writer, other, true);
+		}, iterations, publicSeconds);
+
+		BOOST_TEST_MESSAGE("Legacy: " << legacyBlock.size() << " bytes, " << (legacySeconds * 1000000.0 / iterations) << " us per block");
+		BOOST_TEST_MESSAGE("Owner:  " << ownerBlock.size() << " bytes, " << (ownerSeconds * 1000000.0 / iterations) << " us per block");
+		BOOST_TEST_MESSAGE("Public: " << publicBlock.size() << " bytes, " << (publicSeconds * 1000000.0 / iterations) << " us per block");
+	}
+}
@@ -0,0 +1,163 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <chrono>
+#include "game_protocol/game_protocol.h"
+#include "binary_io/vector_sink.h"
+#include "binary_io/memory_source.h"
+#include "binary_io/reader.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Creates some update blocks with a realistic mix of repeating and random data.
+		std::vector<std::vector<char>> createTestBlocks(size_t count)
+		{
+			std::mt19937 random(12345);
+			std::vector<std::vector<char>> blocks(count);
+			for (auto &block : blocks)
+			{
+				block.resize(400);
+				for (size_t i = 0; i < block.size(); ++i)
+				{
+					// Most values are zero or small numbers
+					block[i] = (i % 4 == 0) ? static_cast<char>(random() & 0xFF) : 0;
+				}
+			}
+
+			return blocks;
+		}
+
+		/// Decompresses the body of a CompressedUpdateObject packet.
+		String inflatePacket(const std::vector<char> &buffer)
+		{
+			// Skip size, opcode and uncompressed size
+			std::stringstream strm(String(buffer.begin() + 8, buffer.end()));
+
+			boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+			in.push(boost::iostreams::zlib_decompressor());
+			in.push(strm);
+
+			std::stringstream outStrm;
+			boost::iostreams::copy(in, outStrm);
+			return outStrm.str();
+		}
+
+		/// Reads the uncompressed size of a CompressedUpdateObject packet.
+		UInt32 readOriginalSize(const std::vector<char> &buffer)
+		{
+			// Skip size and opcode
+			io::MemorySource source(buffer.data() + 4, buffer.data() + buffer.size());
+			io::Reader reader(source);
+
+			UInt32 origSize = 0;
+			BOOST_REQUIRE(reader >> io::read<NetUInt32>(origSize));
+			return origSize;
+		}
+
+		size_t benchmark(const std::vector<std::vector<char>> &blocks, game::UpdateCompression compression, size_t iterations, double &out_seconds)
+		{
+			std::vector<char> buffer;
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (size_t i = 0; i < iterations; ++i)
+			{
+				buffer.clear();
+
+				io::VectorSink sink(buffer);
+				game::OutgoingPacket packet(sink);
+				game::server_write::compressedUpdateObject(packet, blocks, compression);
+			}
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			out_seconds = std::chrono::duration<double>(end - start).count();
+			return buffer.size();
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(UpdateCompression_roundtrip_test)
+	{
+		const auto blocks = createTestBlocks(8);
+
+		std::vector<char> buffer;
+		io::VectorSink sink(buffer);
+		game::OutgoingPacket packet(sink);
+		game::server_write::compressedUpdateObject(packet, blocks, game::update_compression::Spawn);
+
+		const String data = inflatePacket(buffer);
+		BOOST_REQUIRE(data.size() == 5 + 8 * 400);
+
+		BOOST_CHECK(readOriginalSize(buffer) == data.size());
+		BOOST_CHECK(std::equal(blocks[0].begin(), blocks[0].end(), data.begin() + 5));
+	}
+
+	BOOST_AUTO_TEST_CASE(UpdateCompression_alternating_levels_test)
+	{
+		const auto blocks = createTestBlocks(4);
+
+		game::setUpdateCompressionLevel(game::update_compression::Update, 1);
+		game::setUpdateCompressionLevel(game::update_compression::Spawn, 9);
+
+		// Every packet switches the level of the same thread's compressor
+		for (size_t i = 0; i < 6; ++i)
+		{
+			const auto compression = (i % 2 == 0) ? game::update_compression::Spawn : game::update_compression::Update;
+
+			std::vector<char> buffer;
+			io::VectorSink sink(buffer);
+			game::OutgoingPacket packet(sink);
+			game::server_write::compressedUpdateObject(packet, blocks, compression);
+
+			const String data = inflatePacket(buffer);
+			BOOST_REQUIRE(data.size() == 5 + 4 * 400);
+			BOOST_CHECK(readOriginalSize(buffer) == data.size());
+			for (size_t b = 0; b < blocks.size(); ++b)
+			{
+				BOOST_CHECK(std::equal(blocks[b].begin(), blocks[b].end(), data.begin() + 5 + b * 400));
+			}
+		}
+	}
+
+	// Only run on request: unit_tests --run_test=@benchmark
+	BOOST_AUTO_TEST_CASE(UpdateCompression_level_benchmark, *boost::unit_test::label("benchmark") * boost::unit_test::disabled())
+	{
+		const auto blocks = createTestBlocks(32);
+		const size_t iterations = 1000;
+
+		game::setUpdateCompressionLevel(game::update_compression::Update, 1);
+		game::setUpdateCompressionLevel(game::update_compression::Spawn, 9);
+
+		double fastSeconds = 0.0, bestSeconds = 0.0;
+		const size_t fastBytes = benchmark(blocks, game::update_compression::Update, iterations, fastSeconds);
+		const size_t bestBytes = benchmark(blocks, game::update_compression::Spawn, iterations, bestSeconds);
+
+		BOOST_TEST_MESSAGE("Level 1: " << fastBytes << " bytes, " << (fastSeconds * 1000000.0 / iterations) << " us per packet");
+		BOOST_TEST_MESSAGE("Level 9: " << bestBytes << " bytes, " << (bestSeconds * 1000000.0 / iterations) << " us per packet");
+
+		BOOST_CHECK(bestBytes <= fastBytes);
+	}
+}
@@ -0,0 +1,281 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include <boost/any.hpp>
+#include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <mutex>
+#include <set>
+#include "common/sha1.h"
+#include "updater/http_update_source.h"
+#include "updater/prepare_parameters.h"
+#include "updater/prepare_progress_handler.h"
+#include "updater/prepare_update.h"
+#include "updater/update_parameters.h"
+#include "updater/updater_progress_handler.h"
+#include "updater/apply_update.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Minimal HTTP server which serves files from memory and supports range requests.
+		/// The first request of every file is cut off after a number of bytes to simulate a
+		/// broken connection.
+		class LocalHttpServer final
+		{
+		public:
+
+			explicit LocalHttpServer(std::map<std::string, std::string> files, size_t cutOffAfter)
+				: m_files(std::move(files))
+				, m_cutOffAfter(cutOffAfter)
+				, m_acceptor(m_ioService, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+				, m_rangeRequests(0)
+				, m_stopping(false)
+			{
+				m_thread = std::thread([this]() { run(); });
+			}
+
+			~LocalHttpServer()
+			{
+				// Wake up the blocking accept call
+				m_stopping = true;
+				{
+					boost::asio::io_service ioService;
+					boost::asio::ip::tcp::socket socket(ioService);
+					boost::system::error_code error;
+					socket.connect(m_acceptor.local_endpoint(), error);
+				}
+				m_thread.join();
+				for (auto &connection : m_connections)
+				{
+					connection.join();
+				}
+			}
+
+			NetPort getPort() const { return m_acceptor.local_endpoint().port(); }
+			size_t getRangeRequests() const { return m_rangeRequests; }
+
+		private:
+
+			void run()
+			{
+				for (;;)
+				{
+					auto socket = std::make_shared<boost::asio::ip::tcp::socket>(m_ioService);
+					boost::system::error_code error;
+					m_acceptor.accept(*socket, error);
+					if (error || m_stopping)
+					{
+						break;
+					}
+
+					m_connections.emplace_back([this, socket]() { serve(*socket); });
+				}
+			}
+
+			void serve(boost::asio::ip::tcp::socket &socket)
+			{
+				boost::asio::streambuf request;
+				boost::system::error_code error;
+				boost::asio::read_until(socket, request, "\r\n\r\n", error);
+				if (error)
+				{
+					return;
+				}
+
+				std::istream requestStream(&request);
+				std::string method, document, line;
+				requestStream >> method >> document;
+				std::getline(requestStream, line);
+
+				size_t rangeBegin = 0;
+				while (std::getline(requestStream, line) && line != "\r")
+				{
+					const std::string rangePrefix = "Range: bytes=";
+					if (line.compare(0, rangePrefix.size(), rangePrefix) == 0)
+					{
+						rangeBegin = std::stoul(line.substr(rangePrefix.size()));
+						++m_rangeRequests;
+					}
+				}
+
+				std::string response;
+				bool cutOff = false;
+				std::string body;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					const auto file = m_files.find(document);
+					if (file == m_files.end())
+					{
+						response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+					}
+					else
+					{
+						body = file->second.substr(std::min(rangeBegin, file->second.size()));
+						response = (rangeBegin > 0 ? "HTTP/1.0 206 Partial Content\r\n" : "HTTP/1.0 200 OK\r\n");
+						response += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+
+						cutOff = (m_cutOffAfter > 0 && document != "/list.txt" && m_served.insert(document).second);
+					}
+				}
+
+				if (cutOff && body.size() > m_cutOffAfter)
+				{
+					body.resize(m_cutOffAfter);
+				}
+
+				response += body;
+				boost::asio::write(socket, boost::asio::buffer(response), error);
+				socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+			}
+
+		private:
+
+			std::map<std::string, std::string> m_files;
+			const size_t m_cutOffAfter;
+			boost::asio::io_service m_ioService;
+			boost::asio::ip::tcp::acceptor m_acceptor;
+			std::thread m_thread;
+			std::vector<std::thread> m_connections;
+			std::mutex m_mutex;
+			std::set<std::string> m_served;
+			std::atomic<size_t> m_rangeRequests;
+			std::atomic<bool> m_stopping;
+		};
+
+		struct NullProgressHandler : updating::IPrepareProgressHandler, updating::IUpdaterProgressHandler
+		{
+			double bytesPerSecond = 0.0;
+
+			virtual void beginCheckLocalCopy(const std::string &/*name*/) override
+			{
+			}
+			virtual void updateFile(const std::string &/*name*/, boost::uintmax_t /*size*/, boost::uintmax_t /*loaded*/) override
+			{
+			}
+			virtual void updateTotal(boost::uintmax_t /*size*/, boost::uintmax_t /*loaded*/, double bytesPerSecond) override
+			{
+				this->bytesPerSecond = bytesPerSecond;
+			}
+		};
+
+		std::string compress(const std::string &content)
+		{
+			std::istringstream source(content);
+			boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+			in.push(boost::iostreams::zlib_compressor());
+			in.push(source);
+
+			std::ostringstream compressed;
+			boost::iostreams::copy(in, compressed);
+			return compressed.str();
+		}
+
+		std::string readWholeFile(const boost::filesystem::path &path)
+		{
+			std::ifstream file(path.string(), std::ios::binary);
+			std::ostringstream content;
+			content << file.rdbuf();
+			return content.str();
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(Updater_resumable_parallel_download_test)
+	{
+		const size_t fileCount = 8;
+
+		// Create some files and the matching update list
+		std::mt19937 random(4711);
+		std::map<std::string, std::string> originals;
+		std::map<std::string, std::string> served;
+		std::ostringstream list;
+		list << "version = 1\nroot = (type = \"fs\", name = \"\", entries =\n{\n";
+		for (size_t i = 0; i < fileCount; ++i)
+		{
+			const std::string name = "file" + std::to_string(i) + ".dat";
+			std::string content(256 * 1024, '\0');
+			for (size_t j = 0; j < content.size(); ++j)
+			{
+				content[j] = (j % 3 == 0) ? static_cast<char>(random() & 0x0F) : static_cast<char>('a' + (j % 7));
+			}
+
+			const std::string compressed = compress(content);
+			std::istringstream hashSource(content);
+			std::ostringstream hash;
+			sha1PrintHex(hash, sha1(hashSource));
+
+			list << "\t(type = \"fs\", name = \"" << name << "\", compressedName = \"" << name << ".z\", originalSize = " << content.size() <<
+			     ", sha1 = \"" << hash.str() << "\", compression = \"zlib\", compressedSize = " << compressed.size() << ")\n";
+
+			originals[name] = content;
+			served["/" + name + ".z"] = compressed;
+		}
+		list << "})\n";
+		served["/list.txt"] = list.str();
+
+		const auto outputDir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("wowpp-updater-%%%%%%%%");
+		boost::filesystem::create_directories(outputDir);
+
+		{
+			LocalHttpServer server(served, 10000);
+			NullProgressHandler progress;
+
+			updating::PrepareParameters prepareParameters(
+			    std::unique_ptr<updating::IUpdateSource>(new updating::HTTPUpdateSource("127.0.0.1", server.getPort(), "/")),
+			    std::set<std::string>(),
+			    false,
+			    progress);
+
+			const auto preparedUpdate = updating::prepareUpdate(
+			                                (outputDir / "missing").string(),
+			                                outputDir.string(),
+			                                prepareParameters);
+			BOOST_REQUIRE(preparedUpdate.steps.size() == fileCount);
+
+			updating::UpdateParameters updateParameters(
+			    std::move(prepareParameters.source),
+			    false,
+			    progress);
+
+			const auto statistics = updating::applyUpdate(preparedUpdate, updateParameters, 4);
+			BOOST_TEST_MESSAGE("Downloaded " << statistics.downloadedBytes << " bytes in " << statistics.seconds <<
+			                   "s (" << (statistics.getBytesPerSecond() / (1024.0 * 1024.0)) << " MB/s)");
+
+			// Every file was cut off once and had to be resumed
+			BOOST_CHECK(server.getRangeRequests() == fileCount);
+			BOOST_CHECK(statistics.downloadedBytes == preparedUpdate.estimates.downloadSize);
+		}
+
+		for (const auto &original : originals)
+		{
+			const auto path = outputDir / original.first;
+			BOOST_CHECK(readWholeFile(path) == original.second);
+			BOOST_CHECK(!boost::filesystem::exists(path.string() + ".part"));
+		}
+
+		boost::filesystem::remove_all(outputDir);
+	}
+}
@@ -0,0 +1,162 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/clock.h"
+#include "common/timer_queue.h"
+#include "common/id_generator.h"
+#include "proto_data/project.h"
+#include "game/universe.h"
+#include "game/trigger_handler.h"
+#include "game/world_instance_manager.h"
+#include "game/world_instance.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		const GameTime IdleTimeout = constants::OneMinute;
+
+		/// Triggers aren't used by these tests.
+		struct NullTriggerHandler final : game::ITriggerHandler
+		{
+			void executeTrigger(const proto::TriggerEntry &entry, game::TriggerContext context, UInt32 actionOffset, bool ignoreProbability) override
+			{
+			}
+		};
+
+		/// A world node with one global map and one dungeon map, driven by simulated time.
+		struct TestNode final
+		{
+			boost::asio::io_service ioService;
+			TimerQueue timers;
+			proto::Project project;
+			Universe universe;
+			NullTriggerHandler triggerHandler;
+			IdGenerator<UInt32> instanceIdGenerator;
+			IdGenerator<UInt64> objectIdGenerator;
+			WorldInstanceManager manager;
+			const proto::MapEntry *globalMap;
+			const proto::MapEntry *dungeonMap;
+
+			TestNode()
+				: timers(ioService)
+				, universe(ioService, timers)
+				, objectIdGenerator(0x01)
+				, manager(ioService, universe, triggerHandler, instanceIdGenerator, objectIdGenerator, project, 0, "")
+			{
+				enableSimulatedTime(constants::OneHour);
+				manager.stopUpdates();
+				manager.setIdleTimeout(IdleTimeout);
+
+				auto *global = project.maps.add(0);
+				global->set_instancetype(proto::MapEntry_MapInstanceType_GLOBAL);
+				globalMap = global;
+
+				auto *dungeon = project.maps.add(33);
+				dungeon->set_instancetype(proto::MapEntry_MapInstanceType_DUNGEON);
+				dungeonMap = dungeon;
+			}
+
+			~TestNode()
+			{
+				disableSimulatedTime();
+			}
+
+			/// Lets time pass and updates all instances once.
+			void advance(GameTime delta)
+			{
+				advanceSimulatedTime(delta);
+				manager.updateInstances();
+			}
+		};
+	}
+
+	BOOST_AUTO_TEST_CASE(WorldInstanceManager_unloads_idle_dungeons)
+	{
+		TestNode node;
+
+		const UInt32 globalId = node.manager.createInstance(*node.globalMap)->getId();
+		const UInt32 idleId = node.manager.createInstance(*node.dungeonMap)->getId();
+		auto *bound = node.manager.createInstance(*node.dungeonMap);
+		const UInt32 boundId = bound->getId();
+		bound->bindPlayer();
+
+		// Nothing is unloaded before the timeout
+		node.advance(IdleTimeout / 2);
+		BOOST_CHECK(node.manager.getInstanceById(idleId) != nullptr);
+		BOOST_CHECK_EQUAL(node.manager.getInstances().size(), 3);
+
+		node.advance(IdleTimeout / 2);
+		BOOST_CHECK(node.manager.getInstanceById(idleId) == nullptr);
+		BOOST_CHECK(node.manager.getInstanceById(boundId) == bound);
+		BOOST_CHECK(node.manager.getInstanceById(globalId) != nullptr);
+		BOOST_CHECK_EQUAL(node.manager.getInstances().size(), 2);
+
+		// The timeout starts when the last bound player leaves
+		bound->bindPlayer();
+		bound->unbindPlayer();
+		node.advance(IdleTimeout);
+		BOOST_CHECK(node.manager.getInstanceById(boundId) == bound);
+
+		bound->unbindPlayer();
+		BOOST_CHECK_EQUAL(bound->getPlayerCount(), 0);
+		node.advance(IdleTimeout / 2);
+		BOOST_CHECK(node.manager.getInstanceById(boundId) == bound);
+
+		node.advance(IdleTimeout / 2);
+		BOOST_CHECK(node.manager.getInstanceById(boundId) == nullptr);
+
+		// Global maps are never unloaded
+		node.advance(IdleTimeout * 10);
+		BOOST_CHECK(node.manager.getInstanceById(globalId) != nullptr);
+		BOOST_CHECK_EQUAL(node.manager.getInstances().size(), 1);
+	}
+
+	BOOST_AUTO_TEST_CASE(WorldInstanceManager_reuses_grids_of_unloaded_instances)
+	{
+		TestNode node;
+		const size_t maxPooled = WorldInstanceManager::MaxPooledGrids;
+
+		std::vector<const VisibilityGrid *> grids;
+		for (size_t i = 0; i < maxPooled + 2; ++i)
+		{
+			grids.push_back(&node.manager.createInstance(*node.dungeonMap)->getGrid());
+		}
+		BOOST_CHECK_EQUAL(node.manager.getPooledGridCount(), 0);
+
+		// Only a limited number of grids is kept
+		node.advance(IdleTimeout);
+		BOOST_CHECK(node.manager.getInstances().empty());
+		BOOST_CHECK_EQUAL(node.manager.getPooledGridCount(), maxPooled);
+
+		// The grid of the last instance which went into the pool is used first
+		auto *reused = node.manager.createInstance(*node.dungeonMap);
+		BOOST_CHECK(&reused->getGrid() == grids[maxPooled - 1]);
+		BOOST_CHECK_EQUAL(node.manager.getPooledGridCount(), maxPooled - 1);
+
+		// Unloading it again returns the grid to the pool
+		node.advance(IdleTimeout);
+		BOOST_CHECK_EQUAL(node.manager.getPooledGridCount(), maxPooled);
+	}
+}
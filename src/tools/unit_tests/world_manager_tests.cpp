@@ -0,0 +1,182 @@
+//
+// This file is part of the WoW++ project.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+// World of Warcraft, and all World of Warcraft or Warcraft art, images,
+// and lore are copyrighted by Blizzard Entertainment, Inc.
+//
+
+
+#include "pch.h"
+#include <boost/test/unit_test.hpp>
+#include "common/timer_queue.h"
+#include "proto_data/project.h"
+#include "binary_io/string_sink.h"
+#include "binary_io/memory_source.h"
+#include "servers/realm/world.h"
+#include "servers/realm/world_manager.h"
+#include "servers/realm/player_manager.h"
+#include "servers/realm/player_group.h"
+#include "servers/realm/mysql_database.h"
+
+namespace wowpp
+{
+	namespace
+	{
+		/// Both world nodes number their instances on their own and report the same id.
+		const UInt32 SharedInstanceId = 1 | (33 << 16);
+
+		/// A world node connection which discards everything the realm sends.
+		struct NullConnection final : AbstractConnection<pp::Protocol>
+		{
+			Listener *listener = nullptr;
+			Buffer sendBuffer;
+
+			void setListener(Listener &listener_) override { listener = &listener_; }
+			void resetListener() override { listener = nullptr; }
+			boost::asio::ip::address getRemoteAddress() const override { return boost::asio::ip::address(); }
+			Buffer &getSendBuffer() override { return sendBuffer; }
+			void startReceiving() override {}
+			void resumeParsing() override {}
+			void flush() override { sendBuffer.clear(); }
+			void close() override {}
+			void setReceiveSize(size_t size) override {}
+
+			/// Passes a packet written by the given generator to the realm side of the connection.
+			template<class F>
+			void receive(F generator)
+			{
+				String buffer;
+				io::StringSink sink(buffer);
+				pp::OutgoingPacket outgoing(sink);
+				generator(outgoing);
+
+				io::MemorySource source(buffer);
+				pp::IncomingPacket incoming;
+				BOOST_REQUIRE(pp::IncomingPacket::start(incoming, source) == receive_state::Complete);
+				BOOST_REQUIRE(listener);
+				listener->connectionPacketReceived(incoming);
+			}
+		};
+
+		/// A realm with two world nodes which both serve the dungeon map 33.
+		struct TestRealm final
+		{
+			boost::asio::io_service ioService;
+			TimerQueue timers;
+			proto::Project project;
+			MySQLDatabase database;
+			WorldManager worldManager;
+			PlayerManager playerManager;
+			const proto::MapEntry *dungeonMap;
+
+			TestRealm()
+				: timers(ioService)
+				, database(project, MySQL::DatabaseInfo())
+				, worldManager(2)
+				, playerManager(timers, 1, 8)
+			{
+				auto *dungeon = project.maps.add(33);
+				dungeon->set_instancetype(proto::MapEntry_MapInstanceType_DUNGEON);
+				dungeonMap = dungeon;
+			}
+
+			/// Connects a world node which already runs the given instances of the dungeon map.
+			std::shared_ptr<World> addWorld(std::shared_ptr<NullConnection> &connection, const std::vector<UInt32> &instanceIds)
+			{
+				connection = std::make_shared<NullConnection>();
+				auto world = std::make_shared<World>(worldManager, playerManager, project, database, connection, "127.0.0.1", "Test");
+				worldManager.addWorld(world);
+
+				const std::vector<UInt32> mapIds(1, dungeonMap->id());
+				connection->receive(std::bind(pp::world_realm::world_write::login, std::placeholders::_1, std::cref(mapIds), std::cref(instanceIds)));
+				return world;
+			}
+
+			/// Selects a world node for the dungeon map like a player login with the given binding would.
+			World *select(World *instanceWorld, UInt32 &instanceId)
+			{
+				return worldManager.selectWorldForMap(*dungeonMap, instanceWorld, instanceId);
+			}
+		};
+	}
+
+	BOOST_AUTO_TEST_CASE(WorldManager_routes_instances_by_world_node)
+	{
+		TestRealm realm;
+
+		std::shared_ptr<NullConnection> firstConnection, secondConnection;
+		auto first = realm.addWorld(firstConnection, std::vector<UInt32>(1, SharedInstanceId));
+		auto second = realm.addWorld(secondConnection, std::vector<UInt32>(1, SharedInstanceId));
+		BOOST_REQUIRE(first->hasInstance(SharedInstanceId));
+		BOOST_REQUIRE(second->hasInstance(SharedInstanceId));
+
+		// Each binding stays on the node which runs the bound instance
+		UInt32 instanceId = SharedInstanceId;
+		BOOST_CHECK(realm.select(first.get(), instanceId) == first.get());
+		BOOST_CHECK_EQUAL(instanceId, SharedInstanceId);
+
+		instanceId = SharedInstanceId;
+		BOOST_CHECK(realm.select(second.get(), instanceId) == second.get());
+		BOOST_CHECK_EQUAL(instanceId, SharedInstanceId);
+
+		// Unloading the instance on one node doesn't affect the instance of the other node
+		firstConnection->receive(std::bind(pp::world_realm::world_write::worldInstanceUnloaded, std::placeholders::_1, SharedInstanceId));
+		BOOST_CHECK(!first->hasInstance(SharedInstanceId));
+		BOOST_CHECK(second->hasInstance(SharedInstanceId));
+
+		instanceId = SharedInstanceId;
+		BOOST_CHECK(realm.select(first.get(), instanceId) != nullptr);
+		BOOST_CHECK_EQUAL(instanceId, std::numeric_limits<UInt32>::max());
+
+		instanceId = SharedInstanceId;
+		BOOST_CHECK(realm.select(second.get(), instanceId) == second.get());
+		BOOST_CHECK_EQUAL(instanceId, SharedInstanceId);
+
+		// A binding to a disconnected node is dropped even if the node object is still alive
+		secondConnection->listener->connectionLost();
+		instanceId = SharedInstanceId;
+		BOOST_CHECK(realm.select(second.get(), instanceId) == first.get());
+		BOOST_CHECK_EQUAL(instanceId, std::numeric_limits<UInt32>::max());
+	}
+
+	BOOST_AUTO_TEST_CASE(PlayerGroup_rebinds_unloaded_instances)
+	{
+		TestRealm realm;
+
+		std::shared_ptr<NullConnection> firstConnection, secondConnection;
+		auto first = realm.addWorld(firstConnection, std::vector<UInt32>(1, SharedInstanceId));
+		auto second = realm.addWorld(secondConnection, std::vector<UInt32>(1, SharedInstanceId));
+
+		PlayerGroup group(1, realm.playerManager, realm.database);
+		const UInt32 mapId = realm.dungeonMap->id();
+		BOOST_CHECK(group.addInstanceBinding(*first, SharedInstanceId, mapId));
+
+		// The same instance id on another node is a different instance
+		BOOST_CHECK(!group.addInstanceBinding(*second, SharedInstanceId, mapId));
+		const auto *binding = group.instanceBindingForMap(mapId);
+		BOOST_REQUIRE(binding);
+		BOOST_CHECK(binding->world.lock() == first);
+
+		// Once the bound instance is unloaded, the next instance entered by a member is bound
+		firstConnection->receive(std::bind(pp::world_realm::world_write::worldInstanceUnloaded, std::placeholders::_1, SharedInstanceId));
+		BOOST_CHECK(group.addInstanceBinding(*second, SharedInstanceId, mapId));
+		binding = group.instanceBindingForMap(mapId);
+		BOOST_REQUIRE(binding);
+		BOOST_CHECK(binding->world.lock() == second);
+		BOOST_CHECK_EQUAL(binding->instanceId, SharedInstanceId);
+	}
+}
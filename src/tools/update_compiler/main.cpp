@@ -34,8 +34,9 @@ int main(int argc, char **argv)
 
 	static const std::string VersionStr = "WoW++ Update Compiler 1.0";
 
-	std::string sourceDir, outputDir;
+	std::string sourceDir, outputDir, cacheDir;
 	std::string compression;
+	size_t threadCount = 0;
 
 	po::options_description desc(VersionStr + ", available options");
 	desc.add_options()
@@ -44,6 +45,9 @@ int main(int argc, char **argv)
 	("source,s", po::value<std::string>(&sourceDir), "a directory containing source.txt")
 	("output,o", po::value<std::string>(&outputDir), "where to put the updater-compatible files")
 	("compression,c", po::value<std::string>(&compression), "provide 'zlib' for compression")
+	("threads,j", po::value<size_t>(&threadCount), "number of threads used to hash and compress files (default: one per core)")
+	("cache", po::value<std::string>(&cacheDir), "where to remember the compiled files for the next compilation (default: <output>.cache)")
+	("rebuild", "ignore the results of the previous compilation and compile all files again")
 	;
 
 	po::positional_options_description p;
@@ -96,12 +100,37 @@ int main(int argc, char **argv)
 	{
 		virtual_dir::FileSystemReader sourceReader(sourceDir);
 		virtual_dir::FileSystemWriter outputWriter(outputDir);
+		virtual_dir::FileSystemReader previousOutputReader(outputDir);
 
-		wowpp::updating::compileDirectory(
-		    sourceReader,
-		    outputWriter,
-		    isZLibCompressed
-		);
+		// Keep the cache next to the output directory, so that it is not published with the update
+		if (cacheDir.empty())
+		{
+			const boost::filesystem::path outputPath(outputDir);
+			cacheDir = (outputPath.has_filename() && outputPath.filename() != ".")
+			           ? outputPath.string() + ".cache"
+			           : (outputPath.parent_path().string() + ".cache");
+		}
+		virtual_dir::FileSystemWriter cacheWriter(cacheDir);
+		virtual_dir::FileSystemReader previousCacheReader(cacheDir);
+
+		wowpp::updating::CompileOptions options;
+		options.isZLibCompressed = isZLibCompressed;
+		options.threadCount = threadCount;
+		options.cache = &cacheWriter;
+		if (!vm.count("rebuild"))
+		{
+			options.previousOutput = &previousOutputReader;
+			options.previousCache = &previousCacheReader;
+		}
+
+		const auto statistics = wowpp::updating::compileDirectory(
+		                            sourceReader,
+		                            outputWriter,
+		                            options
+		                        );
+
+		std::cerr << "Compiled " << statistics.compiledFiles << " files, reused "
+		          << statistics.reusedFiles << " unchanged files\n";
 	}
 	catch (const std::exception &e)
 	{